@@ -0,0 +1,69 @@
+#ifndef BENCH_CURVE_HPP
+#define BENCH_CURVE_HPP
+
+#include <qobject.h>
+#include <qtest.h>
+
+#include "benchmark_data.hpp"
+#include "plot_sampler.hpp"
+#include "fft_sampler.hpp"
+
+
+class PlotCurveBenchmarks : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void updateCurveSamples_data(void)
+    {
+        QTest::addColumn<qint64>("size");
+        QTest::addColumn<double>("zoom");
+
+        for (qint64 size = 1000; size <= 100000000 && size <= BenchmarkData::maxSize(); size *= 10)
+        {
+            for (double zoom : {1.0, 0.1, 0.001})
+            {
+                QString label = QString("%1 @ %2%").arg(BenchmarkData::sizeLabel(size)).arg(zoom * 100);
+
+                QTest::newRow(qPrintable(label)) << size << zoom;
+            }
+        }
+    }
+
+    void updateCurveSamples(void)
+    {
+        QFETCH(qint64, size);
+        QFETCH(double, zoom);
+
+        DataSeriesPointer series = BenchmarkData::generateSeries(size);
+        PlotCurveUpdater updater(*series);
+
+        // View centered on the data
+        double span = size * zoom;
+        double t_min = (size - span) / 2;
+        double t_max = t_min + span;
+
+        QBENCHMARK
+        {
+            updater.invalidate();
+            updater.updateCurveSamples(t_min, t_max, 1920);
+        }
+    }
+
+    void fft_data(void) { BenchmarkData::addSizeRows(); }
+    void fft(void)
+    {
+        QFETCH(qint64, size);
+
+        DataSeriesPointer series = BenchmarkData::generateSeries(size, "series", 50);
+        FFTCurveUpdater updater(*series);
+
+        QBENCHMARK
+        {
+            updater.invalidate();
+            updater.updateCurveSamples(0, size, 1920);
+        }
+    }
+};
+
+#endif // BENCH_CURVE_HPP
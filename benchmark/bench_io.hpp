@@ -0,0 +1,120 @@
+#ifndef BENCH_IO_HPP
+#define BENCH_IO_HPP
+
+#include <qobject.h>
+#include <qtest.h>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "benchmark_data.hpp"
+#include "lumberjack_csv_importer.hpp"
+#include "lumberjack_csv_exporter.hpp"
+
+
+class DataIOBenchmarks : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void importCSV_data(void) { BenchmarkData::addSizeRows(); }
+    void importCSV(void)
+    {
+        QFETCH(qint64, size);
+
+        QString filename = dir.filePath(QString("import_%1.csv").arg(size));
+
+        QVERIFY(writeCSV(filename, size, 4));
+
+        QBENCHMARK
+        {
+            LumberjackCSVImporter importer;
+
+            importer.setInteractive(false);
+            importer.setFilename(filename);
+
+            QStringList errors;
+
+            QVERIFY(importer.beforeImport());
+            QVERIFY(importer.importData(errors));
+
+            QCOMPARE(importer.getDataSeries().count(), 4);
+        }
+
+        QFile::remove(filename);
+    }
+
+    void exportCSV_data(void) { BenchmarkData::addSizeRows(); }
+    void exportCSV(void)
+    {
+        QFETCH(qint64, size);
+
+        QList<DataSeriesPointer> series;
+
+        series << BenchmarkData::generateSeries(size, "a", 1.0);
+        series << BenchmarkData::generateSeries(size, "b", 5.0);
+
+        QString filename = dir.filePath(QString("export_%1.csv").arg(size));
+
+        QBENCHMARK
+        {
+            LumberjackCSVExporter exporter;
+
+            exporter.setInteractive(false);
+            exporter.setFilename(filename);
+
+            QStringList errors;
+
+            QVERIFY(exporter.beforeExport());
+            QVERIFY(exporter.exportData(series, errors));
+        }
+
+        QFile::remove(filename);
+    }
+
+protected:
+    // Write a CSV file with a timestamp column (seconds) and the specified number of value columns
+    bool writeCSV(QString filename, qint64 rows, int columns)
+    {
+        QFile file(filename);
+
+        if (!file.open(QIODevice::WriteOnly)) return false;
+
+        QByteArray buffer;
+
+        buffer.append("timestamp");
+
+        for (int col = 0; col < columns; col++)
+        {
+            buffer.append(QString(",column_%1").arg(col).toUtf8());
+        }
+
+        buffer.append('\n');
+
+        for (qint64 row = 0; row < rows; row++)
+        {
+            buffer.append(QByteArray::number(row * 0.001, 'f', 3));
+
+            for (int col = 0; col < columns; col++)
+            {
+                buffer.append(',');
+                buffer.append(QByteArray::number(sin(row * 0.001 * (col + 1)), 'g', 8));
+            }
+
+            buffer.append('\n');
+
+            if (buffer.size() > 0x100000)
+            {
+                file.write(buffer);
+                buffer.clear();
+            }
+        }
+
+        file.write(buffer);
+
+        return true;
+    }
+
+    QTemporaryDir dir;
+};
+
+#endif // BENCH_IO_HPP
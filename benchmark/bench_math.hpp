@@ -0,0 +1,43 @@
+#ifndef BENCH_MATH_HPP
+#define BENCH_MATH_HPP
+
+#include <qobject.h>
+#include <qtest.h>
+
+#include "benchmark_data.hpp"
+#include "math_data_series.hpp"
+#include "math_trace_computer.hpp"
+
+
+class MathTraceBenchmarks : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void evaluate_data(void) { BenchmarkData::addSizeRows(); }
+    void evaluate(void)
+    {
+        QFETCH(qint64, size);
+
+        QMap<QString, DataSeriesPointer> variables;
+
+        variables["a"] = BenchmarkData::generateSeries(size, "a", 1.0);
+        variables["b"] = BenchmarkData::generateSeries(size, "b", 5.0);
+
+        const QString expression = "a * 2 + sin(b) - a / 3";
+
+        QBENCHMARK
+        {
+            MathDataSeriesPointer result(new MathDataSeries("result", expression, variables));
+
+            MathTraceComputer computer;
+
+            computer.compute(expression, variables, result);
+            computer.startComputation();
+
+            QVERIFY(result->size() > 0);
+        }
+    }
+};
+
+#endif // BENCH_MATH_HPP
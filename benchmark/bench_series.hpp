@@ -0,0 +1,101 @@
+#ifndef BENCH_SERIES_HPP
+#define BENCH_SERIES_HPP
+
+#include <qobject.h>
+#include <qtest.h>
+
+#include "benchmark_data.hpp"
+
+
+class DataSeriesBenchmarks : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void appendData_data(void) { BenchmarkData::addSizeRows(); }
+    void appendData(void)
+    {
+        QFETCH(qint64, size);
+
+        QBENCHMARK
+        {
+            DataSeries series;
+
+            for (qint64 ii = 0; ii < size; ii++)
+            {
+                series.addData(ii, ii % 100, false);
+            }
+        }
+    }
+
+    void insertOutOfOrder_data(void) { BenchmarkData::addSizeRows(); }
+    void insertOutOfOrder(void)
+    {
+        QFETCH(qint64, size);
+
+        // Every 100th sample arrives 10 samples late
+        QBENCHMARK
+        {
+            DataSeries series;
+
+            for (qint64 ii = 0; ii < size; ii++)
+            {
+                qint64 t = (ii % 100 == 10) ? ii - 10 : ii;
+
+                series.addData(t, ii % 100, false);
+            }
+
+            // Late samples are buffered until the series is sealed
+            series.seal();
+        }
+    }
+
+    void indexForTimestamp_data(void) { BenchmarkData::addSizeRows(); }
+    void indexForTimestamp(void)
+    {
+        QFETCH(qint64, size);
+
+        DataSeriesPointer series = BenchmarkData::generateSeries(size);
+
+        const int LOOKUPS = 100000;
+
+        uint64_t total = 0;
+
+        QBENCHMARK
+        {
+            for (int ii = 0; ii < LOOKUPS; ii++)
+            {
+                double t = (double) ((ii * 7919LL) % size) + 0.5;
+
+                total += series->getIndexForTimestamp(t);
+            }
+        }
+
+        QVERIFY(total > 0);
+    }
+
+    void rangeStatistics_data(void) { BenchmarkData::addSizeRows(); }
+    void rangeStatistics(void)
+    {
+        QFETCH(qint64, size);
+
+        DataSeriesPointer series = BenchmarkData::generateSeries(size);
+
+        // Middle half of the data
+        double t_min = size / 4;
+        double t_max = size * 3 / 4;
+
+        double result = 0;
+
+        QBENCHMARK
+        {
+            result += series->getMinimumValue(t_min, t_max);
+            result += series->getMaximumValue(t_min, t_max);
+            result += series->getMeanValue(t_min, t_max);
+        }
+
+        QVERIFY(!isnan(result));
+    }
+};
+
+#endif // BENCH_SERIES_HPP
@@ -0,0 +1,65 @@
+QT += core gui widgets testlib
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+TARGET = benchmark
+
+# Benchmarks are always built with optimization (and without coverage instrumentation)
+CONFIG -= debug
+CONFIG += release
+
+QMAKE_CXXFLAGS += -Wno-unused-parameter -Wno-sign-compare
+
+INCLUDEPATH += \
+    ../src \
+    ../src/plugins \
+    ../src/widgets \
+    ../plugins/csv_importer \
+    ../plugins/csv_exporter \
+    ..
+
+SOURCES += \
+    ../src/data_series.cpp \
+    ../src/data_storage.cpp \
+    ../src/fft_sampler.cpp \
+    ../src/math_data_series.cpp \
+    ../src/math_expression_parser.cpp \
+    ../src/math_trace_computer.cpp \
+    ../src/performance_monitor.cpp \
+    ../src/plugins/plugin_exporter.cpp \
+    ../src/plugins/plugin_importer.cpp \
+    ../src/widgets/plot_sampler.cpp \
+    ../plugins/csv_exporter/lumberjack_csv_exporter.cpp \
+    ../plugins/csv_importer/import_options_dialog.cpp \
+    ../plugins/csv_importer/lumberjack_csv_importer.cpp \
+    main.cpp
+
+HEADERS += \
+    ../src/data_batch.hpp \
+    ../src/data_point.hpp \
+    ../src/data_series.hpp \
+    ../src/data_storage.hpp \
+    ../src/fft_sampler.hpp \
+    ../src/math_data_series.hpp \
+    ../src/math_expression_parser.hpp \
+    ../src/math_trace_computer.hpp \
+    ../src/performance_monitor.hpp \
+    ../src/plugins/plugin_base.hpp \
+    ../src/plugins/plugin_exporter.hpp \
+    ../src/plugins/plugin_importer.hpp \
+    ../src/widgets/plot_sampler.hpp \
+    ../plugins/csv_exporter/lumberjack_csv_exporter.hpp \
+    ../plugins/csv_importer/csv_import_options.hpp \
+    ../plugins/csv_importer/import_options_dialog.hpp \
+    ../plugins/csv_importer/lumberjack_csv_importer.hpp \
+    benchmark_data.hpp \
+    bench_curve.hpp \
+    bench_io.hpp \
+    bench_math.hpp \
+    bench_series.hpp
+
+FORMS += \
+    ../plugins/csv_importer/ui/csv_import_options.ui
+
+UI_DIR = build/ui
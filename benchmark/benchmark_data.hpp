@@ -0,0 +1,99 @@
+#ifndef BENCHMARK_DATA_HPP
+#define BENCHMARK_DATA_HPP
+
+#include <qtest.h>
+
+#include <math.h>
+#include <vector>
+
+#include "data_series.hpp"
+
+
+/**
+ * @brief The BenchmarkData class generates (deterministic) data sets for the benchmarks
+ *
+ * Each benchmark is run for sample counts from 1K up to getMaxSize(),
+ * which is set with the --max-size argument (see main.cpp).
+ */
+class BenchmarkData
+{
+public:
+    static qint64 &maxSize(void)
+    {
+        static qint64 size = DEFAULT_MAX_SIZE;
+        return size;
+    }
+
+    //! Largest data set used by default (larger sets require several GB of memory)
+    static const qint64 DEFAULT_MAX_SIZE = 1000000;
+
+    // Parse a size string, e.g. "100K" or "10M"
+    static qint64 parseSize(QString text)
+    {
+        text = text.trimmed().toUpper();
+
+        qint64 multiplier = 1;
+
+        if (text.endsWith("K")) multiplier = 1000;
+        else if (text.endsWith("M")) multiplier = 1000000;
+
+        if (multiplier > 1) text.chop(1);
+
+        bool ok = false;
+        qint64 size = text.toLongLong(&ok);
+
+        return ok ? size * multiplier : 0;
+    }
+
+    static QString sizeLabel(qint64 size)
+    {
+        if (size >= 1000000) return QString("%1M").arg(size / 1000000);
+        if (size >= 1000) return QString("%1K").arg(size / 1000);
+
+        return QString::number(size);
+    }
+
+    // Add a data row for each benchmark size (call from a _data() function)
+    static void addSizeRows(void)
+    {
+        QTest::addColumn<qint64>("size");
+
+        for (qint64 size = 1000; size <= 100000000 && size <= maxSize(); size *= 10)
+        {
+            QTest::newRow(qPrintable(sizeLabel(size))) << size;
+        }
+    }
+
+    // Generate a series of evenly spaced (1ms) samples
+    static DataSeriesPointer generateSeries(qint64 size, QString label = "series", double frequency = 1.0)
+    {
+        DataSeriesPointer series(new DataSeries(label));
+
+        const qint64 chunk = 0x10000;
+
+        std::vector<double> timestamps;
+        std::vector<double> values;
+
+        for (qint64 idx = 0; idx < size; idx += chunk)
+        {
+            qint64 n = qMin(chunk, size - idx);
+
+            timestamps.resize(n);
+            values.resize(n);
+
+            for (qint64 ii = 0; ii < n; ii++)
+            {
+                double t = idx + ii;
+
+                timestamps[ii] = t;
+                values[ii] = sin(2 * M_PI * frequency * t / 1000) + 0.1 * ((idx + ii) % 7);
+            }
+
+            series->appendColumns(timestamps.data(), values.data(), n, false);
+        }
+
+        return series;
+    }
+};
+
+#endif // BENCHMARK_DATA_HPP
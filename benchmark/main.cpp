@@ -0,0 +1,81 @@
+#include <QApplication>
+#include <QDir>
+#include <qtest.h>
+
+#include "benchmark_data.hpp"
+#include "bench_series.hpp"
+#include "bench_curve.hpp"
+#include "bench_io.hpp"
+#include "bench_math.hpp"
+
+/*
+ * Lumberjack benchmark suite
+ *
+ * Usage: benchmark [--max-size <size>] [--output <dir>] [QTest options]
+ *
+ * --max-size   Largest data set (default 1M), e.g. "100M" runs every size from 1K to 100M
+ * --output     Directory for results; each benchmark class writes <class>.csv (QTest CSV format)
+ *
+ * Any other arguments are passed to QTest (e.g. -iterations, -callgrind, or a test function name).
+ */
+int main(int argc, char *argv[])
+{
+    QApplication app(argc, argv);
+
+    QStringList args = app.arguments();
+    QStringList qtestArgs;
+
+    QString outputDir = "benchmark_results";
+
+    qtestArgs << args.value(0);
+
+    for (int ii = 1; ii < args.count(); ii++)
+    {
+        if (args.at(ii) == "--max-size" && ii + 1 < args.count())
+        {
+            BenchmarkData::maxSize() = BenchmarkData::parseSize(args.at(++ii));
+        }
+        else if (args.at(ii) == "--output" && ii + 1 < args.count())
+        {
+            outputDir = args.at(++ii);
+        }
+        else
+        {
+            qtestArgs << args.at(ii);
+        }
+    }
+
+    QDir().mkpath(outputDir);
+
+    qDebug() << "Running benchmarks up to" << BenchmarkData::sizeLabel(BenchmarkData::maxSize()) << "samples";
+    qDebug() << "Writing results to" << QDir(outputDir).absolutePath();
+
+    int result = 0;
+
+    auto run = [&](QObject *benchmark, QString name)
+    {
+        QStringList runArgs = qtestArgs;
+
+        // Machine-readable results, as well as the usual console output
+        runArgs << "-o" << QDir(outputDir).filePath(name + ".csv") + ",csv";
+        runArgs << "-o" << "-,txt";
+
+        result += QTest::qExec(benchmark, runArgs);
+    };
+
+    DataSeriesBenchmarks bench_series;
+    run(&bench_series, "data_series");
+
+    PlotCurveBenchmarks bench_curve;
+    run(&bench_curve, "plot_curve");
+
+    DataIOBenchmarks bench_io;
+    run(&bench_io, "data_io");
+
+    MathTraceBenchmarks bench_math;
+    run(&bench_math, "math_trace");
+
+    qDebug() << "All benchmarks complete" << result;
+
+    return result;
+}
@@ -1,4 +1,4 @@
-QT       += core gui opengl svg
+QT       += core gui opengl svg network
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -36,12 +36,23 @@ INCLUDEPATH += src \
     plugins/cobsr
 
 SOURCES += \
+    src/data_file_follower.cpp \
+    src/data_import_scheduler.cpp \
+    src/data_io_job.cpp \
     src/data_source_manager.cpp \
     src/fft_sampler.cpp \
+    src/filter_pipeline.cpp \
+    src/filtered_data_series.cpp \
     src/fft_widget.cpp \
     src/helpers.cpp \
+    src/compressed_data_series.cpp \
     src/data_series.cpp \
+    src/data_storage.cpp \
+    src/data_series_factory.cpp \
     src/data_source.cpp \
+    src/float32_data_series.cpp \
+    src/data_stream_session.cpp \
+    src/lumberjack_batch.cpp \
     src/lumberjack_debug.cpp \
     src/lumberjack_settings.cpp \
     src/lumberjack_version.cpp \
@@ -54,17 +65,25 @@ SOURCES += \
     src/plot_marker.cpp \
     src/plot_widget.cpp \
     src/main.cpp \
+    src/page_store.cpp \
+    src/paged_data_series.cpp \
+    src/performance_monitor.cpp \
     src/mainwindow.cpp \
     src/plugins/plugin_exporter.cpp \
     src/plugins/plugin_importer.cpp \
     src/plugins/plugin_registry.cpp \
+    src/plugins/plugin_stream.cpp \
+    src/ring_buffer_data_series.cpp \
+    src/series_registry.cpp \
     src/widgets/about_dialog.cpp \
     src/widgets/axis_edit_dialog.cpp \
     src/widgets/datatable_widget.cpp \
     src/widgets/dataview_tree.cpp \
     src/widgets/dataview_widget.cpp \
+    src/widgets/filter_options_dialog.cpp \
     src/widgets/debug_widget.cpp \
     src/widgets/math_trace_dialog.cpp \
+    src/widgets/performance_widget.cpp \
     src/widgets/plot_sampler.cpp \
     src/widgets/plugins_dialog.cpp \
     src/widgets/series_editor_dialog.cpp \
@@ -72,13 +91,27 @@ SOURCES += \
     src/widgets/timeline_widget.cpp
 
 HEADERS += \
+    src/data_batch.hpp \
+    src/data_file_follower.hpp \
+    src/data_import_scheduler.hpp \
+    src/data_io_job.hpp \
     src/data_source_manager.hpp \
     src/mainwindow.h \
     src/fft_sampler.hpp \
+    src/filter_pipeline.hpp \
+    src/filtered_data_series.hpp \
     src/fft_widget.hpp \
     src/helpers.hpp \
+    src/import_diagnostics.hpp \
+    src/compressed_data_series.hpp \
+    src/data_point.hpp \
     src/data_series.hpp \
+    src/data_storage.hpp \
+    src/data_series_factory.hpp \
     src/data_source.hpp \
+    src/float32_data_series.hpp \
+    src/data_stream_session.hpp \
+    src/lumberjack_batch.hpp \
     src/lumberjack_debug.hpp \
     src/lumberjack_settings.hpp \
     src/lumberjack_version.hpp \
@@ -86,6 +119,9 @@ HEADERS += \
     src/math_data_source.hpp \
     src/math_expression_parser.hpp \
     src/math_trace_computer.hpp \
+    src/page_store.hpp \
+    src/paged_data_series.hpp \
+    src/performance_monitor.hpp \
     src/plot_curve.hpp \
     src/plot_legend.hpp \
     src/plot_marker.hpp \
@@ -96,13 +132,18 @@ HEADERS += \
     src/plugins/plugin_filter.hpp \
     src/plugins/plugin_importer.hpp \
     src/plugins/plugin_registry.hpp \
+    src/plugins/plugin_stream.hpp \
+    src/ring_buffer_data_series.hpp \
+    src/series_registry.hpp \
     src/widgets/about_dialog.hpp \
     src/widgets/axis_edit_dialog.hpp \
     src/widgets/datatable_widget.hpp \
     src/widgets/dataview_tree.hpp \
     src/widgets/dataview_widget.hpp \
+    src/widgets/filter_options_dialog.hpp \
     src/widgets/debug_widget.hpp \
     src/widgets/math_trace_dialog.hpp \
+    src/widgets/performance_widget.hpp \
     src/widgets/plot_sampler.hpp \
     src/widgets/plugins_dialog.hpp \
     src/widgets/series_editor_dialog.hpp \
@@ -16,13 +16,18 @@ HEADERS += \
     csv_exporter_global.h \
     lumberjack_csv_export_plugin.hpp \
     lumberjack_csv_exporter.hpp \
+    ../../src/data_point.hpp \
     ../../src/data_series.hpp \
+    ../../src/data_storage.hpp \
+    ../../src/performance_monitor.hpp \
     ../../src/plugins/plugin_base.hpp \
     ../../src/plugins/plugin_exporter.hpp \
 
 SOURCES += \
     lumberjack_csv_exporter.cpp \
     ../../src/data_series.cpp \
+    ../../src/data_storage.cpp \
+    ../../src/performance_monitor.cpp \
     ../../src/plugins/plugin_exporter.cpp
 
 # Default rules for deployment.
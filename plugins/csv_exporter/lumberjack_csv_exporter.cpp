@@ -9,6 +9,21 @@ LumberjackCSVExporter::LumberjackCSVExporter()
 }
 
 
+/*
+ * Create a new exporter with the same export options
+ */
+ExportPlugin *LumberjackCSVExporter::createInstance() const
+{
+    LumberjackCSVExporter *exporter = new LumberjackCSVExporter();
+
+    exporter->m_delimiter = m_delimiter;
+    exporter->m_zeroTimestamp = m_zeroTimestamp;
+    exporter->m_unitsRow = m_unitsRow;
+
+    return exporter;
+}
+
+
 QStringList LumberjackCSVExporter::supportedFileTypes() const
 {
     QStringList fileTypes;
@@ -49,6 +64,7 @@ bool LumberjackCSVExporter::exportData(QList<DataSeriesPointer> &series, QString
     // Copy across data series
     m_data.clear();
     m_indices.clear();
+    m_readers.clear();
 
     for (auto s : series)
     {
@@ -56,6 +72,7 @@ bool LumberjackCSVExporter::exportData(QList<DataSeriesPointer> &series, QString
         {
             m_data.append(s);
             m_indices.append(0);
+            m_readers.emplace_back(*s);
         }
     }
 
@@ -188,7 +205,7 @@ QStringList LumberjackCSVExporter::nextDataRow(bool &valid)
         {
             dataAvailable = true;
 
-            auto point = series->getDataPoint(idx);
+            auto point = m_readers[ii].at(idx);
 
             if (point.timestamp < nextTimestamp)
             {
@@ -219,7 +236,7 @@ QStringList LumberjackCSVExporter::nextDataRow(bool &valid)
 
         if (idx < series->size())
         {
-            auto point = series->getDataPoint(idx);
+            auto point = m_readers[ii].at(idx);
 
             // Timestamp is within allowable range
             if (point.timestamp <= (nextTimestamp + DT))
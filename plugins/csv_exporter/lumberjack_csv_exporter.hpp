@@ -17,6 +17,8 @@ public:
     virtual QString pluginVersion(void) const override { return m_version; }
 
     // Exporter plugin functionality
+    virtual ExportPlugin *createInstance(void) const override;
+
     virtual QStringList supportedFileTypes(void) const override;
 
     virtual bool beforeExport(void) override;
@@ -32,6 +34,9 @@ protected:
     QList<DataSeriesPointer> m_data;
     QList<uint64_t> m_indices;
 
+    // Buffered readers for each exported series
+    std::vector<DataSeriesReader> m_readers;
+
     bool m_isExporting = false;
 
     double m_currentTimestamp = 0;
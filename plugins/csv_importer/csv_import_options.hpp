@@ -3,6 +3,8 @@
 
 #include <QString>
 
+#include "data_series.hpp"
+
 
 /**
  * @brief The CSVImportOptions class defines various import options for CSV files
@@ -43,6 +45,9 @@ struct CSVImportOptions
 
     QString ignoreRowsStartingWith;
 
+    //! Precision used to store the imported values (single precision requires less memory)
+    DataSeries::ValuePrecision valuePrecision = DataSeries::PRECISION_DOUBLE;
+
     QString getDelimiterString(void) const
     {
         switch (delimeter)
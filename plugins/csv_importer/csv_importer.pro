@@ -21,12 +21,17 @@ HEADERS += \
     lumberjack_csv_importer.hpp \
     import_options_dialog.hpp \
     csv_import_options.hpp \
+    ../../src/data_point.hpp \
     ../../src/data_series.hpp \
+    ../../src/data_storage.hpp \
+    ../../src/performance_monitor.hpp \
     ../../src/plugins/plugin_base.hpp \
     ../../src/plugins/plugin_importer.hpp \
 
 SOURCES += \
     ../../src/data_series.cpp \
+    ../../src/data_storage.cpp \
+    ../../src/performance_monitor.cpp \
     ../../src/plugins/plugin_importer.cpp \
     import_options_dialog.cpp \
     lumberjack_csv_importer.cpp
@@ -64,6 +64,11 @@ void CSVImportOptionsDialog::initImportOptions()
     ui.dataStartRow->setValue(m_options.rowDataStart);
 
     ui.ignoreStartWith->setText(m_options.ignoreRowsStartingWith);
+
+    ui.valuePrecision->addItem(tr("Double (64-bit)"));
+    ui.valuePrecision->addItem(tr("Single (32-bit)"));
+
+    ui.valuePrecision->setCurrentIndex((int) m_options.valuePrecision);
 }
 
 
@@ -87,6 +92,10 @@ void CSVImportOptionsDialog::saveImportOptions()
 
     options.ignoreRowsStartingWith = ui.ignoreStartWith->text().trimmed();
 
+    options.valuePrecision = (DataSeries::ValuePrecision) ui.valuePrecision->currentIndex();
+
+    m_options = options;
+
     accept();
 }
 
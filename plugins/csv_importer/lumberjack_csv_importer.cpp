@@ -1,5 +1,6 @@
 #include <QFile>
 #include <QFileInfo>
+#include <QElapsedTimer>
 
 #include <math.h>
 
@@ -15,6 +16,20 @@ LumberjackCSVImporter::LumberjackCSVImporter()
 }
 
 
+/**
+ * @brief LumberjackCSVImporter::createInstance - Create a new importer with the same import options
+ * @return
+ */
+ImportPlugin *LumberjackCSVImporter::createInstance() const
+{
+    LumberjackCSVImporter *importer = new LumberjackCSVImporter();
+
+    importer->m_options = m_options;
+
+    return importer;
+}
+
+
 QStringList LumberjackCSVImporter::supportedFileTypes() const
 {
     QStringList fileTypes;
@@ -33,6 +48,12 @@ QStringList LumberjackCSVImporter::supportedFileTypes() const
  */
 bool LumberjackCSVImporter::beforeImport(void)
 {
+    // Use the current (default) options when running headless
+    if (!isInteractive())
+    {
+        return true;
+    }
+
     CSVImportOptionsDialog dlg(m_filename);
 
     int result = dlg.exec();
@@ -57,9 +78,46 @@ bool LumberjackCSVImporter::importData(QStringList &errors)
     // Reset importer to initial conditions
     m_headers.clear();
     columnMap.clear();
+    columnSeries.clear();
+    columnBuffers.clear();
     incrementingTimestamp = 0;
     initialTimestampSeen = false;
 
+    m_fileOffset = 0;
+    m_lineCount = 0;
+    m_partialLine.clear();
+    m_partialSamples.clear();
+
+    return readRows(errors, false);
+}
+
+
+/**
+ * @brief LumberjackCSVImporter::followData - Import rows appended to the file since the last read
+ * @param errors
+ * @return false if the file can no longer be followed
+ */
+bool LumberjackCSVImporter::followData(QStringList &errors)
+{
+    return readRows(errors, true);
+}
+
+
+/**
+ * @brief LumberjackCSVImporter::readRows - Read and process rows, starting from the current file offset
+ *
+ * A trailing line which is not terminated by a newline may still be being written.
+ * When following, such a line is left in the file to be read next time.
+ * Otherwise it is processed (so that the last row of a static file is not lost),
+ * and ignored if it is read again (unchanged) when following.
+ * If the line was completed with different content, the samples from the partial line are replaced.
+ *
+ * @param errors
+ * @param follow - true if reading data appended to a previously imported file
+ * @return
+ */
+bool LumberjackCSVImporter::readRows(QStringList &errors, bool follow)
+{
     QFileInfo fi(m_filename);
 
     if (!fi.exists() || !fi.isFile())
@@ -68,33 +126,84 @@ bool LumberjackCSVImporter::importData(QStringList &errors)
         return false;
     }
 
-    m_bytesRead = 0;
-    m_fileSize = fi.size();
+    if (fi.size() < m_fileOffset)
+    {
+        errors.append(tr("File has been truncated"));
+        return false;
+    }
 
-    m_file = new QFile(m_filename);
+    QFile file(m_filename);
 
-    if (!m_file->open(QIODevice::ReadOnly) || !m_file->isOpen() || !m_file->isReadable())
+    if (!file.open(QIODevice::ReadOnly) || !file.isReadable())
     {
         errors.append(tr("Could not open file for reading"));
-        m_file->close();
         return false;
     }
 
+    m_bytesRead = 0;
+    m_fileSize = fi.size() - m_fileOffset;
+
     QString delimiter = m_options.getDelimiterString();
 
-    qint64 lineCount = 0;
     qint64 badLineCount = 0;
 
-    // Ensure we are at the start of the file
-    m_file->seek(0);
+    m_diagnostics.clear();
+
+    // Skip data which have already been processed
+    file.seek(m_fileOffset);
 
     QStringList row;
 
     m_isImporting = true;
 
-    while (!m_file->atEnd() && m_isImporting && m_file != nullptr)
+    // Buffered samples are periodically appended, so that the data can be viewed during import
+    QElapsedTimer publishTimer;
+
+    publishTimer.start();
+
+    while (!file.atEnd() && m_isImporting)
     {
-        QByteArray bytes = m_file->readLine();
+        if (publishTimer.elapsed() >= PUBLISH_INTERVAL)
+        {
+            flushColumnBuffers();
+            publishTimer.restart();
+        }
+
+        QByteArray bytes = file.readLine();
+
+        m_bytesRead += bytes.length();
+
+        bool partial = !bytes.endsWith('\n');
+
+        if (partial)
+        {
+            // Wait for the rest of the line to be written
+            if (follow) break;
+
+            m_partialLine = bytes;
+            m_partialSamples.clear();
+        }
+        else
+        {
+            m_fileOffset += bytes.length();
+
+            if (!m_partialLine.isEmpty())
+            {
+                bool seen = bytes.trimmed() == m_partialLine.trimmed();
+
+                m_partialLine.clear();
+
+                // Line was already processed at the end of the previous read
+                if (seen)
+                {
+                    m_partialSamples.clear();
+                    m_lineCount++;
+                    continue;
+                }
+
+                removePartialSamples();
+            }
+        }
 
         QString line(bytes);
 
@@ -107,18 +216,24 @@ bool LumberjackCSVImporter::importData(QStringList &errors)
 
         row = line.split(delimiter);
 
-        if (!processRow(lineCount, row, errors))
+        m_recordSamples = partial;
+
+        if (!processRow(m_lineCount, row, errors))
         {
             badLineCount++;
         }
 
-        m_bytesRead += line.length();
+        m_recordSamples = false;
 
-        lineCount++;
+        if (!partial)
+        {
+            m_lineCount++;
+        }
     }
 
-    // Ensure file object is closed
-    m_file->close();
+    file.close();
+
+    flushColumnBuffers();
 
     m_isImporting = false;
 
@@ -127,10 +242,73 @@ bool LumberjackCSVImporter::importData(QStringList &errors)
         errors.append(QString("Lines with errors: " + QString::number(badLineCount)));
     }
 
+    // Issues are summarized (once) rather than logged for each line
+    m_diagnostics.report(errors, m_headers);
+
     return true;
 }
 
 
+/**
+ * @brief LumberjackCSVImporter::flushColumnBuffers - Append all buffered samples to the associated series
+ */
+void LumberjackCSVImporter::flushColumnBuffers(void)
+{
+    for (int ii = 0; ii < columnSeries.size() && ii < (int) columnBuffers.size(); ii++)
+    {
+        auto &buffer = columnBuffers[ii];
+
+        if (!columnSeries[ii].isNull() && !buffer.empty())
+        {
+            columnSeries[ii]->appendData(buffer, false);
+        }
+
+        buffer.clear();
+    }
+}
+
+
+/**
+ * @brief LumberjackCSVImporter::removePartialSamples - Remove the samples which were imported from a partial line
+ *
+ * The partial line was the last line processed, so each sample is the last sample with its timestamp
+ * (and is normally the newest sample in the series, which is removed by truncating the series).
+ * Any samples which follow it (if the file is not sorted by timestamp) are re-appended.
+ */
+void LumberjackCSVImporter::removePartialSamples(void)
+{
+    flushColumnBuffers();
+
+    for (const auto &sample : m_partialSamples)
+    {
+        if (sample.first >= columnSeries.size() || columnSeries[sample.first].isNull()) continue;
+
+        auto series = columnSeries[sample.first];
+
+        const double timestamp = sample.second.timestamp;
+
+        // Index of the first sample after the partial sample
+        uint64_t idx = series->getIndexForTimestamp(timestamp, DataSeries::SEARCH_LEFT_TO_RIGHT);
+        uint64_t count = series->size();
+
+        if (idx == 0 || idx > count || series->getTimestamp(idx - 1) != timestamp) continue;
+
+        if (idx == count)
+        {
+            series->truncateData(idx - 1, false);
+            continue;
+        }
+
+        std::vector<DataPoint> data = series->getData();
+
+        series->truncateData(idx - 1, false);
+        series->appendData(std::vector<DataPoint>(data.begin() + idx, data.end()), false);
+    }
+
+    m_partialSamples.clear();
+}
+
+
 /**
  * @brief LumberjackCSVImporter::processRow - Process a single row of data from the file
  * @param rowIndex - The row index with in the file
@@ -172,9 +350,7 @@ bool LumberjackCSVImporter::processRow(int rowIndex, const QStringList &row, QSt
  */
 bool LumberjackCSVImporter::extractHeaders(int rowIndex, const QStringList &row, QStringList &errors)
 {
-    Q_UNUSED(rowIndex);
-
-    // TODO: Error messages
+    // Issues are recorded in m_diagnostics
     Q_UNUSED(errors);
 
     m_headers.clear();
@@ -185,7 +361,7 @@ bool LumberjackCSVImporter::extractHeaders(int rowIndex, const QStringList &row,
 
         if (header.isEmpty())
         {
-            qWarning() << "Empty header in column" << ii;
+            m_diagnostics.add("Empty header", ii, rowIndex);
 
             // Default column headers
             header = "Column " + QString::number(ii);
@@ -202,13 +378,30 @@ bool LumberjackCSVImporter::extractHeaders(int rowIndex, const QStringList &row,
         // Check that we don't have a duplicate header already
         if (!columnMap.contains(header))
         {
-            columnMap.insert(
-                header,
-                QSharedPointer<DataSeries>(new DataSeries(header))
-            );
+            DataSeriesPointer series = createDataSeries(header);
+
+            columnMap.insert(header, series);
+
+            publishSeries(series);
         }
     }
 
+    // Lookup table of series by column index
+    flushColumnBuffers();
+
+    columnSeries.clear();
+    columnSeries.resize(m_headers.length());
+
+    columnBuffers.clear();
+    columnBuffers.resize(m_headers.length());
+
+    for (int ii = 0; ii < m_headers.length(); ii++)
+    {
+        if (m_options.hasTimestamp && ii == m_options.colTimestamp) continue;
+
+        columnSeries[ii] = columnMap.value(m_headers.at(ii));
+    }
+
     return true;
 }
 
@@ -223,7 +416,7 @@ bool LumberjackCSVImporter::extractHeaders(int rowIndex, const QStringList &row,
  */
 bool LumberjackCSVImporter::extractData(int rowIndex, const QStringList &row, QStringList &errors)
 {
-    // TODO: Error messages
+    // Issues are recorded in m_diagnostics
     Q_UNUSED(errors)
 
     double timestamp = 0;
@@ -238,7 +431,6 @@ bool LumberjackCSVImporter::extractData(int rowIndex, const QStringList &row, QS
     }
     else if (!extractTimestamp(rowIndex, row, timestamp))
     {
-        qWarning() << "CSV:" << "Line" << rowIndex << "does not contain valid timestamp";
         return false;
     }
 
@@ -263,10 +455,11 @@ bool LumberjackCSVImporter::extractData(int rowIndex, const QStringList &row, QS
 
         QString text = row.at(ii).trimmed();
 
+        // Any remaining cells are ignored
         if (ii >= m_headers.length())
         {
-            qWarning() << "CSV: Line" << rowIndex << "exceeded header count";
-            continue;
+            m_diagnostics.add("Line exceeded header count", -1, rowIndex);
+            break;
         }
 
         // Ignore empty cell values
@@ -298,27 +491,25 @@ bool LumberjackCSVImporter::extractData(int rowIndex, const QStringList &row, QS
         // Ignore invalid or infinite values
         if (isnan(value) || isinf(value)) continue;
 
-        QString header = m_headers.at(ii);
-        QString backupHeader = "Column " + QString::number(ii);
-
-        QSharedPointer<DataSeries> series;
-
-        if (columnMap.contains(header))
+        if (ii >= columnSeries.size() || columnSeries[ii].isNull())
         {
-            series = columnMap.value(header);
-        }
-        else if (columnMap.contains(backupHeader))
-        {
-            series = columnMap.value(backupHeader);
+            m_diagnostics.add("No series matching column", ii, rowIndex);
+            continue;
         }
 
-        if (series.isNull())
+        auto &buffer = columnBuffers[ii];
+
+        buffer.push_back(DataPoint(timestamp, value));
+
+        if (m_recordSamples)
         {
-            qWarning() << "CSV: No series matching label" << header;
+            m_partialSamples.push_back(std::make_pair(ii, buffer.back()));
         }
-        else
+
+        if (buffer.size() >= COLUMN_BUFFER_SIZE)
         {
-            series->addData(timestamp, value, false);
+            columnSeries[ii]->appendData(buffer, false);
+            buffer.clear();
         }
     }
 
@@ -337,7 +528,7 @@ bool LumberjackCSVImporter::extractTimestamp(int rowIndex, const QStringList &ro
 {
     if (row.length() <= m_options.colTimestamp)
     {
-        qWarning() << "Line" << rowIndex << "missing timestamp column";
+        m_diagnostics.add("Missing timestamp column", -1, rowIndex);
         return false;
     }
 
@@ -405,6 +596,7 @@ bool LumberjackCSVImporter::extractTimestamp(int rowIndex, const QStringList &ro
             return true;
         }
 
+        m_diagnostics.add("Invalid timestamp", m_options.colTimestamp, rowIndex);
         return false;
 
     }
@@ -415,23 +607,12 @@ bool LumberjackCSVImporter::extractTimestamp(int rowIndex, const QStringList &ro
     {
         timestamp *= timestampScaler;
     }
-
-    return result;
-}
-
-
-void LumberjackCSVImporter::afterImport(void)
-{
-    if (m_file)
+    else
     {
-        if (m_file->isOpen())
-        {
-            m_file->close();
-        }
-
-        delete m_file;
-        m_file = nullptr;
+        m_diagnostics.add("Invalid timestamp", m_options.colTimestamp, rowIndex);
     }
+
+    return result;
 }
 
 
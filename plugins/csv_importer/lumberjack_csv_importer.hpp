@@ -19,17 +19,23 @@ public:
     virtual QString pluginVersion(void) const override { return m_version; }
 
     // Importer plugin functionality
+    virtual ImportPlugin *createInstance(void) const override;
+
     virtual QStringList supportedFileTypes(void) const override;
 
     virtual bool beforeImport(void) override;
     virtual bool importData(QStringList &errors) override;
-    virtual void afterImport(void) override;
     virtual void cancelImport(void) override;
 
     virtual uint8_t getImportProgress(void) const override;
 
     virtual QList<QSharedPointer<DataSeries>> getDataSeries(void) const override;
 
+    virtual bool supportsFollow(void) const override { return true; }
+    virtual bool followData(QStringList &errors) override;
+
+    virtual DataSeries::ValuePrecision getValuePrecision(void) const override { return m_options.valuePrecision; }
+
 protected:
     //! Plugin metadata
     const QString m_name = "CSV Importer";
@@ -42,6 +48,9 @@ protected:
     QStringList m_headers;
 
     //! Internal functions for processing data
+    bool readRows(QStringList &errors, bool follow);
+    void flushColumnBuffers(void);
+    void removePartialSamples(void);
     bool processRow(int rowIndex, const QStringList &row, QStringList &errors);
     bool extractHeaders(int rowIndex, const QStringList &row, QStringList &errors);
     bool extractData(int rowIndex, const QStringList &row, QStringList &errors);
@@ -50,6 +59,15 @@ protected:
     // Keep track of data columns while loading
     QHash<QString, QSharedPointer<DataSeries>> columnMap;
 
+    // Series associated with each column index (null for the timestamp column)
+    QVector<QSharedPointer<DataSeries>> columnSeries;
+
+    // Samples waiting to be appended to each column series
+    std::vector<std::vector<DataPoint>> columnBuffers;
+
+    // Number of samples buffered per column before appending to the series
+    static const size_t COLUMN_BUFFER_SIZE = 0x10000;
+
     // Keep track of first timestamp value
     double initialTimetamp = 0;
     bool initialTimestampSeen = false;
@@ -57,16 +75,28 @@ protected:
     // Internal timestamp which is used if not available in imported file
     double incrementingTimestamp = 0;
 
-    //! File object being imported
-    QFile *m_file = nullptr;
-
     bool m_isImporting = false;
 
-    //! Number of bytes processed from the file
-    int64_t m_bytesRead;
+    //! Number of bytes processed from the file (during the current read)
+    int64_t m_bytesRead = 0;
+
+    //! Total number of bytes to be read from the file
+    int64_t m_fileSize = 0;
+
+    //! Offset of the first byte which has not yet been consumed
+    int64_t m_fileOffset = 0;
+
+    //! Number of (complete) rows processed so far
+    int64_t m_lineCount = 0;
+
+    //! Trailing line (without a newline) which was processed at the end of the file
+    QByteArray m_partialLine;
+
+    //! Samples (column index, sample) imported from the partial line
+    std::vector<std::pair<int, DataPoint>> m_partialSamples;
 
-    //! Total number of bytes in the file
-    int64_t m_fileSize;
+    //! Set while processing a partial line, so that its samples are recorded
+    bool m_recordSamples = false;
 
 };
 
@@ -1,7 +1,50 @@
 #include "offset_filter.hpp"
 
 
-OffsetFilter::OffsetFilter()
+OffsetFilter::OffsetFilter(double offset) : m_offset(offset)
 {
-    // TODO
+}
+
+
+size_t OffsetFilter::process(const FilterInput &input, FilterOutput &output)
+{
+    const size_t n = input.size();
+
+    const double *in = input.values.data;
+    double *out = output.values.data;
+
+    const double offset = m_offset;
+
+    for (size_t ii = 0; ii < n; ii++)
+    {
+        out[ii] = in[ii] + offset;
+    }
+
+    passTimestamps(input, output);
+
+    return n;
+}
+
+
+QVariantMap OffsetFilter::getOptions() const
+{
+    QVariantMap options;
+
+    options["offset"] = m_offset;
+
+    return options;
+}
+
+
+bool OffsetFilter::setOptions(const QVariantMap &options)
+{
+    bool ok = true;
+
+    double offset = options.value("offset", m_offset).toDouble(&ok);
+
+    if (!ok) return false;
+
+    m_offset = offset;
+
+    return true;
 }
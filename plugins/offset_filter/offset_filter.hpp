@@ -5,24 +5,38 @@
 
 
 /**
- * @brief The ScaleOffsetFilter class provides simple scaling and offset functionality
+ * @brief The OffsetFilter class adds a constant offset to each sample value
  */
 class OffsetFilter : public FilterPlugin
 {
     Q_OBJECT
 public:
-    OffsetFilter();
+    OffsetFilter(double offset = 0);
 
     // Base plugin functionality
     virtual QString pluginName(void) const override { return m_name; }
     virtual QString pluginDescription(void) const override { return m_description; }
     virtual QString pluginVersion(void) const override { return m_version; }
 
+    // Filter functionality
+    virtual FilterPlugin *createInstance(void) const override { return new OffsetFilter(m_offset); }
+
+    virtual bool isStateless(void) const override { return true; }
+
+    virtual size_t process(const FilterInput &input, FilterOutput &output) override;
+
+    virtual QVariantMap getOptions(void) const override;
+    virtual bool setOptions(const QVariantMap &options) override;
+
+    double getOffset(void) const { return m_offset; }
+    void setOffset(double offset) { m_offset = offset; }
+
 protected:
     const QString m_name = "Offset Filter";
     const QString m_description = "Apply custom offset to a dataset";
-    const QString m_version = "0.1.0";
+    const QString m_version = "0.2.0";
 
+    double m_offset = 0;
 };
 
 #endif // LUMBERJACK_OFFSET_FILTER_HPP
@@ -1,5 +1,6 @@
 # Importer plugins
 include("csv_importer/csv_importer.pri")
+include("synthetic_importer/synthetic_importer.pri")
 
 # Exporter plugins
 include("csv_exporter/csv_exporter.pri")
@@ -7,3 +8,7 @@ include("csv_exporter/csv_exporter.pri")
 # Filter plugins
 include("offset_filter/offset_filter.pri")
 include("scaler_filter/scaler_filter.pri")
+include("signal_filters/signal_filters.pri")
+
+# Stream plugins
+include("stream_reader/stream_reader.pri")
@@ -7,4 +7,5 @@ SUBDIRS += \
     csv_exporter \
     offset_filter \
     scaler_filter \
+    stream_reader \
 
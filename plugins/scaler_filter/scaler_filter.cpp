@@ -1,8 +1,50 @@
 #include "scaler_filter.hpp"
 
 
+ScalerFilter::ScalerFilter(double scaler) : m_scaler(scaler)
+{
+}
+
+
+size_t ScalerFilter::process(const FilterInput &input, FilterOutput &output)
+{
+    const size_t n = input.size();
+
+    const double *in = input.values.data;
+    double *out = output.values.data;
+
+    const double scaler = m_scaler;
+
+    for (size_t ii = 0; ii < n; ii++)
+    {
+        out[ii] = in[ii] * scaler;
+    }
+
+    passTimestamps(input, output);
+
+    return n;
+}
 
-ScalerFilter::ScalerFilter()
+
+QVariantMap ScalerFilter::getOptions() const
 {
-    // TODO
+    QVariantMap options;
+
+    options["scaler"] = m_scaler;
+
+    return options;
+}
+
+
+bool ScalerFilter::setOptions(const QVariantMap &options)
+{
+    bool ok = true;
+
+    double scaler = options.value("scaler", m_scaler).toDouble(&ok);
+
+    if (!ok) return false;
+
+    m_scaler = scaler;
+
+    return true;
 }
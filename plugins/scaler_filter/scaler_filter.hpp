@@ -5,24 +5,38 @@
 
 
 /**
- * @brief The ScaleOffsetFilter class provides simple scaling and offset functionality
+ * @brief The ScalerFilter class multiplies each sample value by a constant scaler
  */
 class ScalerFilter : public FilterPlugin
 {
     Q_OBJECT
 public:
-    ScalerFilter();
+    ScalerFilter(double scaler = 1);
 
     // Base plugin functionality
     virtual QString pluginName(void) const override { return m_name; }
     virtual QString pluginDescription(void) const override { return m_description; }
     virtual QString pluginVersion(void) const override { return m_version; }
 
+    // Filter functionality
+    virtual FilterPlugin *createInstance(void) const override { return new ScalerFilter(m_scaler); }
+
+    virtual bool isStateless(void) const override { return true; }
+
+    virtual size_t process(const FilterInput &input, FilterOutput &output) override;
+
+    virtual QVariantMap getOptions(void) const override;
+    virtual bool setOptions(const QVariantMap &options) override;
+
+    double getScaler(void) const { return m_scaler; }
+    void setScaler(double scaler) { m_scaler = scaler; }
+
 protected:
     const QString m_name = "Scaler Filter";
     const QString m_description = "Apply custom scaler to a dataset";
-    const QString m_version = "0.1.0";
+    const QString m_version = "0.2.0";
 
+    double m_scaler = 1;
 };
 
 #endif // LUMBERJACK_SCALER_FILTER_HPP
@@ -0,0 +1,134 @@
+#include <math.h>
+
+#include "biquad_cascade.hpp"
+
+
+/**
+ * @brief BiquadCascade::designButterworth - Design a Butterworth low-pass or high-pass filter
+ * @param order - Filter order (number of poles)
+ * @param cutoff - Cutoff (-3dB) frequency, normalized to the sample rate
+ * @param highPass - Design a high-pass filter (otherwise low-pass)
+ * @return true if the filter could be designed
+ *
+ * Each pair of poles forms a second-order section (bilinear transform, with pre-warping),
+ * and an odd order adds a single first-order section.
+ */
+bool BiquadCascade::designButterworth(int order, double cutoff, bool highPass)
+{
+    clear();
+
+    if (order < 1 || !(cutoff > 0) || !(cutoff < 0.5)) return false;
+
+    const double w0 = 2 * M_PI * cutoff;
+    const double cw = cos(w0);
+    const double sw = sin(w0);
+
+    for (int k = 1; k <= order / 2; k++)
+    {
+        const double Q = 1.0 / (2 * sin((2 * k - 1) * M_PI / (2 * order)));
+        const double alpha = sw / (2 * Q);
+        const double a0 = 1 + alpha;
+
+        Section section;
+
+        if (highPass)
+        {
+            section.b0 = (1 + cw) / 2 / a0;
+            section.b1 = -(1 + cw) / a0;
+        }
+        else
+        {
+            section.b0 = (1 - cw) / 2 / a0;
+            section.b1 = (1 - cw) / a0;
+        }
+
+        section.b2 = section.b0;
+        section.a1 = -2 * cw / a0;
+        section.a2 = (1 - alpha) / a0;
+
+        sections.push_back(section);
+    }
+
+    if (order % 2 == 1)
+    {
+        const double K = tan(w0 / 2);
+
+        Section section;
+
+        section.b0 = highPass ? 1 / (1 + K) : K / (1 + K);
+        section.b1 = highPass ? -section.b0 : section.b0;
+        section.a1 = (K - 1) / (K + 1);
+
+        sections.push_back(section);
+    }
+
+    return true;
+}
+
+
+void BiquadCascade::reset()
+{
+    for (auto &section : sections)
+    {
+        section.s1 = 0;
+        section.s2 = 0;
+    }
+
+    primed = false;
+}
+
+
+void BiquadCascade::prime(double value)
+{
+    for (auto &section : sections)
+    {
+        // DC gain of this section
+        double gain = (section.b0 + section.b1 + section.b2) / (1 + section.a1 + section.a2);
+        double output = gain * value;
+
+        section.s2 = section.b2 * value - section.a2 * output;
+        section.s1 = section.b1 * value - section.a1 * output + section.s2;
+
+        value = output;
+    }
+
+    primed = true;
+}
+
+
+/*
+ * Each section is applied to the entire block in turn,
+ * so that the coefficients and state remain in registers for the inner loop.
+ */
+void BiquadCascade::process(double *values, size_t count)
+{
+    if (count == 0) return;
+
+    if (!primed)
+    {
+        prime(values[0]);
+    }
+
+    for (auto &section : sections)
+    {
+        const double b0 = section.b0, b1 = section.b1, b2 = section.b2;
+        const double a1 = section.a1, a2 = section.a2;
+
+        double s1 = section.s1;
+        double s2 = section.s2;
+
+        for (size_t ii = 0; ii < count; ii++)
+        {
+            const double x = values[ii];
+            const double y = b0 * x + s1;
+
+            s1 = b1 * x - a1 * y + s2;
+            s2 = b2 * x - a2 * y;
+
+            values[ii] = y;
+        }
+
+        section.s1 = s1;
+        section.s2 = s2;
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef LUMBERJACK_BIQUAD_CASCADE_HPP
+#define LUMBERJACK_BIQUAD_CASCADE_HPP
+
+#include <stddef.h>
+#include <vector>
+
+
+/**
+ * @brief The BiquadCascade class implements an IIR filter as a cascade of second-order sections
+ *
+ * Each section is evaluated in transposed direct form II,
+ * and the state of each section is carried between calls to process().
+ */
+class BiquadCascade
+{
+public:
+    // Design a Butterworth filter of the given order
+    // The cutoff frequency is normalized to the sample rate (0 < cutoff < 0.5)
+    bool designButterworth(int order, double cutoff, bool highPass);
+
+    void clear(void) { sections.clear(); primed = false; }
+
+    // Clear the state of each section
+    void reset(void);
+
+    bool isEmpty(void) const { return sections.empty(); }
+    int getSectionCount(void) const { return (int) sections.size(); }
+
+    // Filter the provided values in-place
+    void process(double *values, size_t count);
+
+protected:
+    struct Section
+    {
+        double b0 = 1, b1 = 0, b2 = 0;
+        double a1 = 0, a2 = 0;
+
+        // Filter state
+        double s1 = 0, s2 = 0;
+    };
+
+    // Set the state of each section to the steady-state response for a constant input,
+    // so that the output does not "ring" from zero at the start of the data
+    void prime(double value);
+
+    std::vector<Section> sections;
+
+    bool primed = false;
+};
+
+#endif // LUMBERJACK_BIQUAD_CASCADE_HPP
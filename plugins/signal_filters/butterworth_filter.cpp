@@ -0,0 +1,109 @@
+#include <QDebug>
+
+#include "butterworth_filter.hpp"
+
+
+const int ButterworthFilter::MAX_ORDER;
+
+
+ButterworthFilter::ButterworthFilter()
+{
+}
+
+
+FilterPlugin *ButterworthFilter::createInstance() const
+{
+    ButterworthFilter *filter = new ButterworthFilter();
+
+    filter->setOptions(getOptions());
+
+    return filter;
+}
+
+
+void ButterworthFilter::reset()
+{
+    // If the sample rate is estimated, it is re-estimated from the next block of samples
+    if (m_sampleRate > 0)
+    {
+        m_cascade.reset();
+    }
+    else
+    {
+        m_cascade.clear();
+        m_designed = false;
+    }
+}
+
+
+bool ButterworthFilter::design(double sampleRate)
+{
+    m_designed = true;
+
+    if (!(sampleRate > 0) || !m_cascade.designButterworth(m_order, m_cutoff / sampleRate, m_highPass))
+    {
+        qWarning() << m_name << "- cutoff frequency" << m_cutoff << "Hz is invalid for sample rate" << sampleRate << "Hz";
+        return false;
+    }
+
+    return true;
+}
+
+
+size_t ButterworthFilter::process(const FilterInput &input, FilterOutput &output)
+{
+    const size_t n = input.size();
+
+    if (!m_designed)
+    {
+        design(m_sampleRate > 0 ? m_sampleRate : estimateSampleRate(input));
+    }
+
+    if (output.values.data != input.values.data)
+    {
+        std::copy(input.values.begin(), input.values.end(), output.values.data);
+    }
+
+    // An invalid design passes the data through unchanged
+    m_cascade.process(output.values.data, n);
+
+    passTimestamps(input, output);
+
+    return n;
+}
+
+
+QVariantMap ButterworthFilter::getOptions() const
+{
+    QVariantMap options;
+
+    options["cutoff"] = m_cutoff;
+    options["order"] = m_order;
+    options["highPass"] = m_highPass;
+    options["sampleRate"] = m_sampleRate;
+
+    return options;
+}
+
+
+bool ButterworthFilter::setOptions(const QVariantMap &options)
+{
+    double cutoff = options.value("cutoff", m_cutoff).toDouble();
+    int order = options.value("order", m_order).toInt();
+    double sampleRate = options.value("sampleRate", m_sampleRate).toDouble();
+
+    if (!(cutoff > 0) || order < 1 || order > MAX_ORDER || sampleRate < 0) return false;
+
+    // The cutoff must be below the Nyquist frequency
+    if (sampleRate > 0 && cutoff >= sampleRate / 2) return false;
+
+    m_cutoff = cutoff;
+    m_order = order;
+    m_highPass = options.value("highPass", m_highPass).toBool();
+    m_sampleRate = sampleRate;
+
+    m_cascade.clear();
+    m_designed = false;
+
+    return true;
+}
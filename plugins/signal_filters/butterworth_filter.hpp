@@ -0,0 +1,54 @@
+#ifndef LUMBERJACK_BUTTERWORTH_FILTER_HPP
+#define LUMBERJACK_BUTTERWORTH_FILTER_HPP
+
+#include "plugin_filter.hpp"
+#include "biquad_cascade.hpp"
+
+
+/**
+ * @brief The ButterworthFilter class provides a Butterworth low-pass or high-pass filter
+ *
+ * The filter is implemented as a cascade of biquad sections.
+ * If the sample rate is not specified, it is estimated from the first block of samples.
+ */
+class ButterworthFilter : public FilterPlugin
+{
+    Q_OBJECT
+public:
+    ButterworthFilter();
+
+    // Base plugin functionality
+    virtual QString pluginName(void) const override { return m_name; }
+    virtual QString pluginDescription(void) const override { return m_description; }
+    virtual QString pluginVersion(void) const override { return m_version; }
+
+    // Filter functionality
+    virtual FilterPlugin *createInstance(void) const override;
+
+    virtual void reset(void) override;
+
+    virtual size_t process(const FilterInput &input, FilterOutput &output) override;
+
+    virtual QVariantMap getOptions(void) const override;
+    virtual bool setOptions(const QVariantMap &options) override;
+
+    static const int MAX_ORDER = 16;
+
+protected:
+    const QString m_name = "Butterworth Filter";
+    const QString m_description = "Butterworth low-pass or high-pass filter";
+    const QString m_version = "0.1.0";
+
+    // Filter options
+    double m_cutoff = 10;
+    int m_order = 4;
+    bool m_highPass = false;
+    double m_sampleRate = 0;
+
+    bool design(double sampleRate);
+
+    BiquadCascade m_cascade;
+    bool m_designed = false;
+};
+
+#endif // LUMBERJACK_BUTTERWORTH_FILTER_HPP
@@ -0,0 +1,87 @@
+#include "decimate_filter.hpp"
+
+
+const int DecimateFilter::ANTI_ALIAS_ORDER;
+const double DecimateFilter::ANTI_ALIAS_CUTOFF = 0.8;
+
+
+DecimateFilter::DecimateFilter(int factor) : m_factor(qMax(1, factor))
+{
+    design();
+}
+
+
+void DecimateFilter::design()
+{
+    m_cascade.clear();
+    m_phase = 0;
+
+    if (m_factor > 1)
+    {
+        m_cascade.designButterworth(ANTI_ALIAS_ORDER, ANTI_ALIAS_CUTOFF * 0.5 / m_factor, false);
+    }
+}
+
+
+void DecimateFilter::reset()
+{
+    m_cascade.reset();
+    m_phase = 0;
+}
+
+
+size_t DecimateFilter::process(const FilterInput &input, FilterOutput &output)
+{
+    const size_t n = input.size();
+
+    if (output.values.data != input.values.data)
+    {
+        std::copy(input.values.begin(), input.values.end(), output.values.data);
+    }
+
+    m_cascade.process(output.values.data, n);
+
+    // Retain every Nth sample (the output never overtakes the input, so this is safe in-place)
+    size_t produced = 0;
+
+    for (size_t ii = 0; ii < n; ii++)
+    {
+        if (m_phase == 0)
+        {
+            output.timestamps[produced] = input.timestamps[ii];
+            output.values[produced] = output.values[ii];
+            produced++;
+        }
+
+        if (++m_phase >= m_factor)
+        {
+            m_phase = 0;
+        }
+    }
+
+    return produced;
+}
+
+
+QVariantMap DecimateFilter::getOptions() const
+{
+    QVariantMap options;
+
+    options["factor"] = m_factor;
+
+    return options;
+}
+
+
+bool DecimateFilter::setOptions(const QVariantMap &options)
+{
+    int factor = options.value("factor", m_factor).toInt();
+
+    if (factor < 1) return false;
+
+    m_factor = factor;
+
+    design();
+
+    return true;
+}
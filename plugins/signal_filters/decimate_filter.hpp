@@ -0,0 +1,56 @@
+#ifndef LUMBERJACK_DECIMATE_FILTER_HPP
+#define LUMBERJACK_DECIMATE_FILTER_HPP
+
+#include "plugin_filter.hpp"
+#include "biquad_cascade.hpp"
+
+
+/**
+ * @brief The DecimateFilter class reduces the sample rate by an integer factor
+ *
+ * An anti-aliasing (Butterworth) low-pass filter is applied before every Nth sample is retained.
+ */
+class DecimateFilter : public FilterPlugin
+{
+    Q_OBJECT
+public:
+    DecimateFilter(int factor = 10);
+
+    // Base plugin functionality
+    virtual QString pluginName(void) const override { return m_name; }
+    virtual QString pluginDescription(void) const override { return m_description; }
+    virtual QString pluginVersion(void) const override { return m_version; }
+
+    // Filter functionality
+    virtual FilterPlugin *createInstance(void) const override { return new DecimateFilter(m_factor); }
+
+    virtual void reset(void) override;
+
+    virtual size_t process(const FilterInput &input, FilterOutput &output) override;
+
+    virtual QVariantMap getOptions(void) const override;
+    virtual bool setOptions(const QVariantMap &options) override;
+
+    //! Order of the anti-aliasing filter
+    static const int ANTI_ALIAS_ORDER = 8;
+
+    //! Cutoff of the anti-aliasing filter (relative to the decimated Nyquist frequency)
+    static const double ANTI_ALIAS_CUTOFF;
+
+protected:
+    const QString m_name = "Decimate Filter";
+    const QString m_description = "Anti-aliased decimation by an integer factor";
+    const QString m_version = "0.1.0";
+
+    // Filter options
+    int m_factor = 10;
+
+    void design(void);
+
+    BiquadCascade m_cascade;
+
+    //! Position (modulo factor) of the next input sample
+    int m_phase = 0;
+};
+
+#endif // LUMBERJACK_DECIMATE_FILTER_HPP
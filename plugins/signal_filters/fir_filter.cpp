@@ -0,0 +1,194 @@
+#include <QDebug>
+
+#include <math.h>
+
+#include "fir_filter.hpp"
+
+
+const int FIRFilter::MAX_TAPS;
+
+
+FIRFilter::FIRFilter()
+{
+}
+
+
+FilterPlugin *FIRFilter::createInstance() const
+{
+    FIRFilter *filter = new FIRFilter();
+
+    filter->setOptions(getOptions());
+
+    if (m_custom)
+    {
+        filter->setCoefficients(m_coefficients);
+    }
+
+    return filter;
+}
+
+
+void FIRFilter::reset()
+{
+    m_primed = false;
+
+    if (!m_custom && !(m_sampleRate > 0))
+    {
+        // Coefficients are re-designed for the estimated sample rate of the next block
+        m_coefficients.clear();
+        m_reversed.clear();
+    }
+}
+
+
+void FIRFilter::setCoefficients(const std::vector<double> &coefficients)
+{
+    m_coefficients = coefficients;
+    m_reversed.assign(coefficients.rbegin(), coefficients.rend());
+
+    m_custom = !coefficients.empty();
+    m_primed = false;
+}
+
+
+/*
+ * Design a Hamming-windowed sinc low-pass filter, with unity gain at DC
+ */
+bool FIRFilter::design(double sampleRate)
+{
+    if (!(sampleRate > 0) || !(m_cutoff < sampleRate / 2))
+    {
+        qWarning() << m_name << "- cutoff frequency" << m_cutoff << "Hz is invalid for sample rate" << sampleRate << "Hz";
+
+        // Pass through
+        m_coefficients.assign(1, 1.0);
+        m_reversed = m_coefficients;
+
+        return false;
+    }
+
+    const double fc = m_cutoff / sampleRate;
+    const int M = m_taps - 1;
+
+    std::vector<double> coefficients(m_taps);
+
+    double sum = 0;
+
+    for (int ii = 0; ii < m_taps; ii++)
+    {
+        double x = ii - M / 2.0;
+        double h = (x == 0) ? 2 * fc : sin(2 * M_PI * fc * x) / (M_PI * x);
+
+        if (M > 0)
+        {
+            h *= 0.54 - 0.46 * cos(2 * M_PI * ii / M);
+        }
+
+        coefficients[ii] = h;
+        sum += h;
+    }
+
+    for (auto &c : coefficients)
+    {
+        c /= sum;
+    }
+
+    m_coefficients = coefficients;
+    m_reversed.assign(coefficients.rbegin(), coefficients.rend());
+
+    return true;
+}
+
+
+/*
+ * The convolution loops over coefficients in the outer loop, and samples in the inner loop,
+ * so that each output sample is an independent accumulator (which the compiler can vectorize).
+ */
+size_t FIRFilter::process(const FilterInput &input, FilterOutput &output)
+{
+    const size_t n = input.size();
+
+    if (n == 0) return 0;
+
+    if (m_reversed.empty())
+    {
+        design(m_sampleRate > 0 ? m_sampleRate : estimateSampleRate(input));
+    }
+
+    const size_t taps = m_reversed.size();
+    const size_t history = taps - 1;
+
+    // Initial history is the first sample, so the output does not ramp up from zero
+    if (!m_primed)
+    {
+        m_buffer.assign(history, input.values[0]);
+        m_primed = true;
+    }
+
+    m_buffer.resize(history + n);
+
+    std::copy(input.values.begin(), input.values.end(), m_buffer.begin() + history);
+
+    double *out = output.values.data;
+
+    std::fill(out, out + n, 0.0);
+
+    for (size_t jj = 0; jj < taps; jj++)
+    {
+        const double c = m_reversed[jj];
+        const double *in = m_buffer.data() + jj;
+
+        for (size_t ii = 0; ii < n; ii++)
+        {
+            out[ii] += c * in[ii];
+        }
+    }
+
+    // Retain the most recent samples for the next block
+    std::copy(m_buffer.end() - history, m_buffer.end(), m_buffer.begin());
+    m_buffer.resize(history);
+
+    passTimestamps(input, output);
+
+    return n;
+}
+
+
+QVariantMap FIRFilter::getOptions() const
+{
+    QVariantMap options;
+
+    options["taps"] = m_taps;
+    options["cutoff"] = m_cutoff;
+    options["sampleRate"] = m_sampleRate;
+
+    return options;
+}
+
+
+bool FIRFilter::setOptions(const QVariantMap &options)
+{
+    int taps = options.value("taps", m_taps).toInt();
+    double cutoff = options.value("cutoff", m_cutoff).toDouble();
+    double sampleRate = options.value("sampleRate", m_sampleRate).toDouble();
+
+    if (taps < 1 || taps > MAX_TAPS || !(cutoff > 0) || sampleRate < 0) return false;
+
+    if (sampleRate > 0 && cutoff >= sampleRate / 2) return false;
+
+    m_taps = taps;
+    m_cutoff = cutoff;
+    m_sampleRate = sampleRate;
+
+    m_custom = false;
+    m_coefficients.clear();
+    m_reversed.clear();
+    m_primed = false;
+
+    if (m_sampleRate > 0)
+    {
+        design(m_sampleRate);
+    }
+
+    return true;
+}
@@ -0,0 +1,66 @@
+#ifndef LUMBERJACK_FIR_FILTER_HPP
+#define LUMBERJACK_FIR_FILTER_HPP
+
+#include <vector>
+
+#include "plugin_filter.hpp"
+
+
+/**
+ * @brief The FIRFilter class provides a finite impulse response filter
+ *
+ * By default the coefficients are designed as a windowed-sinc (Hamming) low-pass filter,
+ * but custom coefficients can also be provided.
+ * The most recent (taps - 1) samples are retained between blocks.
+ */
+class FIRFilter : public FilterPlugin
+{
+    Q_OBJECT
+public:
+    FIRFilter();
+
+    // Base plugin functionality
+    virtual QString pluginName(void) const override { return m_name; }
+    virtual QString pluginDescription(void) const override { return m_description; }
+    virtual QString pluginVersion(void) const override { return m_version; }
+
+    // Filter functionality
+    virtual FilterPlugin *createInstance(void) const override;
+
+    virtual void reset(void) override;
+
+    virtual size_t process(const FilterInput &input, FilterOutput &output) override;
+
+    virtual QVariantMap getOptions(void) const override;
+    virtual bool setOptions(const QVariantMap &options) override;
+
+    // Use custom filter coefficients (instead of designing a low-pass filter)
+    void setCoefficients(const std::vector<double> &coefficients);
+    const std::vector<double> &getCoefficients(void) const { return m_coefficients; }
+
+    static const int MAX_TAPS = 4096;
+
+protected:
+    const QString m_name = "FIR Filter";
+    const QString m_description = "Windowed-sinc FIR low-pass filter";
+    const QString m_version = "0.1.0";
+
+    // Filter options
+    int m_taps = 31;
+    double m_cutoff = 10;
+    double m_sampleRate = 0;
+
+    bool design(double sampleRate);
+
+    std::vector<double> m_coefficients;
+    bool m_custom = false;
+
+    //! Coefficients in reverse order (so that convolution is a forward scan of the input)
+    std::vector<double> m_reversed;
+
+    //! Previous (taps - 1) samples, followed by the current block
+    std::vector<double> m_buffer;
+    bool m_primed = false;
+};
+
+#endif // LUMBERJACK_FIR_FILTER_HPP
@@ -0,0 +1,149 @@
+#include <iterator>
+#include <math.h>
+
+#include "median_filter.hpp"
+
+
+const int MedianFilter::MAX_WINDOW;
+
+
+MedianFilter::MedianFilter(int window) : m_window(qBound(1, window, MAX_WINDOW))
+{
+}
+
+
+void MedianFilter::reset()
+{
+    m_lower.clear();
+    m_upper.clear();
+    m_samples.clear();
+    m_head = 0;
+}
+
+
+void MedianFilter::insert(double value)
+{
+    if (m_lower.empty() || value <= *m_lower.rbegin())
+    {
+        m_lower.insert(value);
+    }
+    else
+    {
+        m_upper.insert(value);
+    }
+
+    rebalance();
+}
+
+
+void MedianFilter::remove(double value)
+{
+    // Every value in the upper half is at least as large as the largest value in the lower half
+    if (!m_lower.empty() && value <= *m_lower.rbegin())
+    {
+        m_lower.erase(m_lower.find(value));
+    }
+    else
+    {
+        m_upper.erase(m_upper.find(value));
+    }
+
+    rebalance();
+}
+
+
+void MedianFilter::rebalance()
+{
+    while (m_lower.size() > m_upper.size() + 1)
+    {
+        auto last = std::prev(m_lower.end());
+
+        m_upper.insert(*last);
+        m_lower.erase(last);
+    }
+
+    while (m_upper.size() > m_lower.size())
+    {
+        auto first = m_upper.begin();
+
+        m_lower.insert(*first);
+        m_upper.erase(first);
+    }
+}
+
+
+double MedianFilter::median() const
+{
+    if (m_lower.size() > m_upper.size())
+    {
+        return *m_lower.rbegin();
+    }
+
+    return (*m_lower.rbegin() + *m_upper.begin()) / 2;
+}
+
+
+/*
+ * Until the window is full, the median of the samples received so far is used.
+ * NaN and inf samples cannot be ordered, so they are passed through without being added to the window.
+ */
+size_t MedianFilter::process(const FilterInput &input, FilterOutput &output)
+{
+    const size_t n = input.size();
+    const size_t window = (size_t) m_window;
+
+    for (size_t ii = 0; ii < n; ii++)
+    {
+        const double value = input.values[ii];
+
+        if (isnan(value) || isinf(value))
+        {
+            output.values[ii] = value;
+            continue;
+        }
+
+        if (m_samples.size() < window)
+        {
+            m_samples.push_back(value);
+        }
+        else
+        {
+            remove(m_samples[m_head]);
+
+            m_samples[m_head] = value;
+            m_head = (m_head + 1) % window;
+        }
+
+        insert(value);
+
+        output.values[ii] = median();
+    }
+
+    passTimestamps(input, output);
+
+    return n;
+}
+
+
+QVariantMap MedianFilter::getOptions() const
+{
+    QVariantMap options;
+
+    options["window"] = m_window;
+
+    return options;
+}
+
+
+bool MedianFilter::setOptions(const QVariantMap &options)
+{
+    int window = options.value("window", m_window).toInt();
+
+    if (window < 1 || window > MAX_WINDOW) return false;
+
+    m_window = window;
+
+    reset();
+
+    return true;
+}
@@ -0,0 +1,62 @@
+#ifndef LUMBERJACK_MEDIAN_FILTER_HPP
+#define LUMBERJACK_MEDIAN_FILTER_HPP
+
+#include <set>
+#include <vector>
+
+#include "plugin_filter.hpp"
+
+
+/**
+ * @brief The MedianFilter class replaces each sample with the median of the most recent samples
+ *
+ * The window is split into two ordered sets (the lower and upper halves),
+ * so each sample is added and removed in O(log window) time.
+ */
+class MedianFilter : public FilterPlugin
+{
+    Q_OBJECT
+public:
+    MedianFilter(int window = 5);
+
+    // Base plugin functionality
+    virtual QString pluginName(void) const override { return m_name; }
+    virtual QString pluginDescription(void) const override { return m_description; }
+    virtual QString pluginVersion(void) const override { return m_version; }
+
+    // Filter functionality
+    virtual FilterPlugin *createInstance(void) const override { return new MedianFilter(m_window); }
+
+    virtual void reset(void) override;
+
+    virtual size_t process(const FilterInput &input, FilterOutput &output) override;
+
+    virtual QVariantMap getOptions(void) const override;
+    virtual bool setOptions(const QVariantMap &options) override;
+
+    static const int MAX_WINDOW = 100000;
+
+protected:
+    const QString m_name = "Median Filter";
+    const QString m_description = "Sliding window median filter";
+    const QString m_version = "0.1.0";
+
+    // Filter options
+    int m_window = 5;
+
+    void insert(double value);
+    void remove(double value);
+    void rebalance(void);
+
+    double median(void) const;
+
+    //! Lower and upper halves of the window (the lower half may contain one extra sample)
+    std::multiset<double> m_lower;
+    std::multiset<double> m_upper;
+
+    //! Samples in the window, in order of arrival
+    std::vector<double> m_samples;
+    size_t m_head = 0;
+};
+
+#endif // LUMBERJACK_MEDIAN_FILTER_HPP
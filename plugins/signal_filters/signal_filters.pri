@@ -0,0 +1,15 @@
+INCLUDEPATH += ./plugins/signal_filters
+
+HEADERS += \
+    ./plugins/signal_filters/biquad_cascade.hpp \
+    ./plugins/signal_filters/butterworth_filter.hpp \
+    ./plugins/signal_filters/decimate_filter.hpp \
+    ./plugins/signal_filters/fir_filter.hpp \
+    ./plugins/signal_filters/median_filter.hpp
+
+SOURCES += \
+    ./plugins/signal_filters/biquad_cascade.cpp \
+    ./plugins/signal_filters/butterworth_filter.cpp \
+    ./plugins/signal_filters/decimate_filter.cpp \
+    ./plugins/signal_filters/fir_filter.cpp \
+    ./plugins/signal_filters/median_filter.cpp
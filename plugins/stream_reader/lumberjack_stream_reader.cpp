@@ -0,0 +1,160 @@
+#include <QtEndian>
+
+#include "lumberjack_stream_reader.hpp"
+
+
+LumberjackStreamReader::LumberjackStreamReader()
+{
+
+}
+
+
+void LumberjackStreamReader::resetStream(void)
+{
+    m_channels.clear();
+    m_pending.clear();
+    m_bytesSkipped = 0;
+}
+
+
+/**
+ * @brief LumberjackStreamReader::channelSeries - Return the series associated with a channel ID
+ * @param channel
+ * @return
+ */
+RingBufferDataSeries* LumberjackStreamReader::channelSeries(uint16_t channel)
+{
+    if (channel >= m_channels.size())
+    {
+        m_channels.resize(channel + 1, nullptr);
+    }
+
+    RingBufferDataSeries *series = m_channels[channel];
+
+    if (!series)
+    {
+        series = getOrCreateSeries("Channel " + QString::number(channel));
+        m_channels[channel] = series;
+    }
+
+    return series;
+}
+
+
+/**
+ * @brief LumberjackStreamReader::flushChannel - Append the pending samples for a channel to its series
+ * @param channel
+ */
+void LumberjackStreamReader::flushChannel(uint16_t channel)
+{
+    if (channel >= m_pending.size()) return;
+
+    PendingSamples &pending = m_pending[channel];
+
+    if (pending.timestamps.empty()) return;
+
+    channelSeries(channel)->appendColumns(pending.timestamps.data(), pending.values.data(), pending.timestamps.size(), false);
+
+    pending.timestamps.clear();
+    pending.values.clear();
+}
+
+
+void LumberjackStreamReader::flushChannels(void)
+{
+    for (size_t channel = 0; channel < m_pending.size(); channel++)
+    {
+        flushChannel(channel);
+    }
+}
+
+
+/**
+ * @brief LumberjackStreamReader::decodeFrames - Decode all complete frames in the buffer
+ * @param buffer - Raw bytes received from the stream
+ * @param errors
+ * @return the number of bytes consumed
+ */
+qint64 LumberjackStreamReader::decodeFrames(const QByteArray &buffer, QStringList &errors)
+{
+    const uchar *bytes = reinterpret_cast<const uchar*>(buffer.constData());
+    const qint64 length = buffer.length();
+
+    qint64 pos = 0;
+
+    while (length - pos >= HEADER_LENGTH)
+    {
+        // Search for the start of the next frame
+        if (bytes[pos] != SYNC_BYTE_1 || bytes[pos + 1] != SYNC_BYTE_2)
+        {
+            pos++;
+            m_bytesSkipped++;
+            continue;
+        }
+
+        const uchar *frame = bytes + pos + HEADER_LENGTH;
+        const qint64 available = length - pos - HEADER_LENGTH;
+
+        uint8_t frameType = bytes[pos + 2];
+
+        if (frameType == FRAME_SAMPLE)
+        {
+            if (available < SAMPLE_LENGTH) break;
+
+            uint16_t channel = qFromLittleEndian<quint16>(frame);
+            double timestamp = qFromLittleEndian<double>(frame + 2);
+            double value = qFromLittleEndian<double>(frame + 10);
+
+            if (channel >= m_pending.size())
+            {
+                m_pending.resize(channel + 1);
+            }
+
+            m_pending[channel].timestamps.push_back(timestamp);
+            m_pending[channel].values.push_back(value);
+
+            pos += HEADER_LENGTH + SAMPLE_LENGTH;
+        }
+        else if (frameType == FRAME_CHANNEL)
+        {
+            if (available < 3) break;
+
+            uint16_t channel = qFromLittleEndian<quint16>(frame);
+            uint8_t labelLength = frame[2];
+
+            if (available < 3 + labelLength) break;
+
+            QString label = QString::fromUtf8(reinterpret_cast<const char*>(frame + 3), labelLength).trimmed();
+
+            if (label.isEmpty())
+            {
+                label = "Channel " + QString::number(channel);
+            }
+
+            // Samples received before the definition belong to the previous series
+            flushChannel(channel);
+
+            if (channel >= m_channels.size())
+            {
+                m_channels.resize(channel + 1, nullptr);
+            }
+
+            m_channels[channel] = getOrCreateSeries(label);
+
+            pos += HEADER_LENGTH + 3 + labelLength;
+        }
+        else
+        {
+            errors.append(tr("Unknown frame type") + ": " + QString::number(frameType));
+
+            // Skip the sync bytes and attempt to re-synchronize
+            pos += 2;
+            m_bytesSkipped += 2;
+        }
+    }
+
+    // Samples are appended once per call, rather than once per frame
+    flushChannels();
+
+    return pos;
+}
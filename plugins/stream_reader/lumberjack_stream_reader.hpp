@@ -0,0 +1,79 @@
+#ifndef LUMBERJACK_STREAM_READER_HPP
+#define LUMBERJACK_STREAM_READER_HPP
+
+#include <QVector>
+
+#include <vector>
+
+#include "plugin_stream.hpp"
+
+
+/**
+ * @brief The LumberjackStreamReader class decodes framed binary samples from a live stream
+ *
+ * All multi-byte values are little-endian. Each frame starts with two sync bytes (0xA5 0x5A),
+ * followed by a frame type byte:
+ *
+ * 0x01 - Channel definition
+ *   uint16 channel, uint8 length, char[length] label (UTF-8)
+ *
+ * 0x02 - Sample
+ *   uint16 channel, float64 timestamp, float64 value
+ *
+ * Samples for channels which have not been defined are assigned the label "Channel <n>"
+ */
+class LumberjackStreamReader : public StreamPlugin
+{
+    Q_OBJECT
+public:
+    LumberjackStreamReader();
+
+    // Base plugin functionality
+    virtual QString pluginName(void) const override { return m_name; }
+    virtual QString pluginDescription(void) const override { return m_description; }
+    virtual QString pluginVersion(void) const override { return m_version; }
+
+    // Stream plugin functionality
+    virtual qint64 decodeFrames(const QByteArray &buffer, QStringList &errors) override;
+    virtual void resetStream(void) override;
+
+    // Frame definitions
+    static const uint8_t SYNC_BYTE_1 = 0xA5;
+    static const uint8_t SYNC_BYTE_2 = 0x5A;
+
+    enum FrameType
+    {
+        FRAME_CHANNEL = 0x01,
+        FRAME_SAMPLE = 0x02,
+    };
+
+    static const int HEADER_LENGTH = 3;
+    static const int SAMPLE_LENGTH = 2 + 8 + 8;
+
+protected:
+    const QString m_name = "Stream Reader";
+    const QString m_description = "Read framed binary samples from a socket, pipe or stdin";
+    const QString m_version = "0.1.0";
+
+    RingBufferDataSeries* channelSeries(uint16_t channel);
+
+    void flushChannel(uint16_t channel);
+    void flushChannels(void);
+
+    // Direct lookup of series by channel ID
+    QVector<RingBufferDataSeries*> m_channels;
+
+    // Samples decoded for each channel, which are appended to the series as a block
+    struct PendingSamples
+    {
+        std::vector<double> timestamps;
+        std::vector<double> values;
+    };
+
+    std::vector<PendingSamples> m_pending;
+
+    // Number of bytes discarded while searching for sync bytes
+    quint64 m_bytesSkipped = 0;
+};
+
+#endif // LUMBERJACK_STREAM_READER_HPP
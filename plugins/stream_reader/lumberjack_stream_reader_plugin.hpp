@@ -0,0 +1,19 @@
+#ifndef LUMBERJACK_STREAM_READER_PLUGIN_HPP
+#define LUMBERJACK_STREAM_READER_PLUGIN_HPP
+
+#include "lumberjack_stream_reader.hpp"
+#include "stream_reader_global.h"
+
+
+/**
+ * Plugin interface definition for the LumberjackStreamReader
+ * Use this to compile as a standalone plugin
+ */
+class STREAM_READER_EXPORT LumberjackStreamReaderPlugin : public LumberjackStreamReader
+{
+    Q_OBJECT
+    Q_PLUGIN_METADATA(IID StreamInterface_iid)
+    Q_INTERFACES(StreamPlugin)
+};
+
+#endif // LUMBERJACK_STREAM_READER_PLUGIN_HPP
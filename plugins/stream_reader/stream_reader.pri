@@ -0,0 +1,7 @@
+INCLUDEPATH += ./plugins/stream_reader
+
+HEADERS += \
+    ./plugins/stream_reader/lumberjack_stream_reader.hpp
+
+SOURCES += \
+    ./plugins/stream_reader/lumberjack_stream_reader.cpp
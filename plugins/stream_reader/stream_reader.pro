@@ -0,0 +1,60 @@
+QT += gui network
+
+TEMPLATE = lib
+DEFINES += STREAM_READER_LIBRARY
+
+CONFIG += c++17
+CONFIG -= debug_and_release
+
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+INCLUDEPATH += \
+    ../../src \
+    ../../src/plugins
+
+HEADERS += \
+    stream_reader_global.h \
+    lumberjack_stream_reader_plugin.hpp \
+    lumberjack_stream_reader.hpp \
+    ../../src/data_point.hpp \
+    ../../src/data_series.hpp \
+    ../../src/data_storage.hpp \
+    ../../src/performance_monitor.hpp \
+    ../../src/ring_buffer_data_series.hpp \
+    ../../src/plugins/plugin_base.hpp \
+    ../../src/plugins/plugin_stream.hpp \
+
+SOURCES += \
+    lumberjack_stream_reader.cpp \
+    ../../src/data_series.cpp \
+    ../../src/data_storage.cpp \
+    ../../src/performance_monitor.cpp \
+    ../../src/ring_buffer_data_series.cpp \
+    ../../src/plugins/plugin_stream.cpp
+
+# Default rules for deployment.
+unix {
+    target.path = /usr/lib
+}
+
+# Specify output directory
+CONFIG(debug, debug|release) {
+    CONFIG += debug
+    DESTDIR = build/debug
+
+} else {
+    CONFIG += release
+    DESTDIR = ../build/release
+}
+
+RCC_DIR = $$DESDIR
+MOC_DIR = $$DESTDIR/moc
+OBJECTS_DIR = $$DESTDIR/objects
+
+#Set the location for the generated ui_xxxx.h files
+UI_DIR = build/ui
+
+!isEmpty(target.path): INSTALLS += target
+
+DISTFILES += \
+    lumberjack_stream_reader.json
@@ -0,0 +1,12 @@
+#ifndef STREAM_READER_GLOBAL_H
+#define STREAM_READER_GLOBAL_H
+
+#include <QtCore/qglobal.h>
+
+#if defined(STREAM_READER_LIBRARY)
+#define STREAM_READER_EXPORT Q_DECL_EXPORT
+#else
+#define STREAM_READER_EXPORT Q_DECL_IMPORT
+#endif
+
+#endif // STREAM_READER_GLOBAL_H
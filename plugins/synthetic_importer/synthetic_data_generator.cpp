@@ -0,0 +1,404 @@
+#include <QDataStream>
+#include <QFile>
+#include <QFileInfo>
+#include <QSettings>
+
+#include <math.h>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "synthetic_data_generator.hpp"
+
+
+const size_t SyntheticDataGenerator::CHUNK_SIZE;
+
+
+bool SyntheticDataOptions::load(QString filename, QStringList &errors)
+{
+    if (!QFileInfo::exists(filename))
+    {
+        errors.append(QString("File does not exist: %1").arg(filename));
+        return false;
+    }
+
+    QSettings settings(filename, QSettings::IniFormat);
+
+    if (settings.status() != QSettings::NoError)
+    {
+        errors.append(QString("Could not read generator specification: %1").arg(filename));
+        return false;
+    }
+
+    settings.beginGroup("generator");
+
+    seed = settings.value("seed", (qulonglong) seed).toULongLong();
+    sources = settings.value("sources", sources).toInt();
+    seriesPerSource = settings.value("series", seriesPerSource).toInt();
+    samplesPerSeries = settings.value("samples", (qlonglong) samplesPerSeries).toLongLong();
+    sampleRate = settings.value("sampleRate", sampleRate).toDouble();
+    rateSpread = settings.value("rateSpread", rateSpread).toDouble();
+    jitter = settings.value("jitter", jitter).toDouble();
+    gapProbability = settings.value("gapProbability", gapProbability).toDouble();
+    gapDuration = settings.value("gapDuration", gapDuration).toDouble();
+    outOfOrderFraction = settings.value("outOfOrderFraction", outOfOrderFraction).toDouble();
+    nanFraction = settings.value("nanFraction", nanFraction).toDouble();
+    waveform = waveformFromName(settings.value("waveform", waveformName(waveform)).toString());
+    sharedTimebase = settings.value("sharedTimebase", sharedTimebase).toBool();
+
+    settings.endGroup();
+
+    if (sources < 1 || seriesPerSource < 1 || samplesPerSeries < 0 || !(sampleRate > 0))
+    {
+        errors.append(QString("Invalid generator specification: %1").arg(filename));
+        return false;
+    }
+
+    return true;
+}
+
+
+bool SyntheticDataOptions::save(QString filename) const
+{
+    QSettings settings(filename, QSettings::IniFormat);
+
+    settings.beginGroup("generator");
+
+    settings.setValue("seed", (qulonglong) seed);
+    settings.setValue("sources", sources);
+    settings.setValue("series", seriesPerSource);
+    settings.setValue("samples", (qlonglong) samplesPerSeries);
+    settings.setValue("sampleRate", sampleRate);
+    settings.setValue("rateSpread", rateSpread);
+    settings.setValue("jitter", jitter);
+    settings.setValue("gapProbability", gapProbability);
+    settings.setValue("gapDuration", gapDuration);
+    settings.setValue("outOfOrderFraction", outOfOrderFraction);
+    settings.setValue("nanFraction", nanFraction);
+    settings.setValue("waveform", waveformName(waveform));
+    settings.setValue("sharedTimebase", sharedTimebase);
+
+    settings.endGroup();
+    settings.sync();
+
+    return settings.status() == QSettings::NoError;
+}
+
+
+QString SyntheticDataOptions::waveformName(Waveform waveform)
+{
+    switch (waveform)
+    {
+    case SINE:
+        return "Sine";
+    case SQUARE:
+        return "Square";
+    case SAWTOOTH:
+        return "Sawtooth";
+    case NOISE:
+        return "Noise";
+    case RANDOM_WALK:
+        return "Walk";
+    default:
+    case MIXED:
+        return "Mixed";
+    }
+}
+
+
+SyntheticDataOptions::Waveform SyntheticDataOptions::waveformFromName(QString name)
+{
+    for (int ii = SINE; ii <= MIXED; ii++)
+    {
+        if (name.compare(waveformName((Waveform) ii), Qt::CaseInsensitive) == 0)
+        {
+            return (Waveform) ii;
+        }
+    }
+
+    return MIXED;
+}
+
+
+double SyntheticRandom::gaussian()
+{
+    // Box-Muller transform
+    double u1 = uniform();
+    double u2 = uniform();
+
+    if (u1 <= 0) u1 = std::numeric_limits<double>::min();
+
+    return sqrt(-2 * log(u1)) * cos(2 * M_PI * u2);
+}
+
+
+uint64_t SyntheticRandom::derive(uint64_t seed, uint64_t a, uint64_t b, uint64_t c)
+{
+    uint64_t x = SyntheticRandom(seed).next() ^ (a * 0xD1B54A32D192ED03ULL);
+
+    x = SyntheticRandom(x).next() ^ (b * 0xABC98388FB8FAC03ULL);
+    x = SyntheticRandom(x).next() ^ (c * 0x8CB92BA72F3D8DD7ULL);
+
+    return SyntheticRandom(x).next();
+}
+
+
+SyntheticSeriesGenerator::SyntheticSeriesGenerator(const SyntheticDataOptions &options, int source, int series) :
+    options(options)
+{
+    // All series in a shared timebase use the same random sequence for timestamps
+    uint64_t timeSeries = options.sharedTimebase ? 0xFFFFFFFF : (uint64_t) series;
+
+    timeRandom = SyntheticRandom(SyntheticRandom::derive(options.seed, source, timeSeries, 1));
+    valueRandom = SyntheticRandom(SyntheticRandom::derive(options.seed, source, series, 2));
+
+    SyntheticRandom parameters(SyntheticRandom::derive(options.seed, source, series, 3));
+
+    waveform = options.waveform;
+
+    if (waveform == SyntheticDataOptions::MIXED)
+    {
+        waveform = (SyntheticDataOptions::Waveform) (series % SyntheticDataOptions::MIXED);
+    }
+
+    label = QString("%1 %2").arg(SyntheticDataOptions::waveformName(waveform)).arg(series + 1);
+
+    double rate = options.sampleRate;
+
+    if (!options.sharedTimebase && options.rateSpread > 0)
+    {
+        rate *= 1 + options.rateSpread * parameters.uniform(-1, 1);
+    }
+
+    period = 1000.0 / rate;
+
+    // Keep the signal well below the Nyquist frequency
+    frequency = std::min(parameters.uniform(0.1, 10), rate / 8);
+    amplitude = parameters.uniform(1, 100);
+    offset = parameters.uniform(-50, 50);
+    phase = parameters.uniform(0, 2 * M_PI);
+}
+
+
+double SyntheticSeriesGenerator::nextValue(double t)
+{
+    const double noise = 0.01 * amplitude * valueRandom.gaussian();
+    const double x = 2 * M_PI * frequency * t + phase;
+
+    switch (waveform)
+    {
+    default:
+    case SyntheticDataOptions::SINE:
+        return amplitude * sin(x) + offset + noise;
+    case SyntheticDataOptions::SQUARE:
+        return (sin(x) >= 0 ? amplitude : -amplitude) + offset + noise;
+    case SyntheticDataOptions::SAWTOOTH:
+    {
+        double cycle = x / (2 * M_PI);
+        return amplitude * (2 * (cycle - floor(cycle)) - 1) + offset + noise;
+    }
+    case SyntheticDataOptions::NOISE:
+        return 0.3 * amplitude * valueRandom.gaussian() + offset;
+    case SyntheticDataOptions::RANDOM_WALK:
+        walk += noise;
+        return walk + offset;
+    }
+}
+
+
+/*
+ * Random values for timestamps (gaps, jitter, ordering) are always drawn in the same sequence,
+ * independently of the values, so that series with a shared timebase have identical timestamps.
+ */
+size_t SyntheticSeriesGenerator::next(double *timestamps, double *values, size_t count)
+{
+    size_t n = (size_t) std::max<int64_t>(0, std::min<int64_t>(count, getRemaining()));
+
+    for (size_t ii = 0; ii < n; ii++)
+    {
+        if (options.gapProbability > 0 && timeRandom.uniform() < options.gapProbability)
+        {
+            gapOffset += options.gapDuration * 1000;
+        }
+
+        double t = (index + ii) * period + gapOffset;
+
+        if (options.jitter > 0)
+        {
+            t += options.jitter * period * timeRandom.uniform(-0.5, 0.5);
+        }
+
+        // Late samples are stamped before the preceding sample (independent of the chunk size)
+        if (options.outOfOrderFraction > 0 && timeRandom.uniform() < options.outOfOrderFraction)
+        {
+            t -= (1.5 + options.jitter) * period;
+        }
+
+        timestamps[ii] = t;
+
+        if (options.nanFraction > 0 && valueRandom.uniform() < options.nanFraction)
+        {
+            values[ii] = std::numeric_limits<double>::quiet_NaN();
+        }
+        else
+        {
+            values[ii] = nextValue(t / 1000);
+        }
+    }
+
+    index += n;
+
+    return n;
+}
+
+
+bool SyntheticDataGenerator::writeCSV(QString filename, int source, QStringList &errors) const
+{
+    if (options.seriesPerSource < 1)
+    {
+        errors.append(QString("No series to write"));
+        return false;
+    }
+
+    QFile file(filename);
+
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        errors.append(QString("Could not open file for writing: %1").arg(filename));
+        return false;
+    }
+
+    SyntheticDataOptions shared = options;
+    shared.sharedTimebase = true;
+
+    const int M = shared.seriesPerSource;
+
+    std::vector<SyntheticSeriesGenerator> generators;
+
+    QByteArray buffer("timestamp");
+
+    for (int ii = 0; ii < M; ii++)
+    {
+        generators.emplace_back(shared, source, ii);
+
+        buffer.append(',');
+        buffer.append(generators.back().getLabel().toUtf8());
+    }
+
+    buffer.append('\n');
+
+    std::vector<double> timestamps(CHUNK_SIZE);
+    std::vector<std::vector<double>> values(M, std::vector<double>(CHUNK_SIZE));
+
+    while (generators.front().getRemaining() > 0)
+    {
+        size_t n = 0;
+
+        // Timestamps are identical for each series
+        for (int ii = 0; ii < M; ii++)
+        {
+            n = generators[ii].next(timestamps.data(), values[ii].data(), CHUNK_SIZE);
+        }
+
+        for (size_t row = 0; row < n; row++)
+        {
+            buffer.append(QByteArray::number(timestamps[row] / 1000, 'f', 6));
+
+            for (int ii = 0; ii < M; ii++)
+            {
+                buffer.append(',');
+
+                if (!isnan(values[ii][row]))
+                {
+                    buffer.append(QByteArray::number(values[ii][row], 'g', 10));
+                }
+            }
+
+            buffer.append('\n');
+        }
+
+        if (file.write(buffer) != buffer.size())
+        {
+            errors.append(QString("Error writing file: %1").arg(filename));
+            return false;
+        }
+
+        buffer.clear();
+    }
+
+    return true;
+}
+
+
+bool SyntheticDataGenerator::writeBinary(QString filename, int source, QStringList &errors) const
+{
+    if (options.seriesPerSource < 1)
+    {
+        errors.append(QString("No series to write"));
+        return false;
+    }
+
+    QFile file(filename);
+
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        errors.append(QString("Could not open file for writing: %1").arg(filename));
+        return false;
+    }
+
+    SyntheticDataOptions shared = options;
+    shared.sharedTimebase = true;
+
+    const int M = shared.seriesPerSource;
+
+    QDataStream stream(&file);
+
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+
+    stream.writeRawData("LJSYNTH1", 8);
+    stream << (quint32) M << (quint64) shared.samplesPerSeries;
+
+    std::vector<SyntheticSeriesGenerator> generators;
+
+    for (int ii = 0; ii < M; ii++)
+    {
+        generators.emplace_back(shared, source, ii);
+
+        QByteArray label = generators.back().getLabel().toUtf8();
+
+        stream << (quint32) label.size();
+        stream.writeRawData(label.constData(), label.size());
+    }
+
+    std::vector<double> timestamps(CHUNK_SIZE);
+    std::vector<std::vector<double>> values(M, std::vector<double>(CHUNK_SIZE));
+
+    while (generators.front().getRemaining() > 0)
+    {
+        size_t n = 0;
+
+        for (int ii = 0; ii < M; ii++)
+        {
+            n = generators[ii].next(timestamps.data(), values[ii].data(), CHUNK_SIZE);
+        }
+
+        for (size_t row = 0; row < n; row++)
+        {
+            stream << timestamps[row];
+
+            for (int ii = 0; ii < M; ii++)
+            {
+                stream << values[ii][row];
+            }
+        }
+    }
+
+    if (stream.status() != QDataStream::Ok)
+    {
+        errors.append(QString("Error writing file: %1").arg(filename));
+        return false;
+    }
+
+    return true;
+}
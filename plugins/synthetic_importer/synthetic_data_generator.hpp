@@ -0,0 +1,177 @@
+#ifndef SYNTHETIC_DATA_GENERATOR_HPP
+#define SYNTHETIC_DATA_GENERATOR_HPP
+
+#include <QString>
+#include <QStringList>
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+/**
+ * @brief The SyntheticDataOptions struct describes a set of generated data
+ *
+ * The data are fully determined by these options (including the seed),
+ * so the same options always produce the same samples, on any platform.
+ */
+struct SyntheticDataOptions
+{
+    enum Waveform
+    {
+        SINE = 0,
+        SQUARE,
+        SAWTOOTH,
+        NOISE,
+        RANDOM_WALK,
+        MIXED,          //!< Each series uses a different waveform
+    };
+
+    uint64_t seed = 1;
+
+    int sources = 1;
+    int seriesPerSource = 8;
+    int64_t samplesPerSeries = 100000;
+
+    //! Nominal sample rate (Hz)
+    double sampleRate = 1000;
+
+    //! Sample rate of each series varies by up to +/- this fraction (ignored for a shared timebase)
+    double rateSpread = 0;
+
+    //! Random variation of each timestamp, as a fraction of the sample period
+    double jitter = 0;
+
+    //! Probability that a gap occurs before each sample, and the duration of each gap (seconds)
+    double gapProbability = 0;
+    double gapDuration = 1.0;
+
+    //! Fraction of samples which are timestamped before the preceding sample
+    double outOfOrderFraction = 0;
+
+    //! Fraction of sample values which are NaN
+    double nanFraction = 0;
+
+    Waveform waveform = MIXED;
+
+    //! All series of a source share the same timestamps
+    bool sharedTimebase = false;
+
+    // Load / save options from a generator specification (INI) file
+    bool load(QString filename, QStringList &errors);
+    bool save(QString filename) const;
+
+    static QString waveformName(Waveform waveform);
+    static Waveform waveformFromName(QString name);
+};
+
+
+/**
+ * @brief The SyntheticRandom class is a small, portable pseudo-random generator (splitmix64)
+ *
+ * The standard library distributions are implementation-defined,
+ * so are not used where the output must be reproducible across platforms.
+ */
+class SyntheticRandom
+{
+public:
+    SyntheticRandom(uint64_t seed = 0) : state(seed) {}
+
+    uint64_t next(void)
+    {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+
+        return z ^ (z >> 31);
+    }
+
+    // Uniform value in [0, 1)
+    double uniform(void) { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+
+    // Uniform value in [lo, hi)
+    double uniform(double lo, double hi) { return lo + (hi - lo) * uniform(); }
+
+    // Standard normal value
+    double gaussian(void);
+
+    // Derive an independent seed from a seed and a set of indices
+    static uint64_t derive(uint64_t seed, uint64_t a, uint64_t b = 0, uint64_t c = 0);
+
+protected:
+    uint64_t state;
+};
+
+
+/**
+ * @brief The SyntheticSeriesGenerator class generates the samples of a single series, in chunks
+ *
+ * Timestamps are in milliseconds (from zero), and are generated independently of the values,
+ * so that series which share a timebase have identical timestamps.
+ */
+class SyntheticSeriesGenerator
+{
+public:
+    SyntheticSeriesGenerator(const SyntheticDataOptions &options, int source, int series);
+
+    QString getLabel(void) const { return label; }
+
+    int64_t getRemaining(void) const { return options.samplesPerSeries - index; }
+
+    // Generate (up to) count samples, returns the number of samples generated
+    size_t next(double *timestamps, double *values, size_t count);
+
+protected:
+    double nextValue(double t);
+
+    SyntheticDataOptions options;
+
+    QString label;
+
+    SyntheticRandom timeRandom;
+    SyntheticRandom valueRandom;
+
+    SyntheticDataOptions::Waveform waveform;
+
+    double period = 1;
+    double frequency = 1;
+    double amplitude = 1;
+    double offset = 0;
+    double phase = 0;
+
+    double walk = 0;
+    double gapOffset = 0;
+
+    int64_t index = 0;
+};
+
+
+/**
+ * @brief The SyntheticDataGenerator class writes generated data to files
+ *
+ * Files are written with a shared timebase, so that they contain the same samples
+ * as the equivalent generated source.
+ */
+class SyntheticDataGenerator
+{
+public:
+    SyntheticDataGenerator(const SyntheticDataOptions &options) : options(options) {}
+
+    // CSV file with a timestamp column (seconds), and one column per series (NaN samples are empty)
+    bool writeCSV(QString filename, int source, QStringList &errors) const;
+
+    /*
+     * Binary file (little-endian):
+     * - "LJSYNTH1" (8 bytes), series count (uint32), samples per series (uint64)
+     * - for each series: label length (uint32) and UTF-8 label
+     * - for each sample: timestamp (float64, ms), then one value (float64) per series
+     */
+    bool writeBinary(QString filename, int source, QStringList &errors) const;
+
+    static const size_t CHUNK_SIZE = 0x10000;
+
+protected:
+    SyntheticDataOptions options;
+};
+
+#endif // SYNTHETIC_DATA_GENERATOR_HPP
@@ -0,0 +1,204 @@
+#include <QThread>
+
+#include <thread>
+#include <vector>
+
+#include "synthetic_importer.hpp"
+
+
+SyntheticDataImporter::SyntheticDataImporter()
+{
+}
+
+
+ImportPlugin *SyntheticDataImporter::createInstance() const
+{
+    SyntheticDataImporter *importer = new SyntheticDataImporter();
+
+    importer->m_options = m_options;
+    importer->m_sourceIndex = m_sourceIndex;
+
+    return importer;
+}
+
+
+QStringList SyntheticDataImporter::supportedFileTypes() const
+{
+    QStringList fileTypes;
+
+    fileTypes << "ljgen";
+
+    return fileTypes;
+}
+
+
+/**
+ * @brief SyntheticDataImporter::importData - Generate the series for a single source
+ * @param errors - List of errors
+ * @return true if the data were generated
+ *
+ * If a filename has been set, the generator options are loaded from the file.
+ */
+bool SyntheticDataImporter::importData(QStringList &errors)
+{
+    m_series.clear();
+    m_cancelled = false;
+    m_generated = 0;
+
+    if (!m_filename.isEmpty() && !m_options.load(m_filename, errors))
+    {
+        return false;
+    }
+
+    const int M = m_options.seriesPerSource;
+
+    if (M <= 0 || m_options.samplesPerSeries <= 0)
+    {
+        errors.append(tr("No data to generate"));
+        return false;
+    }
+
+    m_total = (int64_t) M * m_options.samplesPerSeries;
+
+    std::vector<SyntheticSeriesGenerator> generators;
+
+    for (int ii = 0; ii < M; ii++)
+    {
+        generators.emplace_back(m_options, m_sourceIndex, ii);
+    }
+
+    if (m_options.sharedTimebase)
+    {
+        return importBatch(generators, errors);
+    }
+
+    // Series are created (and published) in this thread, then filled in parallel
+    for (int ii = 0; ii < M; ii++)
+    {
+        DataSeriesPointer series = createDataSeries(generators[ii].getLabel());
+
+        m_series.append(series);
+        publishSeries(series);
+    }
+
+    std::atomic<int> next {0};
+
+    auto worker = [&]()
+    {
+        std::vector<double> timestamps(SyntheticDataGenerator::CHUNK_SIZE);
+        std::vector<double> values(SyntheticDataGenerator::CHUNK_SIZE);
+
+        int idx;
+
+        while ((idx = next++) < M)
+        {
+            auto &generator = generators[idx];
+            auto series = m_series.at(idx);
+
+            while (!m_cancelled && generator.getRemaining() > 0)
+            {
+                size_t n = generator.next(timestamps.data(), values.data(), timestamps.size());
+
+                series->appendColumns(timestamps.data(), values.data(), n, false);
+
+                m_generated += n;
+            }
+        }
+    };
+
+    int threads = qBound(1, QThread::idealThreadCount(), M);
+
+    std::vector<std::thread> workers;
+
+    for (int ii = 1; ii < threads; ii++)
+    {
+        workers.emplace_back(worker);
+    }
+
+    worker();
+
+    for (auto &thread : workers)
+    {
+        thread.join();
+    }
+
+    if (m_cancelled)
+    {
+        errors.append(tr("Data generation cancelled"));
+        return false;
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief SyntheticDataImporter::importBatch - Generate series which share a timebase, via the columnar batch interface
+ * @param generators - One generator per series
+ * @param errors - List of errors
+ * @return true if the data were generated
+ *
+ * Each chunk contains the (shared) timestamps and one value column per series,
+ * and is ingested as soon as it has been generated.
+ */
+bool SyntheticDataImporter::importBatch(std::vector<SyntheticSeriesGenerator> &generators, QStringList &errors)
+{
+    resetBatch();
+
+    for (const auto &generator : generators)
+    {
+        m_batch.addColumn(generator.getLabel());
+    }
+
+    std::vector<double> scratch(SyntheticDataGenerator::CHUNK_SIZE);
+
+    while (!m_cancelled && generators.front().getRemaining() > 0)
+    {
+        std::vector<double> timestamps(SyntheticDataGenerator::CHUNK_SIZE);
+        std::vector<std::vector<double>> values(generators.size());
+
+        size_t n = 0;
+
+        for (size_t ii = 0; ii < generators.size(); ii++)
+        {
+            values[ii].resize(SyntheticDataGenerator::CHUNK_SIZE);
+
+            // Timestamps are identical for every series, so only the first set is kept
+            n = generators[ii].next(ii == 0 ? timestamps.data() : scratch.data(), values[ii].data(), timestamps.size());
+
+            values[ii].resize(n);
+        }
+
+        timestamps.resize(n);
+
+        m_batch.addChunk(std::move(timestamps), std::move(values));
+
+        ingestBatch();
+
+        m_generated += (int64_t) n * generators.size();
+    }
+
+    m_series = getBatchSeries();
+
+    if (m_cancelled)
+    {
+        errors.append(tr("Data generation cancelled"));
+        return false;
+    }
+
+    return true;
+}
+
+
+void SyntheticDataImporter::cancelImport()
+{
+    m_cancelled = true;
+}
+
+
+uint8_t SyntheticDataImporter::getImportProgress() const
+{
+    if (m_total <= 0) return 0;
+
+    return (uint8_t) qBound<int64_t>(0, m_generated * 100 / m_total, 100);
+}
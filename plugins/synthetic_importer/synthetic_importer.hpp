@@ -0,0 +1,67 @@
+#ifndef LUMBERJACK_SYNTHETIC_IMPORTER_HPP
+#define LUMBERJACK_SYNTHETIC_IMPORTER_HPP
+
+#include <atomic>
+#include <vector>
+
+#include "plugin_importer.hpp"
+#include "synthetic_data_generator.hpp"
+
+
+/**
+ * @brief The SyntheticDataImporter class generates reproducible synthetic data (e.g. for load testing)
+ *
+ * The generator is configured by a specification file (*.ljgen, INI format - see SyntheticDataOptions),
+ * or programmatically with setOptions(). Each import generates a single source;
+ * the source index selects which of the specified sources is generated.
+ *
+ * Series are generated in parallel, and appended directly to series storage in chunks.
+ * Series which share a timebase are generated as a single columnar batch (see ImportPlugin::ingestBatch).
+ */
+class SyntheticDataImporter : public ImportPlugin
+{
+    Q_OBJECT
+public:
+    SyntheticDataImporter();
+
+    // Base plugin functionality
+    virtual QString pluginName(void) const override { return m_name; }
+    virtual QString pluginDescription(void) const override { return m_description; }
+    virtual QString pluginVersion(void) const override { return m_version; }
+
+    // Importer plugin functionality
+    virtual ImportPlugin *createInstance(void) const override;
+
+    virtual QStringList supportedFileTypes(void) const override;
+
+    virtual bool importData(QStringList &errors) override;
+    virtual void cancelImport(void) override;
+
+    virtual uint8_t getImportProgress(void) const override;
+
+    virtual QList<DataSeriesPointer> getDataSeries(void) const override { return m_series; }
+
+    const SyntheticDataOptions &getOptions(void) const { return m_options; }
+    void setOptions(const SyntheticDataOptions &options) { m_options = options; }
+
+    void setSourceIndex(int index) { m_sourceIndex = index; }
+
+protected:
+    bool importBatch(std::vector<SyntheticSeriesGenerator> &generators, QStringList &errors);
+
+    //! Plugin metadata
+    const QString m_name = "Synthetic Data Generator";
+    const QString m_description = "Generate reproducible synthetic data";
+    const QString m_version = "0.1.0";
+
+    SyntheticDataOptions m_options;
+    int m_sourceIndex = 0;
+
+    QList<DataSeriesPointer> m_series;
+
+    std::atomic<bool> m_cancelled {false};
+    std::atomic<int64_t> m_generated {0};
+    int64_t m_total = 0;
+};
+
+#endif // LUMBERJACK_SYNTHETIC_IMPORTER_HPP
@@ -0,0 +1,9 @@
+INCLUDEPATH += ./plugins/synthetic_importer
+
+HEADERS += \
+    ./plugins/synthetic_importer/synthetic_data_generator.hpp \
+    ./plugins/synthetic_importer/synthetic_importer.hpp
+
+SOURCES += \
+    ./plugins/synthetic_importer/synthetic_data_generator.cpp \
+    ./plugins/synthetic_importer/synthetic_importer.cpp
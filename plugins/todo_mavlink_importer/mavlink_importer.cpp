@@ -115,6 +115,8 @@ bool MavlinkImporter::loadDataFromFile(QStringList &errors)
 
     f.seek(0);
 
+    diagnostics.clear();
+
     QByteArray bytes;
 
     int64_t byteCount = 0;
@@ -150,6 +152,8 @@ bool MavlinkImporter::loadDataFromFile(QStringList &errors)
         progress.close();
     }
 
+    diagnostics.report(errors);
+
     qDebug() << "Decoded" << messageCount << "messages from" << filename << "in" << QString::number((double) totalTime.elapsed() / 1000, 'f', 2) + "s";
 
     return true;
@@ -192,7 +196,7 @@ void MavlinkImporter::processChunk(const QByteArray &bytes)
                     // Check there is enough data
                     if (data.count() < format.length)
                     {
-                        qWarning() << format.name << "missing data:" << data.count() << format.length;
+                        diagnostics.add("Message is missing data", -1, messageCount);
                     }
                     else
                     {
@@ -327,7 +331,7 @@ void MavlinkImporter::processData(const MavlinkFormatMessage &format, QByteArray
             value = extractUInt64(bytes);
             break;
         default:
-            qWarning() << graphName << "invalid format:" << fmt;
+            diagnostics.add("Invalid format character", -1, messageCount);
             return;
         }
 
@@ -13,6 +13,7 @@
 #define MAVLINK_IMPORTER_HPP
 
 #include "data_source.hpp"
+#include "import_diagnostics.hpp"
 
 
 /*
@@ -55,6 +56,9 @@ protected:
 
     int messageCount = 0;
 
+    //! Issues found while decoding messages (reported once the file has been read)
+    ImportDiagnostics diagnostics;
+
     // Expected header bytes (according to ArduPilot spec)
     const char HEAD_BYTE_1 = 0xA3;
     const char HEAD_BYTE_2 = 0x95;
@@ -0,0 +1,951 @@
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <stdexcept>
+#include <iterator>
+
+#include <QtAlgorithms>
+
+#include "compressed_data_series.hpp"
+
+
+const uint64_t CompressedDataSeries::BLOCK_SAMPLES;
+
+
+/**
+ * @brief The BitWriter class appends variable-width fields to a bitstream (MSB first)
+ */
+class BitWriter
+{
+public:
+    BitWriter(std::vector<uint64_t> &w) : words(w)
+    {
+        words.clear();
+    }
+
+    // Write the lowest n bits of value (1 <= n <= 64)
+    void write(uint64_t value, int n)
+    {
+        if (n < 64) value &= (1ULL << n) - 1;
+
+        if (used == 64)
+        {
+            words.push_back(0);
+            used = 0;
+        }
+
+        int available = 64 - used;
+
+        if (n <= available)
+        {
+            words.back() |= value << (available - n);
+            used += n;
+        }
+        else
+        {
+            int spill = n - available;
+
+            words.back() |= value >> spill;
+            words.push_back(value << (64 - spill));
+            used = spill;
+        }
+    }
+
+protected:
+    std::vector<uint64_t> &words;
+
+    //! Number of bits used in the last word
+    int used = 64;
+};
+
+
+/**
+ * @brief The BitReader class reads variable-width fields from a bitstream (MSB first)
+ */
+class BitReader
+{
+public:
+    BitReader(const std::vector<uint64_t> &w) : words(w) {}
+
+    // Read n bits (1 <= n <= 64)
+    uint64_t read(int n)
+    {
+        uint64_t word = position / 64;
+        int bit = position % 64;
+        int available = 64 - bit;
+
+        uint64_t result = (words[word] << bit) >> (64 - n);
+
+        if (n > available)
+        {
+            result |= words[word + 1] >> (64 - (n - available));
+        }
+
+        position += n;
+
+        return result;
+    }
+
+protected:
+    const std::vector<uint64_t> &words;
+
+    uint64_t position = 0;
+};
+
+
+static inline uint64_t toBits(double d)
+{
+    uint64_t bits;
+    memcpy(&bits, &d, sizeof(bits));
+    return bits;
+}
+
+
+static inline double fromBits(uint64_t bits)
+{
+    double d;
+    memcpy(&d, &bits, sizeof(d));
+    return d;
+}
+
+
+/*
+ * Timestamp encoding (delta-of-delta, zigzag encoded):
+ *
+ * '0'              : delta unchanged
+ * '10'   + 7 bits  : small change
+ * '110'  + 12 bits
+ * '1110' + 32 bits
+ * '1111' + 64 bits
+ */
+static void encodeTimestamp(BitWriter &writer, int64_t dod)
+{
+    uint64_t zz = ((uint64_t) dod << 1) ^ (uint64_t) (dod >> 63);
+
+    if (zz == 0)
+    {
+        writer.write(0x0, 1);
+    }
+    else if (zz < (1ULL << 7))
+    {
+        writer.write(0x2, 2);
+        writer.write(zz, 7);
+    }
+    else if (zz < (1ULL << 12))
+    {
+        writer.write(0x6, 3);
+        writer.write(zz, 12);
+    }
+    else if (zz < (1ULL << 32))
+    {
+        writer.write(0xE, 4);
+        writer.write(zz, 32);
+    }
+    else
+    {
+        writer.write(0xF, 4);
+        writer.write(zz, 64);
+    }
+}
+
+
+static int64_t decodeTimestamp(BitReader &reader)
+{
+    static const int widths[] = {7, 12, 32, 64};
+
+    int prefix = 0;
+
+    while (prefix < 4 && reader.read(1))
+    {
+        prefix++;
+    }
+
+    if (prefix == 0) return 0;
+
+    uint64_t zz = reader.read(widths[prefix - 1]);
+
+    return (int64_t) (zz >> 1) ^ -(int64_t) (zz & 1);
+}
+
+
+/*
+ * Value encoding (XOR with previous value):
+ *
+ * '0'  : value unchanged
+ * '10' + meaningful bits : XOR fits within the previous leading / trailing zero window
+ * '11' + 6 bits leading zeros + 6 bits (length - 1) + meaningful bits
+ */
+static void encodeValue(BitWriter &writer, uint64_t xored, int &leading, int &trailing)
+{
+    if (xored == 0)
+    {
+        writer.write(0x0, 1);
+        return;
+    }
+
+    int lz = qCountLeadingZeroBits(xored);
+    int tz = qCountTrailingZeroBits(xored);
+
+    if (leading >= 0 && lz >= leading && tz >= trailing)
+    {
+        writer.write(0x2, 2);
+        writer.write(xored >> trailing, 64 - leading - trailing);
+    }
+    else
+    {
+        int length = 64 - lz - tz;
+
+        writer.write(0x3, 2);
+        writer.write(lz, 6);
+        writer.write(length - 1, 6);
+        writer.write(xored >> tz, length);
+
+        leading = lz;
+        trailing = tz;
+    }
+}
+
+
+static uint64_t decodeValue(BitReader &reader, int &leading, int &trailing)
+{
+    if (!reader.read(1)) return 0;
+
+    if (reader.read(1))
+    {
+        leading = reader.read(6);
+        trailing = 64 - leading - (reader.read(6) + 1);
+    }
+
+    return reader.read(64 - leading - trailing) << trailing;
+}
+
+
+CompressedDataSeries::CompressedDataSeries(QString lbl) : DataSeries(lbl)
+{
+}
+
+
+CompressedDataSeries::CompressedDataSeries(QString grp, QString lbl) : DataSeries(grp, lbl)
+{
+}
+
+
+CompressedDataSeries::~CompressedDataSeries()
+{
+}
+
+
+/*
+ * Encode a set of (time-ordered) samples into a block
+ */
+void CompressedDataSeries::encodeBlock(const std::vector<DataPoint> &points, uint64_t first_index, EncodedBlock &block)
+{
+    DataSummaryBlock &summary = block.summary;
+
+    summary.first_index = first_index;
+    summary.last_index = first_index + points.size() - 1;
+    summary.first = points.front();
+    summary.last = points.back();
+    summary.min = points.front();
+    summary.max = points.front();
+
+    BitWriter writer(block.bits);
+
+    uint64_t prevTime = toBits(points.front().timestamp);
+    uint64_t prevDelta = 0;
+    uint64_t prevValue = toBits(points.front().value);
+
+    int leading = -1;
+    int trailing = 0;
+
+    for (size_t idx = 1; idx < points.size(); idx++)
+    {
+        const DataPoint &dp = points[idx];
+
+        if (dp.value < summary.min.value) summary.min = dp;
+        if (dp.value > summary.max.value) summary.max = dp;
+
+        // Integer arithmetic on the bit patterns is exact (wrapping)
+        uint64_t t = toBits(dp.timestamp);
+        uint64_t delta = t - prevTime;
+
+        encodeTimestamp(writer, (int64_t) (delta - prevDelta));
+
+        prevTime = t;
+        prevDelta = delta;
+
+        uint64_t v = toBits(dp.value);
+
+        encodeValue(writer, v ^ prevValue, leading, trailing);
+
+        prevValue = v;
+    }
+
+    block.bits.shrink_to_fit();
+}
+
+
+/*
+ * Decode an entire block into (contiguous) timestamp and value arrays
+ */
+void CompressedDataSeries::decodeBlock(const EncodedBlock &block, double *timestamps, double *values)
+{
+    const uint64_t count = block.count();
+
+    timestamps[0] = block.summary.first.timestamp;
+    values[0] = block.summary.first.value;
+
+    BitReader reader(block.bits);
+
+    uint64_t prevTime = toBits(timestamps[0]);
+    uint64_t prevDelta = 0;
+    uint64_t prevValue = toBits(values[0]);
+
+    int leading = 0;
+    int trailing = 0;
+
+    for (uint64_t idx = 1; idx < count; idx++)
+    {
+        prevDelta += (uint64_t) decodeTimestamp(reader);
+        prevTime += prevDelta;
+
+        prevValue ^= decodeValue(reader, leading, trailing);
+
+        timestamps[idx] = fromBits(prevTime);
+        values[idx] = fromBits(prevValue);
+    }
+}
+
+
+size_t CompressedDataSeries::getBlockCount() const
+{
+    sealForRead();
+
+    DataLocker lock(this);
+
+    return blocks.size();
+}
+
+
+size_t CompressedDataSeries::getStorageBytes() const
+{
+    DataLocker lock(this);
+
+    size_t bytes = blocks.capacity() * sizeof(EncodedBlock) + tail.capacity() * sizeof(DataPoint);
+
+    for (const EncodedBlock &block : blocks)
+    {
+        bytes += block.bits.capacity() * sizeof(uint64_t);
+    }
+
+    return bytes;
+}
+
+
+uint64_t CompressedDataSeries::getMemoryUsage() const
+{
+    uint64_t bytes = getStorageBytes();
+
+    DataLocker lock(this);
+
+    return bytes + (cachedTimestamps.capacity() + cachedValues.capacity()) * sizeof(double);
+}
+
+
+/*
+ * Decode the specified block into the cache (data_mutex must be held)
+ */
+void CompressedDataSeries::decodeCached(size_t b) const
+{
+    if (cachedBlock == (int64_t) b) return;
+
+    const EncodedBlock &block = blocks[b];
+
+    cachedTimestamps.resize(block.count());
+    cachedValues.resize(block.count());
+
+    decodeBlock(block, cachedTimestamps.data(), cachedValues.data());
+
+    cachedBlock = b;
+}
+
+
+void CompressedDataSeries::decodeToVector(size_t b, std::vector<DataPoint> &points) const
+{
+    decodeCached(b);
+
+    points.resize(cachedTimestamps.size());
+
+    for (size_t idx = 0; idx < points.size(); idx++)
+    {
+        points[idx] = DataPoint(cachedTimestamps[idx], cachedValues[idx]);
+    }
+}
+
+
+/*
+ * Return the index of the block containing the specified storage index (data_mutex must be held)
+ */
+size_t CompressedDataSeries::blockForIndex(uint64_t sidx) const
+{
+    auto it = std::partition_point(blocks.begin(), blocks.end(), [sidx](const EncodedBlock &block) {
+        return block.summary.last_index < sidx;
+    });
+
+    return std::distance(blocks.begin(), it);
+}
+
+
+/*
+ * Add a single sample (data_mutex must be held)
+ */
+void CompressedDataSeries::addSample(const DataPoint &point)
+{
+    // Ignore NaN and inf values
+    if (isnan(point.value) || isinf(point.value)) return;
+
+    if (!tail.empty() || !blocks.empty())
+    {
+        double newest = tail.empty() ? blocks.back().summary.last.timestamp : tail.back().timestamp;
+
+        if (point.timestamp < newest)
+        {
+            // Out-of-order samples are merged (once per batch) when the series is next read
+            bufferLateSample(point, newest);
+            return;
+        }
+    }
+
+    tail.push_back(point);
+
+    if (tail.size() >= BLOCK_SAMPLES)
+    {
+        sealTail();
+    }
+}
+
+
+/*
+ * Merge the buffered samples into the stored data.
+ * Each affected block is decoded and re-encoded once (split into blocks of at most BLOCK_SAMPLES samples),
+ * and the indices of the following blocks are shifted.
+ */
+void CompressedDataSeries::mergeSamples(const std::vector<DataPoint> &points)
+{
+    if (points.empty()) return;
+
+    auto before = [](const DataPoint &a, const DataPoint &b) { return a.timestamp < b.timestamp; };
+
+    std::vector<EncodedBlock> merged;
+    std::vector<DataPoint> existing;
+    std::vector<DataPoint> combined;
+
+    merged.reserve(blocks.size());
+
+    size_t next = 0;
+    uint64_t shift = 0;
+    uint64_t clipped = 0;
+
+    // Merge points [next, end) with the current samples into 'combined'
+    // (existing samples with equal timestamps are retained first, as std::merge is stable)
+    auto mergeInto = [&](const std::vector<DataPoint> &current, uint64_t first_index, size_t end) {
+        for (size_t idx = next; idx < end; idx++)
+        {
+            auto upper = std::upper_bound(current.begin(), current.end(), points[idx], before);
+
+            // Samples which precede the clipped region remain hidden
+            if (first_index + std::distance(current.begin(), upper) < offset) clipped++;
+        }
+
+        combined.clear();
+        combined.reserve(current.size() + end - next);
+
+        std::merge(current.begin(), current.end(), points.begin() + next, points.begin() + end,
+                   std::back_inserter(combined), before);
+    };
+
+    for (size_t b = 0; b < blocks.size(); b++)
+    {
+        EncodedBlock &block = blocks[b];
+
+        // Buffered samples which belong within this block
+        auto end = std::partition_point(points.begin() + next, points.end(), [&block](const DataPoint &dp) {
+            return dp.timestamp < block.summary.last.timestamp;
+        });
+
+        size_t last = std::distance(points.begin(), end);
+
+        uint64_t first_index = block.summary.first_index + shift;
+
+        if (last == next)
+        {
+            block.summary.first_index = first_index;
+            block.summary.last_index += shift;
+
+            merged.push_back(std::move(block));
+            continue;
+        }
+
+        decodeToVector(b, existing);
+
+        mergeInto(existing, block.summary.first_index, last);
+
+        for (size_t idx = 0; idx < combined.size(); idx += BLOCK_SAMPLES)
+        {
+            std::vector<DataPoint> chunk(combined.begin() + idx,
+                                         combined.begin() + std::min<size_t>(idx + BLOCK_SAMPLES, combined.size()));
+
+            EncodedBlock encoded;
+
+            encodeBlock(chunk, first_index + idx, encoded);
+
+            merged.push_back(std::move(encoded));
+        }
+
+        shift += last - next;
+        next = last;
+    }
+
+    blocks.swap(merged);
+
+    invalidateCache();
+
+    // Remaining samples belong in the tail
+    if (next < points.size())
+    {
+        mergeInto(tail, sealedCount() - shift, points.size());
+
+        tail.swap(combined);
+    }
+
+    offset += clipped;
+
+    sealTail();
+}
+
+
+/*
+ * Compress the tail, in blocks of BLOCK_SAMPLES samples
+ */
+void CompressedDataSeries::sealTail()
+{
+    if (tail.size() < BLOCK_SAMPLES) return;
+
+    EncodedBlock block;
+
+    if (tail.size() == BLOCK_SAMPLES)
+    {
+        encodeBlock(tail, sealedCount(), block);
+        blocks.push_back(std::move(block));
+
+        tail.clear();
+        return;
+    }
+
+    // The tail may exceed a single block once out-of-order samples are merged
+    size_t idx = 0;
+
+    for (; idx + BLOCK_SAMPLES <= tail.size(); idx += BLOCK_SAMPLES)
+    {
+        std::vector<DataPoint> chunk(tail.begin() + idx, tail.begin() + idx + BLOCK_SAMPLES);
+
+        encodeBlock(chunk, sealedCount(), block);
+        blocks.push_back(std::move(block));
+    }
+
+    tail.erase(tail.begin(), tail.begin() + idx);
+}
+
+
+void CompressedDataSeries::addData(DataPoint point, bool do_update)
+{
+    lockData();
+
+    addSample(point);
+
+    data_mutex.unlock();
+
+    if (do_update)
+    {
+        update();
+    }
+    else
+    {
+        pendingUpdate = true;
+    }
+}
+
+
+void CompressedDataSeries::appendData(const std::vector<DataPoint> &points, bool do_update)
+{
+    if (points.empty()) return;
+
+    lockData();
+
+    for (const DataPoint &point : points)
+    {
+        addSample(point);
+    }
+
+    data_mutex.unlock();
+
+    if (do_update)
+    {
+        update();
+    }
+    else
+    {
+        pendingUpdate = true;
+    }
+}
+
+
+/*
+ * Return the sample at the specified storage index (data_mutex must be held)
+ */
+DataPoint CompressedDataSeries::storedPoint(uint64_t sidx) const
+{
+    const uint64_t sealed = sealedCount();
+
+    if (sidx < sealed)
+    {
+        size_t b = blockForIndex(sidx);
+
+        decodeCached(b);
+
+        uint64_t idx = sidx - blocks[b].summary.first_index;
+
+        return DataPoint(cachedTimestamps[idx], cachedValues[idx]);
+    }
+
+    sidx -= sealed;
+
+    if (sidx < tail.size())
+    {
+        return tail[sidx];
+    }
+
+    return DataPoint();
+}
+
+
+/*
+ * Binary search across all stored samples (data_mutex must be held).
+ * The block summaries are searched first, so that at most one block is decoded.
+ *
+ * SEARCH_LEFT_TO_RIGHT finds the first sample *after* t (upper bound)
+ * SEARCH_RIGHT_TO_LEFT finds the first sample *at or after* t (lower bound)
+ */
+uint64_t CompressedDataSeries::storedIndexForTimestamp(double t, SearchDirection direction) const
+{
+    const bool upper = direction == SEARCH_LEFT_TO_RIGHT;
+
+    auto after = [upper](double ts, double t) { return upper ? (ts > t) : (ts >= t); };
+
+    auto block = std::partition_point(blocks.begin(), blocks.end(), [&](const EncodedBlock &b) {
+        return !after(b.summary.last.timestamp, t);
+    });
+
+    if (block != blocks.end())
+    {
+        decodeCached(std::distance(blocks.begin(), block));
+
+        auto begin = cachedTimestamps.begin();
+        auto end = cachedTimestamps.end();
+
+        auto it = upper ? std::upper_bound(begin, end, t) : std::lower_bound(begin, end, t);
+
+        return block->summary.first_index + std::distance(begin, it);
+    }
+
+    auto it = std::partition_point(tail.begin(), tail.end(), [&](const DataPoint &dp) {
+        return !after(dp.timestamp, t);
+    });
+
+    return sealedCount() + std::distance(tail.begin(), it);
+}
+
+
+/*
+ * Truncate the stored data to the first n samples (data_mutex must be held)
+ */
+void CompressedDataSeries::truncateStorage(uint64_t n)
+{
+    if (n >= storedCount()) return;
+
+    const uint64_t sealed = sealedCount();
+
+    if (n >= sealed)
+    {
+        tail.resize(n - sealed);
+        return;
+    }
+
+    size_t b = blockForIndex(n);
+
+    // The partial block is moved back into the (uncompressed) tail
+    std::vector<DataPoint> partial;
+
+    decodeToVector(b, partial);
+
+    partial.resize(n - blocks[b].summary.first_index);
+
+    blocks.resize(b);
+    tail.swap(partial);
+
+    invalidateCache();
+}
+
+
+/*
+ * Release any blocks which lie entirely within the clipped region (data_mutex must be held)
+ */
+void CompressedDataSeries::discardFront()
+{
+    size_t drop = 0;
+
+    while (drop < blocks.size() && blocks[drop].summary.last_index < offset)
+    {
+        drop++;
+    }
+
+    if (drop > 0)
+    {
+        uint64_t shift = blocks[drop - 1].summary.last_index + 1;
+
+        blocks.erase(blocks.begin(), blocks.begin() + drop);
+
+        for (EncodedBlock &block : blocks)
+        {
+            block.summary.first_index -= shift;
+            block.summary.last_index -= shift;
+        }
+
+        offset -= shift;
+
+        invalidateCache();
+    }
+
+    if (blocks.empty() && offset > 0)
+    {
+        tail.erase(tail.begin(), tail.begin() + std::min<uint64_t>(offset, tail.size()));
+        offset = 0;
+    }
+}
+
+
+void CompressedDataSeries::clipTimeRange(double t_min, double t_max, bool do_update)
+{
+    if (t_min > t_max)
+    {
+        std::swap(t_min, t_max);
+    }
+
+    lockData();
+
+    mergeLateSamples();
+
+    uint64_t first = storedIndexForTimestamp(t_min, SEARCH_RIGHT_TO_LEFT);
+    uint64_t last = storedIndexForTimestamp(t_max, SEARCH_LEFT_TO_RIGHT);
+
+    truncateStorage(last);
+
+    offset = std::min(std::max(offset, first), storedCount());
+
+    discardFront();
+
+    data_mutex.unlock();
+
+    if (do_update)
+    {
+        update();
+    }
+}
+
+
+void CompressedDataSeries::clearData(bool do_update)
+{
+    lockData();
+
+    blocks.clear();
+    tail.clear();
+    offset = 0;
+
+    clearLateSamples();
+
+    invalidateCache();
+
+    data_mutex.unlock();
+
+    if (do_update)
+    {
+        update();
+    }
+}
+
+
+void CompressedDataSeries::truncateData(uint64_t count, bool do_update)
+{
+    lockData();
+
+    mergeLateSamples();
+
+    truncateStorage(offset + count);
+
+    data_mutex.unlock();
+
+    if (do_update)
+    {
+        update();
+    }
+}
+
+
+size_t CompressedDataSeries::size() const
+{
+    sealForRead();
+
+    DataLocker lock(this);
+
+    return storedCount() - offset;
+}
+
+
+/*
+ * Return a (decompressed) copy of all samples
+ */
+std::vector<DataPoint> CompressedDataSeries::getData() const
+{
+    sealForRead();
+
+    DataLocker lock(this);
+
+    std::vector<DataPoint> all;
+
+    all.reserve(storedCount() - offset);
+
+    std::vector<double> timestamps;
+    std::vector<double> values;
+
+    for (const EncodedBlock &block : blocks)
+    {
+        timestamps.resize(block.count());
+        values.resize(block.count());
+
+        decodeBlock(block, timestamps.data(), values.data());
+
+        uint64_t start = block.summary.first_index < offset ? offset - block.summary.first_index : 0;
+
+        for (uint64_t idx = start; idx < timestamps.size(); idx++)
+        {
+            all.push_back(DataPoint(timestamps[idx], values[idx]));
+        }
+    }
+
+    uint64_t start = offset > sealedCount() ? offset - sealedCount() : 0;
+
+    all.insert(all.end(), tail.begin() + start, tail.end());
+
+    return all;
+}
+
+
+DataPoint CompressedDataSeries::getRawDataPoint(uint64_t idx) const
+{
+    sealForRead();
+
+    DataLocker lock(this);
+
+    uint64_t n = storedCount() - offset;
+
+    // The series may have been clipped since the caller checked the index
+    if (idx >= n)
+    {
+        throw std::out_of_range("data index out of range");
+    }
+
+    return storedPoint(offset + idx);
+}
+
+
+/*
+ * Copy a range of samples, decoding each block only once
+ */
+uint64_t CompressedDataSeries::getRawDataPoints(uint64_t idx, uint64_t count, DataPoint *points) const
+{
+    sealForRead();
+
+    DataLocker lock(this);
+
+    uint64_t n = storedCount() - offset;
+
+    if (idx >= n) return 0;
+
+    count = std::min<uint64_t>(count, n - idx);
+
+    const uint64_t sealed = sealedCount();
+
+    uint64_t sidx = offset + idx;
+    uint64_t copied = 0;
+
+    while (copied < count && sidx < sealed)
+    {
+        size_t b = blockForIndex(sidx);
+
+        decodeCached(b);
+
+        uint64_t start = sidx - blocks[b].summary.first_index;
+        uint64_t end = std::min<uint64_t>(cachedTimestamps.size(), start + count - copied);
+
+        for (uint64_t ii = start; ii < end; ii++)
+        {
+            points[copied++] = DataPoint(cachedTimestamps[ii], cachedValues[ii]);
+        }
+
+        sidx += end - start;
+    }
+
+    while (copied < count)
+    {
+        points[copied++] = tail[sidx - sealed];
+        sidx++;
+    }
+
+    return count;
+}
+
+
+bool CompressedDataSeries::getRawSummaryBlock(uint64_t idx, DataSummaryBlock &block) const
+{
+    sealForRead();
+
+    DataLocker lock(this);
+
+    uint64_t sidx = offset + idx;
+
+    if (sidx >= sealedCount()) return false;
+
+    const DataSummaryBlock &summary = blocks[blockForIndex(sidx)].summary;
+
+    // First block has been (partially) clipped
+    if (summary.first_index < offset) return false;
+
+    block = summary;
+
+    block.first_index -= offset;
+    block.last_index -= offset;
+
+    return true;
+}
+
+
+uint64_t CompressedDataSeries::getIndexForTimestamp(double t, SearchDirection direction) const
+{
+    sealForRead();
+
+    DataLocker lock(this);
+
+    uint64_t sidx = storedIndexForTimestamp(t, direction);
+
+    return sidx > offset ? sidx - offset : 0;
+}
@@ -0,0 +1,116 @@
+#ifndef COMPRESSED_DATA_SERIES_HPP
+#define COMPRESSED_DATA_SERIES_HPP
+
+#include "data_series.hpp"
+
+
+/**
+ * @brief The CompressedDataSeries class stores samples using a lossless compressed encoding
+ *
+ * Samples are split into fixed-size blocks of BLOCK_SAMPLES samples:
+ *
+ * - Timestamps are encoded as the delta-of-delta of their IEEE-754 bit patterns,
+ *   so that (near) uniform sample intervals require only a single bit per sample
+ * - Values are XOR encoded against the previous value (Gorilla-style),
+ *   so that repeated or slowly varying values require only a few bits per sample
+ * - Each block has a summary header (first, last, min, max), used for range scans
+ *
+ * New samples are collected in an uncompressed "tail" block, which is encoded once full.
+ * Out-of-order samples are collected in the ingestion buffer, and each affected block is re-encoded
+ * once when the buffer is merged.
+ * Blocks are decoded on demand into contiguous arrays, and the most recently decoded block is cached.
+ */
+class CompressedDataSeries : public DataSeries
+{
+    Q_OBJECT
+
+public:
+    CompressedDataSeries(QString label);
+    CompressedDataSeries(QString group, QString label);
+
+    virtual ~CompressedDataSeries();
+
+    //! Number of samples in each compressed block
+    static const uint64_t BLOCK_SAMPLES = 1024;
+
+    size_t getBlockCount(void) const;
+
+    //! Approximate memory used to store the samples (bytes)
+    size_t getStorageBytes(void) const;
+
+    virtual uint64_t getMemoryUsage(void) const override;
+
+    using DataSeries::addData;
+    virtual void addData(DataPoint point, bool update=true) override;
+    virtual void appendData(const std::vector<DataPoint> &points, bool update=true) override;
+
+    virtual void appendColumns(const double *timestamps, const double *values, uint64_t count, bool update=true) override
+    {
+        appendColumnsAsPoints(timestamps, values, count, update);
+    }
+
+    virtual void clipTimeRange(double t_min, double t_max, bool update=true) override;
+
+    virtual void clearData(bool update=true) override;
+    virtual void truncateData(uint64_t count, bool update=true) override;
+
+    virtual size_t size() const override;
+
+    virtual std::vector<DataPoint> getData() const override;
+
+    virtual uint64_t getIndexForTimestamp(double t, SearchDirection direction=SEARCH_LEFT_TO_RIGHT) const override;
+
+    virtual bool hasSummaryBlocks(void) const override { return true; }
+
+protected:
+    virtual DataPoint getRawDataPoint(uint64_t idx) const override;
+    virtual uint64_t getRawDataPoints(uint64_t idx, uint64_t count, DataPoint *points) const override;
+    virtual bool getRawSummaryBlock(uint64_t idx, DataSummaryBlock &block) const override;
+
+    virtual void mergeSamples(const std::vector<DataPoint> &points) override;
+
+    //! A single block of encoded samples
+    struct EncodedBlock
+    {
+        DataSummaryBlock summary;
+
+        //! Encoded bitstream (excluding the first sample, which is stored in the summary)
+        std::vector<uint64_t> bits;
+
+        uint64_t count(void) const { return summary.last_index - summary.first_index + 1; }
+    };
+
+    static void encodeBlock(const std::vector<DataPoint> &points, uint64_t first_index, EncodedBlock &block);
+    static void decodeBlock(const EncodedBlock &block, double *timestamps, double *values);
+
+    // Note: The following functions must be called with data_mutex held
+    void addSample(const DataPoint &point);
+    void sealTail(void);
+    void decodeToVector(size_t b, std::vector<DataPoint> &points) const;
+    void decodeCached(size_t b) const;
+    void invalidateCache(void) const { cachedBlock = -1; }
+    void truncateStorage(uint64_t n);
+    void discardFront(void);
+
+    uint64_t sealedCount(void) const { return blocks.empty() ? 0 : blocks.back().summary.last_index + 1; }
+    uint64_t storedCount(void) const { return sealedCount() + tail.size(); }
+    size_t blockForIndex(uint64_t sidx) const;
+    DataPoint storedPoint(uint64_t sidx) const;
+    uint64_t storedIndexForTimestamp(double t, SearchDirection direction) const;
+
+    //! Compressed blocks
+    std::vector<EncodedBlock> blocks;
+
+    //! Samples which have not yet been compressed
+    std::vector<DataPoint> tail;
+
+    //! Number of stored samples which have been clipped from the start of the series
+    uint64_t offset = 0;
+
+    //! Most recently decoded block
+    mutable int64_t cachedBlock = -1;
+    mutable std::vector<double> cachedTimestamps;
+    mutable std::vector<double> cachedValues;
+};
+
+#endif // COMPRESSED_DATA_SERIES_HPP
@@ -0,0 +1,159 @@
+#ifndef DATA_BATCH_HPP
+#define DATA_BATCH_HPP
+
+#include <QString>
+#include <QMutex>
+
+#include <vector>
+#include <utility>
+
+#include "data_series.hpp"
+
+
+/**
+ * @brief The DataBatchColumn struct describes a single (value) column of a DataBatch
+ */
+struct DataBatchColumn
+{
+    //! Native type of the source data
+    enum DataType
+    {
+        DTYPE_FLOAT64,
+        DTYPE_FLOAT32,
+    };
+
+    QString label;
+    QString units;
+
+    DataType dtype = DTYPE_FLOAT64;
+
+    // Precision required to store the column values without loss
+    DataSeries::ValuePrecision getPrecision(void) const
+    {
+        return dtype == DTYPE_FLOAT32 ? DataSeries::PRECISION_FLOAT : DataSeries::PRECISION_DOUBLE;
+    }
+};
+
+
+/**
+ * @brief The DataBatchChunk struct contains a contiguous block of samples for every column of a DataBatch
+ */
+struct DataBatchChunk
+{
+    //! Timestamps, shared by all columns in the chunk
+    std::vector<double> timestamps;
+
+    //! One array of values per column (each the same length as the timestamps)
+    //! A NaN value indicates that the column has no sample at that timestamp
+    std::vector<std::vector<double>> values;
+
+    size_t size(void) const { return timestamps.size(); }
+};
+
+
+/**
+ * @brief The DataBatch class allows import plugins to provide data in a columnar format
+ *
+ * - The schema (named columns, with units and data type) is defined first
+ * - Chunks of samples are then added as they are decoded, and are moved (not copied) into the batch
+ * - The core periodically takes the pending chunks, and appends them directly into series storage
+ *
+ * This avoids constructing each sample individually, so plugins for binary formats
+ * (which decode whole blocks at a time) are limited only by memory bandwidth.
+ *
+ * Chunks may be added and taken from different threads.
+ * The schema must not be modified once chunks have been added.
+ */
+class DataBatch
+{
+public:
+    // Add a column to the schema, and return the column index
+    int addColumn(QString label, QString units = QString(), DataBatchColumn::DataType dtype = DataBatchColumn::DTYPE_FLOAT64)
+    {
+        DataBatchColumn column;
+
+        column.label = label;
+        column.units = units;
+        column.dtype = dtype;
+
+        columns.push_back(column);
+
+        return (int) columns.size() - 1;
+    }
+
+    int getColumnCount(void) const { return (int) columns.size(); }
+    const DataBatchColumn &getColumn(int idx) const { return columns.at(idx); }
+
+    // Add a chunk of samples (the chunk is moved into the batch)
+    // Returns false if the chunk does not match the schema
+    bool addChunk(DataBatchChunk &&chunk)
+    {
+        if (chunk.values.size() != columns.size()) return false;
+
+        for (const auto &values : chunk.values)
+        {
+            if (values.size() != chunk.timestamps.size()) return false;
+        }
+
+        if (chunk.timestamps.empty()) return true;
+
+        QMutexLocker lock(&mutex);
+
+        pendingSamples += chunk.timestamps.size();
+        chunks.push_back(std::move(chunk));
+
+        return true;
+    }
+
+    // Convenience function for building a chunk from separate arrays
+    bool addChunk(std::vector<double> &&timestamps, std::vector<std::vector<double>> &&values)
+    {
+        DataBatchChunk chunk;
+
+        chunk.timestamps = std::move(timestamps);
+        chunk.values = std::move(values);
+
+        return addChunk(std::move(chunk));
+    }
+
+    // Remove (and return) all pending chunks
+    std::vector<DataBatchChunk> takeChunks(void)
+    {
+        QMutexLocker lock(&mutex);
+
+        std::vector<DataBatchChunk> taken;
+
+        taken.swap(chunks);
+        pendingSamples = 0;
+
+        return taken;
+    }
+
+    //! Number of samples (rows) which have been added but not yet taken
+    uint64_t getPendingSamples(void) const
+    {
+        QMutexLocker lock(&mutex);
+        return pendingSamples;
+    }
+
+    // Remove the schema and any pending chunks
+    void clear(void)
+    {
+        QMutexLocker lock(&mutex);
+
+        columns.clear();
+        chunks.clear();
+        pendingSamples = 0;
+    }
+
+protected:
+    std::vector<DataBatchColumn> columns;
+
+    std::vector<DataBatchChunk> chunks;
+    uint64_t pendingSamples = 0;
+
+    mutable QMutex mutex;
+};
+
+
+#endif // DATA_BATCH_HPP
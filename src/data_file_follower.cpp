@@ -0,0 +1,177 @@
+#include <QFileInfo>
+
+#include "data_file_follower.hpp"
+#include "lumberjack_settings.hpp"
+
+
+DataFileFollower::DataFileFollower(QSharedPointer<ImportPlugin> plugin, DataSourcePointer source) :
+    m_plugin(plugin),
+    m_source(source)
+{
+    if (!m_plugin.isNull())
+    {
+        m_filename = m_plugin->getFilename();
+    }
+
+    auto *settings = LumberjackSettings::getInstance();
+
+    int interval = settings->loadSetting("import", "followInterval", 100).toInt();
+
+    m_refreshTimer.setSingleShot(true);
+    m_refreshTimer.setInterval(qMax(0, interval));
+
+    connect(&m_watcher, &QFileSystemWatcher::fileChanged, this, &DataFileFollower::onFileChanged);
+    connect(&m_refreshTimer, &QTimer::timeout, this, &DataFileFollower::refresh);
+}
+
+
+DataFileFollower::~DataFileFollower()
+{
+    setActive(false);
+}
+
+
+/**
+ * @brief DataFileFollower::setActive - Start (or stop) following the file
+ * @param active
+ */
+void DataFileFollower::setActive(bool active)
+{
+    if (active == m_active) return;
+
+    if (active)
+    {
+        if (m_plugin.isNull() || m_source.isNull() || !m_plugin->supportsFollow()) return;
+
+        if (!m_watcher.addPath(m_filename))
+        {
+            qWarning() << "Could not watch file:" << m_filename;
+            return;
+        }
+
+        m_active = true;
+
+        qDebug() << "Following file:" << m_filename;
+
+        // Catch up with any data written since the file was imported
+        refresh();
+    }
+    else
+    {
+        m_refreshTimer.stop();
+
+        m_refreshPending = false;
+
+        if (!m_job.isNull())
+        {
+            m_job->cancel();
+        }
+
+        if (!m_watcher.files().isEmpty())
+        {
+            m_watcher.removePaths(m_watcher.files());
+        }
+
+        m_active = false;
+    }
+}
+
+
+void DataFileFollower::onFileChanged(const QString &path)
+{
+    Q_UNUSED(path);
+
+    // Some editors (and log rotation) replace the file, which removes it from the watcher
+    if (m_active && !m_watcher.files().contains(m_filename) && QFileInfo::exists(m_filename))
+    {
+        m_watcher.addPath(m_filename);
+    }
+
+    if (m_active && !m_refreshTimer.isActive())
+    {
+        m_refreshTimer.start();
+    }
+}
+
+
+/**
+ * @brief DataFileFollower::refresh - Import any data appended to the file (in a background thread)
+ * @return false if the file is not being followed
+ */
+bool DataFileFollower::refresh()
+{
+    if (!m_active) return false;
+
+    // Only one read runs at a time, and the file is read again once it completes
+    if (!m_job.isNull() && !m_job->isFinished())
+    {
+        m_refreshPending = true;
+        return true;
+    }
+
+    m_refreshPending = false;
+
+    m_job = DataIOJobPointer(new DataFollowJob(m_plugin, m_filename), &QObject::deleteLater);
+
+    connect(m_job.data(), &DataIOJob::finished, this, &DataFileFollower::onFollowFinished);
+
+    m_job->start();
+
+    return true;
+}
+
+
+void DataFileFollower::onFollowFinished(bool result)
+{
+    if (!m_active || m_job.isNull()) return;
+
+    // Following was stopped (and restarted) while the file was being read
+    if (m_job->getState() == DataIOJob::JOB_CANCELLED)
+    {
+        if (m_refreshPending) refresh();
+
+        return;
+    }
+
+    for (QString err : m_job->getErrors())
+    {
+        qWarning() << "Follow err:" << err;
+    }
+
+    // Add any series which have been created since the last refresh
+    for (auto series : m_plugin->getDataSeries())
+    {
+        if (series.isNull()) continue;
+
+        if (m_source->getSeriesByLabel(series->getLabel()).isNull())
+        {
+            m_source->addSeries(series);
+        }
+    }
+
+    // Signal a single update for each series which received new data
+    for (int idx = 0; idx < m_source->getSeriesCount(); idx++)
+    {
+        auto series = m_source->getSeriesByIndex(idx);
+
+        if (!series.isNull())
+        {
+            series->flushUpdate();
+        }
+    }
+
+    if (!result)
+    {
+        qWarning() << "Stopped following file:" << m_filename;
+
+        setActive(false);
+        emit followStopped();
+
+        return;
+    }
+
+    if (m_refreshPending)
+    {
+        refresh();
+    }
+}
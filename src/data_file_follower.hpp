@@ -0,0 +1,70 @@
+#ifndef DATA_FILE_FOLLOWER_HPP
+#define DATA_FILE_FOLLOWER_HPP
+
+#include <QFileSystemWatcher>
+#include <QTimer>
+
+#include "data_io_job.hpp"
+#include "data_source.hpp"
+#include "plugin_importer.hpp"
+
+
+/**
+ * @brief The DataFileFollower class keeps an imported DataSource up to date with a growing file
+ *
+ * - Watches the source file for changes
+ * - Asks the importer (which must support "follow" mode) to read only the appended data,
+ *   in a background thread (see DataFollowJob)
+ * - Emits a single dataUpdated() signal for each series after new data are appended
+ */
+class DataFileFollower : public QObject
+{
+    Q_OBJECT
+
+public:
+    DataFileFollower(QSharedPointer<ImportPlugin> plugin, DataSourcePointer source);
+    virtual ~DataFileFollower();
+
+    QSharedPointer<ImportPlugin> getPlugin(void) const { return m_plugin; }
+    DataSourcePointer getSource(void) const { return m_source; }
+
+    QString getFilename(void) const { return m_filename; }
+
+    bool isActive(void) const { return m_active; }
+
+public slots:
+    void setActive(bool active);
+    bool refresh(void);
+
+signals:
+    // Emitted if the file can no longer be followed (e.g. it was deleted or truncated)
+    void followStopped(void);
+
+protected slots:
+    void onFileChanged(const QString &path);
+    void onFollowFinished(bool result);
+
+protected:
+    QSharedPointer<ImportPlugin> m_plugin;
+    DataSourcePointer m_source;
+
+    QString m_filename;
+
+    bool m_active = false;
+
+    QFileSystemWatcher m_watcher;
+
+    //! Coalesces rapid file change notifications into a single refresh
+    QTimer m_refreshTimer;
+
+    //! Most recent read of the file
+    DataIOJobPointer m_job;
+
+    //! The file changed while it was being read, so must be read again
+    bool m_refreshPending = false;
+};
+
+typedef QSharedPointer<DataFileFollower> DataFileFollowerPointer;
+
+
+#endif // DATA_FILE_FOLLOWER_HPP
@@ -0,0 +1,326 @@
+#include <QApplication>
+#include <QFileInfo>
+#include <QThread>
+
+#include "data_import_scheduler.hpp"
+#include "data_source_manager.hpp"
+#include "lumberjack_settings.hpp"
+
+
+DataImportScheduler::DataImportScheduler(DataSourceManager *manager) :
+    QObject(manager),
+    m_manager(manager)
+{
+}
+
+
+DataImportScheduler::~DataImportScheduler()
+{
+    if (m_progressDialog)
+    {
+        delete m_progressDialog;
+    }
+}
+
+
+/**
+ * @brief DataImportScheduler::getMaxConcurrentJobs - Maximum number of files imported in parallel
+ *
+ * By default this is the number of available cores, limited so that
+ * a large batch of files does not saturate the disk with parallel reads.
+ */
+int DataImportScheduler::getMaxConcurrentJobs() const
+{
+    auto *settings = LumberjackSettings::getInstance();
+
+    int jobs = settings->loadSetting("import", "maxConcurrentJobs", 0).toInt();
+
+    if (jobs <= 0)
+    {
+        jobs = qBound(1, QThread::idealThreadCount(), 8);
+    }
+
+    return jobs;
+}
+
+
+int DataImportScheduler::getProgress() const
+{
+    if (m_total <= 0) return 0;
+
+    int progress = (m_succeeded + m_failed) * 100;
+
+    for (auto job : m_running)
+    {
+        progress += job->getProgress();
+    }
+
+    return progress / m_total;
+}
+
+
+/**
+ * @brief DataImportScheduler::addFiles - Queue files for import
+ *
+ * Files may be added while a batch is already running, and are appended to that batch.
+ */
+void DataImportScheduler::addFiles(QStringList filenames)
+{
+    int added = 0;
+
+    for (QString filename : filenames)
+    {
+        if (filename.isEmpty() || m_queue.contains(filename)) continue;
+
+        if (!QFileInfo::exists(filename))
+        {
+            qCritical() << "File does not exist:" << filename;
+            continue;
+        }
+
+        m_queue.append(filename);
+        added++;
+    }
+
+    if (added == 0) return;
+
+    m_total += added;
+
+    showProgress();
+    schedule();
+}
+
+
+/**
+ * @brief DataImportScheduler::cancel - Cancel all queued and running imports
+ */
+void DataImportScheduler::cancel()
+{
+    m_failed += m_queue.count();
+    m_queue.clear();
+
+    // Running jobs finish (with a false result) once their plugin has stopped
+    for (auto job : m_running)
+    {
+        job->cancel();
+    }
+
+    if (m_running.isEmpty())
+    {
+        finishBatch();
+    }
+}
+
+
+/**
+ * @brief DataImportScheduler::schedule - Start queued imports, while job slots and plugins are available
+ */
+void DataImportScheduler::schedule()
+{
+    if (m_scheduling)
+    {
+        m_rescheduleRequested = true;
+        return;
+    }
+
+    m_scheduling = true;
+
+    do
+    {
+        m_rescheduleRequested = false;
+
+        int idx = 0;
+
+        while (idx < m_queue.count() && m_running.count() < getMaxConcurrentJobs())
+        {
+            QString filename = m_queue.at(idx);
+
+            if (!m_manager->isImporterAvailable(filename))
+            {
+                // Wait for the plugin to become available
+                idx++;
+                continue;
+            }
+
+            m_queue.removeAt(idx);
+
+            auto importer = m_manager->getImporterForFile(filename);
+
+            // Configure each plugin once per batch
+            bool configure = importer.isNull() || !m_configured.contains(importer->pluginName());
+
+            QStringList errors;
+
+            bool cancelled = false;
+
+            DataIOJobPointer job = m_manager->createImportJob(filename, configure, errors, &cancelled);
+
+            for (QString err : errors)
+            {
+                qWarning() << "Import err:" << err;
+            }
+
+            if (job.isNull())
+            {
+                m_failed++;
+                emit fileImported(filename, false);
+
+                // The user declined to configure the plugin, so its remaining files are not imported
+                // (rather than prompting again for each file)
+                if (cancelled && !importer.isNull())
+                {
+                    cancelQueuedFiles(importer->pluginName());
+
+                    // Files before idx may also have been removed
+                    idx = 0;
+                }
+
+                continue;
+            }
+
+            if (configure)
+            {
+                m_configured.insert(importer->pluginName());
+            }
+
+            connect(job.data(), &DataIOJob::finished, this, &DataImportScheduler::onJobFinished);
+            connect(job.data(), &DataIOJob::progressChanged, this, &DataImportScheduler::updateProgress);
+
+            m_running.append(job);
+
+            job->start();
+        }
+    }
+    while (m_rescheduleRequested);
+
+    m_scheduling = false;
+
+    updateProgress();
+
+    if (m_queue.isEmpty() && m_running.isEmpty())
+    {
+        finishBatch();
+    }
+}
+
+
+void DataImportScheduler::cancelQueuedFiles(QString pluginName)
+{
+    int idx = 0;
+
+    while (idx < m_queue.count())
+    {
+        QString filename = m_queue.at(idx);
+
+        auto importer = m_manager->getImporterForFile(filename);
+
+        if (importer.isNull() || importer->pluginName() != pluginName)
+        {
+            idx++;
+            continue;
+        }
+
+        m_queue.removeAt(idx);
+
+        qInfo() << "Import cancelled:" << filename;
+
+        m_failed++;
+        emit fileImported(filename, false);
+    }
+}
+
+
+void DataImportScheduler::onJobFinished(bool result)
+{
+    DataIOJob *job = qobject_cast<DataIOJob*>(sender());
+
+    if (!job) return;
+
+    for (int idx = 0; idx < m_running.count(); idx++)
+    {
+        if (m_running.at(idx).data() == job)
+        {
+            m_running.removeAt(idx);
+            break;
+        }
+    }
+
+    if (result)
+    {
+        m_succeeded++;
+    }
+    else
+    {
+        m_failed++;
+    }
+
+    emit fileImported(job->getFilename(), result);
+
+    // A plugin (and a job slot) is now available
+    schedule();
+}
+
+
+void DataImportScheduler::updateProgress()
+{
+    int progress = getProgress();
+
+    if (m_progressDialog)
+    {
+        m_progressDialog->setLabelText(tr("Importing files") + QString(" (%1 / %2)").arg(m_succeeded + m_failed).arg(m_total));
+        m_progressDialog->setValue(progress);
+    }
+
+    emit progressChanged(progress);
+}
+
+
+/*
+ * Display a (non-modal) progress dialog for the batch.
+ * The dialog is only shown if the batch takes a noticeable amount of time.
+ */
+void DataImportScheduler::showProgress()
+{
+    // No progress display in headless mode
+    if (!qobject_cast<QApplication*>(QCoreApplication::instance())) return;
+
+    if (m_progressDialog) return;
+
+    m_progressDialog = new QProgressDialog();
+
+    m_progressDialog->setWindowTitle(tr("Importing Data"));
+    m_progressDialog->setMinimum(0);
+    m_progressDialog->setMaximum(100);
+    m_progressDialog->setMinimumDuration(500);
+    m_progressDialog->setAutoClose(false);
+    m_progressDialog->setAutoReset(false);
+    m_progressDialog->setValue(0);
+
+    connect(m_progressDialog.data(), &QProgressDialog::canceled, this, &DataImportScheduler::cancel);
+}
+
+
+void DataImportScheduler::finishBatch()
+{
+    if (m_total > 0)
+    {
+        qInfo() << "Imported" << m_succeeded << "of" << m_total << "files";
+
+        emit batchFinished(m_succeeded, m_failed);
+    }
+
+    m_total = 0;
+    m_succeeded = 0;
+    m_failed = 0;
+
+    m_configured.clear();
+
+    if (m_progressDialog)
+    {
+        // Prevent the "canceled" signal (emitted on close) from re-entering cancel()
+        m_progressDialog->disconnect(this);
+        m_progressDialog->close();
+        m_progressDialog->deleteLater();
+        m_progressDialog = nullptr;
+    }
+}
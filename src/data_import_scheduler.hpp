@@ -0,0 +1,90 @@
+#ifndef DATA_IMPORT_SCHEDULER_HPP
+#define DATA_IMPORT_SCHEDULER_HPP
+
+#include <QObject>
+#include <QPointer>
+#include <QProgressDialog>
+#include <QSet>
+
+#include "data_io_job.hpp"
+
+
+class DataSourceManager;
+
+
+/**
+ * @brief The DataImportScheduler class imports multiple files concurrently
+ *
+ * - Files are queued, and imported by up to getMaxConcurrentJobs() jobs in parallel
+ * - Each job uses its own plugin instance (ImportPlugin::createInstance), where supported;
+ *   files for plugins which cannot be instantiated wait until the shared plugin is available
+ * - Each plugin is configured (interactively) once per batch, and the same options
+ *   are used for all subsequent files in the batch
+ * - If the user cancels the configuration of a plugin, the queued files for that plugin are not imported
+ * - Sources are added to the DataSourceManager as each file finishes
+ * - A single (combined) progress display is shown for the whole batch
+ */
+class DataImportScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    DataImportScheduler(DataSourceManager *manager);
+    virtual ~DataImportScheduler();
+
+    int getMaxConcurrentJobs(void) const;
+
+    int getQueuedCount(void) const { return m_queue.count(); }
+    int getRunningCount(void) const { return m_running.count(); }
+
+    bool isBusy(void) const { return m_queue.count() > 0 || m_running.count() > 0; }
+
+    // Combined progress (0-100) of the current batch
+    int getProgress(void) const;
+
+public slots:
+    void addFiles(QStringList filenames);
+    void cancel(void);
+
+signals:
+    void progressChanged(int progress);
+    void fileImported(QString filename, bool result);
+    void batchFinished(int succeeded, int failed);
+
+protected slots:
+    void schedule(void);
+    void onJobFinished(bool result);
+    void updateProgress(void);
+
+protected:
+    DataSourceManager *m_manager = nullptr;
+
+    //! Files waiting to be imported
+    QStringList m_queue;
+
+    //! Jobs which are currently running
+    QList<DataIOJobPointer> m_running;
+
+    //! Plugins which have been configured for the current batch
+    QSet<QString> m_configured;
+
+    //! Progress of the current batch
+    int m_total = 0;
+    int m_succeeded = 0;
+    int m_failed = 0;
+
+    //! Guard against re-entrant scheduling (e.g. from within a modal options dialog)
+    bool m_scheduling = false;
+    bool m_rescheduleRequested = false;
+
+    QPointer<QProgressDialog> m_progressDialog;
+
+    void showProgress(void);
+    void finishBatch(void);
+
+    // Remove the queued files which would be imported by the named plugin
+    void cancelQueuedFiles(QString pluginName);
+};
+
+
+#endif // DATA_IMPORT_SCHEDULER_HPP
@@ -0,0 +1,448 @@
+#include <QFileInfo>
+
+#include "data_io_job.hpp"
+#include "lumberjack_settings.hpp"
+#include "performance_monitor.hpp"
+
+
+DataImportWorker::DataImportWorker(QSharedPointer<ImportPlugin> plugin) : m_plugin(plugin)
+{
+}
+
+
+void DataImportWorker::run()
+{
+    m_errors.clear();
+
+    if (m_plugin)
+    {
+        m_result = m_plugin->importData(m_errors);
+
+        // Merge any out-of-order samples here, rather than when the series is first read
+        for (auto series : m_plugin->getDataSeries())
+        {
+            if (series) series->seal();
+        }
+    }
+    else
+    {
+        m_result = false;
+    }
+
+    if (m_cancelled)
+    {
+        m_errors.append(tr("Import process cancelled"));
+        m_result = false;
+    }
+
+    m_complete = true;
+
+    emit completed();
+}
+
+
+/*
+ * Request cancellation (called from the owning thread, while the import is running)
+ */
+void DataImportWorker::cancel()
+{
+    m_cancelled = true;
+
+    if (m_plugin)
+    {
+        m_plugin->cancelImport();
+    }
+}
+
+
+DataFollowWorker::DataFollowWorker(QSharedPointer<ImportPlugin> plugin) : DataImportWorker(plugin)
+{
+}
+
+
+void DataFollowWorker::run()
+{
+    m_errors.clear();
+
+    if (m_plugin)
+    {
+        m_result = m_plugin->followData(m_errors);
+
+        for (auto series : m_plugin->getDataSeries())
+        {
+            if (series) series->seal();
+        }
+    }
+    else
+    {
+        m_result = false;
+    }
+
+    if (m_cancelled)
+    {
+        m_result = false;
+    }
+
+    m_complete = true;
+
+    emit completed();
+}
+
+
+DataExportWorker::DataExportWorker(QSharedPointer<ExportPlugin> plugin, QList<DataSeriesPointer> &series)
+    : m_plugin(plugin), m_series(series)
+{
+}
+
+
+void DataExportWorker::run()
+{
+    m_errors.clear();
+
+    if (m_plugin)
+    {
+        m_result = m_plugin->exportData(m_series, m_errors);
+    }
+    else
+    {
+        m_result = false;
+    }
+
+    if (m_cancelled)
+    {
+        m_errors.append(tr("Export process cancelled"));
+        m_result = false;
+    }
+
+    m_complete = true;
+
+    emit completed();
+}
+
+
+/*
+ * Request cancellation (called from the owning thread, while the export is running)
+ */
+void DataExportWorker::cancel()
+{
+    m_cancelled = true;
+
+    if (m_plugin)
+    {
+        m_plugin->cancelExport();
+    }
+}
+
+
+DataIOJob::DataIOJob(QString filename) : m_filename(filename)
+{
+    m_progressTimer.setInterval(PROGRESS_INTERVAL);
+
+    connect(&m_progressTimer, &QTimer::timeout, this, &DataIOJob::updateProgress);
+}
+
+
+DataIOJob::~DataIOJob()
+{
+    if (m_thread.isRunning())
+    {
+        m_worker->cancel();
+        m_thread.wait();
+    }
+
+    if (m_worker)
+    {
+        delete m_worker;
+        m_worker = nullptr;
+    }
+}
+
+
+/**
+ * @brief DataIOJob::start - Start the operation in a background thread, and return immediately
+ */
+void DataIOJob::start()
+{
+    if (m_state != JOB_PENDING) return;
+
+    m_worker = createWorker();
+    m_worker->moveToThread(&m_thread);
+
+    connect(&m_thread, &QThread::started, m_worker, &DataIOWorker::run);
+    connect(m_worker, &DataIOWorker::completed, &m_thread, &QThread::quit);
+
+    // QThread::finished is emitted from the worker thread, and is queued to this object
+    connect(&m_thread, &QThread::finished, this, &DataIOJob::onThreadFinished);
+
+    m_state = JOB_RUNNING;
+
+    m_thread.start();
+    m_progressTimer.start();
+
+    emit started();
+}
+
+
+/**
+ * @brief DataIOJob::cancel - Request cancellation of the job
+ *
+ * A running job finishes (with a false result) once the plugin has stopped.
+ */
+void DataIOJob::cancel()
+{
+    switch (m_state)
+    {
+    case JOB_PENDING:
+        m_state = JOB_CANCELLED;
+        m_errors.append(tr("Cancelled"));
+        emit finished(false);
+        break;
+    case JOB_RUNNING:
+        m_worker->cancel();
+        break;
+    default:
+        break;
+    }
+}
+
+
+void DataIOJob::onThreadFinished()
+{
+    m_progressTimer.stop();
+
+    // The worker thread has exited, so its results can be read safely
+    m_result = m_worker->getResult();
+    m_errors = m_worker->getErrors();
+
+    if (m_worker->isCancelled())
+    {
+        m_state = JOB_CANCELLED;
+    }
+    else if (m_result)
+    {
+        m_state = JOB_FINISHED;
+        m_progress = 100;
+        emit progressChanged(m_progress);
+    }
+    else
+    {
+        m_state = JOB_FAILED;
+    }
+
+    delete m_worker;
+    m_worker = nullptr;
+
+    if (m_errors.count() > 0)
+    {
+        emit errorsReported(m_errors);
+    }
+
+    emit finished(m_result);
+}
+
+
+void DataIOJob::updateProgress()
+{
+    if (m_state != JOB_RUNNING) return;
+
+    int progress = qBound(0, getOperationProgress(), 100);
+
+    if (progress != m_progress)
+    {
+        m_progress = progress;
+        emit progressChanged(m_progress);
+    }
+}
+
+
+DataImportJob::DataImportJob(QSharedPointer<ImportPlugin> plugin, QString filename) :
+    DataIOJob(filename),
+    m_plugin(plugin)
+{
+    auto settings = LumberjackSettings::getInstance();
+
+    m_updateTimer.setInterval(settings->loadSetting("import", "updateInterval", UPDATE_INTERVAL).toInt());
+
+    connect(&m_updateTimer, &QTimer::timeout, this, &DataImportJob::updateSeries);
+
+    connect(this, &DataIOJob::started, this, &DataImportJob::onStarted);
+    connect(this, &DataIOJob::finished, this, &DataImportJob::onFinished);
+
+    if (m_plugin)
+    {
+        // Series are published from the import thread
+        connect(m_plugin.data(), &ImportPlugin::seriesCreated, this, &DataImportJob::onSeriesCreated, Qt::QueuedConnection);
+    }
+}
+
+
+void DataImportJob::onSeriesCreated(DataSeriesPointer series)
+{
+    if (series.isNull() || m_published.contains(series)) return;
+
+    // Series are forwarded at the next update, so that many columns can be added at once
+    m_published.append(series);
+    m_pending.append(series);
+}
+
+
+void DataImportJob::onStarted()
+{
+    m_startTime = PerformanceMonitor::now();
+
+    m_updateTimer.start();
+}
+
+
+void DataImportJob::onFinished()
+{
+    m_updateTimer.stop();
+
+    // Series published just before the import completed may still be queued
+    QCoreApplication::sendPostedEvents(this, QEvent::MetaCall);
+
+    updateSeries();
+
+    if (m_result)
+    {
+        recordPerformance();
+        reportDisorder();
+    }
+}
+
+
+void DataImportJob::recordPerformance()
+{
+    int64_t duration = PerformanceMonitor::now() - m_startTime;
+
+    if (duration <= 0 || m_plugin.isNull()) return;
+
+    QString filename = QFileInfo(m_filename).fileName();
+
+    // Each series has (at most) one sample per row
+    uint64_t rows = 0;
+
+    for (auto series : m_plugin->getDataSeries())
+    {
+        rows = std::max<uint64_t>(rows, series->size());
+    }
+
+    double seconds = duration / 1e9;
+    double megabytes = QFileInfo(m_filename).size() / (1024.0 * 1024.0);
+
+    auto *monitor = PerformanceMonitor::getInstance();
+
+    monitor->recordSpan("Import/File", filename, m_startTime, duration);
+    monitor->recordCounter("Import/Throughput (MB/s)", filename, megabytes / seconds);
+    monitor->recordCounter("Import/Throughput (rows/s)", filename, rows / seconds);
+}
+
+
+/*
+ * Report (once per file) how many samples were received out of time order
+ */
+void DataImportJob::reportDisorder()
+{
+    if (m_plugin.isNull()) return;
+
+    uint64_t samples = 0;
+    uint64_t late = 0;
+    double lateness = 0;
+
+    for (auto series : m_plugin->getDataSeries())
+    {
+        if (series.isNull()) continue;
+
+        samples += series->size();
+        late += series->getOutOfOrderCount();
+        lateness = std::max(lateness, series->getMaximumLateness());
+    }
+
+    if (late == 0 || samples == 0) return;
+
+    QString filename = QFileInfo(m_filename).fileName();
+
+    double percent = 100.0 * late / samples;
+
+    qInfo().noquote() << QString("%1: %2 of %3 samples out of order (%4%), up to %5 ms late")
+                         .arg(filename)
+                         .arg(late)
+                         .arg(samples)
+                         .arg(percent, 0, 'f', 2)
+                         .arg(lateness, 0, 'g', 6);
+
+    PerformanceMonitor::getInstance()->recordCounter("Import/Out-of-order (%)", filename, percent);
+}
+
+
+/*
+ * Forward newly published series, and emit (throttled) update signals for the data appended so far.
+ * The plugin appends data without emitting updates, so that the import thread is never blocked by the GUI.
+ */
+void DataImportJob::updateSeries()
+{
+    if (m_pending.count() > 0)
+    {
+        QList<DataSeriesPointer> pending;
+
+        pending.swap(m_pending);
+
+        emit seriesPublished(pending);
+    }
+
+    for (auto series : m_published)
+    {
+        series->flushUpdate();
+    }
+}
+
+
+DataIOWorker *DataImportJob::createWorker()
+{
+    return new DataImportWorker(m_plugin);
+}
+
+
+int DataImportJob::getOperationProgress() const
+{
+    return m_plugin.isNull() ? 0 : m_plugin->getImportProgress();
+}
+
+
+DataFollowJob::DataFollowJob(QSharedPointer<ImportPlugin> plugin, QString filename) :
+    DataIOJob(filename),
+    m_plugin(plugin)
+{
+}
+
+
+DataIOWorker *DataFollowJob::createWorker()
+{
+    return new DataFollowWorker(m_plugin);
+}
+
+
+int DataFollowJob::getOperationProgress() const
+{
+    return m_plugin.isNull() ? 0 : m_plugin->getImportProgress();
+}
+
+
+DataExportJob::DataExportJob(QSharedPointer<ExportPlugin> plugin, QList<DataSeriesPointer> &series, QString filename) :
+    DataIOJob(filename),
+    m_plugin(plugin),
+    m_series(series)
+{
+}
+
+
+DataIOWorker *DataExportJob::createWorker()
+{
+    return new DataExportWorker(m_plugin, m_series);
+}
+
+
+int DataExportJob::getOperationProgress() const
+{
+    return m_plugin.isNull() ? 0 : m_plugin->getExportProgress();
+}
@@ -0,0 +1,293 @@
+#ifndef DATA_IO_JOB_HPP
+#define DATA_IO_JOB_HPP
+
+#include <QThread>
+#include <QTimer>
+
+#include <atomic>
+
+#include "plugin_importer.hpp"
+#include "plugin_exporter.hpp"
+#include "data_source.hpp"
+
+
+/**
+ * @brief The DataIOWorker class runs a single import or export operation in a background thread
+ */
+class DataIOWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    bool getResult(void) const { return m_result; }
+    QStringList getErrors(void) const { return m_errors; }
+    bool isComplete(void) const { return m_complete; }
+    bool isCancelled(void) const { return m_cancelled; }
+
+public slots:
+    virtual void run(void) = 0;
+    virtual void cancel(void) = 0;
+
+signals:
+    void completed(void);
+
+protected:
+    // Note: These are only accessed by the worker thread (until the thread has finished)
+    QStringList m_errors;
+    bool m_result = false;
+
+    std::atomic<bool> m_complete {false};
+    std::atomic<bool> m_cancelled {false};
+};
+
+
+/**
+ * @brief The DataImportWorker class runs a data import session
+ */
+class DataImportWorker : public DataIOWorker
+{
+    Q_OBJECT
+
+public:
+    DataImportWorker(QSharedPointer<ImportPlugin> plugin);
+
+public slots:
+    virtual void run(void) override;
+    virtual void cancel(void) override;
+
+protected:
+    QSharedPointer<ImportPlugin> m_plugin;
+};
+
+
+/**
+ * @brief The DataFollowWorker class imports the data appended to a followed file
+ */
+class DataFollowWorker : public DataImportWorker
+{
+    Q_OBJECT
+
+public:
+    DataFollowWorker(QSharedPointer<ImportPlugin> plugin);
+
+public slots:
+    virtual void run(void) override;
+};
+
+
+/**
+ * @brief The DataExportWorker class runs a data export session
+ */
+class DataExportWorker : public DataIOWorker
+{
+    Q_OBJECT
+
+public:
+    DataExportWorker(QSharedPointer<ExportPlugin> plugin, QList<DataSeriesPointer> &series);
+
+public slots:
+    virtual void run(void) override;
+    virtual void cancel(void) override;
+
+protected:
+    QSharedPointer<ExportPlugin> m_plugin;
+    QList<DataSeriesPointer> m_series;
+};
+
+
+/**
+ * @brief The DataIOJob class manages a single asynchronous import or export operation
+ *
+ * - The operation is run by a DataIOWorker in a dedicated thread
+ * - Progress, errors and completion are reported via signals (in the thread which owns the job)
+ * - Completion is signalled as soon as the worker thread finishes (no polling)
+ *
+ * The caller must not block waiting for the job; connect to the finished() signal instead.
+ */
+class DataIOJob : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum JobState
+    {
+        JOB_PENDING,
+        JOB_RUNNING,
+        JOB_FINISHED,
+        JOB_FAILED,
+        JOB_CANCELLED,
+    };
+
+    DataIOJob(QString filename);
+    virtual ~DataIOJob();
+
+    QString getFilename(void) const { return m_filename; }
+
+    JobState getState(void) const { return m_state; }
+
+    bool isRunning(void) const { return m_state == JOB_RUNNING; }
+    bool isFinished(void) const { return m_state >= JOB_FINISHED; }
+
+    bool getResult(void) const { return m_result; }
+    QStringList getErrors(void) const { return m_errors; }
+
+    int getProgress(void) const { return m_progress; }
+
+    // Return the plugin used by this job
+    virtual const PluginBase *getPluginBase(void) const = 0;
+
+    // Block until the worker thread has finished (only intended for application shutdown)
+    void wait(void) { m_thread.wait(); }
+
+    //! Interval for sampling plugin progress (ms)
+    static const int PROGRESS_INTERVAL = 50;
+
+public slots:
+    void start(void);
+    void cancel(void);
+
+signals:
+    void started(void);
+    void progressChanged(int progress);
+    void errorsReported(QStringList errors);
+    void finished(bool result);
+
+protected slots:
+    void onThreadFinished(void);
+    void updateProgress(void);
+
+protected:
+    virtual DataIOWorker *createWorker(void) = 0;
+
+    // Return current progress (0-100) of the running operation
+    virtual int getOperationProgress(void) const = 0;
+
+    QString m_filename;
+
+    JobState m_state = JOB_PENDING;
+
+    bool m_result = false;
+    QStringList m_errors;
+
+    int m_progress = 0;
+
+    DataIOWorker *m_worker = nullptr;
+    QThread m_thread;
+
+    QTimer m_progressTimer;
+};
+
+typedef QSharedPointer<DataIOJob> DataIOJobPointer;
+
+
+/**
+ * @brief The DataImportJob class imports data from a file using the provided plugin
+ *
+ * The plugin must already be configured (filename, options) before the job is started.
+ *
+ * Series which the plugin publishes during the import (see ImportPlugin::publishSeries)
+ * are forwarded (in batches) via seriesPublished(), and their update signals are emitted
+ * periodically while the import runs, so that the data can be displayed progressively.
+ */
+class DataImportJob : public DataIOJob
+{
+    Q_OBJECT
+
+public:
+    DataImportJob(QSharedPointer<ImportPlugin> plugin, QString filename);
+
+    QSharedPointer<ImportPlugin> getPlugin(void) const { return m_plugin; }
+    virtual const PluginBase *getPluginBase(void) const override { return m_plugin.data(); }
+
+    // Series published so far
+    QList<DataSeriesPointer> getPublishedSeries(void) const { return m_published; }
+
+    // Source which displays the published series (created when the first series is published)
+    DataSourcePointer getSource(void) const { return m_source; }
+    void setSource(DataSourcePointer source) { m_source = source; }
+
+    //! Default interval for updating published series (ms)
+    static const int UPDATE_INTERVAL = 250;
+
+signals:
+    void seriesPublished(QList<DataSeriesPointer> series);
+
+protected slots:
+    void onSeriesCreated(DataSeriesPointer series);
+    void onStarted(void);
+    void onFinished(void);
+    void updateSeries(void);
+
+protected:
+    virtual DataIOWorker *createWorker(void) override;
+    virtual int getOperationProgress(void) const override;
+
+    // Record the duration and throughput of a completed import
+    void recordPerformance(void);
+
+    // Report the number of samples which were imported out of time order
+    void reportDisorder(void);
+
+    QSharedPointer<ImportPlugin> m_plugin;
+
+    //! Start time of the import (see PerformanceMonitor::now)
+    int64_t m_startTime = 0;
+
+    //! Series which have been published, and those not yet forwarded
+    QList<DataSeriesPointer> m_published;
+    QList<DataSeriesPointer> m_pending;
+
+    DataSourcePointer m_source;
+
+    QTimer m_updateTimer;
+};
+
+
+/**
+ * @brief The DataFollowJob class reads the data appended to a previously imported file
+ *
+ * The plugin must support "follow" mode (see ImportPlugin::followData).
+ * New samples are appended to the existing series, without emitting update signals.
+ * The job returns false if the file can no longer be followed.
+ */
+class DataFollowJob : public DataIOJob
+{
+    Q_OBJECT
+
+public:
+    DataFollowJob(QSharedPointer<ImportPlugin> plugin, QString filename);
+
+    QSharedPointer<ImportPlugin> getPlugin(void) const { return m_plugin; }
+    virtual const PluginBase *getPluginBase(void) const override { return m_plugin.data(); }
+
+protected:
+    virtual DataIOWorker *createWorker(void) override;
+    virtual int getOperationProgress(void) const override;
+
+    QSharedPointer<ImportPlugin> m_plugin;
+};
+
+
+/**
+ * @brief The DataExportJob class exports a set of series to a file using the provided plugin
+ */
+class DataExportJob : public DataIOJob
+{
+    Q_OBJECT
+
+public:
+    DataExportJob(QSharedPointer<ExportPlugin> plugin, QList<DataSeriesPointer> &series, QString filename);
+
+    QSharedPointer<ExportPlugin> getPlugin(void) const { return m_plugin; }
+    virtual const PluginBase *getPluginBase(void) const override { return m_plugin.data(); }
+
+protected:
+    virtual DataIOWorker *createWorker(void) override;
+    virtual int getOperationProgress(void) const override;
+
+    QSharedPointer<ExportPlugin> m_plugin;
+    QList<DataSeriesPointer> m_series;
+};
+
+
+#endif // DATA_IO_JOB_HPP
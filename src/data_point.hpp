@@ -0,0 +1,21 @@
+#ifndef DATA_POINT_HPP
+#define DATA_POINT_HPP
+
+
+/**
+ * @brief The DataPoint class represents a single <x, y> point of data
+ */
+class DataPoint
+{
+public:
+    DataPoint() : timestamp(0), value(0) {}
+    DataPoint(double t, double v) : timestamp(t), value(v) {}
+
+    //! Timestamp (milliseconds)
+    double timestamp = 0;
+
+    //! Value
+    double value = 0;
+};
+
+#endif // DATA_POINT_HPP
@@ -2,6 +2,7 @@
 #include <algorithm>
 
 #include "data_series.hpp"
+#include "performance_monitor.hpp"
 
 const float DataSeries::LINE_WIDTH_MIN = 1.0f;
 const float DataSeries::LINE_WIDTH_MAX = 5.0f;
@@ -9,6 +10,8 @@ const float DataSeries::LINE_WIDTH_MAX = 5.0f;
 const int DataSeries::SYMBOL_SIZE_MIN = 3;
 const int DataSeries::SYMBOL_SIZE_MAX = 10;
 
+const uint64_t DataSeriesReader::DEFAULT_CHUNK_SIZE;
+
 
 // Comparison operators for DataPoint and timestamps
 bool operator== (const DataPoint point, const double timestamp)
@@ -76,7 +79,7 @@ DataSeries::DataSeries(const DataSeries &other) : DataSeries()
     label = other.getLabel();
     units = other.getUnits();
 
-    data = other.getData();
+    data.assign(other.getData());
 
     // TODO - What else needs copying?
 
@@ -123,7 +126,7 @@ DataSeries::DataSeries(const DataSeries &other, int64_t t_min, int64_t t_max, un
     }
 
     // Allocate memory
-    data.reserve(idx_max - idx_min);
+    data.reserveAdditional(idx_max - idx_min + 1);
 
     auto length = other.size();
 
@@ -155,6 +158,8 @@ void DataSeries::setColor(QColor c)
  */
 size_t DataSeries::size() const
 {
+    sealForRead();
+
     return data.size();
 }
 
@@ -181,7 +186,11 @@ QRectF DataSeries::getBounds() const
 
 std::vector<DataPoint> DataSeries::getData(void) const
 {
-    return data;
+    sealForRead();
+
+    DataStorage::Snapshot snapshot(data);
+
+    return snapshot.toVector();
 }
 
 
@@ -205,9 +214,9 @@ std::vector<DataPoint> DataSeries::getData(double t_min, double t_max) const
 
     subset.resize(idx_max - idx_min + 2);
 
-    for (uint64_t idx = idx_min; idx <= idx_max; idx++)
+    for (uint64_t idx = idx_min; idx <= idx_max && idx < size(); idx++)
     {
-        subset.push_back(data[idx]);
+        subset.push_back(getRawDataPoint(idx));
     }
 
     return subset;
@@ -221,7 +230,7 @@ const DataPoint DataSeries::getDataPoint(uint64_t idx) const
         throw std::out_of_range("data index out of range");
     }
 
-    DataPoint dp = data[idx];
+    DataPoint dp = getRawDataPoint(idx);
 
     dp.value *= scalerValue;
     dp.value += offsetValue;
@@ -230,6 +239,93 @@ const DataPoint DataSeries::getDataPoint(uint64_t idx) const
 }
 
 
+/*
+ * Copy a contiguous range of (scaled) samples into the provided buffer.
+ * Returns the number of samples copied, which may be less than count at the end of the series.
+ */
+uint64_t DataSeries::getDataPoints(uint64_t idx, uint64_t count, DataPoint *points) const
+{
+    uint64_t n = getRawDataPoints(idx, count, points);
+
+    for (uint64_t ii = 0; ii < n; ii++)
+    {
+        points[ii].value *= scalerValue;
+        points[ii].value += offsetValue;
+    }
+
+    return n;
+}
+
+
+/*
+ * The uncontended case is a single tryLock(), so the wait time is only measured when blocked
+ */
+void DataSeries::lockData() const
+{
+    if (data_mutex.tryLock()) return;
+
+    PerformanceScope scope("Series/Lock wait");
+
+    data_mutex.lock();
+}
+
+
+uint64_t DataSeries::getMemoryUsage() const
+{
+    return data.getMemoryUsage();
+}
+
+
+DataPoint DataSeries::getRawDataPoint(uint64_t idx) const
+{
+    sealForRead();
+
+    DataStorage::Snapshot snapshot(data);
+
+    // The data may have been cleared since the caller checked the index
+    if (idx >= snapshot.size())
+    {
+        throw std::out_of_range("data index out of range");
+    }
+
+    return snapshot.at(idx);
+}
+
+
+uint64_t DataSeries::getRawDataPoints(uint64_t idx, uint64_t count, DataPoint *points) const
+{
+    sealForRead();
+
+    DataStorage::Snapshot snapshot(data);
+
+    return snapshot.copy(idx, count, points);
+}
+
+
+/*
+ * Return the summary of the block which contains the sample at the specified index.
+ * Returns false if the storage mode does not provide block summaries.
+ */
+bool DataSeries::getSummaryBlock(uint64_t idx, DataSummaryBlock &block) const
+{
+    if (!getRawSummaryBlock(idx, block)) return false;
+
+    for (DataPoint *dp : {&block.first, &block.last, &block.min, &block.max})
+    {
+        dp->value *= scalerValue;
+        dp->value += offsetValue;
+    }
+
+    // Negative scaling swaps the extremes
+    if (scalerValue < 0)
+    {
+        std::swap(block.min, block.max);
+    }
+
+    return true;
+}
+
+
 double DataSeries::getTimestamp(uint64_t idx) const
 {
     return getDataPoint(idx).timestamp;
@@ -249,7 +345,7 @@ double DataSeries::getValue(uint64_t idx) const
  * the new sample is simply appended to the dataset.
  * (This is a much more efficient operation).
  *
- * Otherwise, the sample is inserted into the series, which is more expensive.
+ * Otherwise, the sample is added to the ingestion buffer, and merged when the series is sealed.
  */
 void DataSeries::addData(DataPoint point, bool do_update)
 {
@@ -259,24 +355,26 @@ void DataSeries::addData(DataPoint point, bool do_update)
     // Ignore inf values
     if (isinf(point.value)) return;
 
-    data_mutex.lock();
+    lockData();
 
     // If the new datapoint is of equal or greater timestamp value, simply append!
-    if (size() == 0 || point.timestamp >= getNewestTimestamp())
+    if (data.size() == 0 || point.timestamp >= data.back().timestamp)
     {
-        data.push_back(point);
+        data.append(point);
     }
     else
     {
-        auto idx = getIndexForTimestamp(point.timestamp);
-
-        data.insert(data.begin() + idx, point);
+        bufferLateSample(point, data.back().timestamp);
     }
 
     if (do_update)
     {
         update();
     }
+    else
+    {
+        pendingUpdate = true;
+    }
 
     data_mutex.unlock();
 }
@@ -291,6 +389,195 @@ void DataSeries::addData(double t, float value, bool do_update)
 }
 
 
+/*
+ * Add a block of samples to the series, acquiring the lock only once.
+ *
+ * Samples are expected to be (mostly) in time order, in which case they are simply appended.
+ * Any out-of-order samples are added to the ingestion buffer.
+ */
+void DataSeries::appendData(const std::vector<DataPoint> &points, bool do_update)
+{
+    if (points.empty()) return;
+
+    lockData();
+
+    data.reserveAdditional(points.size());
+
+    double newest = data.size() > 0 ? data.back().timestamp : -INFINITY;
+
+    for (const DataPoint &point : points)
+    {
+        // Ignore NaN and inf values
+        if (isnan(point.value) || isinf(point.value)) continue;
+
+        if (point.timestamp >= newest)
+        {
+            data.append(point);
+            newest = point.timestamp;
+        }
+        else
+        {
+            bufferLateSample(point, newest);
+        }
+    }
+
+    data_mutex.unlock();
+
+    if (do_update)
+    {
+        update();
+    }
+    else
+    {
+        pendingUpdate = true;
+    }
+}
+
+
+/**
+ * @brief DataSeries::appendColumns - Append samples from separate timestamp and value arrays
+ *
+ * Sorted data are written directly into storage, without any intermediate copies.
+ * Otherwise, the samples are inserted as per appendData().
+ * As per appendData(), NaN and inf values are ignored.
+ */
+void DataSeries::appendColumns(const double *timestamps, const double *values, uint64_t count, bool do_update)
+{
+    if (count == 0) return;
+
+    lockData();
+
+    double t_min = data.size() > 0 ? data.back().timestamp : -INFINITY;
+
+    if (!isColumnSorted(timestamps, count, t_min))
+    {
+        data_mutex.unlock();
+        appendColumnsAsPoints(timestamps, values, count, do_update);
+        return;
+    }
+
+    data.reserveAdditional(count);
+
+    for (uint64_t ii = 0; ii < count; ii++)
+    {
+        // Ignore NaN and inf values
+        if (isnan(values[ii]) || isinf(values[ii])) continue;
+
+        data.append(DataPoint(timestamps[ii], values[ii]));
+    }
+
+    data_mutex.unlock();
+
+    if (do_update)
+    {
+        update();
+    }
+    else
+    {
+        pendingUpdate = true;
+    }
+}
+
+
+void DataSeries::bufferLateSample(const DataPoint &point, double newest)
+{
+    lateSamples.push_back(point);
+    lateCount.store(lateSamples.size(), std::memory_order_release);
+
+    outOfOrderCount++;
+
+    if (newest - point.timestamp > maximumLateness)
+    {
+        maximumLateness = newest - point.timestamp;
+    }
+}
+
+
+/*
+ * The buffered samples are sorted (stable, so that samples with equal timestamps retain their arrival order)
+ * and merged into the data in a single pass.
+ * (For in-memory storage, only the blocks which follow the oldest buffered sample are rewritten)
+ */
+void DataSeries::mergeLateSamples()
+{
+    if (lateSamples.empty()) return;
+
+    PerformanceScope scope("Series/Seal", label);
+
+    std::stable_sort(lateSamples.begin(), lateSamples.end(), [](const DataPoint &a, const DataPoint &b) {
+        return a.timestamp < b.timestamp;
+    });
+
+    mergeSamples(lateSamples);
+
+    lateSamples.clear();
+    lateCount.store(0, std::memory_order_release);
+}
+
+
+void DataSeries::mergeSamples(const std::vector<DataPoint> &points)
+{
+    data.merge(points);
+}
+
+
+void DataSeries::clearLateSamples()
+{
+    lateSamples.clear();
+    lateCount = 0;
+
+    outOfOrderCount = 0;
+    maximumLateness = 0;
+}
+
+
+void DataSeries::seal(bool wait) const
+{
+    if (lateCount.load(std::memory_order_acquire) == 0) return;
+
+    if (wait)
+    {
+        lockData();
+    }
+    else if (!data_mutex.tryLock())
+    {
+        return;
+    }
+
+    // Sealing does not change the (logical) contents of the series
+    const_cast<DataSeries*>(this)->mergeLateSamples();
+
+    data_mutex.unlock();
+}
+
+
+void DataSeries::appendColumnsAsPoints(const double *timestamps, const double *values, uint64_t count, bool do_update)
+{
+    std::vector<DataPoint> points(count);
+
+    for (uint64_t ii = 0; ii < count; ii++)
+    {
+        points[ii].timestamp = timestamps[ii];
+        points[ii].value = values[ii];
+    }
+
+    appendData(points, do_update);
+}
+
+
+bool DataSeries::isColumnSorted(const double *timestamps, uint64_t count, double t_min)
+{
+    for (uint64_t ii = 0; ii < count; ii++)
+    {
+        if (!(timestamps[ii] >= t_min)) return false;
+
+        t_min = timestamps[ii];
+    }
+
+    return true;
+}
+
+
 void DataSeries::clipTimeRange(double t_min, double t_max, bool do_update)
 {
     // Ensure that the timestamps are the right way around!
@@ -302,21 +589,28 @@ void DataSeries::clipTimeRange(double t_min, double t_max, bool do_update)
         t_max = swap;
     }
 
-    auto idx_min = getIndexForTimestamp(t_min, SEARCH_RIGHT_TO_LEFT);
-    auto idx_max = getIndexForTimestamp(t_max, SEARCH_LEFT_TO_RIGHT);
+    lockData();
+
+    mergeLateSamples();
 
     // Construct a subset of the data
     std::vector<DataPoint> subset;
 
-    subset.resize(idx_max - idx_min + 2);
-
-    for (uint64_t idx = idx_min; idx <= idx_max; idx++)
     {
-        subset.push_back(data[idx]);
+        DataStorage::Snapshot snapshot(data);
+
+        uint64_t idx_min = snapshot.lowerBound(t_min);
+        uint64_t idx_max = snapshot.upperBound(t_max);
+
+        subset.resize(idx_max - idx_min);
+
+        snapshot.copy(idx_min, subset.size(), subset.data());
     }
 
     // Override original data
-    data = subset;
+    data.assign(subset);
+
+    data_mutex.unlock();
 
     if (do_update)
     {
@@ -327,10 +621,29 @@ void DataSeries::clipTimeRange(double t_min, double t_max, bool do_update)
 
 void DataSeries::clearData(bool do_update)
 {
-    data_mutex.lock();
+    lockData();
 
     data.clear();
 
+    clearLateSamples();
+
+    data_mutex.unlock();
+
+    if (do_update)
+    {
+        update();
+    }
+}
+
+
+void DataSeries::truncateData(uint64_t count, bool do_update)
+{
+    lockData();
+
+    mergeLateSamples();
+
+    data.truncate(count);
+
     data_mutex.unlock();
 
     if (do_update)
@@ -408,11 +721,27 @@ double DataSeries::getMinimumValue(double t_min, double t_max) const
 
     unsigned int length = size();
 
+    DataSeriesReader reader(*this);
+
+    bool summary = hasSummaryBlocks();
+    DataSummaryBlock block;
+
     for (auto idx = idx_min + 1; idx <= idx_max && idx < size(); idx++)
     {
         if (idx >= length) continue;
 
-        double v = getValue(idx);
+        double v = 0;
+
+        // Skip entire blocks which fall within the range
+        if (summary && getSummaryBlock(idx, block) && block.first_index == idx && block.last_index <= idx_max)
+        {
+            v = block.min.value;
+            idx = block.last_index;
+        }
+        else
+        {
+            v = reader.getValue(idx);
+        }
 
         if (v < value)
         {
@@ -442,11 +771,27 @@ double DataSeries::getMaximumValue(double t_min, double t_max) const
 
     unsigned int length = size();
 
+    DataSeriesReader reader(*this);
+
+    bool summary = hasSummaryBlocks();
+    DataSummaryBlock block;
+
     for (auto idx = idx_min + 1; idx <= idx_max && idx < size(); idx++)
     {
         if (idx >= length) continue;
 
-        double v = getValue(idx);
+        double v = 0;
+
+        // Skip entire blocks which fall within the range
+        if (summary && getSummaryBlock(idx, block) && block.first_index == idx && block.last_index <= idx_max)
+        {
+            v = block.max.value;
+            idx = block.last_index;
+        }
+        else
+        {
+            v = reader.getValue(idx);
+        }
 
         if (v > value)
         {
@@ -521,11 +866,13 @@ double DataSeries::getMeanValue(double t_min, double t_max) const
 
     unsigned int length = size();
 
+    DataSeriesReader reader(*this);
+
     for (size_t idx = idx_min; idx <= idx_max && idx < size(); idx++)
     {
         if (idx < length)
         {
-            accumulator += getValue(idx);
+            accumulator += reader.getValue(idx);
             count += 1;
         }
     }
@@ -542,26 +889,51 @@ double DataSeries::getMeanValue(double t_min, double t_max) const
 
 uint64_t DataSeries::getIndexForTimestamp(double t, SearchDirection direction) const
 {
-    if (size() == 0) return 0;
+    sealForRead();
+
+    DataStorage::Snapshot snapshot(data);
+
+    if (snapshot.isEmpty()) return 0;
 
-    if (t < getOldestTimestamp())
+    if (t < snapshot.front().timestamp)
     {
         return 0;
     }
 
-    else if (t > getNewestTimestamp())
+    else if (t > snapshot.back().timestamp)
     {
-        return size();
+        return snapshot.size();
     }
 
     if (direction == SEARCH_LEFT_TO_RIGHT)
     {
-        auto upper= std::upper_bound(data.begin(), data.end(), t);
-        return std::distance(data.begin(), upper);
+        return snapshot.upperBound(t);
     }
     else
     {
-        auto lower = std::lower_bound(data.begin(), data.end(), t);
-        return std::distance(data.begin(), lower);
+        return snapshot.lowerBound(t);
     }
 }
+
+
+DataSeriesReader::DataSeriesReader(const DataSeries &s, uint64_t chunkSize) : series(s)
+{
+    buffer.resize(std::max<uint64_t>(chunkSize, 1));
+}
+
+
+const DataPoint& DataSeriesReader::at(uint64_t idx)
+{
+    if (idx < bufferStart || idx >= bufferStart + bufferCount)
+    {
+        bufferStart = idx;
+        bufferCount = series.getDataPoints(idx, buffer.size(), buffer.data());
+
+        if (bufferCount == 0)
+        {
+            throw std::out_of_range("data index out of range");
+        }
+    }
+
+    return buffer[idx - bufferStart];
+}
@@ -5,30 +5,49 @@
 #include <qobject.h>
 #include <qvector.h>
 #include <vector>
+#include <algorithm>
+#include <atomic>
 #include <qmutex.h>
 #include <QRectF>
 #include <QColor>
 
+#include "data_point.hpp"
+#include "data_storage.hpp"
+
 
 /**
- * @brief The DataPoint class represents a single <x, y> point of data
+ * @brief The DataSummaryBlock class summarizes a contiguous block of samples
+ *
+ * Storage modes which maintain block summaries allow large ranges of data
+ * to be scanned (e.g. for plotting or min/max calculations) without reading every sample.
  */
-class DataPoint
+class DataSummaryBlock
 {
 public:
-    DataPoint() : timestamp(0), value(0) {}
-    DataPoint(double t, double v) : timestamp(t), value(v) {}
+    //! Index of the first and last samples in the block
+    uint64_t first_index = 0;
+    uint64_t last_index = 0;
 
-    //! Timestamp (milliseconds)
-    double timestamp = 0;
+    DataPoint first;
+    DataPoint last;
 
-    //! Value
-    double value = 0;
+    //! Samples with the minimum and maximum values in the block
+    DataPoint min;
+    DataPoint max;
 };
 
 
 /**
  * @brief The DataSeries class represents a timeseries vector of DataPoint objects
+ *
+ * Samples are stored in memory (see DataStorage).
+ * Modifications are serialized by data_mutex, but the samples can be read
+ * from any thread (e.g. sampling, statistics, math) without locking.
+ *
+ * Samples which arrive out of timestamp order are collected in an ingestion buffer,
+ * rather than being inserted one at a time. The buffer is sorted and merged into the data
+ * in a single pass when the series is sealed (e.g. when an import completes),
+ * or when the data are next read.
  */
 class DataSeries : public QObject
 {
@@ -55,6 +74,12 @@ public:
         SAMPLE_HOLD,
     };
 
+    enum ValuePrecision
+    {
+        PRECISION_DOUBLE,
+        PRECISION_FLOAT,
+    };
+
     static const float LINE_WIDTH_MIN;
     static const float LINE_WIDTH_MAX;
 
@@ -140,26 +165,43 @@ public:
     }
 
     /* Data insertion functions */
-    void addData(DataPoint point, bool update=true);
+    virtual void addData(DataPoint point, bool update=true);
     void addData(double t_ms, float value, bool update=true);
+    virtual void appendData(const std::vector<DataPoint> &points, bool update=true);
 
-    void clipTimeRange(double t_min, double t_max, bool update=true);
+    // Append samples from separate (contiguous) timestamp and value arrays
+    // Data which are sorted by timestamp (and follow the existing data) are written directly to storage
+    virtual void appendColumns(const double *timestamps, const double *values, uint64_t count, bool update=true);
+
+    virtual void clipTimeRange(double t_min, double t_max, bool update=true);
 
     /* Data removal functions */
-    void clearData(bool update=true);
+    virtual void clearData(bool update=true);
+
+    // Discard the newest samples, keeping the first count samples (disorder statistics are retained)
+    virtual void truncateData(uint64_t count, bool update=true);
 
     /* Data access functions */
-    size_t size() const;
+    virtual size_t size() const;
 
     QRectF getBounds(void) const;
 
-    std::vector<DataPoint> getData() const;
+    virtual std::vector<DataPoint> getData() const;
     std::vector<DataPoint> getData(double t_min, double t_max) const;
 
     const DataPoint getDataPoint(uint64_t idx) const;
     double getTimestamp(uint64_t idx) const;
     double getValue(uint64_t idx) const;
 
+    // Copy (up to) count samples starting at idx, returns the number of samples copied
+    uint64_t getDataPoints(uint64_t idx, uint64_t count, DataPoint *points) const;
+
+    // Precision with which sample values are stored
+    virtual ValuePrecision getValuePrecision(void) const { return PRECISION_DOUBLE; }
+
+    // Approximate memory (bytes) allocated for the sample data
+    virtual uint64_t getMemoryUsage(void) const;
+
     const DataPoint getOldestDataPoint(void) const;
     double getOldestTimestamp(void) const;
     double getOldestValue(void) const;
@@ -179,15 +221,48 @@ public:
     double getMeanValue(void) const;
     double getMeanValue(double t_min, double t_max) const;
 
-    uint64_t getIndexForTimestamp(double t, SearchDirection direction=SEARCH_LEFT_TO_RIGHT) const;
+    virtual uint64_t getIndexForTimestamp(double t, SearchDirection direction=SEARCH_LEFT_TO_RIGHT) const;
+
+    /* Block summary functions */
+    virtual bool hasSummaryBlocks(void) const { return false; }
+    bool getSummaryBlock(uint64_t idx, DataSummaryBlock &block) const;
+
+    // Merge any buffered out-of-order samples into the data
+    // If wait is false, the samples are not merged if another thread is modifying the series
+    void seal(bool wait = true) const;
+
+    /* Disorder statistics (for samples added since the data were last cleared) */
+
+    //! Number of samples which arrived out of timestamp order
+    uint64_t getOutOfOrderCount(void) const { return outOfOrderCount; }
+
+    //! Largest difference between the newest timestamp and an out-of-order sample (ms)
+    double getMaximumLateness(void) const { return maximumLateness; }
 
     /* Status Functions */
     bool hasData() const { return size() > 0; }
 
+    // Returns true if data were added without emitting dataUpdated()
+    bool hasPendingUpdate(void) const { return pendingUpdate; }
+
 public slots:
-    void update(void) { emit dataUpdated(); }
+    void update(void)
+    {
+        pendingUpdate = false;
+        emit dataUpdated();
+    }
+
     void updateStyle(void) { emit styleUpdated(); }
 
+    // Emit dataUpdated() only if there are pending (unsignalled) changes
+    bool flushUpdate(void)
+    {
+        if (!pendingUpdate) return false;
+
+        update();
+        return true;
+    }
+
 signals:
     // Emitted when data are updated
     void dataUpdated();
@@ -195,7 +270,79 @@ signals:
 
 protected:
 
-    std::vector<DataPoint> data;
+    // Lock the data mutex, recording the time spent waiting (if the mutex is contended)
+    void lockData(void) const;
+
+    // Scoped equivalent of lockData()
+    class DataLocker
+    {
+    public:
+        DataLocker(const DataSeries *series) : series(series) { series->lockData(); }
+        ~DataLocker() { series->data_mutex.unlock(); }
+
+    protected:
+        const DataSeries *series;
+    };
+
+    // Return the unscaled sample at the specified index
+    virtual DataPoint getRawDataPoint(uint64_t idx) const;
+
+    // Copy (up to) count unscaled samples starting at idx, returns the number of samples copied
+    virtual uint64_t getRawDataPoints(uint64_t idx, uint64_t count, DataPoint *points) const;
+
+    // Return the unscaled summary of the block containing the specified index (if available)
+    virtual bool getRawSummaryBlock(uint64_t idx, DataSummaryBlock &block) const { Q_UNUSED(idx); Q_UNUSED(block); return false; }
+
+    // Add an out-of-order sample to the ingestion buffer (data_mutex must be held)
+    void bufferLateSample(const DataPoint &point, double newest);
+
+    // Merge the ingestion buffer into the data (data_mutex must be held)
+    void mergeLateSamples(void);
+
+    // Merge samples (sorted by timestamp) into the data, after any existing samples with equal timestamps
+    // (data_mutex must be held; overridden by storage modes which use the ingestion buffer)
+    virtual void mergeSamples(const std::vector<DataPoint> &points);
+
+    // Discard the ingestion buffer and disorder statistics (data_mutex must be held)
+    void clearLateSamples(void);
+
+    // Seal the series (if required) before the data are read
+    void sealForRead(void) const
+    {
+        if (lateCount.load(std::memory_order_acquire) > 0) seal(false);
+    }
+
+    // Append columnar data via appendData() (for storage modes without a direct columnar path)
+    void appendColumnsAsPoints(const double *timestamps, const double *values, uint64_t count, bool update);
+
+    // Check that the columnar data are sorted, and do not precede the provided timestamp
+    static bool isColumnSorted(const double *timestamps, uint64_t count, double t_min);
+
+    // Reserve space for additional samples, with geometric growth,
+    // so that repeated (chunked) appends do not reallocate the entire buffer each time
+    template <typename T>
+    static void reserveAdditional(std::vector<T> &buffer, size_t count)
+    {
+        size_t required = buffer.size() + count;
+
+        if (required > buffer.capacity())
+        {
+            buffer.reserve(std::max(required, buffer.capacity() * 2));
+        }
+    }
+
+    //! Sample data (modified with data_mutex held, read without locking)
+    DataStorage data;
+
+    //! Out-of-order samples which have not yet been merged into the data
+    std::vector<DataPoint> lateSamples;
+    std::atomic<uint64_t> lateCount {0};
+
+    std::atomic<uint64_t> outOfOrderCount {0};
+    std::atomic<double> maximumLateness {0};
+
+    //! Set when data are changed with update=false, cleared when dataUpdated() is emitted
+    std::atomic<bool> pendingUpdate {false};
 
     //! mutex for controlling data access
     mutable QMutex data_mutex;
@@ -233,4 +380,35 @@ protected:
 typedef QSharedPointer<DataSeries> DataSeriesPointer;
 
 
+/**
+ * @brief The DataSeriesReader class provides buffered access to the samples of a DataSeries
+ *
+ * Samples are fetched in chunks (using DataSeries::getDataPoints),
+ * rather than locking the series for every sample.
+ * Intended for scanning through a range of samples (e.g. sampling, statistics, export).
+ */
+class DataSeriesReader
+{
+public:
+    DataSeriesReader(const DataSeries &series, uint64_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+    static const uint64_t DEFAULT_CHUNK_SIZE = 0x1000;
+
+    // Return the (scaled) sample at the specified index
+    const DataPoint& at(uint64_t idx);
+
+    double getTimestamp(uint64_t idx) { return at(idx).timestamp; }
+    double getValue(uint64_t idx) { return at(idx).value; }
+
+protected:
+    const DataSeries &series;
+
+    std::vector<DataPoint> buffer;
+
+    //! Index of the first buffered sample, and number of buffered samples
+    uint64_t bufferStart = 0;
+    uint64_t bufferCount = 0;
+};
+
+
 #endif // DATA_SERIES_H
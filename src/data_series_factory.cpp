@@ -0,0 +1,101 @@
+#include <QFileInfo>
+
+#include "data_series_factory.hpp"
+#include "paged_data_series.hpp"
+#include "compressed_data_series.hpp"
+#include "float32_data_series.hpp"
+#include "lumberjack_settings.hpp"
+
+
+DataSeriesFactory::StorageMode DataSeriesFactory::getStorageMode(QString filename)
+{
+    auto *settings = LumberjackSettings::getInstance();
+
+    QString mode = settings->loadSetting("storage", "mode", "memory").toString().trimmed().toLower();
+
+    if (mode == "paged")
+    {
+        return STORAGE_PAGED;
+    }
+
+    if (mode == "compressed")
+    {
+        return STORAGE_COMPRESSED;
+    }
+
+    if (mode == "auto" && !filename.isEmpty())
+    {
+        qint64 threshold = settings->loadSetting("storage", "pagedThresholdMB", 4096).toLongLong();
+
+        if (QFileInfo(filename).size() > threshold * 1024 * 1024)
+        {
+            return STORAGE_PAGED;
+        }
+    }
+
+    return STORAGE_MEMORY;
+}
+
+
+DataSeries::ValuePrecision DataSeriesFactory::getValuePrecision(DataSeries::ValuePrecision hint)
+{
+    auto *settings = LumberjackSettings::getInstance();
+
+    QString precision = settings->loadSetting("storage", "valuePrecision", "auto").toString().trimmed().toLower();
+
+    if (precision == "float")
+    {
+        return DataSeries::PRECISION_FLOAT;
+    }
+
+    if (precision == "double")
+    {
+        return DataSeries::PRECISION_DOUBLE;
+    }
+
+    return hint;
+}
+
+
+DataSeriesPointer DataSeriesFactory::createSeries(QString label, StorageMode mode, DataSeries::ValuePrecision precision)
+{
+    switch (mode)
+    {
+    case STORAGE_PAGED:
+        {
+            auto *settings = LumberjackSettings::getInstance();
+
+            // Limit applies to the pages of all paged series
+            int resident = settings->loadSetting("storage", "residentPages", (int) PageStore::DEFAULT_RESIDENT_PAGES).toInt();
+
+            PageStore::setResidentPageLimit(qMax(1, resident));
+            PageStore::setCacheDirectory(LumberjackSettings::getSettingsSubdirectory("cache"));
+
+            return DataSeriesPointer(new PagedDataSeries(label));
+        }
+    case STORAGE_COMPRESSED:
+        return DataSeriesPointer(new CompressedDataSeries(label));
+    case STORAGE_MEMORY:
+    default:
+        if (precision == DataSeries::PRECISION_FLOAT)
+        {
+            return DataSeriesPointer(new Float32DataSeries(label));
+        }
+
+        return DataSeriesPointer(new DataSeries(label));
+    }
+}
+
+
+DataSeriesFactoryFunction DataSeriesFactory::getFactory(QString filename)
+{
+    StorageMode mode = getStorageMode(filename);
+
+    // Determine (once) if the precision is overridden by the user
+    DataSeries::ValuePrecision asDouble = getValuePrecision(DataSeries::PRECISION_DOUBLE);
+    DataSeries::ValuePrecision asFloat = getValuePrecision(DataSeries::PRECISION_FLOAT);
+
+    return [mode, asDouble, asFloat](QString label, DataSeries::ValuePrecision hint) {
+        return DataSeriesFactory::createSeries(label, mode, hint == DataSeries::PRECISION_FLOAT ? asFloat : asDouble);
+    };
+}
@@ -0,0 +1,47 @@
+#ifndef DATA_SERIES_FACTORY_HPP
+#define DATA_SERIES_FACTORY_HPP
+
+#include "data_series.hpp"
+#include "plugin_importer.hpp"
+
+
+/**
+ * @brief The DataSeriesFactory class constructs DataSeries objects using the configured storage mode
+ *
+ * Storage mode is selected by the "storage/mode" setting:
+ * - "memory" : All samples are kept in RAM (default)
+ * - "paged"  : Samples are stored in memory-mapped column files in the cache directory
+ * - "compressed" : Samples are stored in RAM using a lossless compressed encoding
+ * - "auto"   : Paged storage is used for files larger than "storage/pagedThresholdMB"
+ *
+ * Value precision is selected by the "storage/valuePrecision" setting:
+ * - "auto"   : Use the precision requested by the import plugin (default)
+ * - "float"  : Values are stored with single precision
+ * - "double" : Values are stored with double precision
+ *
+ * Note: Single precision values are currently only supported for in-memory storage
+ */
+class DataSeriesFactory
+{
+public:
+    enum StorageMode
+    {
+        STORAGE_MEMORY,
+        STORAGE_PAGED,
+        STORAGE_COMPRESSED,
+    };
+
+    // Determine the storage mode for data imported from the specified file
+    static StorageMode getStorageMode(QString filename = QString());
+
+    // Determine the value precision, given the precision requested by the plugin
+    static DataSeries::ValuePrecision getValuePrecision(DataSeries::ValuePrecision hint = DataSeries::PRECISION_DOUBLE);
+
+    static DataSeriesPointer createSeries(QString label, StorageMode mode, DataSeries::ValuePrecision precision = DataSeries::PRECISION_DOUBLE);
+
+    // Return a factory function for importing the specified file
+    // The precision requested for each series is used unless overridden by the "storage/valuePrecision" setting
+    static DataSeriesFactoryFunction getFactory(QString filename);
+};
+
+#endif // DATA_SERIES_FACTORY_HPP
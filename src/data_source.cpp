@@ -142,7 +142,7 @@ QStringList DataSource::getSeriesLabels(QString filter_string) const
  *
  * Returns true if the series was added, else false
  */
-bool DataSource::addSeries(DataSeriesPointer series, bool auto_color)
+bool DataSource::addSeries(DataSeriesPointer series, bool auto_color, bool update)
 {
     if (series.isNull())
     {
@@ -150,23 +150,34 @@ bool DataSource::addSeries(DataSeriesPointer series, bool auto_color)
         return false;
     }
 
-    for (auto s : data_series.values())
+    if (series_set.contains(series.data()))
     {
-        if (s == series)
-        {
-            qWarning() << "Attempting to add duplicate DataSeries";
-            return false;
-        }
+        qWarning() << "Attempting to add duplicate DataSeries";
+        return false;
+    }
+
+    // A series with the same label is replaced
+    auto existing = data_series.find(series->getLabel());
+
+    if (existing != data_series.end())
+    {
+        removeSeriesAt(existing, false);
     }
 
     data_series[series->getLabel()] = series;
+    series_set.insert(series.data());
 
     if (auto_color)
     {
         series->setColor(getNextColor());
     }
 
-    emit dataChanged();
+    emit seriesAdded(series);
+
+    if (update)
+    {
+        emit dataChanged();
+    }
 
     return true;
 }
@@ -213,23 +224,40 @@ DataSeriesPointer DataSource::getSeriesByIndex(unsigned int index)
 
 bool DataSource::removeSeries(DataSeriesPointer series, bool update)
 {
-    for (QString label : data_series.keys())
-    {
-        if (data_series.value(label) == series)
-        {
-            data_series.remove(label);
+    if (series.isNull() || !series_set.contains(series.data())) return false;
 
-            if (update)
-            {
-                emit dataChanged();
-            }
+    auto it = data_series.find(series->getLabel());
 
-            return true;
+    // The series may have been renamed since it was added
+    if (it == data_series.end() || it.value() != series)
+    {
+        for (it = data_series.begin(); it != data_series.end(); ++it)
+        {
+            if (it.value() == series) break;
         }
     }
 
-    // No matching series found
-    return false;
+    if (it == data_series.end()) return false;
+
+    removeSeriesAt(it, update);
+
+    return true;
+}
+
+
+void DataSource::removeSeriesAt(QMap<QString, DataSeriesPointer>::iterator it, bool update)
+{
+    DataSeriesPointer series = it.value();
+
+    data_series.erase(it);
+    series_set.remove(series.data());
+
+    emit seriesRemoved(series);
+
+    if (update)
+    {
+        emit dataChanged();
+    }
 }
 
 
@@ -252,14 +280,11 @@ DataSeriesPointer DataSource::getSeriesByLabel(QString label)
 
 bool DataSource::removeSeriesByLabel(QString label, bool update)
 {
-    if (data_series.contains(label))
-    {
-        data_series.remove(label);
+    auto it = data_series.find(label);
 
-        if (update)
-        {
-            emit dataChanged();
-        }
+    if (it != data_series.end())
+    {
+        removeSeriesAt(it, update);
 
         return true;
     }
@@ -272,7 +297,15 @@ bool DataSource::removeSeriesByLabel(QString label, bool update)
 
 void DataSource::removeAllSeries(bool update)
 {
+    QList<DataSeriesPointer> removed = data_series.values();
+
     data_series.clear();
+    series_set.clear();
+
+    for (auto series : removed)
+    {
+        emit seriesRemoved(series);
+    }
 
     if (update)
     {
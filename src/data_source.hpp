@@ -5,6 +5,7 @@
 #include <qobject.h>
 #include <qvector.h>
 #include <QFileInfo>
+#include <QSet>
 
 #include "data_series.hpp"
 
@@ -42,9 +43,12 @@ public:
     int getSeriesCount(void) const { return data_series.size(); }
     QStringList getSeriesLabels(QString filter_string=QString()) const;
 
+    // Return all series (ordered by label)
+    QList<DataSeriesPointer> getSeries(void) const { return data_series.values(); }
+
     QStringList getGroupLabels(void) const;
 
-    bool addSeries(DataSeriesPointer series, bool auto_color = true);
+    bool addSeries(DataSeriesPointer series, bool auto_color = true, bool update = true);
     bool addSeries(DataSeries* series, bool auto_color=true);
     bool addSeries(QString label, bool auto_color=true);
 
@@ -59,6 +63,10 @@ public:
 signals:
     void dataChanged(void);
 
+    // Emitted for each individual series which is added to (or removed from) this source
+    void seriesAdded(DataSeriesPointer series);
+    void seriesRemoved(DataSeriesPointer series);
+
 protected:
 
     //! Data source (e.g plugin name)
@@ -80,6 +88,11 @@ protected:
 
     // Keep a map of label:series for efficient lookup
     QMap<QString, DataSeriesPointer> data_series;
+
+    //! Set of contained series, for efficient duplicate checking
+    QSet<const DataSeries*> series_set;
+
+    void removeSeriesAt(QMap<QString, DataSeriesPointer>::iterator it, bool update);
 };
 
 
@@ -2,112 +2,52 @@
 #include <QFileInfo>
 #include <QProgressDialog>
 #include <QApplication>
-#include <QThread>
 
 #include "data_source_manager.hpp"
 
 #include "plugin_registry.hpp"
 #include "lumberjack_settings.hpp"
+#include "data_series_factory.hpp"
 
 
 
-DataImportWorker::DataImportWorker(QSharedPointer<ImportPlugin> plugin) : m_plugin(plugin)
-{
-}
+DataSourceManager *DataSourceManager::instance = 0;
 
 
-void DataImportWorker::runImport()
+DataSourceManager::DataSourceManager()
 {
-    m_errors.clear();
-
-    if (m_plugin)
-    {
-        m_result = m_plugin->importData(m_errors);
-    }
-    else
-    {
-        m_result = false;
-    }
-
-    m_complete = true;
-
-    emit importCompleted();
+    scheduler = new DataImportScheduler(this);
 }
 
 
-void DataImportWorker::cancelImport()
+DataSourceManager::~DataSourceManager()
 {
-    if (m_plugin)
+    for (auto stream : streams)
     {
-        m_plugin->cancelImport();
-        m_result = false;
+        stream->stop();
     }
 
-    m_errors.append(tr("Import process cancelled"));
-
-    m_complete = true;
-}
+    streams.clear();
+    followers.clear();
 
+    // Stop any running jobs before the sources are released
+    scheduler->cancel();
 
-DataExportWorker::DataExportWorker(QSharedPointer<ExportPlugin> plugin, QList<DataSeriesPointer> &series)
-    : m_plugin(plugin), m_series(series)
-{
-}
-
-
-void DataExportWorker::runExport()
-{
-    m_errors.clear();
-
-    if (m_plugin)
-    {
-        m_result = m_plugin->exportData(m_series, m_errors);
-    }
-    else
+    for (auto job : jobs)
     {
-        m_result = false;
+        job->cancel();
+        job->wait();
     }
 
-    m_complete = true;
-    emit exportCompleted();
-}
-
+    jobs.clear();
 
-void DataExportWorker::cancelExport()
-{
-    if (m_plugin)
-    {
-        m_plugin->cancelExport();
-        m_result = false;
-    }
-
-    m_errors.append(tr("Export process cancelled"));
-
-    m_complete = true;
-}
-
-
-DataSourceManager *DataSourceManager::instance = 0;
-
-
-DataSourceManager::DataSourceManager()
-{
-}
-
-
-DataSourceManager::~DataSourceManager()
-{
     removeAllSources(false);
 }
 
 
 DataSeriesPointer DataSourceManager::findSeries(QString source_label, QString series_label)
 {
-    auto source = getSourceByLabel(source_label);
-
-    if (source.isNull()) return DataSeriesPointer(nullptr);
-
-    return source->getSeriesByLabel(series_label);
+    return registry.findSeries(source_label, series_label);
 }
 
 
@@ -136,17 +76,7 @@ DataSourcePointer DataSourceManager::getSourceByIndex(unsigned int idx)
 
 DataSourcePointer DataSourceManager::getSourceByLabel(QString label)
 {
-    for (auto src : sources)
-    {
-        if (src.isNull()) continue;
-
-        if (src->getLabel() == label)
-        {
-            return src;
-        }
-    }
-
-    return DataSourcePointer(nullptr);
+    return registry.findSource(label);
 }
 
 
@@ -170,7 +100,11 @@ bool DataSourceManager::addSource(DataSourcePointer source)
 
     sources.push_back(source);
 
+    registry.registerSource(source);
+
     connect(source.data(), &DataSource::dataChanged, this, &DataSourceManager::onDataChanged);
+    connect(source.data(), &DataSource::seriesAdded, this, &DataSourceManager::onSeriesAdded);
+    connect(source.data(), &DataSource::seriesRemoved, this, &DataSourceManager::onSeriesRemoved);
 
     emit sourcesChanged();
 
@@ -208,9 +142,7 @@ bool DataSourceManager::removeSource(DataSourcePointer source)
 
         if (src == source)
         {
-            sources.removeAt(idx);
-            emit sourcesChanged();
-            return true;
+            return removeSourceByIndex(idx);
         }
     }
 
@@ -228,8 +160,15 @@ bool DataSourceManager::removeSourceByIndex(unsigned int idx, bool update)
 {
     if (idx < sources.size())
     {
+        DataSourcePointer source = sources.at(idx);
+
+        closeStream(source);
+        removeFollowers(source);
         sources.removeAt(idx);
 
+        registry.unregisterSource(source);
+        source->disconnect(this);
+
         if (update)
         {
             emit sourcesChanged();
@@ -242,6 +181,26 @@ bool DataSourceManager::removeSourceByIndex(unsigned int idx, bool update)
 }
 
 
+/*
+ * Keep the registry up to date as series are added to (or removed from) a source
+ */
+void DataSourceManager::onSeriesAdded(DataSeriesPointer series)
+{
+    DataSource *source = qobject_cast<DataSource*>(sender());
+
+    if (source)
+    {
+        registry.registerSeries(source, series);
+    }
+}
+
+
+void DataSourceManager::onSeriesRemoved(DataSeriesPointer series)
+{
+    registry.unregisterSeries(series.data());
+}
+
+
 /**
  * @brief DataSourceManager::removeSourceByLabel - Remove the first DataSource which matches the specified label
  * @param label - QString label
@@ -282,166 +241,477 @@ void DataSourceManager::removeAllSources(bool update)
 }
 
 
-bool DataSourceManager::importData(QString filename)
+/**
+ * @brief DataSourceManager::getImporterForFile - Select an import plugin for the specified file
+ * @param filename
+ * @return the selected plugin, or null if no plugin supports the file type
+ */
+QSharedPointer<ImportPlugin> DataSourceManager::getImporterForFile(QString filename) const
 {
-    auto registry = PluginRegistry::getInstance();
-    auto settings = LumberjackSettings::getInstance();
+    QFileInfo fi(filename);
 
-    if (filename.isEmpty())
+    for (auto plugin : PluginRegistry::getInstance()->ImportPlugins())
     {
-        filename = registry->getFilenameForImport();
+        if (plugin.isNull()) continue;
+
+        // TODO: Select an importer if multiple plugins support this file type
+        // TODO: For now, just take the first one...
+        if (plugin->supportsFileType(fi.suffix()))
+        {
+            return plugin;
+        }
     }
 
-    // Still empty? No further actions
-    if (filename.isEmpty())
+    return QSharedPointer<ImportPlugin>();
+}
+
+
+/**
+ * @brief DataSourceManager::getExporterForFile - Select an export plugin for the specified file
+ * @param filename
+ * @return the selected plugin, or null if no plugin supports the file type
+ */
+QSharedPointer<ExportPlugin> DataSourceManager::getExporterForFile(QString filename) const
+{
+    QFileInfo fi(filename);
+
+    for (auto plugin : PluginRegistry::getInstance()->ExportPlugins())
     {
-        return false;
+        if (plugin.isNull()) continue;
+
+        // TODO: Select an exporter if multiple plugins support this file type
+        // TODO: For now, just take the first one...
+        if (plugin->supportsFileType(fi.suffix()))
+        {
+            return plugin;
+        }
     }
 
-    QFileInfo fi(filename);
+    return QSharedPointer<ExportPlugin>();
+}
 
-    if (!fi.exists())
+
+/**
+ * @brief DataSourceManager::acquireImporter - Return a configured importer for the specified file
+ *
+ * Each import uses a new instance of the registered plugin (see ImportPlugin::createInstance),
+ * so that multiple files can be imported concurrently.
+ * Import options are configured on the registered plugin, and are copied to each new instance.
+ * Plugins which do not support multiple instances are shared, and can only run one import at a time.
+ *
+ * @param filename - File to import
+ * @param configure - If true, the plugin may prompt the user for import options
+ * @param errors - Any errors are appended to this list
+ * @param cancelled - (optional) set to true if the user cancelled the configuration of the plugin
+ * @return the importer, or null if the file is invalid (or the import was cancelled)
+ */
+QSharedPointer<ImportPlugin> DataSourceManager::acquireImporter(QString filename, bool configure, QStringList &errors, bool *cancelled)
+{
+    if (cancelled) *cancelled = false;
+
+    QSharedPointer<ImportPlugin> plugin = getImporterForFile(filename);
+
+    if (plugin.isNull())
     {
-        qCritical() << "File does not exist:" << filename;
-        return false;
+        errors.append(tr("No import plugin available for file") + ": " + filename);
+        return QSharedPointer<ImportPlugin>();
     }
 
-    // Save the last directory information
-    settings->saveSetting("import", "lastDirectory", fi.absoluteDir().absolutePath());
+    if (!plugin->validateFile(filename, errors))
+    {
+        qWarning() << "File is not valid:" << filename;
+        return QSharedPointer<ImportPlugin>();
+    }
 
-    ImportPluginList importers;
+    QSharedPointer<ImportPlugin> importer(plugin->createInstance());
 
-    for (auto plugin : registry->ImportPlugins())
+    if (importer.isNull())
     {
-        if (plugin.isNull()) continue;
+        if (isPluginBusy(plugin.data()))
+        {
+            errors.append(tr("Import plugin is busy") + ": " + plugin->pluginName());
+            return QSharedPointer<ImportPlugin>();
+        }
 
-        if (plugin->supportsFileType(fi.suffix()))
+        importer = plugin;
+
+        // Importing resets the importer state, so previously imported files can no longer be followed
+        removeFollowers(importer);
+    }
+    else if (configure)
+    {
+        plugin->setFilename(filename);
+
+        if (!plugin->beforeImport())
         {
-            importers.append(plugin);
+            if (cancelled) *cancelled = true;
+
+            return QSharedPointer<ImportPlugin>();
         }
+
+        // Create the instance again, with the updated options
+        importer.reset(plugin->createInstance());
+        configure = false;
     }
 
-    QSharedPointer<ImportPlugin> importer;
+    importer->setFilename(filename);
+    importer->setSeriesFactory(DataSeriesFactory::getFactory(filename));
+
+    // Options from the previous import are re-used if the plugin is not configured
+    importer->setInteractive(configure);
+
+    bool result = importer->beforeImport();
+
+    importer->setInteractive(true);
 
-    if (importers.length() == 0)
+    if (!result && configure && cancelled)
     {
-        // TODO: Error message
-        return false;
+        *cancelled = true;
     }
-    else if (importers.length() == 1)
+
+    return result ? importer : QSharedPointer<ImportPlugin>();
+}
+
+
+/**
+ * @brief DataSourceManager::acquireExporter - Return a configured exporter for the specified file
+ *
+ * As per acquireImporter(), each export uses a new instance of the registered plugin (where supported).
+ */
+QSharedPointer<ExportPlugin> DataSourceManager::acquireExporter(QString filename, bool configure, QStringList &errors)
+{
+    QSharedPointer<ExportPlugin> plugin = getExporterForFile(filename);
+
+    if (plugin.isNull())
     {
-        importer = importers.first();
+        errors.append(tr("No export plugin available for file") + ": " + filename);
+        return QSharedPointer<ExportPlugin>();
     }
-    else
+
+    QSharedPointer<ExportPlugin> exporter(plugin->createInstance());
+
+    if (exporter.isNull())
     {
-        // TODO: Select an importer
-        // TODO: For now, just take the first one...
-        importer = importers.first();
+        if (isPluginBusy(plugin.data()))
+        {
+            errors.append(tr("Export plugin is busy") + ": " + plugin->pluginName());
+            return QSharedPointer<ExportPlugin>();
+        }
+
+        exporter = plugin;
+    }
+    else if (configure)
+    {
+        plugin->setFilename(filename);
+
+        if (!plugin->beforeExport())
+        {
+            return QSharedPointer<ExportPlugin>();
+        }
+
+        exporter.reset(plugin->createInstance());
+        configure = false;
     }
 
-    QStringList errors;
+    exporter->setFilename(filename);
+    exporter->setInteractive(configure);
 
-    if (!importer->validateFile(filename, errors))
+    bool result = exporter->beforeExport();
+
+    exporter->setInteractive(true);
+
+    return result ? exporter : QSharedPointer<ExportPlugin>();
+}
+
+
+/**
+ * @brief DataSourceManager::addImportedSource - Create a new DataSource from the results of an import
+ * @return the new source, or null if no data were imported
+ */
+DataSourcePointer DataSourceManager::addImportedSource(QSharedPointer<ImportPlugin> importer, QString filename)
+{
+    QFileInfo fi(filename);
+
+    auto seriesList = importer->getDataSeries();
+
+    if (seriesList.count() == 0)
     {
-        // TODO: Display errors
+        return DataSourcePointer();
+    }
 
-        qWarning() << "File is not valid:" << filename;
-        return false;
+    DataSourcePointer source(new DataSource(
+        importer->pluginName(),
+        fi.fileName(),
+        fi.absoluteFilePath()
+    ));
+
+    for (auto series : seriesList)
+    {
+        source->addSeries(series);
     }
 
-    importer->setFilename(filename);
+    if (!addSource(source))
+    {
+        return DataSourcePointer();
+    }
+
+    return source;
+}
+
+
+/**
+ * @brief DataSourceManager::importData - Import data from a file, in a background thread
+ *
+ * This function returns as soon as the import has been queued.
+ * The new data source is added when the import completes (see importFinished).
+ *
+ * @param filename - File to import (if empty, the user is prompted to select one or more files)
+ * @return true if the import was queued
+ */
+bool DataSourceManager::importData(QString filename)
+{
+    QStringList filenames;
+
+    if (filename.isEmpty())
+    {
+        filenames = PluginRegistry::getInstance()->getFilenamesForImport();
+    }
+    else
+    {
+        filenames.append(filename);
+    }
+
+    return importFiles(filenames);
+}
+
+
+/**
+ * @brief DataSourceManager::importFiles - Import data from multiple files, concurrently
+ * @param filenames
+ * @return true if any imports are in progress
+ */
+bool DataSourceManager::importFiles(QStringList filenames)
+{
+    auto settings = LumberjackSettings::getInstance();
 
-    if (!importer->beforeImport())
+    // Still empty? No further actions
+    if (filenames.isEmpty())
     {
-        // TODO: error message?
         return false;
     }
 
-    QProgressDialog progress;
+    // Save the last directory information
+    QFileInfo fi(filenames.last());
 
-    progress.setWindowTitle(tr("Importing Data"));
-    progress.setMinimum(0);
-    progress.setMaximum(100);
-    progress.setValue(0);
-    progress.setLabelText(tr("Importing data from file"));
+    settings->saveSetting("import", "lastDirectory", fi.absoluteDir().absolutePath());
 
-    progress.show();
+    scheduler->addFiles(filenames);
 
-    QApplication::processEvents();
+    return scheduler->isBusy();
+}
 
-    // Spawn a new thread for importing
-    auto worker = DataImportWorker(importer);
-    auto *thread = new QThread;
 
-    worker.moveToThread(thread);
+/**
+ * @brief DataSourceManager::isImporterAvailable - Check if the plugin for the given file can start a new import
+ *
+ * Plugins which support createInstance() are always available.
+ * Shared plugins hold per-file state, so can only service one import at a time.
+ */
+bool DataSourceManager::isImporterAvailable(QString filename) const
+{
+    QSharedPointer<ImportPlugin> importer = getImporterForFile(filename);
 
-    connect(&worker, &DataImportWorker::importCompleted, thread, &QThread::quit);
-    connect(thread, &QThread::started, &worker, &DataImportWorker::runImport);
-    connect(thread, &QThread::finished, thread, &QThread::deleteLater);
+    // Files without an importer are reported when the job is created
+    return importer.isNull() || !isPluginBusy(importer.data());
+}
 
-    thread->start();
 
-    qDebug() << "Importing data from" << filename;
+/**
+ * @brief DataSourceManager::createImportJob - Configure an importer, and create a job for the given file
+ *
+ * The job is not started. The new data source is added when the job finishes.
+ *
+ * @param filename - File to import
+ * @param configure - If true, the plugin may prompt the user for import options
+ * @param errors - Any errors are appended to this list
+ * @param cancelled - (optional) set to true if the user cancelled the import options
+ * @return the new job, or null if the file cannot be imported (or the user cancelled)
+ */
+DataIOJobPointer DataSourceManager::createImportJob(QString filename, bool configure, QStringList &errors, bool *cancelled)
+{
+    QSharedPointer<ImportPlugin> importer = acquireImporter(filename, configure, errors, cancelled);
 
-    while (!thread->isFinished() && !worker.isComplete())
+    if (importer.isNull())
     {
-        // Check for manual cancel of import process
-        if (progress.wasCanceled())
-        {
-            worker.cancelImport();
-            thread->wait();
-        }
+        return DataIOJobPointer();
+    }
 
-        progress.setValue(importer->getImportProgress());
+    // Jobs may be released from within their own signal handlers, so defer deletion
+    DataIOJobPointer job(new DataImportJob(importer, filename), &QObject::deleteLater);
 
-        QApplication::processEvents();
-        QThread::msleep(100);
-    }
+    connect(job.data(), &DataIOJob::finished, this, &DataSourceManager::onImportJobFinished);
+    connect(static_cast<DataImportJob*>(job.data()), &DataImportJob::seriesPublished, this, &DataSourceManager::onImportSeriesPublished);
+
+    jobs.append(job);
+
+    qDebug() << "Importing data from" << filename;
+
+    return job;
+}
 
-    progress.cancel();
-    progress.close();
 
-    for (QString err : worker.getErrors())
+/*
+ * Called (in the GUI thread) when an import job has finished
+ */
+void DataSourceManager::onImportJobFinished(bool result)
+{
+    DataImportJob *job = qobject_cast<DataImportJob*>(sender());
+
+    if (!job) return;
+
+    QString filename = job->getFilename();
+    auto importer = job->getPlugin();
+
+    for (QString err : job->getErrors())
     {
         // TODO: Display these better?
         qWarning() << "Import err:" << err;
     }
 
-    if (worker.getResult())
-    {
-        // Create a new instance of the provided importer
-        DataSource *source = new DataSource(
-            importer->pluginName(),
-            fi.fileName(),
-            fi.absoluteFilePath()
-        );
+    removeJob(job);
 
+    // Source which was created for progressive display (if any)
+    DataSourcePointer source = job->getSource();
 
-        auto seriesList = importer->getDataSeries();
+    if (!source.isNull())
+    {
+        if (result)
+        {
+            // Add any series which were not published during the import
+            addSeriesToSource(source, importer->getDataSeries());
 
-        if (seriesList.count() == 0)
+            for (auto series : job->getPublishedSeries())
+            {
+                series->flushUpdate();
+            }
+        }
+        else
         {
-            delete source;
-            return false;
+            // Discard partially imported data
+            removeSource(source);
+            source.clear();
         }
+    }
+    else if (result)
+    {
+        source = addImportedSource(importer, filename);
+    }
 
-        for (auto series : importer->getDataSeries())
+    if (result)
+    {
+        if (source.isNull())
+        {
+            result = false;
+        }
+        else
         {
-            source->addSeries(series);
+            addFollower(importer, source);
         }
+    }
+
+    emit importFinished(filename, result);
+}
+
 
-        addSource(source);
+/*
+ * Called (in the GUI thread) when an import job publishes new series, before the import has completed.
+ * The data source is created as soon as the first series is available, so that the data are displayed progressively.
+ */
+void DataSourceManager::onImportSeriesPublished(QList<DataSeriesPointer> series)
+{
+    DataImportJob *job = qobject_cast<DataImportJob*>(sender());
+
+    if (!job || job->isFinished()) return;
+
+    DataSourcePointer source = job->getSource();
+
+    if (source.isNull())
+    {
+        QFileInfo fi(job->getFilename());
+
+        source = DataSourcePointer(new DataSource(
+            job->getPlugin()->pluginName(),
+            fi.fileName(),
+            fi.absoluteFilePath()
+        ));
+
+        // Series are added first, so that the source is only displayed once
+        addSeriesToSource(source, series);
+
+        // e.g. the file is already loaded - the result is handled when the job finishes
+        if (!addSource(source)) return;
+
+        job->setSource(source);
     }
+    else
+    {
+        addSeriesToSource(source, series);
+    }
+}
 
-    return true;
+
+/*
+ * Add a list of series to a source (ignoring any already present),
+ * and notify a single change for the whole list.
+ */
+void DataSourceManager::addSeriesToSource(DataSourcePointer source, QList<DataSeriesPointer> seriesList)
+{
+    bool changed = false;
+
+    for (auto series : seriesList)
+    {
+        if (series.isNull() || source->getSeriesByLabel(series->getLabel()) == series) continue;
+
+        changed |= source->addSeries(series, true, false);
+    }
+
+    if (changed)
+    {
+        emit source->dataChanged();
+    }
+}
+
+
+/*
+ * Create a follower for an imported source, if the importer supports "follow" mode
+ */
+void DataSourceManager::addFollower(QSharedPointer<ImportPlugin> importer, DataSourcePointer source)
+{
+    if (importer.isNull() || !importer->supportsFollow()) return;
+
+    auto settings = LumberjackSettings::getInstance();
+
+    DataFileFollowerPointer follower(new DataFileFollower(importer, source));
+
+    connect(follower.data(), &DataFileFollower::followStopped, this, &DataSourceManager::onDataChanged);
+
+    followers.append(follower);
+
+    if (settings->loadSetting("import", "followFiles", false).toBool())
+    {
+        follower->setActive(true);
+    }
 }
 
 
 /**
- * @brief DataSourceManager::exportData - Export a set of data series to a file
+ * @brief DataSourceManager::exportData - Export a set of data series to a file, in a background thread
+ *
+ * This function returns as soon as the export has been started (see exportFinished).
+ *
  * @param series
  * @param filename
- * @return
+ * @return true if the export was started
  */
 bool DataSourceManager::exportData(QList<DataSeriesPointer> &series, QString filename)
 {
@@ -464,94 +734,364 @@ bool DataSourceManager::exportData(QList<DataSeriesPointer> &series, QString fil
     // Save the last directory information
     settings->saveSetting("export", "lastDirectory", fi.absoluteDir().absolutePath());
 
-    ExportPluginList exporters;
+    QStringList errors;
 
-    QSharedPointer<ExportPlugin> exporter;
+    QSharedPointer<ExportPlugin> exporter = acquireExporter(filename, true, errors);
 
-    for (auto plugin : registry->ExportPlugins())
+    for (QString err : errors)
     {
-        if (plugin.isNull()) continue;
+        // TODO: Display these better?
+        qWarning() << "Export err:" << err;
+    }
 
-        if (plugin->supportsFileType(fi.suffix()))
+    if (exporter.isNull())
+    {
+        return false;
+    }
+
+    DataIOJobPointer job(new DataExportJob(exporter, series, filename), &QObject::deleteLater);
+
+    connect(job.data(), &DataIOJob::finished, this, &DataSourceManager::onExportJobFinished);
+
+    jobs.append(job);
+
+    showJobProgress(job, tr("Exporting Data"), tr("Exporting data to file") + "\n" + fi.fileName());
+
+    qDebug() << "Exporting data to" << filename;
+
+    job->start();
+
+    return true;
+}
+
+
+/*
+ * Called (in the GUI thread) when an export job has finished
+ */
+void DataSourceManager::onExportJobFinished(bool result)
+{
+    DataIOJob *job = qobject_cast<DataIOJob*>(sender());
+
+    if (!job) return;
+
+    QString filename = job->getFilename();
+
+    for (QString err : job->getErrors())
+    {
+        // TODO: Display these better?
+        qWarning() << "Export err:" << err;
+    }
+
+    removeJob(job);
+
+    emit exportFinished(filename, result);
+}
+
+
+/*
+ * Determine if the given plugin is in use by a running job
+ */
+bool DataSourceManager::isPluginBusy(const PluginBase *plugin) const
+{
+    for (auto job : jobs)
+    {
+        if (job->getPluginBase() == plugin && !job->isFinished())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+void DataSourceManager::removeJob(DataIOJob *job)
+{
+    for (int idx = 0; idx < jobs.size(); idx++)
+    {
+        if (jobs.at(idx).data() == job)
+        {
+            jobs.removeAt(idx);
+            return;
+        }
+    }
+}
+
+
+/*
+ * Display a (non-modal) progress dialog for a job.
+ * The dialog is only shown if the job takes a noticeable amount of time.
+ */
+void DataSourceManager::showJobProgress(DataIOJobPointer job, QString title, QString label)
+{
+    // No progress display in headless mode
+    if (!qobject_cast<QApplication*>(QCoreApplication::instance())) return;
+
+    QProgressDialog *progress = new QProgressDialog();
+
+    progress->setAttribute(Qt::WA_DeleteOnClose);
+    progress->setWindowTitle(title);
+    progress->setLabelText(label);
+    progress->setMinimum(0);
+    progress->setMaximum(100);
+    progress->setMinimumDuration(500);
+    progress->setValue(0);
+
+    connect(job.data(), &DataIOJob::progressChanged, progress, &QProgressDialog::setValue);
+    connect(job.data(), &DataIOJob::finished, progress, &QProgressDialog::close);
+    connect(job.data(), &QObject::destroyed, progress, &QProgressDialog::close);
+
+    // Note: Closing the dialog also emits canceled(), which has no effect on a finished job
+    connect(progress, &QProgressDialog::canceled, job.data(), &DataIOJob::cancel);
+}
+
+
+/**
+ * @brief DataSourceManager::importFile - Import data from a file, without any user interaction
+ *
+ * The import is performed synchronously in the calling thread (e.g. for headless batch processing).
+ * Plugins are run non-interactively, and use their default (or stored) options.
+ *
+ * @param filename - File to import
+ * @param errors - Any import errors are appended to this list
+ * @return true if data were imported
+ */
+bool DataSourceManager::importFile(QString filename, QStringList &errors)
+{
+    if (!QFileInfo::exists(filename))
+    {
+        errors.append(tr("File does not exist") + ": " + filename);
+        return false;
+    }
+
+    QSharedPointer<ImportPlugin> importer = acquireImporter(filename, false, errors);
+
+    if (importer.isNull() || !importer->importData(errors))
+    {
+        return false;
+    }
+
+    if (addImportedSource(importer, filename).isNull())
+    {
+        errors.append(tr("No data imported from file") + ": " + filename);
+        return false;
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief DataSourceManager::exportFile - Export data to a file, without any user interaction
+ *
+ * The export is performed synchronously in the calling thread (e.g. for headless batch processing).
+ *
+ * @param series - Series to export
+ * @param filename - Output file
+ * @param errors - Any export errors are appended to this list
+ * @return true if the data were exported
+ */
+bool DataSourceManager::exportFile(QList<DataSeriesPointer> &series, QString filename, QStringList &errors)
+{
+    QSharedPointer<ExportPlugin> exporter = acquireExporter(filename, false, errors);
+
+    return !exporter.isNull() && exporter->exportData(series, errors);
+}
+
+
+/**
+ * @brief DataSourceManager::openStream - Open a live data stream
+ *
+ * Samples are read in a background thread, and are available as soon as they are received.
+ * Each stream plugin can service a single stream at a time.
+ *
+ * @param address - Stream address (e.g. "unix:/tmp/telemetry.sock", "/tmp/telemetry.fifo", "stdin")
+ * @return true if the stream was opened
+ */
+bool DataSourceManager::openStream(QString address)
+{
+    auto registry = PluginRegistry::getInstance();
+    auto settings = LumberjackSettings::getInstance();
+
+    address = address.trimmed();
+
+    if (address.isEmpty())
+    {
+        return false;
+    }
+
+    // TODO: Select a stream plugin
+    // TODO: For now, just take the first one...
+    QSharedPointer<StreamPlugin> plugin;
+
+    for (auto p : registry->StreamPlugins())
+    {
+        if (!p.isNull())
         {
-            exporters.append(plugin);
+            plugin = p;
+            break;
         }
     }
 
-    if (exporters.length() == 0)
+    if (plugin.isNull())
     {
-        // TODO: Error message
+        qWarning() << "No stream plugins available";
         return false;
     }
-    else if (exporters.length() == 1)
+
+    for (auto stream : streams)
     {
-        exporter = exporters.first();
+        if (stream->getPlugin() == plugin)
+        {
+            qWarning() << "Stream plugin already in use:" << plugin->pluginName();
+            return false;
+        }
     }
-    else
+
+    int capacity = settings->loadSetting("stream", "bufferSize", (int) RingBufferDataSeries::DEFAULT_CAPACITY).toInt();
+
+    plugin->setAddress(address);
+    plugin->setBufferCapacity(qMax(1, capacity));
+
+    if (!plugin->beforeStream())
     {
-        // TODO: select an exporter
-        // TODO: For now, just take the first one
-        exporter = exporters.first();
+        return false;
     }
 
-    exporter->setFilename(filename);
+    DataSourcePointer source(new DataSource(plugin->pluginName(), address, address));
 
-    if (!exporter->beforeExport())
+    if (!addSource(source))
     {
-        // TODO: error mesage?
         return false;
     }
 
-    QProgressDialog progress;
+    // Sessions may be released from within their own signal handlers, so defer deletion
+    DataStreamSessionPointer stream(new DataStreamSession(plugin, source), &QObject::deleteLater);
 
-    progress.setWindowTitle(tr("Importing Data"));
-    progress.setMinimum(0);
-    progress.setMaximum(100);
-    progress.setValue(0);
-    progress.setLabelText(tr("Importing data from file"));
+    connect(stream.data(), &DataStreamSession::streamClosed, this, &DataSourceManager::onStreamClosed);
 
-    progress.show();
+    streams.append(stream);
 
-    QApplication::processEvents();
+    stream->start();
 
-    // Spawn a new thread for data export
-    auto worker = DataExportWorker(exporter, series);
-    auto *thread = new QThread();
+    return true;
+}
 
-    worker.moveToThread(thread);
 
-    connect(&worker, &DataExportWorker::exportCompleted, thread, &QThread::quit);
-    connect(thread, &QThread::started, &worker, &DataExportWorker::runExport);
-    connect(thread, &QThread::finished, thread, &QThread::deleteLater);
+/**
+ * @brief DataSourceManager::closeStream - Close the live stream (if any) associated with the given source
+ * @param source
+ */
+void DataSourceManager::closeStream(DataSourcePointer source)
+{
+    for (int idx = 0; idx < streams.size(); idx++)
+    {
+        auto stream = streams.at(idx);
+
+        if (stream->getSource() == source)
+        {
+            streams.removeAt(idx);
+            stream->stop();
+            return;
+        }
+    }
+}
 
-    thread->start();
 
-    qDebug() << "Exporting data to" << filename;
+/**
+ * Called when a live stream is closed by the remote end.
+ * The data source (and received data) are retained.
+ */
+void DataSourceManager::onStreamClosed()
+{
+    DataStreamSession *session = qobject_cast<DataStreamSession*>(sender());
 
-    while (!thread->isFinished() && !worker.isComplete())
+    for (int idx = 0; idx < streams.size(); idx++)
     {
-        if (progress.wasCanceled())
+        if (streams.at(idx).data() == session)
         {
-            worker.cancelExport();
-            thread->wait();
+            streams.removeAt(idx);
+            return;
         }
+    }
+}
 
-        progress.setValue(exporter->getExportProgress());
 
-        QApplication::processEvents();
-        QThread::msleep(100);
+DataFileFollowerPointer DataSourceManager::getFollower(DataSourcePointer source) const
+{
+    for (auto follower : followers)
+    {
+        if (follower->getSource() == source)
+        {
+            return follower;
+        }
     }
 
-    progress.cancel();
-    progress.close();
+    return DataFileFollowerPointer(nullptr);
+}
+
+
+/**
+ * @brief DataSourceManager::canFollowSource - Determine if the given source can be updated as its file grows
+ * @param source
+ * @return
+ */
+bool DataSourceManager::canFollowSource(DataSourcePointer source) const
+{
+    return !getFollower(source).isNull();
+}
+
+
+bool DataSourceManager::isFollowingSource(DataSourcePointer source) const
+{
+    auto follower = getFollower(source);
+
+    return !follower.isNull() && follower->isActive();
+}
+
+
+/**
+ * @brief DataSourceManager::followSource - Start (or stop) following the file associated with a source
+ * @param source
+ * @param follow
+ * @return true if the follow state matches the requested state
+ */
+bool DataSourceManager::followSource(DataSourcePointer source, bool follow)
+{
+    auto follower = getFollower(source);
+
+    if (follower.isNull()) return false;
+
+    follower->setActive(follow);
+
+    return follower->isActive() == follow;
+}
+
 
-    for (QString err : worker.getErrors())
+void DataSourceManager::removeFollowers(DataSourcePointer source)
+{
+    for (int idx = followers.size() - 1; idx >= 0; idx--)
     {
-        // TODO: Display these better?
-        qWarning() << "Export err:" << err;
+        if (followers.at(idx)->getSource() == source)
+        {
+            followers.removeAt(idx);
+        }
     }
+}
 
-    bool result = worker.getResult();
 
-    return result;
+void DataSourceManager::removeFollowers(QSharedPointer<ImportPlugin> plugin)
+{
+    for (int idx = followers.size() - 1; idx >= 0; idx--)
+    {
+        if (followers.at(idx)->getPlugin() == plugin)
+        {
+            if (followers.at(idx)->isActive())
+            {
+                qInfo() << "Stopped following file:" << followers.at(idx)->getFilename();
+            }
+
+            followers.removeAt(idx);
+        }
+    }
 }
@@ -6,61 +6,11 @@
 #include "data_source.hpp"
 #include "plugin_importer.hpp"
 #include "plugin_exporter.hpp"
-
-
-class DataIOWorker : public QObject
-{
-public:
-    bool getResult(void) const { return m_result; }
-    QStringList getErrors(void) const { return m_errors; }
-    bool isComplete(void) const { return m_complete; }
-protected:
-    QStringList m_errors;
-    bool m_complete = false;
-    bool m_result = false;
-};
-
-
-/**
- * @brief The DataImportWorker class manages a data import session
- */
-class DataImportWorker : public DataIOWorker
-{
-    Q_OBJECT
-
-public:
-    DataImportWorker(QSharedPointer<ImportPlugin> plugin);
-
-public slots:
-    void runImport(void);
-    void cancelImport(void);
-
-signals:
-    void importCompleted(void);
-
-protected:
-    QSharedPointer<ImportPlugin> m_plugin;
-};
-
-
-class DataExportWorker : public DataIOWorker
-{
-    Q_OBJECT
-
-public:
-    DataExportWorker(QSharedPointer<ExportPlugin> plugin, QList<DataSeriesPointer> &series);
-
-public slots:
-    void runExport(void);
-    void cancelExport(void);
-
-signals:
-    void exportCompleted(void);
-
-protected:
-    QSharedPointer<ExportPlugin> m_plugin;
-    QList<DataSeriesPointer> m_series;
-};
+#include "data_stream_session.hpp"
+#include "data_file_follower.hpp"
+#include "data_io_job.hpp"
+#include "data_import_scheduler.hpp"
+#include "series_registry.hpp"
 
 
 /*
@@ -97,6 +47,9 @@ public:
         }
     }
 
+    // Index of all series (in all sources), for fast lookup
+    SeriesRegistry *getRegistry(void) { return &registry; }
+
 public slots:
 
     DataSeriesPointer findSeries(QString source_label, QString series_label);
@@ -119,22 +72,87 @@ public slots:
 
     void removeAllSources(bool update = true);
 
-    // Data import functionality
+    // Data import functionality (asynchronous, returns once the import has been started)
     bool importData(QString filename = QString());
+    bool importFiles(QStringList filenames);
 
-    // Data export functionality
+    // Data export functionality (asynchronous, returns once the export has been started)
     bool exportData(QList<DataSeriesPointer> &series, QString filename = QString());
 
+    // Import / export jobs which have not yet finished
+    QList<DataIOJobPointer> getActiveJobs(void) const { return jobs; }
+
+    // Headless import / export (runs in the calling thread, without user interaction)
+    bool importFile(QString filename, QStringList &errors);
+    bool exportFile(QList<DataSeriesPointer> &series, QString filename, QStringList &errors);
+
+    QSharedPointer<ImportPlugin> getImporterForFile(QString filename) const;
+    QSharedPointer<ExportPlugin> getExporterForFile(QString filename) const;
+
+    // Import jobs (used by the import scheduler)
+    bool isImporterAvailable(QString filename) const;
+    DataIOJobPointer createImportJob(QString filename, bool configure, QStringList &errors, bool *cancelled = nullptr);
+
+    DataImportScheduler *getImportScheduler(void) { return scheduler; }
+
+    // Live data stream functionality
+    bool openStream(QString address);
+    void closeStream(DataSourcePointer source);
+
+    // Follow (tail) functionality for imported files
+    bool canFollowSource(DataSourcePointer source) const;
+    bool isFollowingSource(DataSourcePointer source) const;
+    bool followSource(DataSourcePointer source, bool follow = true);
+
     void update(void) { emit sourcesChanged(); }
 
 signals:
     void sourcesChanged();
 
+    void importFinished(QString filename, bool result);
+    void exportFinished(QString filename, bool result);
+
 protected slots:
     void onDataChanged() { emit sourcesChanged(); }
+    void onStreamClosed(void);
+
+    void onSeriesAdded(DataSeriesPointer series);
+    void onSeriesRemoved(DataSeriesPointer series);
+
+    void onImportJobFinished(bool result);
+    void onImportSeriesPublished(QList<DataSeriesPointer> series);
+    void onExportJobFinished(bool result);
 
 protected:
     QVector<DataSourcePointer> sources;
+
+    SeriesRegistry registry;
+
+    //! Currently open live data streams
+    QList<DataStreamSessionPointer> streams;
+
+    //! Followers for imported files which support "follow" mode
+    QList<DataFileFollowerPointer> followers;
+
+    //! Running import and export jobs
+    QList<DataIOJobPointer> jobs;
+
+    //! Scheduler for (concurrent) file imports
+    DataImportScheduler *scheduler = nullptr;
+
+    bool isPluginBusy(const PluginBase *plugin) const;
+    void removeJob(DataIOJob *job);
+    void showJobProgress(DataIOJobPointer job, QString title, QString label);
+
+    QSharedPointer<ImportPlugin> acquireImporter(QString filename, bool configure, QStringList &errors, bool *cancelled = nullptr);
+    QSharedPointer<ExportPlugin> acquireExporter(QString filename, bool configure, QStringList &errors);
+    DataSourcePointer addImportedSource(QSharedPointer<ImportPlugin> importer, QString filename);
+    void addSeriesToSource(DataSourcePointer source, QList<DataSeriesPointer> seriesList);
+    void addFollower(QSharedPointer<ImportPlugin> importer, DataSourcePointer source);
+
+    DataFileFollowerPointer getFollower(DataSourcePointer source) const;
+    void removeFollowers(DataSourcePointer source);
+    void removeFollowers(QSharedPointer<ImportPlugin> plugin);
 };
 
 
@@ -0,0 +1,550 @@
+#include <qthread.h>
+
+#include <algorithm>
+#include <string.h>
+
+#include "data_storage.hpp"
+
+
+template <typename Value> const uint64_t BasicDataStorage<Value>::BLOCK_SIZE;
+template <typename Value> const int BasicDataStorage<Value>::BLOCK_SHIFT;
+template <typename Value> const uint64_t BasicDataStorage<Value>::MIN_CAPACITY;
+
+
+namespace
+{
+
+// Number of blocks required to hold the specified number of samples
+uint64_t blocksRequired(uint64_t samples)
+{
+    return (samples + DataStorage::BLOCK_SIZE - 1) >> DataStorage::BLOCK_SHIFT;
+}
+
+}
+
+
+template <typename Value>
+BasicDataStorage<Value>::Index::Index(uint64_t c, uint64_t fc) :
+    capacity(std::max<uint64_t>(c, 1)),
+    firstCapacity(fc)
+{
+    timestamps = new double*[capacity]();
+    values = new Value*[capacity]();
+    first = new double[capacity]();
+}
+
+
+template <typename Value>
+BasicDataStorage<Value>::Index::~Index()
+{
+    for (uint64_t b = ownedFrom; b < capacity; b++)
+    {
+        delete[] timestamps[b];
+        delete[] values[b];
+    }
+
+    delete[] timestamps;
+    delete[] values;
+    delete[] first;
+}
+
+
+template <typename Value>
+uint64_t BasicDataStorage<Value>::Index::getOwnedBytes() const
+{
+    uint64_t bytes = capacity * (sizeof(double*) + sizeof(Value*) + sizeof(double));
+
+    for (uint64_t b = ownedFrom; b < capacity; b++)
+    {
+        if (timestamps[b])
+        {
+            bytes += (b == 0 ? firstCapacity : BLOCK_SIZE) * (sizeof(double) + sizeof(Value));
+        }
+    }
+
+    return bytes;
+}
+
+
+template <typename Value>
+BasicDataStorage<Value>::BasicDataStorage()
+{
+    readers[0] = 0;
+    readers[1] = 0;
+
+    current.store(new Index(1, 0));
+}
+
+
+template <typename Value>
+BasicDataStorage<Value>::~BasicDataStorage()
+{
+    reclaim(true);
+
+    delete current.load();
+}
+
+
+/*
+ * Register as a reader, and then load the current index.
+ *
+ * Registration is a single atomic increment, so readers never wait for the writer.
+ * The writer does not release a replaced index until every reader which may have loaded it has finished.
+ */
+template <typename Value>
+BasicDataStorage<Value>::Snapshot::Snapshot(const BasicDataStorage &s) : storage(s)
+{
+    slot = storage.epoch.load();
+
+    storage.readers[slot].fetch_add(1);
+
+    index = storage.current.load();
+    count = index->count.load(std::memory_order_acquire);
+}
+
+
+template <typename Value>
+BasicDataStorage<Value>::Snapshot::~Snapshot()
+{
+    storage.readers[slot].fetch_sub(1, std::memory_order_release);
+}
+
+
+template <typename Value>
+uint64_t BasicDataStorage<Value>::Snapshot::copy(uint64_t idx, uint64_t n, DataPoint *points) const
+{
+    if (idx >= count) return 0;
+
+    n = std::min<uint64_t>(n, count - idx);
+
+    // Copy each block section in turn
+    for (uint64_t copied = 0; copied < n;)
+    {
+        uint64_t pos = idx + copied;
+        uint64_t offset = pos & (BLOCK_SIZE - 1);
+        uint64_t chunk = std::min<uint64_t>(n - copied, BLOCK_SIZE - offset);
+
+        const double *t = index->timestamps[pos >> BLOCK_SHIFT] + offset;
+        const Value *v = index->values[pos >> BLOCK_SHIFT] + offset;
+
+        DataPoint *out = points + copied;
+
+        for (uint64_t ii = 0; ii < chunk; ii++)
+        {
+            out[ii].timestamp = t[ii];
+            out[ii].value = v[ii];
+        }
+
+        copied += chunk;
+    }
+
+    return n;
+}
+
+
+template <typename Value>
+std::vector<DataPoint> BasicDataStorage<Value>::Snapshot::toVector() const
+{
+    std::vector<DataPoint> points(count);
+
+    copy(0, count, points.data());
+
+    return points;
+}
+
+
+/*
+ * Two-level binary search:
+ * - Find the last block which starts before (or at, for the upper bound) the timestamp
+ * - Search within that block (the result may be the first sample of the following block)
+ */
+template <typename Value>
+uint64_t BasicDataStorage<Value>::Snapshot::search(double t, bool upper) const
+{
+    if (count == 0) return 0;
+
+    const double *first = index->first;
+    const double *end = first + blocksRequired(count);
+
+    const double *it = upper ? std::upper_bound(first, end, t) : std::lower_bound(first, end, t);
+
+    if (it == first) return 0;
+
+    uint64_t b = (it - first) - 1;
+    uint64_t start = b << BLOCK_SHIFT;
+
+    const double *timestamps = index->timestamps[b];
+    const double *last = timestamps + std::min<uint64_t>(BLOCK_SIZE, count - start);
+
+    const double *pos = upper ? std::upper_bound(timestamps, last, t) : std::lower_bound(timestamps, last, t);
+
+    return start + (pos - timestamps);
+}
+
+
+template <typename Value>
+uint64_t BasicDataStorage<Value>::getMemoryUsage() const
+{
+    Snapshot snapshot(*this);
+
+    const Index *index = snapshot.index;
+
+    uint64_t bytes = index->capacity * (sizeof(double*) + sizeof(Value*) + sizeof(double));
+    uint64_t blocks = blocksRequired(snapshot.count);
+
+    if (blocks > 0)
+    {
+        bytes += (index->firstCapacity + (blocks - 1) * BLOCK_SIZE) * (sizeof(double) + sizeof(Value));
+    }
+
+    return bytes + retiredBytes.load(std::memory_order_relaxed);
+}
+
+
+template <typename Value>
+DataPoint BasicDataStorage<Value>::back() const
+{
+    const Index *index = current.load(std::memory_order_relaxed);
+
+    uint64_t idx = index->count.load(std::memory_order_relaxed) - 1;
+
+    uint64_t b = idx >> BLOCK_SHIFT;
+    uint64_t offset = idx & (BLOCK_SIZE - 1);
+
+    return DataPoint(index->timestamps[b][offset], index->values[b][offset]);
+}
+
+
+/*
+ * The sample is written beyond the published length (where readers do not access it),
+ * and then published by incrementing the length.
+ */
+template <typename Value>
+void BasicDataStorage<Value>::append(const DataPoint &point)
+{
+    Index *index = current.load(std::memory_order_relaxed);
+
+    uint64_t n = index->count.load(std::memory_order_relaxed);
+
+    bool full = n < BLOCK_SIZE ? n >= index->firstCapacity : (n >> BLOCK_SHIFT) >= index->capacity;
+
+    if (full)
+    {
+        ensureCapacity(n + 1);
+        index = current.load(std::memory_order_relaxed);
+    }
+    else if (!retired.empty())
+    {
+        reclaim(false);
+    }
+
+    write(index, n, point);
+
+    index->count.store(n + 1, std::memory_order_release);
+    length.store(n + 1, std::memory_order_release);
+}
+
+
+template <typename Value>
+void BasicDataStorage<Value>::reserveAdditional(uint64_t count)
+{
+    ensureCapacity(size() + count);
+}
+
+
+/*
+ * Samples below the published length cannot be moved in place,
+ * so the merged data are written to new blocks.
+ * Blocks which precede the first merged sample are shared with the new index.
+ */
+template <typename Value>
+void BasicDataStorage<Value>::merge(const std::vector<DataPoint> &points)
+{
+    if (points.empty()) return;
+
+    Index *index = current.load(std::memory_order_relaxed);
+
+    uint64_t n = index->count.load(std::memory_order_relaxed);
+    uint64_t start = 0;
+
+    {
+        Snapshot snapshot(*this);
+
+        start = snapshot.upperBound(points.front().timestamp);
+    }
+
+    uint64_t shared = start >> BLOCK_SHIFT;
+    uint64_t total = n + points.size();
+
+    uint64_t firstCapacity = total < BLOCK_SIZE ? std::max(total, index->firstCapacity) : BLOCK_SIZE;
+
+    Index *replacement = new Index(std::max(blocksRequired(total), index->capacity), firstCapacity);
+
+    for (uint64_t b = 0; b < shared; b++)
+    {
+        replacement->timestamps[b] = index->timestamps[b];
+        replacement->values[b] = index->values[b];
+        replacement->first[b] = index->first[b];
+    }
+
+    auto sample = [index](uint64_t idx) {
+        uint64_t b = idx >> BLOCK_SHIFT;
+        uint64_t offset = idx & (BLOCK_SIZE - 1);
+
+        return DataPoint(index->timestamps[b][offset], index->values[b][offset]);
+    };
+
+    uint64_t ii = shared << BLOCK_SHIFT;
+    uint64_t m = ii;
+
+    auto it = points.begin();
+
+    // Existing samples are placed first, where the timestamps are equal
+    while (ii < n || it != points.end())
+    {
+        if (it == points.end() || (ii < n && !(it->timestamp < sample(ii).timestamp)))
+        {
+            write(replacement, m++, sample(ii++));
+        }
+        else
+        {
+            write(replacement, m++, *it++);
+        }
+    }
+
+    replacement->count.store(m, std::memory_order_relaxed);
+
+    index->ownedFrom = shared;
+
+    publish(replacement);
+}
+
+
+template <typename Value>
+void BasicDataStorage<Value>::assign(const std::vector<DataPoint> &points)
+{
+    uint64_t n = points.size();
+
+    Index *replacement = new Index(blocksRequired(n), std::min<uint64_t>(n, BLOCK_SIZE));
+
+    for (uint64_t ii = 0; ii < n; ii++)
+    {
+        write(replacement, ii, points[ii]);
+    }
+
+    replacement->count.store(n, std::memory_order_relaxed);
+
+    publish(replacement);
+}
+
+
+/*
+ * Samples beyond the new length could be read by an existing snapshot,
+ * so the partial last block is copied (rather than being overwritten by subsequent appends).
+ * The preceding blocks are shared with the new index.
+ */
+template <typename Value>
+void BasicDataStorage<Value>::truncate(uint64_t count)
+{
+    Index *index = current.load(std::memory_order_relaxed);
+
+    uint64_t n = index->count.load(std::memory_order_relaxed);
+
+    if (count >= n) return;
+
+    if (count == 0)
+    {
+        clear();
+        return;
+    }
+
+    uint64_t shared = count >> BLOCK_SHIFT;
+    uint64_t partial = count & (BLOCK_SIZE - 1);
+
+    Index *replacement = new Index(index->capacity, index->firstCapacity);
+
+    for (uint64_t b = 0; b < shared; b++)
+    {
+        replacement->timestamps[b] = index->timestamps[b];
+        replacement->values[b] = index->values[b];
+        replacement->first[b] = index->first[b];
+    }
+
+    if (partial > 0)
+    {
+        allocateBlock(replacement, shared, shared == 0 ? replacement->firstCapacity : BLOCK_SIZE);
+
+        replacement->first[shared] = index->first[shared];
+
+        memcpy(replacement->timestamps[shared], index->timestamps[shared], partial * sizeof(double));
+        memcpy(replacement->values[shared], index->values[shared], partial * sizeof(Value));
+    }
+
+    replacement->count.store(count, std::memory_order_relaxed);
+
+    index->ownedFrom = shared;
+
+    publish(replacement);
+}
+
+
+template <typename Value>
+void BasicDataStorage<Value>::clear()
+{
+    if (size() == 0 && retired.empty()) return;
+
+    publish(new Index(1, 0));
+}
+
+
+template <typename Value>
+void BasicDataStorage<Value>::allocateBlock(Index *index, uint64_t b, uint64_t capacity)
+{
+    // Columns are not initialized
+    index->timestamps[b] = new double[capacity];
+    index->values[b] = new Value[capacity];
+}
+
+
+template <typename Value>
+void BasicDataStorage<Value>::write(Index *index, uint64_t n, const DataPoint &point)
+{
+    uint64_t b = n >> BLOCK_SHIFT;
+    uint64_t offset = n & (BLOCK_SIZE - 1);
+
+    if (offset == 0)
+    {
+        if (!index->timestamps[b])
+        {
+            allocateBlock(index, b, b == 0 ? index->firstCapacity : BLOCK_SIZE);
+        }
+
+        index->first[b] = point.timestamp;
+    }
+
+    index->timestamps[b][offset] = point.timestamp;
+    index->values[b][offset] = (Value) point.value;
+}
+
+
+/*
+ * The first block grows geometrically (and is copied), until it reaches the full block size.
+ * Otherwise, the block index grows geometrically, and the blocks are shared with the new index.
+ */
+template <typename Value>
+void BasicDataStorage<Value>::ensureCapacity(uint64_t required)
+{
+    Index *index = current.load(std::memory_order_relaxed);
+
+    uint64_t n = index->count.load(std::memory_order_relaxed);
+
+    uint64_t firstCapacity = index->firstCapacity;
+    uint64_t capacity = index->capacity;
+
+    if (required > firstCapacity && firstCapacity < BLOCK_SIZE)
+    {
+        firstCapacity = std::min(BLOCK_SIZE, std::max(required, std::max(firstCapacity * 2, MIN_CAPACITY)));
+    }
+
+    if (blocksRequired(required) > capacity)
+    {
+        capacity = std::max(blocksRequired(required), capacity * 2);
+    }
+
+    if (firstCapacity == index->firstCapacity && capacity == index->capacity) return;
+
+    Index *replacement = new Index(capacity, firstCapacity);
+
+    if (firstCapacity != index->firstCapacity)
+    {
+        // The first block is the only block, and is copied
+        if (n > 0)
+        {
+            allocateBlock(replacement, 0, firstCapacity);
+
+            replacement->first[0] = index->first[0];
+
+            memcpy(replacement->timestamps[0], index->timestamps[0], n * sizeof(double));
+            memcpy(replacement->values[0], index->values[0], n * sizeof(Value));
+        }
+    }
+    else
+    {
+        for (uint64_t b = 0; b < index->capacity; b++)
+        {
+            replacement->timestamps[b] = index->timestamps[b];
+            replacement->values[b] = index->values[b];
+            replacement->first[b] = index->first[b];
+        }
+
+        index->ownedFrom = index->capacity;
+    }
+
+    replacement->count.store(n, std::memory_order_relaxed);
+
+    publish(replacement);
+}
+
+
+template <typename Value>
+void BasicDataStorage<Value>::publish(Index *index)
+{
+    Index *previous = current.exchange(index);
+
+    length.store(index->count.load(std::memory_order_relaxed), std::memory_order_release);
+
+    retired.push_back(previous);
+    retiredBytes.fetch_add(previous->getOwnedBytes(), std::memory_order_relaxed);
+
+    // Limit the memory held by retired blocks (growing the storage never waits)
+    reclaim(retiredBytes.load(std::memory_order_relaxed) > index->getOwnedBytes());
+}
+
+
+template <typename Value>
+void BasicDataStorage<Value>::reclaim(bool wait)
+{
+    if (retired.empty()) return;
+
+    // A reader which registers after these checks will load the current index
+    bool idle = readers[0].load() == 0 && readers[1].load() == 0;
+
+    if (!idle)
+    {
+        if (!wait) return;
+
+        synchronize();
+    }
+
+    for (Index *index : retired)
+    {
+        delete index;
+    }
+
+    retired.clear();
+    retiredBytes.store(0, std::memory_order_relaxed);
+}
+
+
+/*
+ * Wait for the readers in each slot in turn.
+ * New readers register in the other slot, so this cannot be held off indefinitely.
+ * (Both slots are drained, as a reader may load the epoch well before registering)
+ */
+template <typename Value>
+void BasicDataStorage<Value>::synchronize()
+{
+    for (int ii = 0; ii < 2; ii++)
+    {
+        int slot = epoch.fetch_xor(1);
+
+        while (readers[slot].load() != 0)
+        {
+            QThread::yieldCurrentThread();
+        }
+    }
+}
+
+
+template class BasicDataStorage<double>;
+template class BasicDataStorage<float>;
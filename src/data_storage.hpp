@@ -0,0 +1,212 @@
+#ifndef DATA_STORAGE_HPP
+#define DATA_STORAGE_HPP
+
+#include <atomic>
+#include <vector>
+
+#include <stdint.h>
+
+#include "data_point.hpp"
+
+
+/**
+ * @brief The BasicDataStorage class stores the samples for in-memory DataSeries objects
+ *
+ * Samples are stored in fixed-size blocks of BLOCK_SIZE samples, referenced by a block index.
+ * Each block holds a timestamp column (double) and a value column (of type Value),
+ * so that single precision values require 12 bytes per sample, rather than 16.
+ *
+ * - Blocks are never moved once allocated, so appending never copies existing data
+ *   (and peak memory is the live memory, rather than double while a buffer is reallocated)
+ * - Only the (small) block index is reallocated as the data grow
+ * - The first block grows geometrically up to BLOCK_SIZE, so that short series remain small
+ * - Timestamps are located with a two-level binary search:
+ *   over the first timestamp of each block, and then within a single block
+ *
+ * Samples can be read concurrently with modification, without locking:
+ *
+ * - Samples are never modified below the published length,
+ *   so new samples are appended in place, and then published by atomically updating the length
+ * - Any other change (inserting or removing samples) builds a new block index,
+ *   which atomically replaces the current index (read-copy-update).
+ *   Blocks before the first modified sample are shared with the new index, rather than copied.
+ * - Readers access the data via a Snapshot, which registers the reader (without blocking)
+ *   so that a replaced index (or block) is not released while it may still be read
+ *
+ * Replaced blocks are released as soon as no readers are active.
+ * If readers are continuously active, the writer eventually waits for
+ * the readers of the replaced blocks to finish (readers never wait).
+ *
+ * Functions which modify the data must be serialized by the caller,
+ * and must not be called while the calling thread holds a Snapshot.
+ */
+template <typename Value>
+class BasicDataStorage
+{
+public:
+    //! Number of samples in each block (must be a power of two)
+    static const uint64_t BLOCK_SIZE = 0x10000;
+    static const int BLOCK_SHIFT = 16;
+
+    //! Initial capacity of the first block
+    static const uint64_t MIN_CAPACITY = 0x100;
+
+protected:
+    struct Index
+    {
+        Index(uint64_t capacity, uint64_t firstCapacity);
+        ~Index();
+
+        // Memory (bytes) released when this index is deleted
+        uint64_t getOwnedBytes(void) const;
+
+        //! Timestamp and value columns of each block (unallocated blocks are null)
+        double **timestamps = nullptr;
+        Value **values = nullptr;
+
+        //! Timestamp of the first sample in each block
+        double *first = nullptr;
+
+        //! Number of block slots
+        uint64_t capacity = 0;
+
+        //! Capacity (samples) of the first block
+        uint64_t firstCapacity = 0;
+
+        //! Blocks below this index are shared with a newer index (and are not deleted with this index)
+        uint64_t ownedFrom = 0;
+
+        //! Number of valid samples (samples below this index are never modified)
+        std::atomic<uint64_t> count {0};
+    };
+
+public:
+    BasicDataStorage();
+    ~BasicDataStorage();
+
+    /**
+     * @brief The Snapshot class provides read access to the samples at the time it was constructed
+     *
+     * Samples which are added while the snapshot exists are not visible to it.
+     * A snapshot should be short lived (e.g. for the duration of a single access or copy),
+     * as replaced blocks cannot be released while it exists.
+     */
+    class Snapshot
+    {
+    public:
+        Snapshot(const BasicDataStorage &storage);
+        ~Snapshot();
+
+        uint64_t size(void) const { return count; }
+        bool isEmpty(void) const { return count == 0; }
+
+        // Return the sample at the specified index (no bounds checking)
+        DataPoint at(uint64_t idx) const
+        {
+            uint64_t b = idx >> BLOCK_SHIFT;
+            uint64_t offset = idx & (BLOCK_SIZE - 1);
+
+            return DataPoint(index->timestamps[b][offset], index->values[b][offset]);
+        }
+
+        DataPoint front(void) const { return at(0); }
+        DataPoint back(void) const { return at(count - 1); }
+
+        // Copy (up to) n samples starting at idx, returns the number of samples copied
+        uint64_t copy(uint64_t idx, uint64_t n, DataPoint *points) const;
+
+        // Index of the first sample with timestamp not less than (lower) or greater than (upper) t
+        uint64_t lowerBound(double t) const { return search(t, false); }
+        uint64_t upperBound(double t) const { return search(t, true); }
+
+        std::vector<DataPoint> toVector(void) const;
+
+    protected:
+        uint64_t search(double t, bool upper) const;
+
+        const BasicDataStorage &storage;
+        const Index *index = nullptr;
+
+        uint64_t count = 0;
+
+        //! Reader slot which was registered
+        int slot = 0;
+
+    private:
+        friend class BasicDataStorage;
+
+        Snapshot(const Snapshot &) = delete;
+        Snapshot& operator=(const Snapshot &) = delete;
+    };
+
+    //! Number of samples (may be read from any thread)
+    uint64_t size(void) const { return length.load(std::memory_order_acquire); }
+
+    // Allocated memory (bytes), including replaced blocks which have not yet been released
+    uint64_t getMemoryUsage(void) const;
+
+    /* Modification functions (must be serialized by the caller) */
+
+    // Return the newest sample, for the writer (the storage must not be empty)
+    DataPoint back(void) const;
+
+    // Append a sample (timestamp order is not checked)
+    void append(const DataPoint &point);
+
+    // Ensure that count samples can be appended without growing the first block or the block index
+    void reserveAdditional(uint64_t count);
+
+    // Merge samples (sorted by timestamp) into the existing data, in a single pass
+    // Samples are placed after any existing samples with the same timestamp
+    void merge(const std::vector<DataPoint> &points);
+
+    // Replace the data with the provided samples (which must be sorted by timestamp)
+    void assign(const std::vector<DataPoint> &points);
+
+    // Discard all samples after the first count samples
+    void truncate(uint64_t count);
+
+    void clear(void);
+
+protected:
+    // Allocate the columns of block b of an index
+    static void allocateBlock(Index *index, uint64_t b, uint64_t capacity);
+
+    // Write a sample at position n of an index (allocating the block if required)
+    static void write(Index *index, uint64_t n, const DataPoint &point);
+
+    // Grow the first block and/or block index of the current index, to hold the required number of samples
+    void ensureCapacity(uint64_t required);
+
+    // Replace the current index, and retire the previous index
+    void publish(Index *index);
+
+    // Release retired indexes (waiting for active readers if required)
+    void reclaim(bool wait);
+
+    // Wait until all readers which registered before this call have finished
+    void synchronize(void);
+
+    //! Index which is currently visible to readers
+    std::atomic<Index*> current {nullptr};
+
+    //! Number of published samples
+    std::atomic<uint64_t> length {0};
+
+    //! Active readers, in two slots which alternate between grace periods
+    mutable std::atomic<int> readers[2];
+    std::atomic<int> epoch {0};
+
+    //! Indexes which have been replaced, but may still be in use by readers
+    std::vector<Index*> retired;
+    std::atomic<uint64_t> retiredBytes {0};
+};
+
+
+//! Storage for samples with double precision values
+typedef BasicDataStorage<double> DataStorage;
+
+//! Storage for samples with single precision values
+typedef BasicDataStorage<float> Float32Storage;
+
+#endif // DATA_STORAGE_HPP
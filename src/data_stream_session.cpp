@@ -0,0 +1,276 @@
+#include <QLocalSocket>
+#include <QFile>
+
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#include <poll.h>
+#endif
+
+#include "data_stream_session.hpp"
+#include "lumberjack_settings.hpp"
+
+
+/*
+ * Wait (up to the specified time) for data to become available on the device.
+ * Returns true if data can be read without blocking.
+ */
+static bool waitForData(QIODevice *device, int msecs)
+{
+    QLocalSocket *socket = qobject_cast<QLocalSocket*>(device);
+
+    if (socket)
+    {
+        return socket->bytesAvailable() > 0 || socket->waitForReadyRead(msecs);
+    }
+
+#ifdef Q_OS_UNIX
+    QFile *file = qobject_cast<QFile*>(device);
+
+    if (file && file->handle() >= 0)
+    {
+        struct pollfd pfd;
+
+        pfd.fd = file->handle();
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+
+        // POLLHUP also indicates readiness, so that end-of-file is detected
+        return ::poll(&pfd, 1, msecs) > 0;
+    }
+#endif
+
+    return true;
+}
+
+
+/*
+ * Read whatever data are currently available from the device.
+ *
+ * QFile::read() on an unbuffered pipe blocks until the *entire* requested size is read,
+ * which adds unbounded latency for slow streams. On UNIX, read from the file descriptor directly.
+ */
+static qint64 readAvailable(QIODevice *device, char *data, qint64 maxSize)
+{
+#ifdef Q_OS_UNIX
+    QFile *file = qobject_cast<QFile*>(device);
+
+    if (file && file->handle() >= 0)
+    {
+        return ::read(file->handle(), data, maxSize);
+    }
+#endif
+
+    return device->read(data, maxSize);
+}
+
+
+DataStreamWorker::DataStreamWorker(QSharedPointer<StreamPlugin> plugin) : m_plugin(plugin)
+{
+}
+
+
+/*
+ * Read and decode data until the stream is closed or cancelled
+ */
+void DataStreamWorker::runStream()
+{
+    m_errors.clear();
+
+    if (m_plugin.isNull())
+    {
+        emit streamCompleted();
+        return;
+    }
+
+    QIODevice *device = m_plugin->openDevice(m_errors);
+
+    if (!device)
+    {
+        emit streamCompleted();
+        return;
+    }
+
+    m_plugin->resetStream();
+
+    m_running = true;
+
+    QLocalSocket *socket = qobject_cast<QLocalSocket*>(device);
+
+    QByteArray buffer;
+    QByteArray chunk(READ_CHUNK_SIZE, Qt::Uninitialized);
+
+    while (m_running)
+    {
+        // Wait (briefly) for data, so that cancellation is responsive
+        if (!waitForData(device, 100))
+        {
+            if (socket && socket->state() != QLocalSocket::ConnectedState) break;
+            continue;
+        }
+
+        qint64 n = readAvailable(device, chunk.data(), chunk.size());
+
+        if (n < 0)
+        {
+            m_errors.append(tr("Error reading from stream") + ": " + device->errorString());
+            break;
+        }
+
+        if (n == 0)
+        {
+            // End of file (pipe closed by the writer)
+            if (!socket) break;
+            continue;
+        }
+
+        buffer.append(chunk.constData(), n);
+
+        qint64 consumed = m_plugin->decodeFrames(buffer, m_errors);
+
+        if (consumed > 0)
+        {
+            buffer.remove(0, consumed);
+        }
+    }
+
+    m_running = false;
+
+    device->close();
+    delete device;
+
+    m_plugin->afterStream();
+
+    emit streamCompleted();
+}
+
+
+/*
+ * Request that the stream stops (takes effect within one poll interval)
+ */
+void DataStreamWorker::cancelStream()
+{
+    m_running = false;
+}
+
+
+DataStreamSession::DataStreamSession(QSharedPointer<StreamPlugin> plugin, DataSourcePointer source) :
+    m_plugin(plugin),
+    m_source(source)
+{
+    auto *settings = LumberjackSettings::getInstance();
+
+    int interval = settings->loadSetting("stream", "updateInterval", 100).toInt();
+
+    m_updateTimer.setInterval(qMax(10, interval));
+
+    connect(&m_updateTimer, &QTimer::timeout, this, &DataStreamSession::flushUpdates);
+}
+
+
+DataStreamSession::~DataStreamSession()
+{
+    stop();
+}
+
+
+void DataStreamSession::start()
+{
+    if (m_plugin.isNull() || m_source.isNull() || isActive()) return;
+
+    m_plugin->clearDataSeries();
+
+    m_worker = new DataStreamWorker(m_plugin);
+    m_worker->moveToThread(&m_thread);
+
+    // Series are created in the streaming thread, but added to the source in this thread
+    connect(m_plugin.data(), &StreamPlugin::seriesCreated, this, &DataStreamSession::onSeriesCreated, Qt::QueuedConnection);
+
+    connect(&m_thread, &QThread::started, m_worker, &DataStreamWorker::runStream);
+    connect(m_worker, &DataStreamWorker::streamCompleted, &m_thread, &QThread::quit);
+    connect(&m_thread, &QThread::finished, this, &DataStreamSession::onStreamCompleted);
+
+    m_thread.start();
+    m_updateTimer.start();
+
+    qDebug() << "Streaming data from" << m_plugin->getAddress();
+}
+
+
+void DataStreamSession::stop()
+{
+    if (m_worker)
+    {
+        m_worker->cancelStream();
+    }
+
+    m_thread.quit();
+    m_thread.wait();
+
+    m_updateTimer.stop();
+
+    // Thread has finished, so the worker can be deleted directly
+    deleteWorker();
+}
+
+
+void DataStreamSession::onSeriesCreated(DataSeriesPointer series)
+{
+    if (!m_source.isNull() && !series.isNull())
+    {
+        m_source->addSeries(series);
+    }
+}
+
+
+void DataStreamSession::onStreamCompleted()
+{
+    // Queued from a previous run, after the stream was stopped and restarted
+    if (isActive()) return;
+
+    // Deliver any remaining data
+    flushUpdates();
+
+    m_updateTimer.stop();
+
+    deleteWorker();
+
+    disconnect(m_plugin.data(), &StreamPlugin::seriesCreated, this, &DataStreamSession::onSeriesCreated);
+
+    qDebug() << "Stream closed:" << m_plugin->getAddress();
+
+    emit streamClosed();
+}
+
+
+/*
+ * Report any errors from the worker, and delete it (the thread must have finished)
+ */
+void DataStreamSession::deleteWorker()
+{
+    if (!m_worker) return;
+
+    for (QString err : m_worker->getErrors())
+    {
+        qWarning() << "Stream err:" << err;
+    }
+
+    delete m_worker;
+    m_worker = nullptr;
+}
+
+
+/*
+ * Emit a single dataUpdated() signal for each series which has received new data
+ */
+void DataStreamSession::flushUpdates()
+{
+    if (m_plugin.isNull()) return;
+
+    for (auto series : m_plugin->getDataSeries())
+    {
+        if (!series.isNull())
+        {
+            series->flushUpdate();
+        }
+    }
+}
@@ -0,0 +1,94 @@
+#ifndef DATA_STREAM_SESSION_HPP
+#define DATA_STREAM_SESSION_HPP
+
+#include <QThread>
+#include <QTimer>
+
+#include <atomic>
+
+#include "data_source.hpp"
+#include "plugin_stream.hpp"
+
+
+/**
+ * @brief The DataStreamWorker class reads from a live stream in a background thread
+ */
+class DataStreamWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    DataStreamWorker(QSharedPointer<StreamPlugin> plugin);
+
+    QStringList getErrors(void) const { return m_errors; }
+    bool isRunning(void) const { return m_running; }
+
+    // Number of bytes read per call to the device
+    static const qint64 READ_CHUNK_SIZE = 0x10000;
+
+public slots:
+    void runStream(void);
+    void cancelStream(void);
+
+signals:
+    void streamCompleted(void);
+
+protected:
+    QSharedPointer<StreamPlugin> m_plugin;
+
+    QStringList m_errors;
+
+    std::atomic<bool> m_running {false};
+};
+
+
+/**
+ * @brief The DataStreamSession class manages a single live data stream
+ *
+ * - Runs a DataStreamWorker in a dedicated thread
+ * - Adds series to the associated DataSource as they are discovered
+ * - Emits throttled dataUpdated() signals at a fixed interval,
+ *   rather than one signal per received sample
+ */
+class DataStreamSession : public QObject
+{
+    Q_OBJECT
+
+public:
+    DataStreamSession(QSharedPointer<StreamPlugin> plugin, DataSourcePointer source);
+    virtual ~DataStreamSession();
+
+    QSharedPointer<StreamPlugin> getPlugin(void) const { return m_plugin; }
+    DataSourcePointer getSource(void) const { return m_source; }
+
+    bool isActive(void) const { return m_thread.isRunning(); }
+
+public slots:
+    void start(void);
+    void stop(void);
+
+signals:
+    void streamClosed(void);
+
+protected slots:
+    void onSeriesCreated(DataSeriesPointer series);
+    void onStreamCompleted(void);
+    void flushUpdates(void);
+
+protected:
+    void deleteWorker(void);
+
+    QSharedPointer<StreamPlugin> m_plugin;
+    DataSourcePointer m_source;
+
+    DataStreamWorker *m_worker = nullptr;
+    QThread m_thread;
+
+    //! Timer for throttling data update signals
+    QTimer m_updateTimer;
+};
+
+typedef QSharedPointer<DataStreamSession> DataStreamSessionPointer;
+
+
+#endif // DATA_STREAM_SESSION_HPP
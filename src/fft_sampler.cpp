@@ -1,8 +1,8 @@
 #include <qmath.h>
 #include <qglobal.h>
-#include <qelapsedtimer.h>
 
 #include "fft_sampler.hpp"
+#include "performance_monitor.hpp"
 
 #define __USE_SQUARE_BRACKETS_FOR_ELEMENT_ACCESS_OPERATOR
 
@@ -28,8 +28,7 @@ void FFTCurveUpdater::updateCurveSamples(double t_min, double t_max, unsigned in
 {
     Q_UNUSED(n_pixels);
 
-    QElapsedTimer fft_timer;
-    fft_timer.restart();
+    PerformanceScope scope("Plot/FFT", series.getLabel());
 
     // Initialize empty arrays
     QVector<double> x_data;
@@ -92,13 +91,21 @@ void FFTCurveUpdater::updateCurveSamples(double t_min, double t_max, unsigned in
     RealArray1D data_in(N);
     ComplexArray1D data_out(N);
 
-    // Copy across the data
-    for (uint64_t ii = 0; ii < N; ii++)
+    // Copy across the data (in a single bulk read)
+    std::vector<DataPoint> samples(qMin<uint64_t>(N, n_samples));
+
+    uint64_t n_read = series.getDataPoints(idx_min, samples.size(), samples.data());
+
+    if (n_read == 0)
     {
-        uint64_t wrapped_idx = ii % n_samples;
+        emit sampleComplete(x_data, y_data);
+        return;
+    }
 
+    for (uint64_t ii = 0; ii < N; ii++)
+    {
         // If we have to pad out the data, wrap it around on itself
-        data_in[ii] = series.getDataPoint(idx_min + wrapped_idx).value;
+        data_in[ii] = samples[ii % n_read].value;
     }
 
     const char* error;
@@ -0,0 +1,324 @@
+#include <QThread>
+
+#include <thread>
+#include <atomic>
+
+#include "filter_pipeline.hpp"
+#include "filtered_data_series.hpp"
+
+
+const size_t FilterPipeline::BLOCK_SIZE;
+const size_t FilterPipeline::MIN_SAMPLES_PER_THREAD;
+
+
+FilterPipeline::FilterPipeline(const FilterPipeline &other)
+{
+    *this = other;
+}
+
+
+FilterPipeline &FilterPipeline::operator=(const FilterPipeline &other)
+{
+    if (this == &other) return *this;
+
+    filters.clear();
+
+    for (auto filter : other.filters)
+    {
+        append(*filter);
+    }
+
+    return *this;
+}
+
+
+void FilterPipeline::append(const FilterPlugin &filter)
+{
+    FilterPlugin *instance = filter.createInstance();
+
+    if (instance)
+    {
+        filters.append(QSharedPointer<FilterPlugin>(instance));
+    }
+    else
+    {
+        qWarning() << "Could not create instance of filter" << filter.pluginName();
+    }
+}
+
+
+bool FilterPipeline::isStateless() const
+{
+    for (auto filter : filters)
+    {
+        if (!filter->isStateless()) return false;
+    }
+
+    return true;
+}
+
+
+bool FilterPipeline::isParallelSafe() const
+{
+    for (auto filter : filters)
+    {
+        if (!filter->isParallelSafe()) return false;
+    }
+
+    return true;
+}
+
+
+void FilterPipeline::reset()
+{
+    for (auto filter : filters)
+    {
+        filter->reset();
+    }
+}
+
+
+size_t FilterPipeline::process(double *timestamps, double *values, size_t count)
+{
+    for (auto filter : filters)
+    {
+        if (count == 0) break;
+
+        FilterInput input;
+        FilterOutput output;
+
+        input.timestamps = FilterSpan<const double>(timestamps, count);
+        input.values = FilterSpan<const double>(values, count);
+
+        output.timestamps = FilterSpan<double>(timestamps, count);
+        output.values = FilterSpan<double>(values, count);
+
+        count = std::min(filter->process(input, output), count);
+    }
+
+    return count;
+}
+
+
+/*
+ * Samples are split into (column) blocks, processed, and written back.
+ * As filters never produce more samples than they consume, the output never overtakes the input.
+ */
+size_t FilterPipeline::process(DataPoint *points, size_t count)
+{
+    if (filters.isEmpty()) return count;
+
+    double timestamps[BLOCK_SIZE];
+    double values[BLOCK_SIZE];
+
+    size_t produced = 0;
+
+    for (size_t offset = 0; offset < count; offset += BLOCK_SIZE)
+    {
+        size_t n = std::min(BLOCK_SIZE, count - offset);
+
+        for (size_t ii = 0; ii < n; ii++)
+        {
+            timestamps[ii] = points[offset + ii].timestamp;
+            values[ii] = points[offset + ii].value;
+        }
+
+        n = process(timestamps, values, n);
+
+        for (size_t ii = 0; ii < n; ii++)
+        {
+            points[produced + ii] = DataPoint(timestamps[ii], values[ii]);
+        }
+
+        produced += n;
+    }
+
+    return produced;
+}
+
+
+void FilterPipeline::applyRange(const DataSeries &input, uint64_t first, uint64_t last, std::vector<double> &timestamps, std::vector<double> &values)
+{
+    std::vector<DataPoint> points(BLOCK_SIZE);
+
+    for (uint64_t idx = first; idx < last; idx += BLOCK_SIZE)
+    {
+        uint64_t n = input.getDataPoints(idx, std::min<uint64_t>(BLOCK_SIZE, last - idx), points.data());
+
+        if (n == 0) break;
+
+        size_t offset = timestamps.size();
+
+        timestamps.resize(offset + n);
+        values.resize(offset + n);
+
+        for (uint64_t ii = 0; ii < n; ii++)
+        {
+            timestamps[offset + ii] = points[ii].timestamp;
+            values[offset + ii] = points[ii].value;
+        }
+
+        n = process(timestamps.data() + offset, values.data() + offset, n);
+
+        timestamps.resize(offset + n);
+        values.resize(offset + n);
+    }
+}
+
+
+/**
+ * @brief FilterPipeline::apply - Apply the pipeline to an entire series
+ * @param input - Series to read
+ * @param output - Series to append the filtered samples to
+ * @param threads - Maximum number of threads (zero = number of available cores)
+ *
+ * The pipeline itself is not modified: each thread uses a copy of the pipeline (starting from a reset state).
+ */
+void FilterPipeline::apply(const DataSeries &input, DataSeries &output, int threads) const
+{
+    const uint64_t N = input.size();
+
+    if (N == 0) return;
+
+    if (threads <= 0)
+    {
+        threads = QThread::idealThreadCount();
+    }
+
+    if (!isParallelSafe())
+    {
+        threads = 1;
+    }
+
+    threads = (int) std::max<uint64_t>(1, std::min<uint64_t>(threads, N / MIN_SAMPLES_PER_THREAD));
+
+    std::vector<FilterPipeline> pipelines(threads, *this);
+    std::vector<std::vector<double>> timestamps(threads);
+    std::vector<std::vector<double>> values(threads);
+
+    for (auto &pipeline : pipelines)
+    {
+        pipeline.reset();
+    }
+
+    auto range = [&](int ii) { return N * ii / threads; };
+
+    if (threads == 1)
+    {
+        pipelines[0].applyRange(input, 0, N, timestamps[0], values[0]);
+    }
+    else
+    {
+        std::vector<std::thread> workers;
+
+        for (int ii = 0; ii < threads; ii++)
+        {
+            workers.emplace_back([&, ii]() {
+                pipelines[ii].applyRange(input, range(ii), range(ii + 1), timestamps[ii], values[ii]);
+            });
+        }
+
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    for (int ii = 0; ii < threads; ii++)
+    {
+        output.appendColumns(timestamps[ii].data(), values[ii].data(), timestamps[ii].size(), false);
+
+        // Release each block of results as soon as it has been appended
+        std::vector<double>().swap(timestamps[ii]);
+        std::vector<double>().swap(values[ii]);
+    }
+
+    output.update();
+}
+
+
+DataSeriesPointer FilterPipeline::createSeries(DataSeriesPointer input, bool materialize) const
+{
+    if (input.isNull()) return DataSeriesPointer();
+
+    DataSeriesPointer series;
+
+    if (isStateless() && !materialize)
+    {
+        series = DataSeriesPointer(new FilteredDataSeries(input, *this));
+    }
+    else
+    {
+        series = DataSeriesPointer(new DataSeries(input->getGroup(), input->getLabel()));
+
+        apply(*input, *series);
+    }
+
+    series->setUnits(input->getUnits());
+
+    return series;
+}
+
+
+QList<DataSeriesPointer> FilterPipeline::createSeries(const QList<DataSeriesPointer> &inputs, bool materialize) const
+{
+    if (inputs.count() == 1 || (isStateless() && !materialize))
+    {
+        QList<DataSeriesPointer> outputs;
+
+        for (auto input : inputs)
+        {
+            outputs.append(createSeries(input, materialize));
+        }
+
+        return outputs;
+    }
+
+    // Output series are constructed in this thread, and filled by the worker threads
+    QList<DataSeriesPointer> outputs;
+
+    for (auto input : inputs)
+    {
+        if (input.isNull())
+        {
+            outputs.append(DataSeriesPointer());
+            continue;
+        }
+
+        DataSeriesPointer output(new DataSeries(input->getGroup(), input->getLabel()));
+        output->setUnits(input->getUnits());
+
+        outputs.append(output);
+    }
+
+    std::atomic<int> next {0};
+
+    auto worker = [&]() {
+        int idx;
+
+        while ((idx = next++) < inputs.count())
+        {
+            if (inputs.at(idx).isNull()) continue;
+
+            apply(*inputs.at(idx), *outputs.at(idx), 1);
+        }
+    };
+
+    int threads = qBound(1, QThread::idealThreadCount(), inputs.count());
+
+    std::vector<std::thread> workers;
+
+    for (int ii = 1; ii < threads; ii++)
+    {
+        workers.emplace_back(worker);
+    }
+
+    worker();
+
+    for (auto &thread : workers)
+    {
+        thread.join();
+    }
+
+    return outputs;
+}
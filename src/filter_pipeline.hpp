@@ -0,0 +1,73 @@
+#ifndef FILTER_PIPELINE_HPP
+#define FILTER_PIPELINE_HPP
+
+#include <vector>
+
+#include "plugin_filter.hpp"
+#include "data_series.hpp"
+
+
+/**
+ * @brief The FilterPipeline class applies a chain of filters to blocks of samples
+ *
+ * - Each pipeline owns its own instance of each filter (see FilterPlugin::createInstance),
+ *   so copying a pipeline produces an independent pipeline with the same configuration
+ * - Blocks are processed in-place, by each filter in turn
+ * - A pipeline of stateless filters can be applied lazily at read time (see FilteredDataSeries),
+ *   otherwise the pipeline is applied to the entire series at once (materialized)
+ */
+class FilterPipeline
+{
+public:
+    FilterPipeline() = default;
+    FilterPipeline(const FilterPipeline &other);
+
+    FilterPipeline &operator=(const FilterPipeline &other);
+
+    // Add a new instance of the provided filter to the end of the pipeline
+    void append(const FilterPlugin &filter);
+
+    int count(void) const { return filters.count(); }
+    bool isEmpty(void) const { return filters.isEmpty(); }
+
+    const FilterPluginList &getFilters(void) const { return filters; }
+
+    bool isStateless(void) const;
+    bool isParallelSafe(void) const;
+
+    // Clear the state of all filters
+    void reset(void);
+
+    // Process a block of samples in-place, and return the number of samples produced
+    size_t process(double *timestamps, double *values, size_t count);
+
+    // Process an array of samples in-place, and return the number of samples produced
+    size_t process(DataPoint *points, size_t count);
+
+    // Apply the pipeline to all samples of the input series, and append the results to the output series
+    // Parallel-safe pipelines are applied to separate ranges of the input concurrently
+    void apply(const DataSeries &input, DataSeries &output, int threads = 0) const;
+
+    // Create a filtered copy of the input series
+    // Stateless pipelines are applied lazily (at read time) unless materialize is set
+    DataSeriesPointer createSeries(DataSeriesPointer input, bool materialize = false) const;
+
+    // Create a filtered copy of each input series
+    // Materialized series are computed concurrently (one series per thread)
+    QList<DataSeriesPointer> createSeries(const QList<DataSeriesPointer> &inputs, bool materialize = false) const;
+
+    //! Number of samples processed per block
+    static const size_t BLOCK_SIZE = 4096;
+
+    //! Minimum number of samples processed by each thread
+    static const size_t MIN_SAMPLES_PER_THREAD = 0x40000;
+
+protected:
+    // Apply the pipeline to a range of the input series, and append the results to the provided columns
+    void applyRange(const DataSeries &input, uint64_t first, uint64_t last, std::vector<double> &timestamps, std::vector<double> &values);
+
+    FilterPluginList filters;
+};
+
+
+#endif // FILTER_PIPELINE_HPP
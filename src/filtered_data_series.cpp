@@ -0,0 +1,137 @@
+#include "filtered_data_series.hpp"
+
+
+FilteredDataSeries::FilteredDataSeries(DataSeriesPointer source, const FilterPipeline &pipeline) :
+    DataSeries(source->getGroup(), source->getLabel()),
+    source(source),
+    pipeline(pipeline)
+{
+    if (!this->pipeline.isStateless())
+    {
+        qWarning() << "FilteredDataSeries requires a stateless filter pipeline:" << getLabel();
+    }
+
+    // Any change to the source data is a change to the filtered data
+    connect(source.data(), &DataSeries::dataUpdated, this, &DataSeries::update);
+}
+
+
+void FilteredDataSeries::addData(DataPoint point, bool update)
+{
+    Q_UNUSED(point);
+    Q_UNUSED(update);
+
+    qWarning() << "Cannot add data to filtered series" << getLabel();
+}
+
+
+void FilteredDataSeries::appendData(const std::vector<DataPoint> &points, bool update)
+{
+    Q_UNUSED(points);
+    Q_UNUSED(update);
+
+    qWarning() << "Cannot add data to filtered series" << getLabel();
+}
+
+
+void FilteredDataSeries::appendColumns(const double *timestamps, const double *values, uint64_t count, bool update)
+{
+    Q_UNUSED(timestamps);
+    Q_UNUSED(values);
+    Q_UNUSED(count);
+    Q_UNUSED(update);
+
+    qWarning() << "Cannot add data to filtered series" << getLabel();
+}
+
+
+void FilteredDataSeries::clipTimeRange(double t_min, double t_max, bool update)
+{
+    Q_UNUSED(t_min);
+    Q_UNUSED(t_max);
+    Q_UNUSED(update);
+
+    qWarning() << "Cannot clip filtered series" << getLabel();
+}
+
+
+void FilteredDataSeries::clearData(bool update)
+{
+    Q_UNUSED(update);
+
+    qWarning() << "Cannot clear filtered series" << getLabel();
+}
+
+
+void FilteredDataSeries::truncateData(uint64_t count, bool update)
+{
+    Q_UNUSED(count);
+    Q_UNUSED(update);
+
+    qWarning() << "Cannot truncate filtered series" << getLabel();
+}
+
+
+size_t FilteredDataSeries::size() const
+{
+    return source->size();
+}
+
+
+std::vector<DataPoint> FilteredDataSeries::getData() const
+{
+    std::vector<DataPoint> points(size());
+
+    points.resize(getRawDataPoints(0, points.size(), points.data()));
+
+    return points;
+}
+
+
+/*
+ * Filters may modify timestamps (while preserving their order),
+ * so the search is performed on the filtered timestamps.
+ */
+uint64_t FilteredDataSeries::getIndexForTimestamp(double t, SearchDirection direction) const
+{
+    uint64_t lo = 0;
+    uint64_t hi = size();
+
+    while (lo < hi)
+    {
+        uint64_t mid = lo + (hi - lo) / 2;
+
+        double timestamp = getRawDataPoint(mid).timestamp;
+
+        bool before = (direction == SEARCH_LEFT_TO_RIGHT) ? (timestamp <= t) : (timestamp < t);
+
+        if (before)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+
+DataPoint FilteredDataSeries::getRawDataPoint(uint64_t idx) const
+{
+    DataPoint point = source->getDataPoint(idx);
+
+    pipeline.process(&point, 1);
+
+    return point;
+}
+
+
+uint64_t FilteredDataSeries::getRawDataPoints(uint64_t idx, uint64_t count, DataPoint *points) const
+{
+    uint64_t n = source->getDataPoints(idx, count, points);
+
+    return pipeline.process(points, n);
+}
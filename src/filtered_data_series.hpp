@@ -0,0 +1,54 @@
+#ifndef FILTERED_DATA_SERIES_HPP
+#define FILTERED_DATA_SERIES_HPP
+
+#include "data_series.hpp"
+#include "filter_pipeline.hpp"
+
+
+/**
+ * @brief The FilteredDataSeries class is a read-only view of another series, with a filter pipeline applied
+ *
+ * No samples are stored: the pipeline is applied to each block of samples as it is read.
+ * The pipeline must be stateless, so that any range of the series can be read independently
+ * (and from multiple threads at once).
+ */
+class FilteredDataSeries : public DataSeries
+{
+    Q_OBJECT
+
+public:
+    FilteredDataSeries(DataSeriesPointer source, const FilterPipeline &pipeline);
+
+    DataSeriesPointer getSource(void) const { return source; }
+    const FilterPipeline &getPipeline(void) const { return pipeline; }
+
+    /* Data insertion functions (not supported) */
+    virtual void addData(DataPoint point, bool update=true) override;
+    virtual void appendData(const std::vector<DataPoint> &points, bool update=true) override;
+    virtual void appendColumns(const double *timestamps, const double *values, uint64_t count, bool update=true) override;
+
+    virtual void clipTimeRange(double t_min, double t_max, bool update=true) override;
+    virtual void clearData(bool update=true) override;
+    virtual void truncateData(uint64_t count, bool update=true) override;
+
+    /* Data access functions */
+    virtual size_t size() const override;
+
+    virtual std::vector<DataPoint> getData() const override;
+
+    virtual ValuePrecision getValuePrecision(void) const override { return source->getValuePrecision(); }
+
+    virtual uint64_t getIndexForTimestamp(double t, SearchDirection direction=SEARCH_LEFT_TO_RIGHT) const override;
+
+protected:
+    virtual DataPoint getRawDataPoint(uint64_t idx) const override;
+    virtual uint64_t getRawDataPoints(uint64_t idx, uint64_t count, DataPoint *points) const override;
+
+    DataSeriesPointer source;
+
+    //! Stateless filters are never modified by processing, so may be shared between readers
+    mutable FilterPipeline pipeline;
+};
+
+
+#endif // FILTERED_DATA_SERIES_HPP
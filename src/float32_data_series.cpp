@@ -0,0 +1,264 @@
+#include <math.h>
+#include <algorithm>
+#include <stdexcept>
+
+#include "float32_data_series.hpp"
+
+
+Float32DataSeries::Float32DataSeries(QString lbl) : DataSeries(lbl)
+{
+}
+
+
+Float32DataSeries::Float32DataSeries(QString grp, QString lbl) : DataSeries(grp, lbl)
+{
+}
+
+
+Float32DataSeries::~Float32DataSeries()
+{
+}
+
+
+void Float32DataSeries::addSample(const DataPoint &point)
+{
+    // Ignore NaN and inf values
+    if (isnan(point.value) || isinf(point.value)) return;
+
+    if (samples.size() == 0 || point.timestamp >= samples.back().timestamp)
+    {
+        samples.append(point);
+    }
+    else
+    {
+        bufferLateSample(point, samples.back().timestamp);
+    }
+}
+
+
+void Float32DataSeries::mergeSamples(const std::vector<DataPoint> &points)
+{
+    samples.merge(points);
+}
+
+
+void Float32DataSeries::addData(DataPoint point, bool do_update)
+{
+    lockData();
+
+    addSample(point);
+
+    data_mutex.unlock();
+
+    if (do_update)
+    {
+        update();
+    }
+    else
+    {
+        pendingUpdate = true;
+    }
+}
+
+
+void Float32DataSeries::appendData(const std::vector<DataPoint> &points, bool do_update)
+{
+    if (points.empty()) return;
+
+    lockData();
+
+    samples.reserveAdditional(points.size());
+
+    for (const DataPoint &point : points)
+    {
+        addSample(point);
+    }
+
+    data_mutex.unlock();
+
+    if (do_update)
+    {
+        update();
+    }
+    else
+    {
+        pendingUpdate = true;
+    }
+}
+
+
+/*
+ * Sorted columnar data are written directly into storage
+ */
+void Float32DataSeries::appendColumns(const double *t, const double *v, uint64_t count, bool do_update)
+{
+    if (count == 0) return;
+
+    lockData();
+
+    if (!isColumnSorted(t, count, samples.size() > 0 ? samples.back().timestamp : -INFINITY))
+    {
+        data_mutex.unlock();
+        appendColumnsAsPoints(t, v, count, do_update);
+        return;
+    }
+
+    samples.reserveAdditional(count);
+
+    for (uint64_t ii = 0; ii < count; ii++)
+    {
+        // Ignore NaN and inf values
+        if (isnan(v[ii]) || isinf(v[ii])) continue;
+
+        samples.append(DataPoint(t[ii], v[ii]));
+    }
+
+    data_mutex.unlock();
+
+    if (do_update)
+    {
+        update();
+    }
+    else
+    {
+        pendingUpdate = true;
+    }
+}
+
+
+void Float32DataSeries::clipTimeRange(double t_min, double t_max, bool do_update)
+{
+    if (t_min > t_max)
+    {
+        std::swap(t_min, t_max);
+    }
+
+    lockData();
+
+    mergeLateSamples();
+
+    std::vector<DataPoint> subset;
+
+    {
+        Float32Storage::Snapshot snapshot(samples);
+
+        uint64_t idx_min = snapshot.lowerBound(t_min);
+        uint64_t idx_max = snapshot.upperBound(t_max);
+
+        subset.resize(idx_max - idx_min);
+
+        snapshot.copy(idx_min, subset.size(), subset.data());
+    }
+
+    samples.assign(subset);
+
+    data_mutex.unlock();
+
+    if (do_update)
+    {
+        update();
+    }
+}
+
+
+void Float32DataSeries::clearData(bool do_update)
+{
+    lockData();
+
+    samples.clear();
+
+    clearLateSamples();
+
+    data_mutex.unlock();
+
+    if (do_update)
+    {
+        update();
+    }
+}
+
+
+void Float32DataSeries::truncateData(uint64_t count, bool do_update)
+{
+    lockData();
+
+    mergeLateSamples();
+
+    samples.truncate(count);
+
+    data_mutex.unlock();
+
+    if (do_update)
+    {
+        update();
+    }
+}
+
+
+uint64_t Float32DataSeries::getMemoryUsage() const
+{
+    return samples.getMemoryUsage();
+}
+
+
+size_t Float32DataSeries::size() const
+{
+    sealForRead();
+
+    return samples.size();
+}
+
+
+std::vector<DataPoint> Float32DataSeries::getData() const
+{
+    sealForRead();
+
+    Float32Storage::Snapshot snapshot(samples);
+
+    return snapshot.toVector();
+}
+
+
+DataPoint Float32DataSeries::getRawDataPoint(uint64_t idx) const
+{
+    sealForRead();
+
+    Float32Storage::Snapshot snapshot(samples);
+
+    // The data may have been cleared since the caller checked the index
+    if (idx >= snapshot.size())
+    {
+        throw std::out_of_range("data index out of range");
+    }
+
+    return snapshot.at(idx);
+}
+
+
+uint64_t Float32DataSeries::getRawDataPoints(uint64_t idx, uint64_t count, DataPoint *points) const
+{
+    sealForRead();
+
+    Float32Storage::Snapshot snapshot(samples);
+
+    return snapshot.copy(idx, count, points);
+}
+
+
+uint64_t Float32DataSeries::getIndexForTimestamp(double t, SearchDirection direction) const
+{
+    sealForRead();
+
+    Float32Storage::Snapshot snapshot(samples);
+
+    if (snapshot.isEmpty()) return 0;
+
+    if (direction == SEARCH_LEFT_TO_RIGHT)
+    {
+        return snapshot.upperBound(t);
+    }
+    else
+    {
+        return snapshot.lowerBound(t);
+    }
+}
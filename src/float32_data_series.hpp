@@ -0,0 +1,60 @@
+#ifndef FLOAT32_DATA_SERIES_HPP
+#define FLOAT32_DATA_SERIES_HPP
+
+#include "data_series.hpp"
+
+
+/**
+ * @brief The Float32DataSeries class stores sample values with single (32-bit) precision
+ *
+ * Timestamps are stored with full (double) precision.
+ * Samples are stored in the same block layout as DataSeries (see BasicDataStorage),
+ * with a single precision value column (12 bytes per sample, rather than 16),
+ * which is sufficient for data from e.g. 16-bit ADCs.
+ *
+ * As per DataSeries, samples can be read without locking.
+ */
+class Float32DataSeries : public DataSeries
+{
+    Q_OBJECT
+
+public:
+    Float32DataSeries(QString label);
+    Float32DataSeries(QString group, QString label);
+
+    virtual ~Float32DataSeries();
+
+    virtual ValuePrecision getValuePrecision(void) const override { return PRECISION_FLOAT; }
+
+    virtual uint64_t getMemoryUsage(void) const override;
+
+    using DataSeries::addData;
+    virtual void addData(DataPoint point, bool update=true) override;
+    virtual void appendData(const std::vector<DataPoint> &points, bool update=true) override;
+    virtual void appendColumns(const double *timestamps, const double *values, uint64_t count, bool update=true) override;
+
+    virtual void clipTimeRange(double t_min, double t_max, bool update=true) override;
+
+    virtual void clearData(bool update=true) override;
+    virtual void truncateData(uint64_t count, bool update=true) override;
+
+    virtual size_t size() const override;
+
+    virtual std::vector<DataPoint> getData() const override;
+
+    virtual uint64_t getIndexForTimestamp(double t, SearchDirection direction=SEARCH_LEFT_TO_RIGHT) const override;
+
+protected:
+    virtual DataPoint getRawDataPoint(uint64_t idx) const override;
+    virtual uint64_t getRawDataPoints(uint64_t idx, uint64_t count, DataPoint *points) const override;
+
+    // Add a single sample (data_mutex must be held)
+    // Out-of-order samples are added to the ingestion buffer
+    void addSample(const DataPoint &point);
+
+    virtual void mergeSamples(const std::vector<DataPoint> &points) override;
+
+    Float32Storage samples;
+};
+
+#endif // FLOAT32_DATA_SERIES_HPP
@@ -0,0 +1,191 @@
+#ifndef IMPORT_DIAGNOSTICS_HPP
+#define IMPORT_DIAGNOSTICS_HPP
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+
+#include <vector>
+
+#include <stdint.h>
+
+
+/**
+ * @brief The ImportDiagnostics class collects issues found while importing a file
+ *
+ * Rather than logging a message for each bad row (which can dominate the import time
+ * for a corrupt file), issues are counted per category and per column,
+ * along with the first few line numbers at which each issue occurred.
+ * A single summary is then reported once the import has finished.
+ *
+ * Categories are static strings, so that recording an issue requires no formatting.
+ * A collector is used by a single import thread.
+ */
+class ImportDiagnostics
+{
+public:
+    //! Number of example line numbers retained for each issue
+    static const int MAX_EXAMPLE_LINES = 5;
+
+    //! Maximum number of issues listed in the summary
+    static const int MAX_REPORTED_ISSUES = 20;
+
+    struct Issue
+    {
+        const char *category = nullptr;
+
+        //! Column index (or -1 if the issue does not relate to a single column)
+        int column = -1;
+
+        uint64_t count = 0;
+
+        std::vector<int64_t> lines;
+    };
+
+    // Record an issue (line is the row or record number, or -1 if not applicable)
+    void add(const char *category, int column = -1, int64_t line = -1)
+    {
+        total++;
+
+        Issue *issue = findIssue(category, column);
+
+        issue->count++;
+
+        if (line >= 0 && issue->lines.size() < (size_t) MAX_EXAMPLE_LINES)
+        {
+            issue->lines.push_back(line);
+        }
+    }
+
+    bool isEmpty(void) const { return total == 0; }
+
+    //! Total number of issues recorded
+    uint64_t getCount(void) const { return total; }
+
+    //! Number of issues recorded in the given category (for all columns)
+    uint64_t getCount(const char *category) const
+    {
+        uint64_t count = 0;
+
+        for (const Issue &issue : issues)
+        {
+            if (sameCategory(issue.category, category)) count += issue.count;
+        }
+
+        return count;
+    }
+
+    const std::vector<Issue> &getIssues(void) const { return issues; }
+
+    void clear(void)
+    {
+        issues.clear();
+        total = 0;
+        lastIssue = -1;
+    }
+
+    /*
+     * Summary of the recorded issues, one line per category and column, e.g.
+     * "Invalid timestamp: 1204 occurrences (column 'time'), e.g. lines 17, 18, 93"
+     */
+    QStringList getSummary(const QStringList &columnNames = QStringList()) const
+    {
+        QStringList summary;
+
+        for (size_t ii = 0; ii < issues.size() && ii < (size_t) MAX_REPORTED_ISSUES; ii++)
+        {
+            const Issue &issue = issues[ii];
+
+            QString text = QString("%1: %2").arg(issue.category).arg(issue.count);
+
+            text += issue.count == 1 ? " occurrence" : " occurrences";
+
+            if (issue.column >= 0)
+            {
+                if (issue.column < columnNames.count())
+                {
+                    text += QString(" (column '%1')").arg(columnNames.at(issue.column));
+                }
+                else
+                {
+                    text += QString(" (column %1)").arg(issue.column);
+                }
+            }
+
+            if (!issue.lines.empty())
+            {
+                QStringList lines;
+
+                for (int64_t line : issue.lines)
+                {
+                    lines.append(QString::number(line));
+                }
+
+                text += (issue.lines.size() == 1 ? ", line " : ", e.g. lines ") + lines.join(", ");
+            }
+
+            summary.append(text);
+        }
+
+        if (issues.size() > (size_t) MAX_REPORTED_ISSUES)
+        {
+            summary.append(QString("... and %1 other issues").arg(issues.size() - MAX_REPORTED_ISSUES));
+        }
+
+        return summary;
+    }
+
+    // Append the summary (if any issues were recorded) to a list of errors
+    void report(QStringList &errors, const QStringList &columnNames = QStringList()) const
+    {
+        if (isEmpty()) return;
+
+        errors.append(getSummary(columnNames));
+    }
+
+protected:
+    static bool sameCategory(const char *a, const char *b)
+    {
+        return a == b || (a && b && qstrcmp(a, b) == 0);
+    }
+
+    Issue *findIssue(const char *category, int column)
+    {
+        // The same issue is usually repeated on consecutive lines
+        if (lastIssue >= 0)
+        {
+            Issue &last = issues[lastIssue];
+
+            if (last.column == column && sameCategory(last.category, category)) return &last;
+        }
+
+        for (size_t ii = 0; ii < issues.size(); ii++)
+        {
+            if (issues[ii].column == column && sameCategory(issues[ii].category, category))
+            {
+                lastIssue = (int) ii;
+                return &issues[ii];
+            }
+        }
+
+        Issue issue;
+
+        issue.category = category;
+        issue.column = column;
+
+        issues.push_back(issue);
+        lastIssue = (int) issues.size() - 1;
+
+        return &issues.back();
+    }
+
+    std::vector<Issue> issues;
+
+    uint64_t total = 0;
+
+    //! Index of the most recently recorded issue
+    int lastIssue = -1;
+};
+
+
+#endif // IMPORT_DIAGNOSTICS_HPP
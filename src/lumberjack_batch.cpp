@@ -0,0 +1,338 @@
+#include <QTextStream>
+#include <qnumeric.h>
+
+#include "lumberjack_batch.hpp"
+
+#include "data_source_manager.hpp"
+#include "plugin_registry.hpp"
+#include "math_data_source.hpp"
+#include "math_trace_computer.hpp"
+
+
+/*
+ * Split a "<name>=<value>" argument
+ */
+static bool splitAssignment(QString argument, QString &name, QString &value)
+{
+    int idx = argument.indexOf('=');
+
+    if (idx <= 0) return false;
+
+    name = argument.left(idx).trimmed();
+    value = argument.mid(idx + 1).trimmed();
+
+    return !name.isEmpty() && !value.isEmpty();
+}
+
+
+LumberjackBatch::LumberjackBatch(const LumberjackBatchOptions &options) : m_options(options)
+{
+}
+
+
+int LumberjackBatch::run()
+{
+    PluginRegistry::getInstance()->loadPlugins();
+
+    bool result = importFiles();
+
+    result &= computeMathTraces();
+
+    QList<DataSeriesPointer> series;
+    QStringList identifiers;
+
+    result &= selectSeries(series, identifiers);
+
+    // Restrict data to the specified time range
+    for (int idx = 0; idx < series.count(); idx++)
+    {
+        series[idx] = extractRange(series[idx]);
+    }
+
+    if (!m_options.exportFile.isEmpty())
+    {
+        result &= exportSeries(series);
+    }
+
+    if (m_options.stats)
+    {
+        printStats(series, identifiers);
+    }
+
+    return result ? 0 : 1;
+}
+
+
+bool LumberjackBatch::importFiles()
+{
+    auto *manager = DataSourceManager::getInstance();
+
+    bool result = true;
+
+    for (QString file : m_options.files)
+    {
+        QStringList errors;
+
+        if (!manager->importFile(file, errors))
+        {
+            qCritical() << "Failed to import" << file;
+            result = false;
+        }
+
+        for (QString err : errors)
+        {
+            qWarning() << "Import err:" << err;
+        }
+    }
+
+    return result;
+}
+
+
+/*
+ * Compute each math trace (in order), so that later traces may refer to earlier ones
+ */
+bool LumberjackBatch::computeMathTraces()
+{
+    bool result = true;
+
+    for (QString trace : m_options.mathTraces)
+    {
+        QString label;
+        QString expression;
+
+        if (!splitAssignment(trace, label, expression))
+        {
+            qCritical() << "Invalid math trace (expected <label>=<expression>):" << trace;
+            result = false;
+            continue;
+        }
+
+        QMap<QString, DataSeriesPointer> variableMapping;
+
+        for (QString variable : m_options.variables)
+        {
+            QString name;
+            QString identifier;
+
+            if (!splitAssignment(variable, name, identifier))
+            {
+                qCritical() << "Invalid variable (expected <name>=<series>):" << variable;
+                result = false;
+                continue;
+            }
+
+            DataSeriesPointer series = findSeries(identifier);
+
+            // Variables which cannot be found are reported by the computer, if required
+            if (!series.isNull())
+            {
+                variableMapping[name] = series;
+            }
+        }
+
+        MathDataSeriesPointer mathSeries = MathDataSeriesPointer::create(label, expression, variableMapping);
+
+        MathTraceComputer computer;
+
+        QString error;
+
+        connect(&computer, &MathTraceComputer::computationFailed, this, [&error](QString msg) {
+            error = msg;
+        });
+
+        // Computation is run directly in this thread
+        computer.compute(expression, variableMapping, mathSeries);
+        computer.startComputation();
+
+        if (!error.isEmpty())
+        {
+            qCritical() << "Math trace" << label << "failed:" << error;
+            result = false;
+            continue;
+        }
+
+        MathDataSource::getInstance()->addMathSeries(mathSeries);
+    }
+
+    return result;
+}
+
+
+/*
+ * Find a series, identified as "<source>:<series>" or "<series>"
+ */
+DataSeriesPointer LumberjackBatch::findSeries(QString identifier) const
+{
+    auto *manager = DataSourceManager::getInstance();
+
+    int idx = identifier.indexOf(':');
+
+    if (idx > 0)
+    {
+        DataSeriesPointer series = manager->findSeries(identifier.left(idx), identifier.mid(idx + 1));
+
+        if (!series.isNull()) return series;
+    }
+
+    // Search all sources for a matching series label
+    for (int ii = 0; ii < manager->getSourceCount(); ii++)
+    {
+        auto source = manager->getSourceByIndex(ii);
+
+        if (source.isNull()) continue;
+
+        DataSeriesPointer series = source->getSeriesByLabel(identifier);
+
+        if (!series.isNull()) return series;
+    }
+
+    return DataSeriesPointer();
+}
+
+
+bool LumberjackBatch::selectSeries(QList<DataSeriesPointer> &series, QStringList &identifiers) const
+{
+    auto *manager = DataSourceManager::getInstance();
+
+    if (m_options.series.isEmpty())
+    {
+        for (int ii = 0; ii < manager->getSourceCount(); ii++)
+        {
+            auto source = manager->getSourceByIndex(ii);
+
+            if (source.isNull()) continue;
+
+            for (int jj = 0; jj < source->getSeriesCount(); jj++)
+            {
+                auto s = source->getSeriesByIndex(jj);
+
+                if (s.isNull()) continue;
+
+                series.append(s);
+                identifiers.append(source->getLabel() + ":" + s->getLabel());
+            }
+        }
+
+        return true;
+    }
+
+    bool result = true;
+
+    for (QString identifier : m_options.series)
+    {
+        DataSeriesPointer s = findSeries(identifier);
+
+        if (s.isNull())
+        {
+            qCritical() << "Series not found:" << identifier;
+            result = false;
+            continue;
+        }
+
+        series.append(s);
+        identifiers.append(identifier);
+    }
+
+    return result;
+}
+
+
+/*
+ * Return a copy of the series, restricted to the specified time range
+ */
+DataSeriesPointer LumberjackBatch::extractRange(DataSeriesPointer series) const
+{
+    if (qIsInf(m_options.t_min) && qIsInf(m_options.t_max))
+    {
+        return series;
+    }
+
+    uint64_t first = series->getIndexForTimestamp(m_options.t_min, DataSeries::SEARCH_RIGHT_TO_LEFT);
+    uint64_t last = series->getIndexForTimestamp(m_options.t_max, DataSeries::SEARCH_LEFT_TO_RIGHT);
+
+    DataSeriesPointer subset(new DataSeries(series->getGroup(), series->getLabel()));
+
+    subset->setUnits(series->getUnits());
+
+    if (last > first)
+    {
+        // Values are copied with scaling applied
+        std::vector<DataPoint> points(last - first);
+
+        points.resize(series->getDataPoints(first, points.size(), points.data()));
+
+        subset->appendData(points, false);
+    }
+
+    return subset;
+}
+
+
+bool LumberjackBatch::exportSeries(const QList<DataSeriesPointer> &series)
+{
+    QList<DataSeriesPointer> exported = series;
+    QStringList errors;
+
+    bool result = DataSourceManager::getInstance()->exportFile(exported, m_options.exportFile, errors);
+
+    for (QString err : errors)
+    {
+        qWarning() << "Export err:" << err;
+    }
+
+    if (!result)
+    {
+        qCritical() << "Failed to export data to" << m_options.exportFile;
+    }
+
+    return result;
+}
+
+
+/*
+ * Print summary statistics for each series (CSV format)
+ */
+void LumberjackBatch::printStats(const QList<DataSeriesPointer> &series, const QStringList &identifiers) const
+{
+    QTextStream out(stdout);
+
+    out << "series,count,t_start,t_end,min,max,mean" << Qt::endl;
+
+    for (int idx = 0; idx < series.count(); idx++)
+    {
+        auto s = series.at(idx);
+
+        uint64_t n = s->size();
+
+        out << "\"" << identifiers.at(idx) << "\"," << n;
+
+        if (n == 0)
+        {
+            out << ",,,,," << Qt::endl;
+            continue;
+        }
+
+        DataSeriesReader reader(*s);
+
+        double v_min = reader.getValue(0);
+        double v_max = v_min;
+        double sum = 0;
+
+        for (uint64_t ii = 0; ii < n; ii++)
+        {
+            double v = reader.getValue(ii);
+
+            v_min = qMin(v_min, v);
+            v_max = qMax(v_max, v);
+            sum += v;
+        }
+
+        out << "," << reader.getTimestamp(0);
+        out << "," << reader.getTimestamp(n - 1);
+        out << "," << v_min;
+        out << "," << v_max;
+        out << "," << sum / n;
+        out << Qt::endl;
+    }
+}
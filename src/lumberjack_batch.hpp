@@ -0,0 +1,77 @@
+#ifndef LUMBERJACK_BATCH_HPP
+#define LUMBERJACK_BATCH_HPP
+
+#include <QObject>
+#include <QStringList>
+
+#include <limits>
+
+#include "data_series.hpp"
+
+
+/**
+ * @brief The LumberjackBatchOptions struct defines the actions performed in batch mode
+ *
+ * Series are identified as "<source>:<series>" (where the source is the imported filename),
+ * or simply "<series>" to use the first matching series from any source.
+ */
+struct LumberjackBatchOptions
+{
+    //! Data files to import
+    QStringList files;
+
+    //! Math traces to compute, "<label>=<expression>"
+    QStringList mathTraces;
+
+    //! Variables used in math expressions, "<name>=<series>"
+    QStringList variables;
+
+    //! Series to export and analyse (all series if empty)
+    QStringList series;
+
+    //! Time range (in the units of the imported timestamps)
+    double t_min = -std::numeric_limits<double>::infinity();
+    double t_max = std::numeric_limits<double>::infinity();
+
+    //! Output file for exported data (optional)
+    QString exportFile;
+
+    //! Print statistics for each series to stdout
+    bool stats = false;
+};
+
+
+/**
+ * @brief The LumberjackBatch class runs Lumberjack without a GUI
+ *
+ * - Imports files via the registered import plugins
+ * - Computes math traces
+ * - Exports selected series (within an optional time range)
+ * - Prints summary statistics as CSV data
+ *
+ * All operations are performed synchronously, and require only a QCoreApplication.
+ */
+class LumberjackBatch : public QObject
+{
+    Q_OBJECT
+
+public:
+    LumberjackBatch(const LumberjackBatchOptions &options);
+
+    // Run the batch process, and return the exit code (zero on success)
+    int run(void);
+
+protected:
+    LumberjackBatchOptions m_options;
+
+    bool importFiles(void);
+    bool computeMathTraces(void);
+    bool selectSeries(QList<DataSeriesPointer> &series, QStringList &identifiers) const;
+    bool exportSeries(const QList<DataSeriesPointer> &series);
+    void printStats(const QList<DataSeriesPointer> &series, const QStringList &identifiers) const;
+
+    DataSeriesPointer findSeries(QString identifier) const;
+    DataSeriesPointer extractRange(DataSeriesPointer series) const;
+};
+
+#endif // LUMBERJACK_BATCH_HPP
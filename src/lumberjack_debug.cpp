@@ -1,20 +1,166 @@
 #include <qelapsedtimer.h>
+#include <qthread.h>
 
 #include "lumberjack_debug.hpp"
-#include "lumberjack_settings.hpp"
 
-#include <stdio.h>
-#include <stddef.h>
-#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <string.h>
 
-void lumberjackDebugHandler(QtMsgType msgType, const QMessageLogContext& context, const QString& message);
 
+namespace
+{
+
+/*
+ * A single entry in the message ring.
+ *
+ * The state encodes which message (sequence number) the slot holds:
+ * - 0 : empty
+ * - 2 * seq + 1 : message seq is being written
+ * - 2 * seq + 2 : message seq is complete
+ *
+ * The message data are stored in atomic words, so that a reader can copy them while
+ * a writer may be overwriting the slot, and then discard the copy if the state changed.
+ * (Data are written with release and read with acquire ordering, so that a reader which sees
+ * any overwritten word also sees the new state when it is checked after the copy)
+ */
+struct DebugMessageSlot
+{
+    static const int WORDS = LUMBERJACK_DEBUG_MESSAGE_LENGTH / sizeof(uint64_t);
+
+    std::atomic<uint64_t> state {0};
+
+    std::atomic<qint64> timestamp {0};
+    std::atomic<int> messageType {QtDebugMsg};
+
+    std::atomic<int> length {0};
+    std::atomic<uint64_t> text[WORDS];
+};
+
+static_assert(LUMBERJACK_DEBUG_MESSAGE_LENGTH % sizeof(uint64_t) == 0, "Message length must be a whole number of words");
 
-QList<LumberjackDebugMessage> messageBuffer;
+
+/*
+ * Bounded, multi-producer ring of debug messages.
+ *
+ * - Producers claim a sequence number with a single atomic increment, and never block
+ *   (except, briefly, if the slot is still being written by a producer which is CAPACITY messages behind)
+ * - Readers do not consume messages: each reader keeps its own cursor (sequence number)
+ * - When the ring is full, the oldest messages are overwritten
+ */
+struct DebugMessageRing
+{
+    std::atomic<uint64_t> next {0};
+    std::atomic<uint64_t> cleared {0};
+
+    DebugMessageSlot slots[LUMBERJACK_DEBUG_CAPACITY];
+
+    void push(qint64 timestamp, QtMsgType type, const QString &message);
+    bool read(uint64_t seq, LumberjackDebugMessage &message, bool &pending) const;
+};
+
+
+DebugMessageRing messageRing;
 QElapsedTimer debugTimer;
 
 
-LumberjackDebugMessage::LumberjackDebugMessage(qint64 t, QtMsgType type, const QString& msg) :
+void DebugMessageRing::push(qint64 timestamp, QtMsgType type, const QString &message)
+{
+    const uint64_t seq = next.fetch_add(1, std::memory_order_relaxed);
+
+    DebugMessageSlot &slot = slots[seq % LUMBERJACK_DEBUG_CAPACITY];
+
+    uint64_t current = slot.state.load(std::memory_order_acquire);
+
+    while (true)
+    {
+        // A newer message has already been written to this slot
+        if (current > 2 * seq + 2) return;
+
+        // The previous occupant is still being written
+        if (current & 1)
+        {
+            QThread::yieldCurrentThread();
+            current = slot.state.load(std::memory_order_acquire);
+            continue;
+        }
+
+        if (slot.state.compare_exchange_weak(current, 2 * seq + 1, std::memory_order_acquire)) break;
+    }
+
+    QByteArray bytes = message.toUtf8();
+
+    int length = qMin((int) bytes.size(), LUMBERJACK_DEBUG_MESSAGE_LENGTH);
+
+    // Do not split a multi-byte character
+    while (length < bytes.size() && length > 0 && (bytes.at(length) & 0xC0) == 0x80)
+    {
+        length--;
+    }
+
+    uint64_t words[DebugMessageSlot::WORDS] = {};
+
+    memcpy(words, bytes.constData(), length);
+
+    const int count = (length + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    for (int ii = 0; ii < count; ii++)
+    {
+        slot.text[ii].store(words[ii], std::memory_order_release);
+    }
+
+    slot.length.store(length, std::memory_order_release);
+    slot.timestamp.store(timestamp, std::memory_order_release);
+    slot.messageType.store(type, std::memory_order_release);
+
+    slot.state.store(2 * seq + 2, std::memory_order_release);
+}
+
+
+/*
+ * Read the message with the specified sequence number.
+ * Returns false if the message is not available: pending is set if the message
+ * has not yet been written (rather than having been overwritten).
+ */
+bool DebugMessageRing::read(uint64_t seq, LumberjackDebugMessage &message, bool &pending) const
+{
+    const DebugMessageSlot &slot = slots[seq % LUMBERJACK_DEBUG_CAPACITY];
+
+    uint64_t before = slot.state.load(std::memory_order_acquire);
+
+    // Not yet claimed (or still being written) by the producer of this message
+    pending = before < 2 * seq + 2;
+
+    if (before != 2 * seq + 2) return false;
+
+    uint64_t words[DebugMessageSlot::WORDS];
+
+    int length = qBound(0, slot.length.load(std::memory_order_acquire), LUMBERJACK_DEBUG_MESSAGE_LENGTH);
+    qint64 timestamp = slot.timestamp.load(std::memory_order_acquire);
+    QtMsgType type = (QtMsgType) slot.messageType.load(std::memory_order_acquire);
+
+    const int count = (length + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    for (int ii = 0; ii < count; ii++)
+    {
+        words[ii] = slot.text[ii].load(std::memory_order_acquire);
+    }
+
+    const char *text = reinterpret_cast<const char*>(words);
+
+    // The slot was overwritten while it was being copied
+    if (slot.state.load(std::memory_order_relaxed) != before) return false;
+
+    message = LumberjackDebugMessage(seq, timestamp, type, QString::fromUtf8(text, length));
+
+    return true;
+}
+
+}
+
+
+LumberjackDebugMessage::LumberjackDebugMessage(uint64_t seq, qint64 t, QtMsgType type, const QString& msg) :
+    sequence(seq),
     timestamp(t),
     messageType(type),
     message(msg)
@@ -28,7 +174,7 @@ void lumberjackDebugHandler(QtMsgType msgType, const QMessageLogContext& context
     Q_UNUSED(context)
 
     // Construct and buffer a new debug message
-    messageBuffer.append(LumberjackDebugMessage(debugTimer.elapsed(), msgType, message));
+    messageRing.push(debugTimer.elapsed(), msgType, message);
 }
 
 
@@ -40,37 +186,49 @@ void registerLumberjackDebugHandler()
 
 
 /*
- * Return a list of debug messages according to the user specified filter
+ * Return the available debug messages which match the provided type mask.
+ * Only messages logged since the previous call (with the same cursor) are returned.
  */
-QList<LumberjackDebugMessage> getLumberjackDebugMessages(qint64 tSince)
+QList<LumberjackDebugMessage> getLumberjackDebugMessages(uint64_t &cursor, uint32_t typeMask)
 {
-    auto *settings = LumberjackSettings().getInstance();
+    QList<LumberjackDebugMessage> messages;
 
-    uint32_t mask = 0x00;
+    const uint64_t end = messageRing.next.load(std::memory_order_acquire);
 
-    // Construct the debug message mask
-    if (settings->loadBoolean("debug", "showInfo")) mask |= (1 << QtMsgType::QtInfoMsg);
-    if (settings->loadBoolean("debug", "showDebug")) mask |= (1 << QtMsgType::QtDebugMsg);
-    if (settings->loadBoolean("debug", "showWarning")) mask |= (1 << QtMsgType::QtWarningMsg);
-    if (settings->loadBoolean("debug", "showCritical")) mask |= (1 << QtMsgType::QtCriticalMsg);
-    if (settings->loadBoolean("debug", "showFatal")) mask |= (1 << QtMsgType::QtFatalMsg);
+    uint64_t seq = std::max(cursor, messageRing.cleared.load(std::memory_order_acquire));
 
-    QList<LumberjackDebugMessage> messages;
+    // Messages older than the ring capacity have been overwritten
+    if (end > LUMBERJACK_DEBUG_CAPACITY)
+    {
+        seq = std::max(seq, end - LUMBERJACK_DEBUG_CAPACITY);
+    }
+
+    LumberjackDebugMessage msg(0, 0, QtDebugMsg, QString());
 
-    for (const auto &msg : messageBuffer)
+    for (; seq < end; seq++)
     {
-        // Ignore messages prior to a given timestamp
-        if (msg.timestamp <= tSince) continue;
+        bool pending = false;
+
+        if (!messageRing.read(seq, msg, pending))
+        {
+            // Stop at a message which is still being written, and resume from there next time
+            if (pending) break;
+
+            continue;
+        }
 
         uint32_t flag = 1 << msg.messageType;
-        if (mask & flag) messages.append(msg);
+
+        if (typeMask & flag) messages.append(msg);
     }
 
+    cursor = seq;
+
     return messages;
 }
 
 
 void clearLumberjackDebugMessages()
 {
-    messageBuffer.clear();
+    messageRing.cleared.store(messageRing.next.load(std::memory_order_acquire), std::memory_order_release);
 }
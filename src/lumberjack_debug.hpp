@@ -3,10 +3,15 @@
 
 #include <qdebug.h>
 
+#include <stdint.h>
+
 class LumberjackDebugMessage
 {
 public:
-    LumberjackDebugMessage(qint64 t, QtMsgType type, const QString& msg);
+    LumberjackDebugMessage(uint64_t seq, qint64 t, QtMsgType type, const QString& msg);
+
+    //! Sequence number (increments for each message logged)
+    uint64_t sequence = 0;
 
     qint64 timestamp = 0;
 
@@ -14,8 +19,25 @@ public:
     QString message;
 };
 
+//! Number of messages retained (older messages are overwritten)
+const uint64_t LUMBERJACK_DEBUG_CAPACITY = 0x1000;
+
+//! Maximum length (bytes, UTF-8) of a retained message
+const int LUMBERJACK_DEBUG_MESSAGE_LENGTH = 480;
+
+//! Mask which matches all message types
+const uint32_t LUMBERJACK_DEBUG_ALL = 0xFFFFFFFF;
+
 void registerLumberjackDebugHandler();
-QList<LumberjackDebugMessage> getLumberjackDebugMessages(qint64 tSince);
+
+// Message handler (installed by registerLumberjackDebugHandler), which buffers the message
+void lumberjackDebugHandler(QtMsgType msgType, const QMessageLogContext& context, const QString& message);
+
+// Return messages (matching the type mask) with a sequence number not less than the cursor,
+// and advance the cursor past the last available message
+QList<LumberjackDebugMessage> getLumberjackDebugMessages(uint64_t &cursor, uint32_t typeMask = LUMBERJACK_DEBUG_ALL);
+
+// Messages logged before this call are no longer returned
 void clearLumberjackDebugMessages();
 
 
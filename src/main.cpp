@@ -6,29 +6,55 @@
 #include "lumberjack_debug.hpp"
 #include "lumberjack_version.hpp"
 #include "lumberjack_settings.hpp"
+#include "lumberjack_batch.hpp"
+#include "data_source_manager.hpp"
+#include "plugin_registry.hpp"
 
 #include "mainwindow.h"
 
 
+/*
+ * Batch mode must be determined before the application is constructed,
+ * as a QApplication cannot be created without a display
+ */
+static bool isBatchMode(int argc, char *argv[])
+{
+    for (int idx = 1; idx < argc; idx++)
+    {
+        if (qstrcmp(argv[idx], "-b") == 0 || qstrcmp(argv[idx], "--batch") == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
 int main(int argc, char *argv[])
 {
+    const bool batch = isBatchMode(argc, argv);
 
-    QApplication a(argc, argv);
+    QScopedPointer<QCoreApplication> a(batch ? new QCoreApplication(argc, argv) : new QApplication(argc, argv));
 
     // Add custom plugin dirs
-    QStringList pluginPaths = a.libraryPaths();
+    QStringList pluginPaths = a->libraryPaths();
 
     pluginPaths.prepend(QDir::currentPath() + "/plugins");
     pluginPaths.prepend(LumberjackSettings::getPluginsDirectory());
 
-    a.setLibraryPaths(pluginPaths);
+    a->setLibraryPaths(pluginPaths);
 
     QString p = QDir::currentPath() + "/plugins";
 
     // Configure application properties
-    a.setApplicationName("lumberjack");
-    a.setApplicationDisplayName("lumberjack");
-    a.setApplicationVersion(getLumberjackVersion());
+    a->setApplicationName("lumberjack");
+    a->setApplicationVersion(getLumberjackVersion());
+
+    if (!batch)
+    {
+        QApplication::setApplicationDisplayName("lumberjack");
+    }
 
     QCoreApplication::setApplicationName("Lumberjack");
     QCoreApplication::setApplicationVersion(getLumberjackVersion());
@@ -41,13 +67,60 @@ int main(int argc, char *argv[])
 
     // Command line options
     QCommandLineOption dummyDataOption(QStringList() << "d" << "dummy", "Load dummy test data");
+    QCommandLineOption generateOption(QStringList() << "g" << "generate", "Load synthetic data, as described by a generator specification", "spec");
     QCommandLineOption debugCmdOption(QStringList() << "c" << "Debug to command line");
+    QCommandLineOption streamOption(QStringList() << "s" << "stream", "Read live data from a stream (unix:<socket>, <named pipe> or stdin)", "address");
+
+    // Batch mode options
+    QCommandLineOption batchOption(QStringList() << "b" << "batch", "Run in headless batch mode (no GUI)");
+    QCommandLineOption mathOption("math", "Compute a math trace (batch mode)", "label=expression");
+    QCommandLineOption variableOption("var", "Assign a series to a math variable (batch mode)", "name=[source:]series");
+    QCommandLineOption seriesOption("series", "Select a series for export and statistics (batch mode, default = all)", "[source:]series");
+    QCommandLineOption startOption("start", "Start of time range (batch mode)", "timestamp");
+    QCommandLineOption endOption("end", "End of time range (batch mode)", "timestamp");
+    QCommandLineOption exportOption(QStringList() << "o" << "export", "Export selected series to file (batch mode)", "file");
+    QCommandLineOption statsOption("stats", "Print statistics for selected series (batch mode)");
 
     parser.addPositionalArgument("files", "Load data files, optionally", "[files...]");
     parser.addOption(dummyDataOption);
+    parser.addOption(generateOption);
     parser.addOption(debugCmdOption);
+    parser.addOption(streamOption);
 
-    parser.process(a);
+    parser.addOption(batchOption);
+    parser.addOption(mathOption);
+    parser.addOption(variableOption);
+    parser.addOption(seriesOption);
+    parser.addOption(startOption);
+    parser.addOption(endOption);
+    parser.addOption(exportOption);
+    parser.addOption(statsOption);
+
+    parser.process(*a);
+
+    if (batch)
+    {
+        // Debug messages are written directly to the console
+        LumberjackBatchOptions options;
+
+        options.files = parser.positionalArguments();
+        options.mathTraces = parser.values(mathOption);
+        options.variables = parser.values(variableOption);
+        options.series = parser.values(seriesOption);
+        options.exportFile = parser.value(exportOption);
+        options.stats = parser.isSet(statsOption);
+
+        if (parser.isSet(startOption)) options.t_min = parser.value(startOption).toDouble();
+        if (parser.isSet(endOption)) options.t_max = parser.value(endOption).toDouble();
+
+        int result = LumberjackBatch(options).run();
+
+        PluginRegistry::cleanup();
+        DataSourceManager::cleanup();
+        LumberjackSettings::cleanup();
+
+        return result;
+    }
 
     if (!parser.isSet(debugCmdOption))
     {
@@ -61,9 +134,14 @@ int main(int argc, char *argv[])
     w.show();
 
     // Import data from specified files
-    for (auto file : parser.positionalArguments())
+    if (!parser.positionalArguments().isEmpty())
     {
-        w.loadDataFromFile(file);
+        w.loadDataFromFiles(parser.positionalArguments());
+    }
+
+    if (parser.isSet(streamOption))
+    {
+        w.openStream(parser.value(streamOption));
     }
 
     if (parser.isSet(dummyDataOption))
@@ -71,5 +149,10 @@ int main(int argc, char *argv[])
         w.loadDummyData();
     }
 
-    return a.exec();
+    if (parser.isSet(generateOption))
+    {
+        w.loadDummyData(parser.value(generateOption));
+    }
+
+    return a->exec();
 }
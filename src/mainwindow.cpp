@@ -3,6 +3,7 @@
 #include <math.h>
 
 #include <qfiledialog.h>
+#include <qinputdialog.h>
 #include <qsharedpointer.h>
 
 #include <qwt_plot.h>
@@ -25,6 +26,7 @@
 #include "math_trace_dialog.hpp"
 
 #include "plugin_registry.hpp"
+#include "synthetic_importer.hpp"
 
 #include <QCoreApplication>
 #include <QDir>
@@ -70,80 +72,64 @@ MainWindow::~MainWindow()
 
 
 /*
- * Load a set of dummy data for testing
+ * Load a set of (reproducible) synthetic data for testing.
+ * The generator options are loaded from the specification file, if provided.
  */
-void MainWindow::loadDummyData()
+void MainWindow::loadDummyData(QString spec)
 {
-    /*
-     * TODO: Reimplement this as a plugin
-     */
-
-    // Construct some sources
-    auto *manager = DataSourceManager::getInstance();
-
-    manager->addSource(new DataSource("Dummy", "Source A"));
-    manager->addSource(new DataSource("Dummy", "Source B"));
-
-    auto src = manager->getSourceByLabel("Source B");
-
-    src->addSeries(new DataSeries("Cat"));
-    src->addSeries(new DataSeries("Dog"));
-    src->addSeries(new DataSeries("Rat"));
-
-    auto *series = new DataSeries("My data");
-
-    for (int idx = 0; idx < 5000; idx += 50)
+    SyntheticDataOptions options;
+
+    // Default data set exercises jitter, gaps, out-of-order samples and NaN values
+    options.sources = 2;
+    options.seriesPerSource = 6;
+    options.samplesPerSeries = 200000;
+    options.sampleRate = 1000;
+    options.rateSpread = 0.5;
+    options.jitter = 0.1;
+    options.gapProbability = 0.00001;
+    options.outOfOrderFraction = 0.0001;
+    options.nanFraction = 0.0001;
+
+    QStringList errors;
+
+    if (!spec.isEmpty() && !options.load(spec, errors))
     {
-        for (double t = -10; t <= 10; t += 0.01)
+        for (QString err : errors)
         {
-            series->addData(t + idx, (double) (rand() % 1000) - 500);
+            qCritical() << err;
         }
 
-        src->getSeriesByLabel("Cat")->addData(idx + rand() % 20 - 10, (double) (rand() % 500) - 250);
-        src->getSeriesByLabel("Rat")->addData(idx + rand() % 20 - 10, (double) (rand() % 500) - 250);
-        src->getSeriesByLabel("Dog")->addData(idx + rand() % 20 - 10, (double) (rand() % 500) - 250);
+        return;
     }
 
-    src->addSeries(series);
-
-    src = manager->getSourceByLabel("Source A");
+    auto *manager = DataSourceManager::getInstance();
 
-    auto series_2 = DataSeriesPointer(new DataSeries("Series 2"));
-    auto series_3 = DataSeriesPointer(new DataSeries("Series 3"));
-    auto series_4 = DataSeriesPointer(new DataSeries("Series 4"));
-    auto series_5 = DataSeriesPointer(new DataSeries("Series 5"));
-    auto series_6 = DataSeriesPointer(new DataSeries("Series 6"));
-    auto series_7 = DataSeriesPointer(new DataSeries("Series 7"));
+    for (int idx = 0; idx < options.sources; idx++)
+    {
+        SyntheticDataImporter generator;
 
-    for (double t = 0; t < 100; t += 0.0001)
-    {        
-        // 5Hz, 20Hz, 50Hz
-        series_2->addData(t, 10 * cos(5 * 2 * M_PI * t) + 5 * sin(20 * 2 * M_PI * t) + 15 * sin(50 * 2 * M_PI * t));
-        series_3->addData(t, 10 * sin(15 * t));
+        generator.setOptions(options);
+        generator.setSourceIndex(idx);
 
-        // Random time data wobble
-        double t_offset = (double) (rand() % 1000 - 500) / 1000;
-        t_offset *= 0.0001;
+        if (!generator.importData(errors))
+        {
+            for (QString err : errors)
+            {
+                qCritical() << err;
+            }
 
-        series_4->addData(t + t_offset, 15 * cos(5 * t));
+            return;
+        }
 
-        // Series 5, 6, 7 have the same frequency data, but at different sampling period
-        // This ensures that the FFT calculations are correct
+        DataSourcePointer source(new DataSource("Synthetic", QString("Synthetic %1").arg(idx + 1)));
 
-        // FFT should have peak at 123.45Hz
-        const double f_base = 123.45 * 2 * M_PI;
+        for (auto series : generator.getDataSeries())
+        {
+            source->addSeries(series, true, false);
+        }
 
-        series_5->addData(0.1 * t, 10 * cos(0.1 * t * f_base));
-        series_6->addData(1.0 * t, 10 * cos(1.0 * t * f_base));
-        series_7->addData(10  * t, 10 * cos(10  * t * f_base));
+        manager->addSource(source);
     }
-
-    src->addSeries(series_2);
-    src->addSeries(series_3);
-    src->addSeries(series_4);
-    src->addSeries(series_5);
-    src->addSeries(series_6);
-    src->addSeries(series_7);
 }
 
 
@@ -173,6 +159,7 @@ void MainWindow::saveWorkspaceSettings()
     settings->saveSetting("mainwindow", "showTimelineView", timelineView.isVisible());
     settings->saveSetting("mainwindow", "showStatsView", statsView.isVisible());
     settings->saveSetting("mainwindow", "showDebugView", debugWidget.isVisible());
+    settings->saveSetting("mainwindow", "showPerformanceView", performanceWidget.isVisible());
 
     settings->saveSetting("mainwindow", "state", saveState());
     settings->saveSetting("mainwindow", "geometry", saveGeometry());
@@ -187,6 +174,7 @@ void MainWindow::initMenus()
 {
     // File menu
     connect(ui->action_Import_Data, &QAction::triggered, this, &MainWindow::importData);
+    connect(ui->action_Open_Stream, &QAction::triggered, this, &MainWindow::openStreamDialog);
     connect(ui->actionE_xit, &QAction::triggered, this, &QMainWindow::close);
 
     // View menu
@@ -203,6 +191,7 @@ void MainWindow::initMenus()
     connect(ui->action_About, &QAction::triggered, this, &MainWindow::showAboutInfo);
     connect(ui->action_Plugins, &QAction::triggered, this, &MainWindow::showPluginsInfo);
     connect(ui->action_Debug, &QAction::triggered, this, &MainWindow::toggleDebugView);
+    connect(ui->action_Performance, &QAction::triggered, this, &MainWindow::togglePerformanceView);
 }
 
 
@@ -234,6 +223,11 @@ void MainWindow::initDocks()
     {
         toggleDebugView();
     }
+
+    if (settings->loadBoolean("mainwindow", "showPerformanceView"))
+    {
+        togglePerformanceView();
+    }
 }
 
 
@@ -247,9 +241,10 @@ void MainWindow::initSignalsSlots()
     if (tree)
     {
         connect(tree, &DataViewTree::onSeriesRemoved, this, &MainWindow::seriesRemoved);
+        connect(tree, &DataViewTree::cursorTimestampSelected, this, &MainWindow::setCursorTimestamp);
     }
 
-    connect(&dataView, &DataviewWidget::fileDropped, this, &MainWindow::loadDataFromFile);
+    connect(&dataView, &DataviewWidget::filesDropped, this, &MainWindow::loadDataFromFiles);
 
     // Timeline view
     connect(&timelineView, &TimelineWidget::timeUpdated, this, &MainWindow::onTimescaleChanged);
@@ -339,6 +334,22 @@ void MainWindow::updateCursorPos(double t, double y1, double y2)
     t_pos.setText("t: " + fixedWidthNumber(t));
     y1_pos.setText("y1: " + fixedWidthNumber(y1));
     y2_pos.setText("y2: " + fixedWidthNumber(y2));
+
+    // Open data tables follow the plot cursor
+    dataView.getTree()->setCursorTimestamp(t);
+}
+
+
+/**
+ * @brief MainWindow::setCursorTimestamp - Display the specified timestamp on all plots (e.g. a selected table row)
+ * @param t
+ */
+void MainWindow::setCursorTimestamp(double t)
+{
+    for (auto plot : plots)
+    {
+        if (!plot.isNull()) plot->setCursorTimestamp(t);
+    }
 }
 
 /**
@@ -411,6 +422,31 @@ void MainWindow::toggleDebugView()
 }
 
 
+/*
+ * Toggle display of the "Performance" window
+ */
+void MainWindow::togglePerformanceView()
+{
+    ui->action_Performance->setCheckable(true);
+
+    if (performanceWidget.isVisible())
+    {
+        hideDockedWidget(&performanceWidget);
+        ui->action_Performance->setChecked(false);
+    }
+    else
+    {
+        QDockWidget *dock = new QDockWidget(tr("Performance"), this);
+        dock->setObjectName("performance-view");
+        dock->setAllowedAreas(Qt::AllDockWidgetAreas);
+        dock->setWidget(&performanceWidget);
+
+        addDockWidget(Qt::RightDockWidgetArea, dock);
+        ui->action_Performance->setChecked(true);
+    }
+}
+
+
 
 /**
  * @brief MainWindow::loadDataFromFile - Load data from the provided file
@@ -423,6 +459,17 @@ void MainWindow::loadDataFromFile(QString filename)
 }
 
 
+/**
+ * @brief MainWindow::loadDataFromFiles - Load data from multiple files (imported concurrently)
+ * @param filenames
+ */
+void MainWindow::loadDataFromFiles(QStringList filenames)
+{
+    auto manager = DataSourceManager::getInstance();
+    manager->importFiles(filenames);
+}
+
+
 /*
  * Callback when the "import data" menu action is fired
  */
@@ -432,6 +479,45 @@ void MainWindow::importData()
 }
 
 
+/**
+ * @brief MainWindow::openStream - Open a live data stream at the provided address
+ * @param address
+ */
+void MainWindow::openStream(QString address)
+{
+    auto manager = DataSourceManager::getInstance();
+    manager->openStream(address);
+}
+
+
+/*
+ * Callback when the "open stream" menu action is fired
+ */
+void MainWindow::openStreamDialog()
+{
+    auto settings = LumberjackSettings::getInstance();
+
+    QString lastAddress = settings->loadSetting("stream", "lastAddress", QString()).toString();
+
+    bool ok = false;
+
+    QString address = QInputDialog::getText(
+        this,
+        tr("Open Stream"),
+        tr("Stream address (unix:<socket>, <named pipe> or stdin)"),
+        QLineEdit::Normal,
+        lastAddress,
+        &ok
+    );
+
+    if (!ok || address.trimmed().isEmpty()) return;
+
+    settings->saveSetting("stream", "lastAddress", address.trimmed());
+
+    openStream(address);
+}
+
+
 void MainWindow::hideDockedWidget(QWidget *widget)
 {
     for (auto *dock : findChildren<QDockWidget*>())
@@ -506,7 +592,7 @@ void MainWindow::addPlot()
     connect(plot, &PlotWidget::viewChanged, this, &MainWindow::onTimescaleChanged);
     connect(plot, &PlotWidget::viewChanged, &timelineView, &TimelineWidget::updateViewLimits);
     connect(plot, &PlotWidget::timestampLimitsChanged, &timelineView, &TimelineWidget::updateTimeLimits);
-    connect(plot, &PlotWidget::fileDropped, this, &MainWindow::loadDataFromFile);
+    connect(plot, &PlotWidget::filesDropped, this, &MainWindow::loadDataFromFiles);
 
     plots.append(QSharedPointer<PlotWidget>(plot));
 
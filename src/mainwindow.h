@@ -7,6 +7,7 @@
 #include "data_series.hpp"
 
 #include "debug_widget.hpp"
+#include "performance_widget.hpp"
 #include "plot_widget.hpp"
 #include "fft_widget.hpp"
 #include "stats_widget.hpp"
@@ -25,15 +26,18 @@ public:
     MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
 
-    void loadDummyData(void);
+    void loadDummyData(QString spec = QString());
 
 public slots:
 
     void onTimescaleChanged(const QwtInterval &view);
     void updateCursorPos(double t, double y1, double y2);
+    void setCursorTimestamp(double t);
     void updateDifferences(double dt, double dy);
     void hideDifferences();
     void loadDataFromFile(QString filename = QString());
+    void loadDataFromFiles(QStringList filenames);
+    void openStream(QString address = QString());
 
 protected:
     void initMenus(void);
@@ -52,8 +56,10 @@ protected slots:
     void showPluginsInfo(void);
 
     void importData(void);
+    void openStreamDialog(void);
 
     void toggleDebugView(void);
+    void togglePerformanceView(void);
     void toggleDataView(void);
     void toggleFftView(void);
     void toggleTimelineView(void);
@@ -86,5 +92,6 @@ private:
     FFTWidget fftView;
 
     DebugWidget debugWidget;
+    PerformanceWidget performanceWidget;
 };
 #endif // MAINWINDOW_H
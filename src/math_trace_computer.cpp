@@ -1,5 +1,5 @@
 #include "math_trace_computer.hpp"
-#include <QElapsedTimer>
+#include "performance_monitor.hpp"
 #include <QDebug>
 #include <algorithm>
 #include <set>
@@ -53,8 +53,7 @@ void MathTraceComputer::compute(const QString& expression,
  */
 void MathTraceComputer::startComputation()
 {
-    QElapsedTimer timer;
-    timer.start();
+    PerformanceScope scope("Math/Compute", currentOutputSeries ? currentOutputSeries->getLabel() : QString());
 
     emit computationStarted();
 
@@ -188,7 +187,7 @@ void MathTraceComputer::startComputation()
     }
 
     qDebug() << "Math trace computation complete:";
-    qDebug() << "  - Time elapsed:" << timer.elapsed() << "ms";
+    qDebug() << "  - Time elapsed:" << scope.stop() << "ms";
     qDebug() << "  - Valid points:" << validPoints;
     qDebug() << "  - Skipped points:" << skippedPoints;
     qDebug() << "  - Total timestamps:" << timestamps.size();
@@ -226,10 +225,11 @@ QVector<double> MathTraceComputer::collectTimestamps(const QMap<QString, DataSer
     for (auto it = series.begin(); it != series.end(); ++it)
     {
         DataSeriesPointer s = it.value();
+        DataSeriesReader reader(*s);
 
         for (uint64_t i = 0; i < s->size(); ++i)
         {
-            double timestamp = s->getTimestamp(i);
+            double timestamp = reader.getTimestamp(i);
             timestampSet.insert(timestamp);  // Duplicates automatically ignored
         }
     }
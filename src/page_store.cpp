@@ -0,0 +1,274 @@
+#include <algorithm>
+
+#include <QDir>
+#include <QDebug>
+
+#include "page_store.hpp"
+
+
+const uint64_t PageStore::PAGE_SAMPLES;
+const size_t PageStore::DEFAULT_RESIDENT_PAGES = 256;
+
+QMutex PageStore::instanceMutex;
+QWeakPointer<PageStore> PageStore::instance;
+QString PageStore::cacheDirectory;
+std::atomic<size_t> PageStore::residentPageLimit {PageStore::DEFAULT_RESIDENT_PAGES};
+
+
+//! Size of each slot (timestamp column followed by value column)
+static const qint64 SLOT_BYTES = PageStore::PAGE_SAMPLES * 2 * sizeof(double);
+
+
+PageStore::PageStore()
+{
+    QString dir = getCacheDirectory();
+
+    QDir().mkpath(dir);
+
+    file.setFileTemplate(dir + QDir::separator() + "pages_XXXXXX.dat");
+
+    valid = file.open();
+
+    if (!valid)
+    {
+        qWarning() << "Could not create page file in" << dir << "- paged data will be kept in memory";
+    }
+}
+
+
+PageStore::~PageStore()
+{
+    // The page file is removed automatically
+    unmapAll();
+}
+
+
+QSharedPointer<PageStore> PageStore::getInstance()
+{
+    QMutexLocker lock(&instanceMutex);
+
+    QSharedPointer<PageStore> store = instance.toStrongRef();
+
+    if (store.isNull())
+    {
+        store = QSharedPointer<PageStore>(new PageStore());
+        instance = store;
+    }
+
+    return store;
+}
+
+
+void PageStore::setCacheDirectory(QString dir)
+{
+    QMutexLocker lock(&instanceMutex);
+
+    cacheDirectory = dir;
+}
+
+
+QString PageStore::getCacheDirectory()
+{
+    QMutexLocker lock(&instanceMutex);
+
+    if (cacheDirectory.isEmpty())
+    {
+        return QDir::tempPath();
+    }
+
+    return cacheDirectory;
+}
+
+
+void PageStore::setResidentPageLimit(size_t pages)
+{
+    residentPageLimit = std::max<size_t>(pages, 1);
+}
+
+
+int64_t PageStore::writePage(const DataPoint *points)
+{
+    QMutexLocker lock(&mutex);
+
+    if (!valid) return -1;
+
+    int64_t slot;
+
+    if (!freeSlots.empty())
+    {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else
+    {
+        slot = slotCount++;
+    }
+
+    std::vector<double> column(PAGE_SAMPLES * 2);
+
+    for (uint64_t idx = 0; idx < PAGE_SAMPLES; idx++)
+    {
+        column[idx] = points[idx].timestamp;
+        column[PAGE_SAMPLES + idx] = points[idx].value;
+    }
+
+    bool ok = file.seek(slot * SLOT_BYTES);
+
+    ok &= file.write(reinterpret_cast<const char*>(column.data()), SLOT_BYTES) == SLOT_BYTES;
+
+    // Data must reach the file before the slot can be mapped
+    ok &= file.flush();
+
+    if (!ok)
+    {
+        qWarning() << "Could not write to page file" << file.fileName();
+
+        freeSlots.push_back(slot);
+        return -1;
+    }
+
+    return slot;
+}
+
+
+void PageStore::releasePage(int64_t slot)
+{
+    QMutexLocker lock(&mutex);
+
+    if (slot < 0 || slot >= slotCount) return;
+
+    unmapSlot(slot);
+
+    freeSlots.push_back(slot);
+
+    // Reclaim disk space once no slots are in use
+    if ((int64_t) freeSlots.size() == slotCount)
+    {
+        unmapAll();
+
+        freeSlots.clear();
+        slotCount = 0;
+
+        file.resize(0);
+    }
+}
+
+
+bool PageStore::readPage(int64_t slot, uint64_t idx, uint64_t count, DataPoint *points) const
+{
+    QMutexLocker lock(&mutex);
+
+    if (idx + count > PAGE_SAMPLES) return false;
+
+    const double *column = mapSlot(slot);
+
+    if (!column) return false;
+
+    for (uint64_t ii = 0; ii < count; ii++)
+    {
+        points[ii].timestamp = column[idx + ii];
+        points[ii].value = column[PAGE_SAMPLES + idx + ii];
+    }
+
+    return true;
+}
+
+
+uint64_t PageStore::searchPage(int64_t slot, double t, bool upper) const
+{
+    QMutexLocker lock(&mutex);
+
+    const double *begin = mapSlot(slot);
+
+    if (!begin) return 0;
+
+    const double *end = begin + PAGE_SAMPLES;
+
+    const double *it = upper ? std::upper_bound(begin, end, t) : std::lower_bound(begin, end, t);
+
+    return it - begin;
+}
+
+
+size_t PageStore::getPageCount() const
+{
+    QMutexLocker lock(&mutex);
+
+    return slotCount - freeSlots.size();
+}
+
+
+size_t PageStore::getResidentPageCount() const
+{
+    QMutexLocker lock(&mutex);
+
+    return mapped.size();
+}
+
+
+/*
+ * Return the mapping for the specified slot, mapping it into memory if required.
+ * The least-recently-used slot is unmapped if the resident limit is reached.
+ */
+const double* PageStore::mapSlot(int64_t slot) const
+{
+    if (!valid || slot < 0 || slot >= slotCount) return nullptr;
+
+    auto it = mapped.find(slot);
+
+    if (it != mapped.end())
+    {
+        if (lru.front() != slot)
+        {
+            lru.remove(slot);
+            lru.push_front(slot);
+        }
+
+        return it.value();
+    }
+
+    const size_t limit = getResidentPageLimit();
+
+    while ((size_t) mapped.size() >= limit && !lru.empty())
+    {
+        unmapSlot(lru.back());
+    }
+
+    uchar *data = file.map(slot * SLOT_BYTES, SLOT_BYTES);
+
+    if (!data)
+    {
+        qWarning() << "Could not map page" << slot << "from" << file.fileName();
+        return nullptr;
+    }
+
+    const double *column = reinterpret_cast<const double*>(data);
+
+    mapped.insert(slot, column);
+    lru.push_front(slot);
+
+    return column;
+}
+
+
+void PageStore::unmapSlot(int64_t slot) const
+{
+    auto it = mapped.find(slot);
+
+    if (it != mapped.end())
+    {
+        file.unmap(reinterpret_cast<uchar*>(const_cast<double*>(it.value())));
+
+        mapped.erase(it);
+        lru.remove(slot);
+    }
+}
+
+
+void PageStore::unmapAll() const
+{
+    while (!lru.empty())
+    {
+        unmapSlot(lru.back());
+    }
+}
@@ -0,0 +1,107 @@
+#ifndef PAGE_STORE_HPP
+#define PAGE_STORE_HPP
+
+#include <QTemporaryFile>
+#include <QSharedPointer>
+#include <QWeakPointer>
+#include <QHash>
+#include <QMutex>
+
+#include <atomic>
+#include <list>
+#include <vector>
+
+#include "data_point.hpp"
+
+
+/**
+ * @brief The PageStore class provides the disk storage which is shared by all PagedDataSeries objects
+ *
+ * All pages are written to a single (temporary) file, which is divided into fixed-size slots.
+ * Each slot holds the timestamps and values of one page of PAGE_SAMPLES samples.
+ *
+ * - Slots which are released (e.g. when a series is cleared) are reused for new pages
+ * - Slots are memory-mapped on demand, and a global limit applies to the number of mapped slots
+ *   (the least-recently-used slot is unmapped first)
+ * - Samples are copied out while the store is locked, so mappings are never exposed to callers
+ *
+ * The store is created when first requested, and removed once no series refers to it.
+ */
+class PageStore
+{
+public:
+    ~PageStore();
+
+    //! Number of samples in each page
+    static const uint64_t PAGE_SAMPLES = 0x10000;
+
+    //! Default number of slots which are kept memory-mapped (across all series)
+    static const size_t DEFAULT_RESIDENT_PAGES;
+
+    static QSharedPointer<PageStore> getInstance(void);
+
+    //! Directory where the page file is created (applies to the next store which is created)
+    static void setCacheDirectory(QString dir);
+    static QString getCacheDirectory(void);
+
+    //! Maximum number of slots which are kept memory-mapped
+    static void setResidentPageLimit(size_t pages);
+    static size_t getResidentPageLimit(void) { return residentPageLimit.load(); }
+
+    //! Returns true if the page file could be created
+    bool isValid(void) const { return valid; }
+
+    /**
+     * @brief writePage writes a full page (PAGE_SAMPLES samples) to a free slot
+     * @return the slot index, or -1 if the page could not be written
+     */
+    int64_t writePage(const DataPoint *points);
+
+    //! Release a slot, so that it can be reused
+    void releasePage(int64_t slot);
+
+    //! Copy samples [idx, idx + count) from the specified slot
+    bool readPage(int64_t slot, uint64_t idx, uint64_t count, DataPoint *points) const;
+
+    /**
+     * @brief searchPage performs a binary search of the timestamps in the specified slot
+     * @param upper - find the first sample after t (otherwise, the first sample at or after t)
+     * @return the index within the page
+     */
+    uint64_t searchPage(int64_t slot, double t, bool upper) const;
+
+    //! Number of slots in use
+    size_t getPageCount(void) const;
+
+    //! Number of slots which are currently mapped
+    size_t getResidentPageCount(void) const;
+
+protected:
+    PageStore();
+
+    // Note: The following functions must be called with mutex held
+    const double* mapSlot(int64_t slot) const;
+    void unmapSlot(int64_t slot) const;
+    void unmapAll(void) const;
+
+    mutable QMutex mutex;
+
+    mutable QTemporaryFile file;
+
+    bool valid = false;
+
+    //! Number of slots in the file, and the slots which are not in use
+    int64_t slotCount = 0;
+    std::vector<int64_t> freeSlots;
+
+    //! Currently mapped slots, and their usage order (most recent first)
+    mutable QHash<int64_t, const double*> mapped;
+    mutable std::list<int64_t> lru;
+
+    static QMutex instanceMutex;
+    static QWeakPointer<PageStore> instance;
+    static QString cacheDirectory;
+    static std::atomic<size_t> residentPageLimit;
+};
+
+#endif // PAGE_STORE_HPP
@@ -0,0 +1,559 @@
+#include <math.h>
+#include <algorithm>
+#include <stdexcept>
+
+#include "paged_data_series.hpp"
+
+
+const uint64_t PagedDataSeries::PAGE_SAMPLES;
+
+
+PagedDataSeries::PagedDataSeries(QString lbl) : DataSeries(lbl),
+    store(PageStore::getInstance())
+{
+    storageValid = store->isValid();
+}
+
+
+PagedDataSeries::PagedDataSeries(QString grp, QString lbl) : DataSeries(grp, lbl),
+    store(PageStore::getInstance())
+{
+    storageValid = store->isValid();
+}
+
+
+PagedDataSeries::~PagedDataSeries()
+{
+    releasePages(0);
+}
+
+
+size_t PagedDataSeries::getPageCount() const
+{
+    sealForRead();
+
+    DataLocker lock(this);
+
+    return pages.size();
+}
+
+
+/*
+ * Add a single sample (data_mutex must be held)
+ * Returns false if the sample was ignored
+ */
+bool PagedDataSeries::addSample(const DataPoint &point)
+{
+    // Ignore NaN and inf values
+    if (isnan(point.value) || isinf(point.value)) return false;
+
+    uint64_t n = storedCount();
+
+    if (n == 0)
+    {
+        tail.push_back(point);
+        return true;
+    }
+
+    double newest = n > pages.size() * PAGE_SAMPLES ? tail.back().timestamp : pages.back().last.timestamp;
+
+    if (point.timestamp < newest)
+    {
+        // Out-of-order samples are merged (once per batch) when the series is next read
+        bufferLateSample(point, newest);
+        return true;
+    }
+
+    tail.push_back(point);
+
+    if (tail.size() >= PAGE_SAMPLES)
+    {
+        sealTail();
+    }
+
+    return true;
+}
+
+
+/*
+ * Merge the buffered samples into the stored data.
+ *
+ * Pages from the one containing the oldest buffered sample onwards are read back (one at a time),
+ * merged with the buffered samples, and written to new slots.
+ * Pages before that point are not touched.
+ */
+void PagedDataSeries::mergeSamples(const std::vector<DataPoint> &points)
+{
+    if (points.empty()) return;
+
+    const uint64_t sealed = pages.size() * PAGE_SAMPLES;
+
+    // Existing samples with equal timestamps are retained first
+    uint64_t start = storedIndexForTimestamp(points.front().timestamp, SEARCH_LEFT_TO_RIGHT);
+    uint64_t firstPage = std::min<uint64_t>(start, sealed) / PAGE_SAMPLES;
+
+    // Existing samples from the first affected page onwards
+    std::vector<int64_t> oldSlots(pageSlots.begin() + firstPage, pageSlots.end());
+    std::vector<DataPoint> oldTail;
+
+    oldTail.swap(tail);
+
+    pages.resize(firstPage);
+    pageSlots.resize(firstPage);
+
+    std::vector<DataPoint> buffer;
+    size_t bufferIdx = 0;
+    size_t nextSlot = 0;
+    bool tailRead = false;
+
+    // Return the next existing sample, reading pages back from the store as required
+    auto nextExisting = [&](DataPoint &dp) -> bool {
+        while (bufferIdx >= buffer.size())
+        {
+            buffer.clear();
+            bufferIdx = 0;
+
+            if (nextSlot < oldSlots.size())
+            {
+                int64_t slot = oldSlots[nextSlot++];
+
+                buffer.resize(PAGE_SAMPLES);
+
+                if (!store->readPage(slot, 0, PAGE_SAMPLES, buffer.data()))
+                {
+                    qWarning() << "Could not read page for" << getLabel() << "- samples have been lost";
+                    buffer.clear();
+                }
+
+                store->releasePage(slot);
+            }
+            else if (!tailRead)
+            {
+                buffer.swap(oldTail);
+                tailRead = true;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        dp = buffer[bufferIdx++];
+        return true;
+    };
+
+    uint64_t consumed = firstPage * PAGE_SAMPLES;
+
+    DataPoint existing;
+    bool hasExisting = nextExisting(existing);
+
+    size_t idx = 0;
+
+    tail.reserve(PAGE_SAMPLES);
+
+    while (hasExisting || idx < points.size())
+    {
+        if (hasExisting && (idx >= points.size() || existing.timestamp <= points[idx].timestamp))
+        {
+            tail.push_back(existing);
+            hasExisting = nextExisting(existing);
+            consumed++;
+        }
+        else
+        {
+            // Samples which precede the clipped region remain hidden
+            if (consumed < offset) offset++;
+
+            tail.push_back(points[idx++]);
+        }
+
+        if (tail.size() >= PAGE_SAMPLES)
+        {
+            sealTail();
+        }
+    }
+}
+
+
+void PagedDataSeries::addData(DataPoint point, bool do_update)
+{
+    lockData();
+
+    bool added = addSample(point);
+
+    data_mutex.unlock();
+
+    if (!added) return;
+
+    if (do_update)
+    {
+        update();
+    }
+    else
+    {
+        pendingUpdate = true;
+    }
+}
+
+
+void PagedDataSeries::appendData(const std::vector<DataPoint> &points, bool do_update)
+{
+    if (points.empty()) return;
+
+    lockData();
+
+    for (const DataPoint &point : points)
+    {
+        addSample(point);
+    }
+
+    data_mutex.unlock();
+
+    if (do_update)
+    {
+        update();
+    }
+    else
+    {
+        pendingUpdate = true;
+    }
+}
+
+
+/*
+ * Write the (full) tail page to the PageStore, and record a summary of the page
+ */
+void PagedDataSeries::sealTail()
+{
+    // Without disk storage, all data remain in the tail
+    if (!storageValid || tail.size() < PAGE_SAMPLES) return;
+
+    DataSummaryBlock summary;
+
+    summary.first_index = pages.size() * PAGE_SAMPLES;
+    summary.last_index = summary.first_index + PAGE_SAMPLES - 1;
+    summary.first = tail.front();
+    summary.last = tail[PAGE_SAMPLES - 1];
+    summary.min = tail.front();
+    summary.max = tail.front();
+
+    for (uint64_t idx = 0; idx < PAGE_SAMPLES; idx++)
+    {
+        const DataPoint &dp = tail[idx];
+
+        if (dp.value < summary.min.value) summary.min = dp;
+        if (dp.value > summary.max.value) summary.max = dp;
+    }
+
+    int64_t slot = store->writePage(tail.data());
+
+    if (slot < 0)
+    {
+        qWarning() << "Could not write page for" << getLabel() << "- data will be kept in memory";
+        storageValid = false;
+        return;
+    }
+
+    pages.push_back(summary);
+    pageSlots.push_back(slot);
+
+    // Samples beyond the first page (from out-of-order insertion) remain in the tail
+    tail.erase(tail.begin(), tail.begin() + PAGE_SAMPLES);
+}
+
+
+/*
+ * Release the pages from the specified page onwards (data_mutex must be held)
+ */
+void PagedDataSeries::releasePages(uint64_t first)
+{
+    for (uint64_t page = first; page < pageSlots.size(); page++)
+    {
+        store->releasePage(pageSlots[page]);
+    }
+
+    if (first < pages.size())
+    {
+        pages.resize(first);
+        pageSlots.resize(first);
+    }
+}
+
+
+/*
+ * Return the sample at the specified storage index (data_mutex must be held)
+ */
+DataPoint PagedDataSeries::storedPoint(uint64_t sidx) const
+{
+    DataPoint dp;
+
+    storedPoints(sidx, 1, &dp);
+
+    return dp;
+}
+
+
+/*
+ * Copy samples from the specified storage index (data_mutex must be held)
+ */
+void PagedDataSeries::storedPoints(uint64_t sidx, uint64_t count, DataPoint *points) const
+{
+    const uint64_t sealed = pages.size() * PAGE_SAMPLES;
+
+    while (count > 0 && sidx < sealed)
+    {
+        uint64_t page = sidx / PAGE_SAMPLES;
+        uint64_t idx = sidx % PAGE_SAMPLES;
+        uint64_t n = std::min<uint64_t>(count, PAGE_SAMPLES - idx);
+
+        if (!store->readPage(pageSlots[page], idx, n, points))
+        {
+            std::fill(points, points + n, DataPoint());
+        }
+
+        sidx += n;
+        points += n;
+        count -= n;
+    }
+
+    for (uint64_t ii = 0; ii < count; ii++)
+    {
+        uint64_t tidx = sidx + ii - sealed;
+
+        points[ii] = tidx < tail.size() ? tail[tidx] : DataPoint();
+    }
+}
+
+
+/*
+ * Binary search across all stored samples (data_mutex must be held).
+ * The page summaries are searched first, so that at most one page is searched.
+ *
+ * SEARCH_LEFT_TO_RIGHT finds the first sample *after* t (upper bound)
+ * SEARCH_RIGHT_TO_LEFT finds the first sample *at or after* t (lower bound)
+ */
+uint64_t PagedDataSeries::storedIndexForTimestamp(double t, SearchDirection direction) const
+{
+    const bool upper = direction == SEARCH_LEFT_TO_RIGHT;
+
+    auto after = [upper](double ts, double t) { return upper ? (ts > t) : (ts >= t); };
+
+    // Find the first page which ends after t
+    auto page = std::partition_point(pages.begin(), pages.end(), [&](const DataSummaryBlock &block) {
+        return !after(block.last.timestamp, t);
+    });
+
+    if (page != pages.end())
+    {
+        uint64_t p = std::distance(pages.begin(), page);
+
+        return p * PAGE_SAMPLES + store->searchPage(pageSlots[p], t, upper);
+    }
+
+    auto it = std::partition_point(tail.begin(), tail.end(), [&](const DataPoint &dp) {
+        return !after(dp.timestamp, t);
+    });
+
+    return pages.size() * PAGE_SAMPLES + std::distance(tail.begin(), it);
+}
+
+
+/*
+ * Truncate the stored data to the first n samples (data_mutex must be held)
+ */
+void PagedDataSeries::truncateStorage(uint64_t n)
+{
+    if (n >= storedCount()) return;
+
+    const uint64_t sealed = pages.size() * PAGE_SAMPLES;
+
+    if (n >= sealed)
+    {
+        tail.resize(n - sealed);
+        return;
+    }
+
+    uint64_t keep = n / PAGE_SAMPLES;
+    uint64_t remainder = n % PAGE_SAMPLES;
+
+    // The partial page is moved back into memory
+    std::vector<DataPoint> partial(remainder);
+
+    storedPoints(keep * PAGE_SAMPLES, remainder, partial.data());
+
+    partial.reserve(PAGE_SAMPLES);
+
+    releasePages(keep);
+    tail.swap(partial);
+}
+
+
+void PagedDataSeries::clipTimeRange(double t_min, double t_max, bool do_update)
+{
+    if (t_min > t_max)
+    {
+        std::swap(t_min, t_max);
+    }
+
+    lockData();
+
+    mergeLateSamples();
+
+    uint64_t first = storedIndexForTimestamp(t_min, SEARCH_RIGHT_TO_LEFT);
+    uint64_t last = storedIndexForTimestamp(t_max, SEARCH_LEFT_TO_RIGHT);
+
+    truncateStorage(last);
+
+    offset = std::min(std::max(offset, first), storedCount());
+
+    data_mutex.unlock();
+
+    if (do_update)
+    {
+        update();
+    }
+}
+
+
+void PagedDataSeries::clearData(bool do_update)
+{
+    lockData();
+
+    releasePages(0);
+
+    tail.clear();
+    offset = 0;
+
+    clearLateSamples();
+
+    data_mutex.unlock();
+
+    if (do_update)
+    {
+        update();
+    }
+}
+
+
+uint64_t PagedDataSeries::getMemoryUsage() const
+{
+    DataLocker lock(this);
+
+    return tail.capacity() * sizeof(DataPoint) +
+           pages.capacity() * (sizeof(DataSummaryBlock) + sizeof(int64_t));
+}
+
+
+void PagedDataSeries::truncateData(uint64_t count, bool do_update)
+{
+    lockData();
+
+    mergeLateSamples();
+
+    truncateStorage(offset + count);
+
+    data_mutex.unlock();
+
+    if (do_update)
+    {
+        update();
+    }
+}
+
+
+size_t PagedDataSeries::size() const
+{
+    sealForRead();
+
+    DataLocker lock(this);
+
+    return storedCount() - offset;
+}
+
+
+/*
+ * Return a copy of *all* samples.
+ * Note: This loads the entire series into memory!
+ */
+std::vector<DataPoint> PagedDataSeries::getData() const
+{
+    sealForRead();
+
+    DataLocker lock(this);
+
+    std::vector<DataPoint> all(storedCount() - offset);
+
+    storedPoints(offset, all.size(), all.data());
+
+    return all;
+}
+
+
+DataPoint PagedDataSeries::getRawDataPoint(uint64_t idx) const
+{
+    sealForRead();
+
+    DataLocker lock(this);
+
+    uint64_t n = storedCount() - offset;
+
+    // The series may have been clipped since the caller checked the index
+    if (idx >= n)
+    {
+        throw std::out_of_range("data index out of range");
+    }
+
+    return storedPoint(offset + idx);
+}
+
+
+uint64_t PagedDataSeries::getRawDataPoints(uint64_t idx, uint64_t count, DataPoint *points) const
+{
+    sealForRead();
+
+    DataLocker lock(this);
+
+    uint64_t n = storedCount() - offset;
+
+    if (idx >= n) return 0;
+
+    count = std::min<uint64_t>(count, n - idx);
+
+    storedPoints(offset + idx, count, points);
+
+    return count;
+}
+
+
+bool PagedDataSeries::getRawSummaryBlock(uint64_t idx, DataSummaryBlock &block) const
+{
+    sealForRead();
+
+    DataLocker lock(this);
+
+    uint64_t page = (offset + idx) / PAGE_SAMPLES;
+
+    if (page >= pages.size()) return false;
+
+    // First page has been (partially) clipped
+    if (page * PAGE_SAMPLES < offset) return false;
+
+    block = pages[page];
+
+    block.first_index -= offset;
+    block.last_index -= offset;
+
+    return true;
+}
+
+
+uint64_t PagedDataSeries::getIndexForTimestamp(double t, SearchDirection direction) const
+{
+    sealForRead();
+
+    DataLocker lock(this);
+
+    uint64_t sidx = storedIndexForTimestamp(t, direction);
+
+    return sidx > offset ? sidx - offset : 0;
+}
@@ -0,0 +1,100 @@
+#ifndef PAGED_DATA_SERIES_HPP
+#define PAGED_DATA_SERIES_HPP
+
+#include <QSharedPointer>
+
+#include "data_series.hpp"
+#include "page_store.hpp"
+
+
+/**
+ * @brief The PagedDataSeries class is a disk-backed DataSeries for datasets larger than RAM
+ *
+ * Samples are split into fixed-size pages of PAGE_SAMPLES samples,
+ * which are written to the PageStore shared by all paged series.
+ *
+ * - New samples are collected in an in-memory "tail" page, which is written to disk once full
+ * - Pages are memory-mapped on demand by the PageStore, which limits the number of resident pages
+ * - A summary header (first, last, min, max) is retained in memory for each page,
+ *   so that timestamp searches and min/max scans touch at most two pages
+ *
+ * Out-of-order samples are collected in the ingestion buffer, and merged when the series is next read.
+ * Only the pages from the oldest buffered sample onwards are rewritten.
+ */
+class PagedDataSeries : public DataSeries
+{
+    Q_OBJECT
+
+public:
+    PagedDataSeries(QString label);
+    PagedDataSeries(QString group, QString label);
+
+    virtual ~PagedDataSeries();
+
+    //! Number of samples in each page (per column)
+    static const uint64_t PAGE_SAMPLES = PageStore::PAGE_SAMPLES;
+
+    //! Returns true if pages can be written to disk (otherwise all data are kept in memory)
+    bool isDiskBacked(void) const { return storageValid; }
+
+    size_t getPageCount(void) const;
+
+    // Memory used by the tail and page summaries (mapped pages are shared between series)
+    virtual uint64_t getMemoryUsage(void) const override;
+
+    using DataSeries::addData;
+    virtual void addData(DataPoint point, bool update=true) override;
+    virtual void appendData(const std::vector<DataPoint> &points, bool update=true) override;
+
+    virtual void appendColumns(const double *timestamps, const double *values, uint64_t count, bool update=true) override
+    {
+        appendColumnsAsPoints(timestamps, values, count, update);
+    }
+
+    virtual void clipTimeRange(double t_min, double t_max, bool update=true) override;
+
+    virtual void clearData(bool update=true) override;
+    virtual void truncateData(uint64_t count, bool update=true) override;
+
+    virtual size_t size() const override;
+
+    virtual std::vector<DataPoint> getData() const override;
+
+    virtual uint64_t getIndexForTimestamp(double t, SearchDirection direction=SEARCH_LEFT_TO_RIGHT) const override;
+
+    virtual bool hasSummaryBlocks(void) const override { return true; }
+
+protected:
+    virtual DataPoint getRawDataPoint(uint64_t idx) const override;
+    virtual uint64_t getRawDataPoints(uint64_t idx, uint64_t count, DataPoint *points) const override;
+    virtual bool getRawSummaryBlock(uint64_t idx, DataSummaryBlock &block) const override;
+
+    virtual void mergeSamples(const std::vector<DataPoint> &points) override;
+
+    // Note: The following functions must be called with data_mutex held
+    bool addSample(const DataPoint &point);
+    void sealTail(void);
+    void releasePages(uint64_t first);
+    void truncateStorage(uint64_t n);
+
+    uint64_t storedCount(void) const { return pages.size() * PAGE_SAMPLES + tail.size(); }
+    DataPoint storedPoint(uint64_t sidx) const;
+    void storedPoints(uint64_t sidx, uint64_t count, DataPoint *points) const;
+    uint64_t storedIndexForTimestamp(double t, SearchDirection direction) const;
+
+    QSharedPointer<PageStore> store;
+
+    bool storageValid = false;
+
+    //! Summary of each page which has been written to disk, and the PageStore slot which holds it
+    std::vector<DataSummaryBlock> pages;
+    std::vector<int64_t> pageSlots;
+
+    //! Samples which have not yet been written to disk
+    std::vector<DataPoint> tail;
+
+    //! Number of stored samples which have been clipped from the start of the series
+    uint64_t offset = 0;
+};
+
+#endif // PAGED_DATA_SERIES_HPP
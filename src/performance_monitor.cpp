@@ -0,0 +1,375 @@
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <chrono>
+#include <string.h>
+
+#include "performance_monitor.hpp"
+
+
+const int PerformanceEvent::DETAIL_LENGTH;
+const uint64_t PerformanceThreadBuffer::CAPACITY;
+const size_t PerformanceMonitor::MAX_HISTORY;
+
+std::atomic<bool> PerformanceMonitor::enabled {true};
+
+
+namespace
+{
+
+/*
+ * Releases the buffer of a thread when the thread exits,
+ * so that short-lived (worker) threads do not each allocate a new buffer.
+ */
+struct ThreadBufferHandle
+{
+    PerformanceThreadBuffer *buffer = nullptr;
+
+    ~ThreadBufferHandle()
+    {
+        if (buffer)
+        {
+            buffer->inUse = false;
+        }
+    }
+};
+
+}
+
+
+void PerformanceEvent::setDetail(const QString &text)
+{
+    if (text.isEmpty())
+    {
+        detail[0] = 0;
+        return;
+    }
+
+    QByteArray bytes = text.toUtf8();
+
+    int n = qMin((int) bytes.size(), DETAIL_LENGTH - 1);
+
+    memcpy(detail, bytes.constData(), n);
+    detail[n] = 0;
+}
+
+
+bool PerformanceThreadBuffer::push(const PerformanceEvent &event)
+{
+    uint64_t h = head.load(std::memory_order_relaxed);
+    uint64_t t = tail.load(std::memory_order_acquire);
+
+    if (h - t >= CAPACITY)
+    {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    events[h % CAPACITY] = event;
+
+    head.store(h + 1, std::memory_order_release);
+
+    return true;
+}
+
+
+void PerformanceThreadBuffer::drain(std::vector<PerformanceEvent> &output)
+{
+    uint64_t t = tail.load(std::memory_order_relaxed);
+    uint64_t h = head.load(std::memory_order_acquire);
+
+    for (; t < h; t++)
+    {
+        output.push_back(events[t % CAPACITY]);
+    }
+
+    tail.store(h, std::memory_order_release);
+}
+
+
+void PerformanceStatistic::add(double value)
+{
+    if (count == 0 || value < minimum) minimum = value;
+    if (count == 0 || value > maximum) maximum = value;
+
+    count++;
+    total += value;
+    last = value;
+}
+
+
+PerformanceMonitor::PerformanceMonitor()
+{
+}
+
+
+int64_t PerformanceMonitor::now()
+{
+    static const auto epoch = std::chrono::steady_clock::now();
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+
+PerformanceThreadBuffer *PerformanceMonitor::getThreadBuffer()
+{
+    static thread_local ThreadBufferHandle handle;
+
+    if (!handle.buffer)
+    {
+        handle.buffer = acquireBuffer();
+    }
+
+    return handle.buffer;
+}
+
+
+/*
+ * Find a buffer which is not in use, or create a new one.
+ * This is only called once for each thread, so may lock.
+ */
+PerformanceThreadBuffer *PerformanceMonitor::acquireBuffer()
+{
+    QMutexLocker lock(&mutex);
+
+    PerformanceThreadBuffer *buffer = nullptr;
+
+    for (auto &b : buffers)
+    {
+        bool expected = false;
+
+        if (b->inUse.compare_exchange_strong(expected, true))
+        {
+            buffer = b.get();
+            break;
+        }
+    }
+
+    if (!buffer)
+    {
+        buffers.emplace_back(new PerformanceThreadBuffer());
+
+        buffer = buffers.back().get();
+        buffer->inUse = true;
+    }
+
+    buffer->thread = ++threadCount;
+
+    return buffer;
+}
+
+
+void PerformanceMonitor::recordSpan(const char *name, const QString &detail, int64_t start, int64_t duration)
+{
+    if (!isEnabled()) return;
+
+    PerformanceThreadBuffer *buffer = getThreadBuffer();
+
+    PerformanceEvent event;
+
+    event.type = PerformanceEvent::SPAN;
+    event.name = name;
+    event.start = start;
+    event.duration = duration;
+    event.thread = buffer->thread;
+    event.setDetail(detail);
+
+    buffer->push(event);
+}
+
+
+void PerformanceMonitor::recordCounter(const char *name, const QString &detail, double value)
+{
+    if (!isEnabled()) return;
+
+    PerformanceThreadBuffer *buffer = getThreadBuffer();
+
+    PerformanceEvent event;
+
+    event.type = PerformanceEvent::COUNTER;
+    event.name = name;
+    event.start = now();
+    event.value = value;
+    event.thread = buffer->thread;
+    event.setDetail(detail);
+
+    buffer->push(event);
+}
+
+
+void PerformanceMonitor::collect()
+{
+    QMutexLocker lock(&mutex);
+
+    std::vector<PerformanceEvent> events;
+
+    for (auto &buffer : buffers)
+    {
+        buffer->drain(events);
+    }
+
+    for (const auto &event : events)
+    {
+        QString detail = QString::fromUtf8(event.detail);
+        QString key = QString(event.name) + '\n' + detail;
+
+        auto it = statistics.find(key);
+
+        if (it == statistics.end())
+        {
+            PerformanceStatistic stat;
+
+            stat.type = event.type;
+            stat.name = QString(event.name);
+            stat.detail = detail;
+
+            it = statistics.insert(key, stat);
+        }
+
+        it->add(event.type == PerformanceEvent::SPAN ? event.duration / 1e6 : event.value);
+
+        history.push_back(event);
+    }
+
+    while (history.size() > MAX_HISTORY)
+    {
+        history.pop_front();
+    }
+}
+
+
+QList<PerformanceStatistic> PerformanceMonitor::getStatistics() const
+{
+    QMutexLocker lock(&mutex);
+
+    return statistics.values();
+}
+
+
+uint64_t PerformanceMonitor::getDroppedCount() const
+{
+    QMutexLocker lock(&mutex);
+
+    uint64_t dropped = 0;
+
+    for (const auto &buffer : buffers)
+    {
+        dropped += buffer->getDropped();
+    }
+
+    return dropped;
+}
+
+
+void PerformanceMonitor::reset()
+{
+    // Discard any events which have not yet been collected
+    collect();
+
+    QMutexLocker lock(&mutex);
+
+    statistics.clear();
+    history.clear();
+}
+
+
+/**
+ * @brief PerformanceMonitor::exportTrace - Export the event history in the Chrome "Trace Event" format
+ * @param filename - JSON file to write
+ * @param errors - List of errors
+ * @return true if the file was written
+ *
+ * Spans are written as complete ("X") events, and counters as counter ("C") events.
+ * The category of each event is the prefix of the event name (e.g. "Plot" for "Plot/Resample").
+ */
+bool PerformanceMonitor::exportTrace(QString filename, QStringList &errors) const
+{
+    QFile file(filename);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        errors.append(QString("Could not open file for writing: %1").arg(filename));
+        return false;
+    }
+
+    QMutexLocker lock(&mutex);
+
+    file.write("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    bool first = true;
+
+    for (const auto &event : history)
+    {
+        QString name(event.name);
+        QString detail = QString::fromUtf8(event.detail);
+
+        QJsonObject json;
+
+        json["name"] = name;
+        json["cat"] = name.section('/', 0, 0);
+        json["pid"] = 1;
+        json["tid"] = (int) event.thread;
+        json["ts"] = event.start / 1e3;
+
+        QJsonObject args;
+
+        if (event.type == PerformanceEvent::SPAN)
+        {
+            json["ph"] = "X";
+            json["dur"] = event.duration / 1e3;
+
+            if (!detail.isEmpty())
+            {
+                args["detail"] = detail;
+            }
+        }
+        else
+        {
+            // Counters with different details are displayed as separate tracks
+            json["ph"] = "C";
+
+            if (!detail.isEmpty())
+            {
+                json["name"] = name + " " + detail;
+            }
+
+            args["value"] = event.value;
+        }
+
+        json["args"] = args;
+
+        if (!first)
+        {
+            file.write(",\n");
+        }
+
+        file.write(QJsonDocument(json).toJson(QJsonDocument::Compact));
+
+        first = false;
+    }
+
+    file.write("\n]}\n");
+
+    if (file.error() != QFileDevice::NoError)
+    {
+        errors.append(QString("Error writing file: %1").arg(filename));
+        return false;
+    }
+
+    return true;
+}
+
+
+double PerformanceScope::stop()
+{
+    if (start < 0) return 0;
+
+    int64_t duration = PerformanceMonitor::now() - start;
+
+    PerformanceMonitor::getInstance()->recordSpan(name, detail, start, duration);
+
+    start = -1;
+
+    return duration / 1e6;
+}
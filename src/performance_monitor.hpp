@@ -0,0 +1,211 @@
+#ifndef PERFORMANCE_MONITOR_HPP
+#define PERFORMANCE_MONITOR_HPP
+
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include <stdint.h>
+
+
+/**
+ * @brief The PerformanceEvent struct is a single timing (span) or counter sample
+ *
+ * Events are plain data, so that they can be recorded without any allocation.
+ * Event names are static strings of the form "Category/Name".
+ */
+struct PerformanceEvent
+{
+    enum EventType
+    {
+        SPAN,
+        COUNTER,
+    };
+
+    static const int DETAIL_LENGTH = 48;
+
+    EventType type = SPAN;
+
+    const char *name = nullptr;
+
+    //! Optional detail (e.g. the series label), truncated to DETAIL_LENGTH - 1 bytes
+    char detail[DETAIL_LENGTH] = {0};
+
+    //! Start time and duration (ns), relative to PerformanceMonitor::now()
+    int64_t start = 0;
+    int64_t duration = 0;
+
+    //! Counter value
+    double value = 0;
+
+    uint32_t thread = 0;
+
+    void setDetail(const QString &text);
+};
+
+
+/**
+ * @brief The PerformanceThreadBuffer class is a single-producer / single-consumer ring of events
+ *
+ * Each recording thread writes to its own buffer, without locking.
+ * Events are dropped (and counted) if the buffer is full, rather than blocking the producer.
+ */
+class PerformanceThreadBuffer
+{
+public:
+    static const uint64_t CAPACITY = 0x1000;
+
+    // Add an event (producer thread only)
+    bool push(const PerformanceEvent &event);
+
+    // Remove all available events (consumer only)
+    void drain(std::vector<PerformanceEvent> &events);
+
+    uint64_t getDropped(void) const { return dropped; }
+
+    //! Set while a thread is writing to this buffer
+    std::atomic<bool> inUse {false};
+
+    uint32_t thread = 0;
+
+protected:
+    std::atomic<uint64_t> head {0};
+    std::atomic<uint64_t> tail {0};
+    std::atomic<uint64_t> dropped {0};
+
+    PerformanceEvent events[CAPACITY];
+};
+
+
+/**
+ * @brief The PerformanceStatistic struct aggregates all events with the same name and detail
+ *
+ * Span statistics are in milliseconds, counter statistics are in the units of the counter.
+ */
+struct PerformanceStatistic
+{
+    PerformanceEvent::EventType type = PerformanceEvent::SPAN;
+
+    QString name;
+    QString detail;
+
+    uint64_t count = 0;
+
+    double total = 0;
+    double minimum = 0;
+    double maximum = 0;
+    double last = 0;
+
+    double getMean(void) const { return count > 0 ? total / count : 0; }
+
+    void add(double value);
+};
+
+
+/**
+ * @brief The PerformanceMonitor class collects timing and counter events from all threads
+ *
+ * - Recording is lock-free: each thread records into its own PerformanceThreadBuffer
+ * - collect() (called periodically from the GUI thread) drains the buffers,
+ *   updates the aggregate statistics and keeps a bounded history of events
+ * - The event history can be exported as a Chrome trace (chrome://tracing, Perfetto)
+ *
+ * Recording is enabled by default, and costs two clock reads and a buffer write per span.
+ */
+class PerformanceMonitor
+{
+public:
+    // Singleton design pattern (the instance is never destroyed, as threads may record at exit)
+    static PerformanceMonitor* getInstance()
+    {
+        static PerformanceMonitor *instance = new PerformanceMonitor();
+
+        return instance;
+    }
+
+    static bool isEnabled(void) { return enabled.load(std::memory_order_relaxed); }
+    static void setEnabled(bool en) { enabled = en; }
+
+    // Monotonic time (ns)
+    static int64_t now(void);
+
+    // Record a completed span
+    void recordSpan(const char *name, const QString &detail, int64_t start, int64_t duration);
+
+    // Record a counter value
+    void recordCounter(const char *name, const QString &detail, double value);
+
+    // Drain all thread buffers, and update the statistics
+    void collect(void);
+
+    QList<PerformanceStatistic> getStatistics(void) const;
+
+    // Number of events dropped because a thread buffer was full
+    uint64_t getDroppedCount(void) const;
+
+    // Remove all statistics and event history
+    void reset(void);
+
+    // Write the event history as a Chrome trace JSON file
+    bool exportTrace(QString filename, QStringList &errors) const;
+
+    //! Maximum number of events retained for trace export
+    static const size_t MAX_HISTORY = 200000;
+
+protected:
+    PerformanceMonitor();
+
+    PerformanceThreadBuffer *getThreadBuffer(void);
+    PerformanceThreadBuffer *acquireBuffer(void);
+
+    static std::atomic<bool> enabled;
+
+    //! Protects the list of buffers, and the collected data
+    mutable QMutex mutex;
+
+    std::vector<std::unique_ptr<PerformanceThreadBuffer>> buffers;
+    uint32_t threadCount = 0;
+
+    QMap<QString, PerformanceStatistic> statistics;
+    std::deque<PerformanceEvent> history;
+};
+
+
+/**
+ * @brief The PerformanceScope class records the lifetime of a scope as a span
+ *
+ * Usage:
+ *   PerformanceScope scope("Plot/Resample", series.getLabel());
+ */
+class PerformanceScope
+{
+public:
+    PerformanceScope(const char *name, const QString &detail = QString()) : name(name), detail(detail)
+    {
+        if (PerformanceMonitor::isEnabled())
+        {
+            start = PerformanceMonitor::now();
+        }
+    }
+
+    ~PerformanceScope() { stop(); }
+
+    // Record the span now (rather than at the end of the scope), returns the elapsed time (ms)
+    double stop(void);
+
+protected:
+    const char *name;
+    QString detail;
+
+    int64_t start = -1;
+};
+
+
+#endif // PERFORMANCE_MONITOR_HPP
@@ -78,6 +78,18 @@ void PlotCurve::resampleData(double t_min, double t_max, unsigned int n_pixels)
 }
 
 
+/*
+ * Force resampling on the next call to resampleData (e.g. when the underlying data have changed)
+ */
+void PlotCurve::invalidateSamples()
+{
+    if (worker != nullptr)
+    {
+        worker->invalidate();
+    }
+}
+
+
 void PlotCurve::setVisible(bool on)
 {
     QwtPlotCurve::setVisible(on);
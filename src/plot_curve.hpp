@@ -34,6 +34,7 @@ public:
 
 public slots:
     void resampleData(double t_min, double t_max, unsigned int n_pixels);
+    void invalidateSamples(void);
     void updateLabel(void);
     void updateLineStyle(void);
 
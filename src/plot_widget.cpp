@@ -22,6 +22,7 @@
 
 #include "data_source_manager.hpp"
 #include "lumberjack_settings.hpp"
+#include "performance_monitor.hpp"
 
 
 /**
@@ -58,6 +59,11 @@ PlotWidget::PlotWidget() : QwtPlot()
 
     connect(this, &PlotWidget::customContextMenuRequested, this, &PlotWidget::onContextMenu);
 
+    liveUpdateTimer.setSingleShot(true);
+    liveUpdateTimer.setInterval(50);
+
+    connect(&liveUpdateTimer, &QTimer::timeout, this, &PlotWidget::onLiveDataUpdated);
+
     // Load graph widget settings
 
     auto *settings = LumberjackSettings::getInstance();
@@ -412,6 +418,10 @@ void PlotWidget::onContextMenu(const QPoint &pos)
     syncAction->setCheckable(true);
     syncAction->setChecked(isTimescaleSynced());
 
+    QAction *followAction = plotMenu->addAction(tr("Follow Live Data"));
+    followAction->setCheckable(true);
+    followAction->setChecked(isFollowingLiveData());
+
     QAction *bgColor = plotMenu->addAction(tr("Set Color"));
     QAction *plotTitle = plotMenu->addAction(tr("Set Title"));
 
@@ -496,6 +506,10 @@ void PlotWidget::onContextMenu(const QPoint &pos)
     {
         setTimescaleSynced(!isTimescaleSynced());
     }
+    else if (action == followAction)
+    {
+        setFollowLiveData(!isFollowingLiveData());
+    }
     else if (action == bgColor)
     {
         selectBackgroundColor();
@@ -842,6 +856,8 @@ void PlotWidget::dropEvent(QDropEvent *event)
     }
     else
     {
+        QStringList filenames;
+
         for (const QUrl &url : event->mimeData()->urls())
         {
             const QString& filename = url.toLocalFile();
@@ -850,9 +866,15 @@ void PlotWidget::dropEvent(QDropEvent *event)
 
             if (info.exists() && info.isFile())
             {
-                emit fileDropped(filename);
+                filenames.append(filename);
             }
         }
+
+        // Dropped files are imported together (concurrently)
+        if (!filenames.isEmpty())
+        {
+            emit filesDropped(filenames);
+        }
     }
 }
 
@@ -955,6 +977,15 @@ void PlotWidget::initCrosshairs()
 }
 
 
+void PlotWidget::drawCanvas(QPainter *painter)
+{
+    // Plots are identified by the title of the enclosing dock
+    PerformanceScope scope("Plot/Frame", parentWidget() ? parentWidget()->windowTitle() : QString());
+
+    QwtPlot::drawCanvas(painter);
+}
+
+
 void PlotWidget::updateLayout()
 {
     QwtPlot::updateLayout();
@@ -1501,6 +1532,35 @@ void PlotWidget::mouseMoveEvent(QMouseEvent *event)
 }
 
 
+/**
+ * @brief PlotWidget::setCursorTimestamp - Move the crosshair to the specified timestamp
+ *
+ * Used to display a timestamp selected elsewhere (e.g. in a data table).
+ * The cursorPositionChanged signal is not emitted.
+ */
+void PlotWidget::setCursorTimestamp(double t)
+{
+    if (!crosshair)
+    {
+        initCrosshairs();
+    }
+
+    crosshair->setXValue(t);
+
+    if (isCurveTrackingEnabled() && !tracking_curve.isNull())
+    {
+        auto series = tracking_curve->getDataSeries();
+
+        if (!series.isNull() && series->size() > 0)
+        {
+            crosshair->setYValue(invTransform(QwtPlot::yLeft, transform(tracking_curve->yAxis(), series->getValueAtTime(t))));
+        }
+    }
+
+    replot();
+}
+
+
 void PlotWidget::mousePressEvent(QMouseEvent *event)
 {
     QPoint canvas_pos = canvas()->mapFromGlobal(mapToGlobal(event->pos()));
@@ -1657,6 +1717,9 @@ bool PlotWidget::addSeries(DataSeriesPointer series, int axis_id, bool do_replot
 
     curves.push_back(QSharedPointer<PlotCurve>(curve));
 
+    // Redraw when new data are added to the series (e.g. from a live stream)
+    connect(series.data(), &DataSeries::dataUpdated, this, &PlotWidget::onSeriesDataUpdated);
+
     auto interval = axisInterval(QwtPlot::xBottom);
 
     // Perform initial data sampling
@@ -1692,6 +1755,8 @@ bool PlotWidget::removeSeries(DataSeriesPointer series)
 
         if (!curve.isNull() && curve->getDataSeries() == series)
         {
+            disconnect(series.data(), &DataSeries::dataUpdated, this, &PlotWidget::onSeriesDataUpdated);
+
             curves.removeAt(idx);
             replot();
 
@@ -1736,6 +1801,11 @@ void PlotWidget::removeAllSeries()
             untrackCurve();
         }
 
+        if (!curve.isNull() && !curve->getDataSeries().isNull())
+        {
+            disconnect(curve->getDataSeries().data(), &DataSeries::dataUpdated, this, &PlotWidget::onSeriesDataUpdated);
+        }
+
         curves.removeAt(0);
     }
 
@@ -1922,3 +1992,68 @@ PlotCurveUpdater* PlotWidget::generateNewWorker(DataSeriesPointer series)
 {
     return new PlotCurveUpdater(*series);
 }
+
+
+/**
+ * @brief PlotWidget::onSeriesDataUpdated - Callback when the data of an attached series changes
+ *
+ * Updates from multiple series are coalesced into a single redraw,
+ * and only the curves of the series which changed are resampled
+ */
+void PlotWidget::onSeriesDataUpdated()
+{
+    updatedSeries.insert(sender());
+
+    if (!liveUpdateTimer.isActive())
+    {
+        liveUpdateTimer.start();
+    }
+}
+
+
+/**
+ * @brief PlotWidget::onLiveDataUpdated - Redraw the plot after the underlying data have changed
+ *
+ * If following live data, the time axis is shifted (keeping the current span)
+ * so that the newest sample is at the right-hand edge of the plot.
+ * The view is only shifted if it was already displaying the newest data,
+ * so that the user can pan back through the history of a live stream.
+ */
+void PlotWidget::onLiveDataUpdated()
+{
+    bool ok = false;
+
+    double t_newest = getNewestTimestamp(&ok);
+
+    if (ok && isFollowingLiveData())
+    {
+        auto interval = axisInterval(QwtPlot::xBottom);
+
+        if (t_newest > interval.maxValue() && interval.maxValue() >= lastNewestTimestamp)
+        {
+            setAxisScale(QwtPlot::xBottom, t_newest - interval.width(), t_newest);
+            updateCurrentView();
+        }
+    }
+
+    if (ok)
+    {
+        lastNewestTimestamp = t_newest;
+    }
+
+    for (auto curve : curves)
+    {
+        if (!curve.isNull() && updatedSeries.contains(curve->getDataSeries().data()))
+        {
+            curve->invalidateSamples();
+        }
+    }
+
+    updatedSeries.clear();
+
+    // Curves which were not invalidated are only resampled if the view has moved
+    resampleCurves();
+    replot();
+
+    updateTimestampLimits();
+}
@@ -3,6 +3,8 @@
 
 #include <QMouseEvent>
 #include <QWheelEvent>
+#include <QSet>
+#include <QTimer>
 
 #include <qwt_plot.h>
 #include <qwt_plot_zoomer.h>
@@ -37,6 +39,9 @@ public:
     bool isTimescaleSynced(void) const { return syncedTimescale; }
     void setTimescaleSynced(bool sync) { syncedTimescale = sync; }
 
+    bool isFollowingLiveData(void) const { return followLiveData; }
+    void setFollowLiveData(bool follow) { followLiveData = follow; }
+
 signals:
     // Emitted whenever the view rect is changed
     void viewChanged(const QwtInterval &view);
@@ -44,7 +49,7 @@ signals:
     // Emitted whenever the timestamp limits are changed
     void timestampLimitsChanged(const QwtInterval &limits);
 
-    void fileDropped(QString filename);
+    void filesDropped(QStringList filenames);
 
     void cursorPositionChanged(double &t, double &y1, double &y2);
 
@@ -88,6 +93,7 @@ public slots:
     void saveImageToFile();
 
     void setTimeInterval(const QwtInterval &interval);
+    void setCursorTimestamp(double t);
     void legendClicked(const QwtPlotItem *item);
     void legendDoubleClicked(const QwtPlotItem *item);
 
@@ -95,10 +101,16 @@ protected slots:
 
     void editAxisScale(QwtPlot::Axis axisId);
 
+    void onSeriesDataUpdated(void);
+    void onLiveDataUpdated(void);
+
 protected:
 
     virtual bool eventFilter(QObject *target, QEvent *event) override;
 
+    // Canvas rendering (timed as the frame time)
+    virtual void drawCanvas(QPainter *painter) override;
+
     // Mouse actions
     virtual void wheelEvent(QWheelEvent *event) override;
     virtual void mouseMoveEvent(QMouseEvent *event) override;
@@ -165,6 +177,18 @@ protected:
 
     // Is this graph synced to the global timescale?
     bool syncedTimescale = true;
+
+    // Does the time axis track the newest data (for live streams)?
+    bool followLiveData = true;
+
+    // Newest timestamp at the previous live update
+    double lastNewestTimestamp = -__DBL_MAX__;
+
+    // Coalesces data update signals from multiple series into a single redraw
+    QTimer liveUpdateTimer;
+
+    // Series which have changed since the previous redraw
+    QSet<QObject*> updatedSeries;
 };
 
 #endif // PLOT_WIDGET_HPP
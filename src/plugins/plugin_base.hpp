@@ -24,6 +24,13 @@ public:
 
     // Return the IID string associated with this plugin
     virtual QString pluginIID(void) const = 0;
+
+    // When not interactive (e.g. headless batch mode), plugins must not display any dialogs
+    void setInteractive(bool interactive) { m_interactive = interactive; }
+    bool isInteractive(void) const { return m_interactive; }
+
+protected:
+    bool m_interactive = true;
 };
 
 typedef QList<QSharedPointer<PluginBase>> PluginList;
@@ -6,7 +6,7 @@
 #include "plugin_base.hpp"
 #include "data_series.hpp"
 
-#define ExporterInterface_iid "org.lumberjack.plugins.ExportPlugin/1.0"
+#define ExporterInterface_iid "org.lumberjack.plugins.ExportPlugin/2.0"
 
 /**
  * @brief The ExportPlugin class defines an interface for exporting data
@@ -17,6 +17,11 @@ class ExportPlugin : public PluginBase
 public:
     virtual ~ExportPlugin() = default;
 
+    // Create a new (independent) instance of this plugin, which is used for a single export job
+    // The new instance must copy the configuration (export options) of this instance.
+    // Return nullptr if the plugin does not support multiple instances.
+    virtual ExportPlugin *createInstance(void) const { return nullptr; }
+
     // Return a list of the support file types e.g. ['csv', 'tsv']
     virtual QStringList supportedFileTypes(void) const = 0;
 
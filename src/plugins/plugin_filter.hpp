@@ -2,15 +2,75 @@
 #define PLUGIN_FILTER_HPP
 
 #include <QtPlugin>
+#include <QVariantMap>
+
+#include <stddef.h>
+#include <algorithm>
 
 #include "plugin_base.hpp"
 
-#define FilterInterface_iid "org.lumberjack.plugins.FilterPlugin/1.0"
+#define FilterInterface_iid "org.lumberjack.plugins.FilterPlugin/2.0"
+
+
+/**
+ * @brief The FilterSpan struct describes a contiguous array of samples (one column)
+ */
+template <typename T>
+struct FilterSpan
+{
+    FilterSpan() = default;
+    FilterSpan(T *ptr, size_t n) : data(ptr), count(n) {}
+
+    T *data = nullptr;
+    size_t count = 0;
+
+    T &operator[](size_t idx) const { return data[idx]; }
+
+    T *begin(void) const { return data; }
+    T *end(void) const { return data + count; }
+
+    size_t size(void) const { return count; }
+    bool empty(void) const { return count == 0; }
+};
+
+
+/**
+ * @brief The FilterInput struct provides a block of (timestamp, value) samples to a filter
+ */
+struct FilterInput
+{
+    FilterSpan<const double> timestamps;
+    FilterSpan<const double> values;
+
+    size_t size(void) const { return timestamps.size(); }
+};
+
 
+/**
+ * @brief The FilterOutput struct receives the samples produced by a filter
+ *
+ * The output spans are always at least as large as the input spans.
+ */
+struct FilterOutput
+{
+    FilterSpan<double> timestamps;
+    FilterSpan<double> values;
+
+    size_t size(void) const { return timestamps.size(); }
+};
 
 
 /**
  * @brief The FilterPlugin class defines an interface for applying custom data filters
+ *
+ * A filter processes a whole block of samples per call (rather than a single sample),
+ * so that the per-sample work can be written as a tight (vectorizable) loop.
+ *
+ * - Output spans may alias the input spans (filters are applied in-place within a pipeline)
+ * - A filter may produce fewer samples than it is given (e.g. decimation),
+ *   but must never produce more, and must preserve timestamp order
+ * - Stateful filters (e.g. IIR filters) carry state from one block to the next,
+ *   until reset() is called
  */
 class FilterPlugin : public PluginBase
 {
@@ -24,8 +84,55 @@ public:
         return QString(FilterInterface_iid);
     }
 
+    // Create a new (independent) instance of this filter, with the same configuration
+    // Each pipeline uses its own instances, so that filter state is never shared
+    virtual FilterPlugin *createInstance(void) const = 0;
+
+    // A stateless filter produces exactly one output sample for each input sample,
+    // which depends only on the corresponding input sample.
+    // Stateless filters can be applied lazily to any range of a series.
+    virtual bool isStateless(void) const { return false; }
+
+    // A parallel-safe filter may process separate blocks of a series concurrently
+    // (using separate instances), and the results concatenated
+    virtual bool isParallelSafe(void) const { return isStateless(); }
+
+    // Clear any state carried between blocks
+    virtual void reset(void) {}
+
+    // Process a block of samples, and return the number of output samples
+    virtual size_t process(const FilterInput &input, FilterOutput &output) = 0;
+
+    // Filter options (name : value), which may be configured by the user
+    // Supported value types are double, int and bool
+    virtual QVariantMap getOptions(void) const { return QVariantMap(); }
 
-    // TODO
+    // Configure the filter, returns false if the options are invalid
+    // Any filter state is reset
+    virtual bool setOptions(const QVariantMap &options) { Q_UNUSED(options); return true; }
+
+protected:
+    // Estimate the sample rate (Hz) of a block of samples (timestamps are in milliseconds)
+    // Returns zero if the rate cannot be determined
+    static double estimateSampleRate(const FilterInput &input)
+    {
+        size_t n = input.size();
+
+        if (n < 2) return 0;
+
+        double dt = input.timestamps[n - 1] - input.timestamps[0];
+
+        return dt > 0 ? 1000.0 * (n - 1) / dt : 0;
+    }
+
+    // Copy timestamps through unchanged (unless the filter is operating in-place)
+    static void passTimestamps(const FilterInput &input, FilterOutput &output)
+    {
+        if (output.timestamps.data != input.timestamps.data)
+        {
+            std::copy(input.timestamps.begin(), input.timestamps.end(), output.timestamps.data);
+        }
+    }
 };
 
 typedef QList<QSharedPointer<FilterPlugin>> FilterPluginList;
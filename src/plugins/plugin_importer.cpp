@@ -80,3 +80,48 @@ bool ImportPlugin::validateFile(QString filename, QStringList &errors) const
 
     return errors.count() == 0;
 }
+
+
+/**
+ * @brief ImportPlugin::ingestBatch - Append pending batch chunks to the series for each column
+ *
+ * Series are created (with the column units and precision) when first required,
+ * and are published so that they can be displayed while the import is running.
+ * Each chunk is appended a column at a time, directly into series storage,
+ * and the chunk buffers are released once ingested.
+ */
+void ImportPlugin::ingestBatch()
+{
+    while (m_batchSeries.count() < m_batch.getColumnCount())
+    {
+        const DataBatchColumn &column = m_batch.getColumn(m_batchSeries.count());
+
+        DataSeriesPointer series = createDataSeries(column.label, column.getPrecision());
+
+        series->setUnits(column.units);
+
+        m_batchSeries.append(series);
+
+        publishSeries(series);
+    }
+
+    std::vector<DataBatchChunk> chunks = m_batch.takeChunks();
+
+    for (DataBatchChunk &chunk : chunks)
+    {
+        for (int col = 0; col < m_batchSeries.count(); col++)
+        {
+            m_batchSeries[col]->appendColumns(chunk.timestamps.data(), chunk.values[col].data(), chunk.size(), false);
+
+            // Release column memory as soon as it has been ingested
+            std::vector<double>().swap(chunk.values[col]);
+        }
+    }
+}
+
+
+void ImportPlugin::resetBatch()
+{
+    m_batch.clear();
+    m_batchSeries.clear();
+}
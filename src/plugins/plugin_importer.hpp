@@ -3,11 +3,18 @@
 
 #include <QtPlugin>
 
+#include <functional>
+
 #include "plugin_base.hpp"
 
 #include "data_series.hpp"
+#include "data_batch.hpp"
+#include "import_diagnostics.hpp"
+
+#define ImporterInterface_iid "org.lumberjack.plugins.ImportPlugin/2.0"
 
-#define ImporterInterface_iid "org.lumberjack.plugins.ImportPlugin/1.0"
+//! Function which constructs a new (empty) DataSeries with the given label and (preferred) value precision
+typedef std::function<DataSeriesPointer(QString label, DataSeries::ValuePrecision precision)> DataSeriesFactoryFunction;
 
 
 /**
@@ -19,6 +26,13 @@ class ImportPlugin : public PluginBase
 public:
     virtual ~ImportPlugin() = default;
 
+    // Create a new (independent) instance of this plugin, which is used for a single import job
+    // The new instance must copy the configuration (import options) of this instance,
+    // but none of the per-file import state.
+    // Return nullptr if the plugin does not support multiple instances,
+    // in which case imports using this plugin are run one at a time.
+    virtual ImportPlugin *createInstance(void) const { return nullptr; }
+
     // Return a list of support file types, e.g. ['csv', 'tsv']
     virtual QStringList supportedFileTypes(void) const = 0;
 
@@ -46,6 +60,18 @@ public:
     // After import, plugin must return a list of DataSeries objects
     virtual QList<DataSeriesPointer> getDataSeries(void) const = 0;
 
+    // Optional "follow" support, for files which are appended to while being viewed
+    virtual bool supportsFollow(void) const { return false; }
+
+    // Import any data appended to the file since the previous call to importData() or followData()
+    // New samples are appended to the existing DataSeries objects (without emitting update signals)
+    // Return False if the file can no longer be followed (e.g. it has been truncated)
+    virtual bool followData(QStringList &errors) { Q_UNUSED(errors); return false; }
+
+    // Preferred precision for imported values
+    // e.g. PRECISION_FLOAT for data which are known to originate from low-resolution sensors
+    virtual DataSeries::ValuePrecision getValuePrecision(void) const { return DataSeries::PRECISION_DOUBLE; }
+
     // Return the IID string
     virtual QString pluginIID(void) const override
     {
@@ -59,9 +85,77 @@ public:
     void setFilename(QString filename) { m_filename = filename; }
     QString getFilename(void) const { return m_filename; }
 
+    // Specify how new DataSeries objects are constructed (e.g. in-memory or disk-backed)
+    void setSeriesFactory(DataSeriesFactoryFunction factory) { m_seriesFactory = factory; }
+
+signals:
+    // Emitted (from the import thread) when a series is published before the import has completed
+    void seriesCreated(DataSeriesPointer series);
+
 protected:
+    // Construct a new DataSeries - plugins should use this rather than creating DataSeries directly
+    DataSeriesPointer createDataSeries(QString label) const
+    {
+        return createDataSeries(label, getValuePrecision());
+    }
+
+    DataSeriesPointer createDataSeries(QString label, DataSeries::ValuePrecision precision) const
+    {
+        if (m_seriesFactory)
+        {
+            return m_seriesFactory(label, precision);
+        }
+
+        return DataSeriesPointer(new DataSeries(label));
+    }
+
+    /*
+     * Progressive import (optional)
+     *
+     * Series may be published as soon as they are created, so that they can be displayed
+     * while the import is still running. Data should then be appended in chunks (with update=false),
+     * and the core emits throttled update signals for published series.
+     * All series must still be returned by getDataSeries() once the import has completed.
+     */
+    void publishSeries(DataSeriesPointer series) { emit seriesCreated(series); }
+
+    //! Interval at which buffered samples should be appended to published series (ms)
+    static const int PUBLISH_INTERVAL = 250;
+
+    /*
+     * Columnar batch interface (optional)
+     *
+     * Rather than constructing DataSeries objects directly, plugins may define the schema of m_batch,
+     * add chunks of decoded samples as they become available, and call ingestBatch() to move the
+     * pending chunks into series storage. One series is created for each column of the schema,
+     * and getBatchSeries() returns these series (e.g. for use in getDataSeries()).
+     */
+
+    // Append any pending batch chunks to the associated series
+    void ingestBatch(void);
+
+    // Clear the batch schema, pending chunks and series (e.g. at the start of an import)
+    void resetBatch(void);
+
+    QList<DataSeriesPointer> getBatchSeries(void) const { return m_batchSeries; }
+
+    DataBatch m_batch;
+
+    //! Series associated with each batch column
+    QList<DataSeriesPointer> m_batchSeries;
+
+    /*
+     * Diagnostics (optional)
+     *
+     * Issues found while decoding (e.g. malformed rows) should be recorded in m_diagnostics,
+     * rather than logged individually, and reported once via the errors list at the end of the import.
+     */
+    ImportDiagnostics m_diagnostics;
+
     // Stored filename, source of imported data
     QString m_filename;
+
+    DataSeriesFactoryFunction m_seriesFactory;
 };
 
 typedef QList<QSharedPointer<ImportPlugin>> ImportPluginList;
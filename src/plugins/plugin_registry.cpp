@@ -14,8 +14,14 @@
 // Imports for built-in plugin classes
 #include "plugins/csv_importer/lumberjack_csv_importer.hpp"
 #include "plugins/csv_exporter/lumberjack_csv_exporter.hpp"
+#include "plugins/synthetic_importer/synthetic_importer.hpp"
 #include "plugins/offset_filter/offset_filter.hpp"
 #include "plugins/scaler_filter/scaler_filter.hpp"
+#include "plugins/signal_filters/butterworth_filter.hpp"
+#include "plugins/signal_filters/decimate_filter.hpp"
+#include "plugins/signal_filters/fir_filter.hpp"
+#include "plugins/signal_filters/median_filter.hpp"
+#include "plugins/stream_reader/lumberjack_stream_reader.hpp"
 
 /**
  * @brief Check whether a plugin was built against a compatible Qt version and
@@ -94,6 +100,7 @@ void PluginRegistry::loadBuiltinPlugins()
 {
     // Builtin importer plugins
     m_ImportPlugins.append(QSharedPointer<ImportPlugin>(new LumberjackCSVImporter()));
+    m_ImportPlugins.append(QSharedPointer<ImportPlugin>(new SyntheticDataImporter()));
 
     // Builtin exporter plugins
     m_ExportPlugins.append(QSharedPointer<ExportPlugin>(new LumberjackCSVExporter()));
@@ -101,6 +108,13 @@ void PluginRegistry::loadBuiltinPlugins()
     // Builtin filter plugins
     m_FilterPlugins.append(QSharedPointer<FilterPlugin>(new OffsetFilter()));
     m_FilterPlugins.append(QSharedPointer<FilterPlugin>(new ScalerFilter()));
+    m_FilterPlugins.append(QSharedPointer<FilterPlugin>(new ButterworthFilter()));
+    m_FilterPlugins.append(QSharedPointer<FilterPlugin>(new FIRFilter()));
+    m_FilterPlugins.append(QSharedPointer<FilterPlugin>(new MedianFilter()));
+    m_FilterPlugins.append(QSharedPointer<FilterPlugin>(new DecimateFilter()));
+
+    // Builtin stream plugins
+    m_StreamPlugins.append(QSharedPointer<StreamPlugin>(new LumberjackStreamReader()));
 }
 
 
@@ -115,7 +129,7 @@ void PluginRegistry::loadPlugins()
 
     QList<QString> checkedPaths;
 
-    for (QString libPath : QApplication::libraryPaths())
+    for (QString libPath : QCoreApplication::libraryPaths())
     {
         if (checkedPaths.contains(libPath)) continue;
 
@@ -149,6 +163,7 @@ void PluginRegistry::loadPlugins()
             if      (loadImportPlugin(instance)) {}
             else if (loadExportPlugin(instance)) {}
             else if (loadFilterPlugin(instance)) {}
+            else if (loadStreamPlugin(instance)) {}
             else
             {
                 // Loaded successfully, but doesn't implement a known interface.
@@ -167,6 +182,7 @@ void PluginRegistry::clearRegistry()
     m_ImportPlugins.clear();
     m_ExportPlugins.clear();
     m_FilterPlugins.clear();
+    m_StreamPlugins.clear();
 }
 
 
@@ -217,11 +233,37 @@ bool PluginRegistry::loadFilterPlugin(QObject *instance)
 }
 
 
+bool PluginRegistry::loadStreamPlugin(QObject *instance)
+{
+    StreamPlugin *plugin = qobject_cast<StreamPlugin*>(instance);
+
+    if (plugin)
+    {
+        m_StreamPlugins.append(QSharedPointer<StreamPlugin>(plugin));
+        return true;
+    }
+
+    return false;
+}
+
+
 /**
  * @brief PluginRegistry::getFilenameForImport - Select a file for importing
  * @return
  */
 QString PluginRegistry::getFilenameForImport(void) const
+{
+    QStringList files = getFilenamesForImport();
+
+    return files.isEmpty() ? QString() : files.first();
+}
+
+
+/**
+ * @brief PluginRegistry::getFilenamesForImport - Select one or more files for importing
+ * @return
+ */
+QStringList PluginRegistry::getFilenamesForImport(void) const
 {
     auto settings = LumberjackSettings::getInstance();
 
@@ -247,7 +289,7 @@ QString PluginRegistry::getFilenameForImport(void) const
         dialog.setDirectory(lastDir);
     }
 
-    dialog.setFileMode(QFileDialog::ExistingFile);
+    dialog.setFileMode(QFileDialog::ExistingFiles);
     dialog.setNameFilters(filePatterns);
     dialog.setViewMode(QFileDialog::Detail);
 
@@ -257,21 +299,18 @@ QString PluginRegistry::getFilenameForImport(void) const
     if (result != QDialog::Accepted)
     {
         // User cancelled the import process
-        return QString();
+        return QStringList();
     }
 
     // Determine which plugin loaded the data
     QString filter = dialog.selectedNameFilter();
-    QStringList files = dialog.selectedFiles();
-
-    QString filename;
 
-    if (!filter.isEmpty() && files.length() >= 1)
+    if (filter.isEmpty())
     {
-        filename = files.first();
+        return QStringList();
     }
 
-    return filename;
+    return dialog.selectedFiles();
 }
 
 
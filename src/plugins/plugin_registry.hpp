@@ -4,6 +4,7 @@
 #include "plugin_filter.hpp"
 #include "plugin_importer.hpp"
 #include "plugin_exporter.hpp"
+#include "plugin_stream.hpp"
 
 /**
  * @brief The PluginRegistry class manages loading of custom plugins
@@ -44,8 +45,10 @@ public:
     const ImportPluginList& ImportPlugins(void) { return m_ImportPlugins; }
     const ExportPluginList& ExportPlugins(void) { return m_ExportPlugins; }
     const FilterPluginList& FilterPlugins(void) { return m_FilterPlugins; }
+    const StreamPluginList& StreamPlugins(void) { return m_StreamPlugins; }
 
     QString getFilenameForImport(void) const;
+    QStringList getFilenamesForImport(void) const;
     QString getFilenameForExport(void) const;
 
 protected:
@@ -53,11 +56,13 @@ protected:
     bool loadImportPlugin(QObject *instance);
     bool loadExportPlugin(QObject *instance);
     bool loadFilterPlugin(QObject *instance);
+    bool loadStreamPlugin(QObject *instance);
 
     // Registry of each plugin "type"
     ImportPluginList m_ImportPlugins;
     ExportPluginList m_ExportPlugins;
     FilterPluginList m_FilterPlugins;
+    StreamPluginList m_StreamPlugins;
 
 };
 
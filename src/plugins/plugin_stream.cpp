@@ -0,0 +1,135 @@
+#include <QFile>
+#include <QFileInfo>
+#include <QLocalSocket>
+#include <QCoreApplication>
+
+#include <stdio.h>
+
+#include "plugin_stream.hpp"
+
+
+/**
+ * @brief StreamPlugin::openDevice - Open the transport device for the stream address
+ *
+ * Supported address formats:
+ * - "stdin" or "-" reads from standard input
+ * - "unix:<path>" connects to a local (UNIX domain) socket, or a Windows named pipe
+ * - Any other value is treated as the path to a named pipe (FIFO)
+ *
+ * The device is opened in unbuffered mode, and is owned by the caller.
+ *
+ * @param errors
+ * @return the opened device, or nullptr on error
+ */
+QIODevice* StreamPlugin::openDevice(QStringList &errors) const
+{
+    QString address = m_address.trimmed();
+
+    if (address.isEmpty())
+    {
+        errors.append(tr("No stream address specified"));
+        return nullptr;
+    }
+
+    if (address == "stdin" || address == "-")
+    {
+        QFile *file = new QFile();
+
+        if (!file->open(stdin, QIODevice::ReadOnly | QIODevice::Unbuffered))
+        {
+            errors.append(tr("Could not open stdin for reading"));
+            delete file;
+            return nullptr;
+        }
+
+        return file;
+    }
+
+    if (address.startsWith("unix:"))
+    {
+        QLocalSocket *socket = new QLocalSocket();
+
+        socket->connectToServer(address.mid(5), QIODevice::ReadOnly | QIODevice::Unbuffered);
+
+        if (!socket->waitForConnected(5000))
+        {
+            errors.append(tr("Could not connect to socket") + ": " + socket->errorString());
+            delete socket;
+            return nullptr;
+        }
+
+        return socket;
+    }
+
+    QFileInfo fi(address);
+
+    if (!fi.exists())
+    {
+        errors.append(tr("Stream does not exist") + ": " + address);
+        return nullptr;
+    }
+
+    QFile *file = new QFile(address);
+
+    if (!file->open(QIODevice::ReadOnly | QIODevice::Unbuffered))
+    {
+        errors.append(tr("Could not open stream for reading") + ": " + address);
+        delete file;
+        return nullptr;
+    }
+
+    return file;
+}
+
+
+QList<DataSeriesPointer> StreamPlugin::getDataSeries(void) const
+{
+    QMutexLocker lock(&m_seriesMutex);
+
+    return m_series.values();
+}
+
+
+void StreamPlugin::clearDataSeries(void)
+{
+    QMutexLocker lock(&m_seriesMutex);
+
+    m_series.clear();
+}
+
+
+/**
+ * @brief StreamPlugin::getOrCreateSeries - Return the series with the given label, creating it if required
+ *
+ * Plugins should cache the returned pointer (e.g. against a channel ID),
+ * rather than calling this function for every decoded sample.
+ *
+ * @param label
+ * @return
+ */
+RingBufferDataSeries* StreamPlugin::getOrCreateSeries(QString label)
+{
+    DataSeriesPointer series;
+
+    {
+        QMutexLocker lock(&m_seriesMutex);
+
+        series = m_series.value(label);
+
+        if (!series.isNull())
+        {
+            return static_cast<RingBufferDataSeries*>(series.data());
+        }
+
+        series = DataSeriesPointer(new RingBufferDataSeries(label, m_capacity));
+
+        // Series are owned by the GUI thread, not the (transient) streaming thread
+        series->moveToThread(QCoreApplication::instance()->thread());
+
+        m_series.insert(label, series);
+    }
+
+    emit seriesCreated(series);
+
+    return static_cast<RingBufferDataSeries*>(series.data());
+}
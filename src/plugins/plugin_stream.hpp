@@ -0,0 +1,89 @@
+#ifndef PLUGIN_STREAM_HPP
+#define PLUGIN_STREAM_HPP
+
+#include <QtPlugin>
+#include <QIODevice>
+#include <QMutex>
+#include <QHash>
+
+#include "plugin_base.hpp"
+
+#include "ring_buffer_data_series.hpp"
+
+#define StreamInterface_iid "org.lumberjack.plugins.StreamPlugin/2.0"
+
+
+/**
+ * @brief The StreamPlugin class defines an interface for reading live (streamed) data
+ *
+ * The transport (UNIX domain socket, named pipe or stdin) is opened by the plugin base class,
+ * and raw bytes are passed to the plugin to be decoded into samples.
+ *
+ * Decoded samples are appended to bounded RingBufferDataSeries objects,
+ * which are created on demand via getOrCreateSeries().
+ */
+class StreamPlugin : public PluginBase
+{
+    Q_OBJECT
+public:
+    virtual ~StreamPlugin() = default;
+
+    // Optional function called before the stream is opened
+    // Return False to cancel the streaming process
+    virtual bool beforeStream(void) { return true; }
+
+    // Decode as many complete frames as possible from the start of the buffer
+    // Returns the number of bytes which were consumed
+    virtual qint64 decodeFrames(const QByteArray &buffer, QStringList &errors) = 0;
+
+    // Optional function called when a stream is (re)opened
+    virtual void resetStream(void) {}
+
+    // Optional function called after the stream is closed
+    virtual void afterStream(void) {}
+
+    // Return the IID string
+    virtual QString pluginIID(void) const override
+    {
+        return QString(StreamInterface_iid);
+    }
+
+    // Open the transport device described by the stream address
+    QIODevice* openDevice(QStringList &errors) const;
+
+    void setAddress(QString address) { m_address = address; }
+    QString getAddress(void) const { return m_address; }
+
+    void setBufferCapacity(size_t capacity) { m_capacity = capacity; }
+    size_t getBufferCapacity(void) const { return m_capacity; }
+
+    // Return a list of all series created by this stream
+    QList<DataSeriesPointer> getDataSeries(void) const;
+
+    // Discard all series created by this stream
+    void clearDataSeries(void);
+
+signals:
+    // Emitted (from the streaming thread) when a new series is created
+    void seriesCreated(DataSeriesPointer series);
+
+protected:
+    RingBufferDataSeries* getOrCreateSeries(QString label);
+
+    // Stream address, e.g. "unix:/tmp/telemetry.sock", "/tmp/telemetry.fifo" or "stdin"
+    QString m_address;
+
+    // Number of samples retained for each series
+    size_t m_capacity = RingBufferDataSeries::DEFAULT_CAPACITY;
+
+    // Series created by this stream, keyed by label
+    QHash<QString, DataSeriesPointer> m_series;
+
+    mutable QMutex m_seriesMutex;
+};
+
+typedef QList<QSharedPointer<StreamPlugin>> StreamPluginList;
+
+Q_DECLARE_INTERFACE(StreamPlugin, StreamInterface_iid)
+
+#endif // PLUGIN_STREAM_HPP
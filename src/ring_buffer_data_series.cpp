@@ -0,0 +1,337 @@
+#include <math.h>
+#include <algorithm>
+#include <stdexcept>
+
+#include "ring_buffer_data_series.hpp"
+
+
+const size_t RingBufferDataSeries::DEFAULT_CAPACITY = 100000;
+
+
+RingBufferDataSeries::RingBufferDataSeries(QString lbl, size_t c) : DataSeries(lbl)
+{
+    setCapacity(c, false);
+}
+
+
+RingBufferDataSeries::RingBufferDataSeries(QString grp, QString lbl, size_t c) : DataSeries(grp, lbl)
+{
+    setCapacity(c, false);
+}
+
+
+RingBufferDataSeries::~RingBufferDataSeries()
+{
+}
+
+
+/*
+ * Set the capacity of the ring buffer.
+ * Any existing data are discarded, and the buffer is allocated in full.
+ */
+void RingBufferDataSeries::setCapacity(size_t c, bool do_update)
+{
+    if (c == 0) c = 1;
+
+    lockData();
+
+    capacity = c;
+
+    buffer.clear();
+    buffer.shrink_to_fit();
+    buffer.resize(capacity);
+
+    head = 0;
+    count = 0;
+
+    data_mutex.unlock();
+
+    if (do_update)
+    {
+        update();
+    }
+}
+
+
+/*
+ * Append a new sample to the buffer (data_mutex must be held).
+ *
+ * If the buffer is full, the oldest sample is overwritten.
+ * Samples older than the newest sample are discarded.
+ */
+void RingBufferDataSeries::pushSample(const DataPoint &point)
+{
+    // Ignore NaN and inf values
+    if (isnan(point.value) || isinf(point.value)) return;
+
+    if (count > 0 && point.timestamp < buffer[bufferIndex(count - 1)].timestamp)
+    {
+        discardedCount++;
+        return;
+    }
+
+    if (count < capacity)
+    {
+        buffer[bufferIndex(count)] = point;
+        count++;
+    }
+    else
+    {
+        // Overwrite the oldest sample
+        buffer[head] = point;
+        head = (head + 1) % capacity;
+        evictedCount++;
+    }
+}
+
+
+void RingBufferDataSeries::addData(DataPoint point, bool do_update)
+{
+    lockData();
+
+    pushSample(point);
+
+    data_mutex.unlock();
+
+    if (do_update)
+    {
+        update();
+    }
+    else
+    {
+        pendingUpdate = true;
+    }
+}
+
+
+void RingBufferDataSeries::appendData(const std::vector<DataPoint> &points, bool do_update)
+{
+    if (points.empty()) return;
+
+    lockData();
+
+    for (const DataPoint &point : points)
+    {
+        pushSample(point);
+    }
+
+    data_mutex.unlock();
+
+    if (do_update)
+    {
+        update();
+    }
+    else
+    {
+        pendingUpdate = true;
+    }
+}
+
+
+/*
+ * Append a block of samples (e.g. all samples decoded from one read) while holding the lock once
+ */
+void RingBufferDataSeries::appendColumns(const double *timestamps, const double *values, uint64_t n, bool do_update)
+{
+    if (n == 0) return;
+
+    lockData();
+
+    for (uint64_t ii = 0; ii < n; ii++)
+    {
+        pushSample(DataPoint(timestamps[ii], values[ii]));
+    }
+
+    data_mutex.unlock();
+
+    if (do_update)
+    {
+        update();
+    }
+    else
+    {
+        pendingUpdate = true;
+    }
+}
+
+
+/*
+ * Discard any samples outside the specified time range
+ */
+void RingBufferDataSeries::clipTimeRange(double t_min, double t_max, bool do_update)
+{
+    if (t_min > t_max)
+    {
+        double swap = t_min;
+
+        t_min = t_max;
+        t_max = swap;
+    }
+
+    lockData();
+
+    // Evict old samples from the front of the buffer
+    while (count > 0 && buffer[head].timestamp < t_min)
+    {
+        head = (head + 1) % capacity;
+        count--;
+    }
+
+    // Trim new samples from the back of the buffer
+    while (count > 0 && buffer[bufferIndex(count - 1)].timestamp > t_max)
+    {
+        count--;
+    }
+
+    data_mutex.unlock();
+
+    if (do_update)
+    {
+        update();
+    }
+}
+
+
+void RingBufferDataSeries::clearData(bool do_update)
+{
+    lockData();
+
+    head = 0;
+    count = 0;
+
+    data_mutex.unlock();
+
+    if (do_update)
+    {
+        update();
+    }
+}
+
+
+void RingBufferDataSeries::truncateData(uint64_t n, bool do_update)
+{
+    lockData();
+
+    count = std::min<uint64_t>(count, n);
+
+    data_mutex.unlock();
+
+    if (do_update)
+    {
+        update();
+    }
+}
+
+
+uint64_t RingBufferDataSeries::getMemoryUsage() const
+{
+    DataLocker lock(this);
+
+    return buffer.capacity() * sizeof(DataPoint);
+}
+
+
+size_t RingBufferDataSeries::size() const
+{
+    DataLocker lock(this);
+
+    return count;
+}
+
+
+/*
+ * Return a linear copy of the buffered data (oldest first)
+ */
+std::vector<DataPoint> RingBufferDataSeries::getData() const
+{
+    DataLocker lock(this);
+
+    std::vector<DataPoint> linear;
+
+    linear.reserve(count);
+
+    for (size_t idx = 0; idx < count; idx++)
+    {
+        linear.push_back(buffer[bufferIndex(idx)]);
+    }
+
+    return linear;
+}
+
+
+DataPoint RingBufferDataSeries::getRawDataPoint(uint64_t idx) const
+{
+    DataLocker lock(this);
+
+    // The buffer may have been clipped since the caller checked the index
+    if (idx >= count)
+    {
+        throw std::out_of_range("data index out of range");
+    }
+
+    return buffer[bufferIndex(idx)];
+}
+
+
+uint64_t RingBufferDataSeries::getRawDataPoints(uint64_t idx, uint64_t n, DataPoint *points) const
+{
+    DataLocker lock(this);
+
+    if (idx >= count) return 0;
+
+    n = std::min<uint64_t>(n, count - idx);
+
+    // Copy in (at most) two contiguous sections
+    size_t start = bufferIndex(idx);
+    size_t first = std::min<uint64_t>(n, capacity - start);
+
+    std::copy(buffer.begin() + start, buffer.begin() + start + first, points);
+    std::copy(buffer.begin(), buffer.begin() + (n - first), points + first);
+
+    return n;
+}
+
+
+/*
+ * Binary search across the (logically ordered) ring buffer
+ */
+uint64_t RingBufferDataSeries::getIndexForTimestamp(double t, SearchDirection direction) const
+{
+    DataLocker lock(this);
+
+    if (count == 0) return 0;
+
+    if (t < buffer[head].timestamp)
+    {
+        return 0;
+    }
+    else if (t > buffer[bufferIndex(count - 1)].timestamp)
+    {
+        return count;
+    }
+
+    uint64_t lower = 0;
+    uint64_t upper = count;
+
+    while (lower < upper)
+    {
+        uint64_t mid = lower + (upper - lower) / 2;
+
+        double ts = buffer[bufferIndex(mid)].timestamp;
+
+        // SEARCH_LEFT_TO_RIGHT finds the first sample *after* t (upper bound)
+        // SEARCH_RIGHT_TO_LEFT finds the first sample *at or after* t (lower bound)
+        bool before = (direction == SEARCH_LEFT_TO_RIGHT) ? (ts <= t) : (ts < t);
+
+        if (before)
+        {
+            lower = mid + 1;
+        }
+        else
+        {
+            upper = mid;
+        }
+    }
+
+    return lower;
+}
@@ -0,0 +1,83 @@
+#ifndef RING_BUFFER_DATA_SERIES_HPP
+#define RING_BUFFER_DATA_SERIES_HPP
+
+#include "data_series.hpp"
+
+
+/**
+ * @brief The RingBufferDataSeries class is a bounded DataSeries for live data
+ *
+ * Samples are stored in a fixed-size circular buffer, allocated once.
+ * Appending a sample is O(1), and once the buffer is full the oldest
+ * sample is evicted (also O(1)), so memory use remains constant
+ * regardless of how long the stream runs.
+ *
+ * Samples which arrive with a timestamp older than the newest sample
+ * are discarded (and counted), rather than being inserted.
+ */
+class RingBufferDataSeries : public DataSeries
+{
+    Q_OBJECT
+
+public:
+    RingBufferDataSeries(QString label, size_t capacity = DEFAULT_CAPACITY);
+    RingBufferDataSeries(QString group, QString label, size_t capacity = DEFAULT_CAPACITY);
+
+    virtual ~RingBufferDataSeries();
+
+    static const size_t DEFAULT_CAPACITY;
+
+    size_t getCapacity(void) const { return capacity; }
+    void setCapacity(size_t c, bool update=true);
+
+    //! Number of samples which have been pushed out of the buffer
+    uint64_t getEvictedCount(void) const { return evictedCount; }
+
+    //! Number of out-of-order samples which have been discarded
+    uint64_t getDiscardedCount(void) const { return discardedCount; }
+
+    virtual uint64_t getMemoryUsage(void) const override;
+
+    using DataSeries::addData;
+    virtual void addData(DataPoint point, bool update=true) override;
+    virtual void appendData(const std::vector<DataPoint> &points, bool update=true) override;
+
+    virtual void appendColumns(const double *timestamps, const double *values, uint64_t count, bool update=true) override;
+
+    virtual void clipTimeRange(double t_min, double t_max, bool update=true) override;
+
+    virtual void clearData(bool update=true) override;
+    virtual void truncateData(uint64_t count, bool update=true) override;
+
+    virtual size_t size() const override;
+
+    virtual std::vector<DataPoint> getData() const override;
+
+    virtual uint64_t getIndexForTimestamp(double t, SearchDirection direction=SEARCH_LEFT_TO_RIGHT) const override;
+
+protected:
+    void pushSample(const DataPoint &point);
+
+    virtual DataPoint getRawDataPoint(uint64_t idx) const override;
+    virtual uint64_t getRawDataPoints(uint64_t idx, uint64_t count, DataPoint *points) const override;
+
+    //! Map a logical index (0 = oldest) to a position in the buffer
+    size_t bufferIndex(uint64_t idx) const { return (head + idx) % capacity; }
+
+    //! Sample buffer (allocated once, when the capacity is set)
+    std::vector<DataPoint> buffer;
+
+    //! Fixed capacity of the buffer
+    size_t capacity = 0;
+
+    //! Buffer position of the oldest sample
+    size_t head = 0;
+
+    //! Number of valid samples in the buffer
+    size_t count = 0;
+
+    uint64_t evictedCount = 0;
+    uint64_t discardedCount = 0;
+};
+
+#endif // RING_BUFFER_DATA_SERIES_HPP
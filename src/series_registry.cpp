@@ -0,0 +1,445 @@
+#include <algorithm>
+
+#include "series_registry.hpp"
+
+
+const SeriesId SeriesRegistry::INVALID_ID;
+constexpr double SeriesRegistry::SIMILARITY_THRESHOLD;
+
+
+void SeriesRegistry::registerSource(DataSourcePointer source)
+{
+    if (source.isNull() || m_sourceList.contains(source)) return;
+
+    m_sourceList.append(source);
+
+    if (!m_sources.contains(source->getLabel()))
+    {
+        m_sources.insert(source->getLabel(), source);
+    }
+
+    for (auto series : source->getSeries())
+    {
+        registerSeries(source.data(), series);
+    }
+}
+
+
+void SeriesRegistry::unregisterSource(DataSourcePointer source)
+{
+    if (source.isNull() || !m_sourceList.removeOne(source)) return;
+
+    QString label = source->getLabel();
+
+    // Another source with the same label may now be found by label
+    if (m_sources.value(label) == source)
+    {
+        m_sources.remove(label);
+
+        for (auto src : m_sourceList)
+        {
+            if (src->getLabel() == label)
+            {
+                m_sources.insert(label, src);
+                break;
+            }
+        }
+    }
+
+    QVector<SeriesId> ids;
+
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it)
+    {
+        if (it->source == source.data()) ids.append(it.key());
+    }
+
+    for (SeriesId id : ids)
+    {
+        removeEntry(id);
+    }
+}
+
+
+/**
+ * @brief SeriesRegistry::registerSeries - Add a series to the registry
+ * @param source - The source which contains the series
+ * @param series
+ * @return the ID of the series
+ */
+SeriesId SeriesRegistry::registerSeries(const DataSource *source, DataSeriesPointer series)
+{
+    if (!source || series.isNull()) return INVALID_ID;
+
+    SeriesId existing = getId(series.data());
+
+    if (existing != INVALID_ID) return existing;
+
+    Entry entry;
+
+    entry.id = m_nextId++;
+    entry.series = series;
+    entry.source = source;
+    entry.identifier = makeIdentifier(source->getLabel(), series->getLabel());
+    entry.key = series->getLabel().toLower();
+
+    m_entries.insert(entry.id, entry);
+    m_ids.insert(series.data(), entry.id);
+    m_identifiers.insert(entry.identifier, entry.id);
+
+    indexEntry(entry);
+
+    return entry.id;
+}
+
+
+bool SeriesRegistry::unregisterSeries(const DataSeries *series)
+{
+    SeriesId id = getId(series);
+
+    if (id == INVALID_ID) return false;
+
+    removeEntry(id);
+
+    return true;
+}
+
+
+void SeriesRegistry::updateSeries(const DataSeries *series)
+{
+    SeriesId id = getId(series);
+
+    if (id == INVALID_ID) return;
+
+    Entry &entry = m_entries[id];
+
+    QString identifier = makeIdentifier(entry.source->getLabel(), series->getLabel());
+
+    if (identifier == entry.identifier) return;
+
+    m_identifiers.remove(entry.identifier, id);
+
+    // Trigrams for the previous label are now stale
+    int count = getTrigrams(entry.key).count();
+
+    m_livePostings -= count;
+    m_stalePostings += count;
+
+    entry.identifier = identifier;
+    entry.key = series->getLabel().toLower();
+
+    m_identifiers.insert(entry.identifier, id);
+
+    indexEntry(entry);
+
+    if (m_stalePostings > m_livePostings)
+    {
+        rebuildTrigrams();
+    }
+}
+
+
+void SeriesRegistry::clear()
+{
+    m_entries.clear();
+    m_ids.clear();
+    m_identifiers.clear();
+    m_sources.clear();
+    m_sourceList.clear();
+    m_trigrams.clear();
+    m_prefixIndex.clear();
+
+    m_livePostings = 0;
+    m_stalePostings = 0;
+    m_prefixIndexValid = false;
+}
+
+
+DataSeriesPointer SeriesRegistry::getSeries(SeriesId id) const
+{
+    auto it = m_entries.constFind(id);
+
+    return it == m_entries.constEnd() ? DataSeriesPointer() : it->series;
+}
+
+
+const DataSource *SeriesRegistry::getSource(SeriesId id) const
+{
+    auto it = m_entries.constFind(id);
+
+    return it == m_entries.constEnd() ? nullptr : it->source;
+}
+
+
+DataSeriesPointer SeriesRegistry::findSeries(QString source_label, QString series_label) const
+{
+    return findSeries(makeIdentifier(source_label, series_label));
+}
+
+
+/**
+ * @brief SeriesRegistry::findSeries - Find a series by "source:label" identifier
+ *
+ * If multiple series share the same identifier, the first one registered is returned.
+ */
+DataSeriesPointer SeriesRegistry::findSeries(QString identifier) const
+{
+    SeriesId id = INVALID_ID;
+
+    for (auto it = m_identifiers.constFind(identifier); it != m_identifiers.constEnd() && it.key() == identifier; ++it)
+    {
+        if (id == INVALID_ID || it.value() < id) id = it.value();
+    }
+
+    return getSeries(id);
+}
+
+
+/**
+ * @brief SeriesRegistry::search - Find series with labels which contain all of the provided terms
+ *
+ * Candidates are taken from the smallest trigram posting list of any term (of at least three characters),
+ * and are then checked against every term. Shorter terms require a scan of all series.
+ *
+ * @return matching series IDs (in order of registration)
+ */
+QVector<SeriesId> SeriesRegistry::search(QString text) const
+{
+    QStringList terms = text.toLower().split(" ", Qt::SkipEmptyParts);
+
+    const QVector<SeriesId> *candidates = nullptr;
+
+    for (const QString &term : terms)
+    {
+        for (quint64 trigram : getTrigrams(term))
+        {
+            const QVector<SeriesId> *postings = getPostings(trigram);
+
+            // No series contains this trigram
+            if (!postings) return QVector<SeriesId>();
+
+            if (!candidates || postings->count() < candidates->count())
+            {
+                candidates = postings;
+            }
+        }
+    }
+
+    QVector<SeriesId> results;
+
+    auto matches = [&terms](const Entry &entry)
+    {
+        for (const QString &term : terms)
+        {
+            if (!entry.key.contains(term)) return false;
+        }
+
+        return true;
+    };
+
+    if (candidates)
+    {
+        for (SeriesId id : *candidates)
+        {
+            auto it = m_entries.constFind(id);
+
+            // Ignore stale entries
+            if (it != m_entries.constEnd() && matches(*it)) results.append(id);
+        }
+    }
+    else
+    {
+        for (const Entry &entry : m_entries)
+        {
+            if (matches(entry)) results.append(entry.id);
+        }
+    }
+
+    std::sort(results.begin(), results.end());
+    results.erase(std::unique(results.begin(), results.end()), results.end());
+
+    return results;
+}
+
+
+QVector<SeriesId> SeriesRegistry::searchPrefix(QString text) const
+{
+    QString prefix = text.toLower();
+
+    if (!m_prefixIndexValid)
+    {
+        m_prefixIndex.clear();
+        m_prefixIndex.reserve(m_entries.count());
+
+        for (const Entry &entry : m_entries)
+        {
+            m_prefixIndex.append(qMakePair(entry.key, entry.id));
+        }
+
+        std::sort(m_prefixIndex.begin(), m_prefixIndex.end());
+
+        m_prefixIndexValid = true;
+    }
+
+    QVector<SeriesId> results;
+
+    auto it = std::lower_bound(m_prefixIndex.constBegin(), m_prefixIndex.constEnd(), qMakePair(prefix, INVALID_ID));
+
+    for (; it != m_prefixIndex.constEnd() && it->first.startsWith(prefix); ++it)
+    {
+        results.append(it->second);
+    }
+
+    std::sort(results.begin(), results.end());
+
+    return results;
+}
+
+
+/**
+ * @brief SeriesRegistry::searchSimilar - Find series with labels similar to the provided text
+ *
+ * Similarity is the proportion of trigrams shared between the text and the label.
+ * Only series which share at least one trigram with the text are considered.
+ *
+ * @param text - Search text (at least three characters, otherwise a prefix search is performed)
+ * @param limit - Maximum number of results
+ * @return matching series IDs, most similar first
+ */
+QVector<SeriesId> SeriesRegistry::searchSimilar(QString text, int limit) const
+{
+    QVector<quint64> trigrams = getTrigrams(text.toLower());
+
+    if (trigrams.isEmpty())
+    {
+        QVector<SeriesId> results = searchPrefix(text);
+
+        if (results.count() > limit) results.resize(limit);
+
+        return results;
+    }
+
+    QHash<SeriesId, int> counts;
+
+    for (quint64 trigram : trigrams)
+    {
+        const QVector<SeriesId> *postings = getPostings(trigram);
+
+        if (!postings) continue;
+
+        for (SeriesId id : *postings)
+        {
+            counts[id]++;
+        }
+    }
+
+    QVector<QPair<double, SeriesId>> scores;
+
+    for (auto it = counts.constBegin(); it != counts.constEnd(); ++it)
+    {
+        auto entry = m_entries.constFind(it.key());
+
+        if (entry == m_entries.constEnd()) continue;
+
+        int labelCount = getTrigrams(entry->key).count();
+
+        // Stale postings may inflate the count
+        int shared = qMin(it.value(), qMin(labelCount, trigrams.count()));
+
+        double score = (double) shared / (double) (trigrams.count() + labelCount - shared);
+
+        if (score >= SIMILARITY_THRESHOLD)
+        {
+            scores.append(qMakePair(-score, it.key()));
+        }
+    }
+
+    std::sort(scores.begin(), scores.end());
+
+    QVector<SeriesId> results;
+
+    for (int ii = 0; ii < scores.count() && ii < limit; ii++)
+    {
+        results.append(scores.at(ii).second);
+    }
+
+    return results;
+}
+
+
+void SeriesRegistry::indexEntry(const Entry &entry)
+{
+    for (quint64 trigram : getTrigrams(entry.key))
+    {
+        m_trigrams[trigram].append(entry.id);
+        m_livePostings++;
+    }
+
+    m_prefixIndexValid = false;
+}
+
+
+void SeriesRegistry::removeEntry(SeriesId id)
+{
+    auto it = m_entries.find(id);
+
+    if (it == m_entries.end()) return;
+
+    int count = getTrigrams(it->key).count();
+
+    m_ids.remove(it->series.data());
+    m_identifiers.remove(it->identifier, id);
+    m_entries.erase(it);
+
+    // Postings are removed lazily
+    m_livePostings -= count;
+    m_stalePostings += count;
+
+    m_prefixIndexValid = false;
+
+    if (m_stalePostings > m_livePostings)
+    {
+        rebuildTrigrams();
+    }
+}
+
+
+void SeriesRegistry::rebuildTrigrams()
+{
+    m_trigrams.clear();
+
+    m_livePostings = 0;
+    m_stalePostings = 0;
+
+    for (const Entry &entry : m_entries)
+    {
+        indexEntry(entry);
+    }
+}
+
+
+/*
+ * Return the (unique) trigrams of the provided text, each packed into a 64-bit key
+ */
+QVector<quint64> SeriesRegistry::getTrigrams(const QString &text)
+{
+    QVector<quint64> trigrams;
+
+    for (int ii = 0; ii + 2 < text.length(); ii++)
+    {
+        quint64 trigram = ((quint64) text.at(ii).unicode() << 32) |
+                          ((quint64) text.at(ii + 1).unicode() << 16) |
+                          ((quint64) text.at(ii + 2).unicode());
+
+        if (!trigrams.contains(trigram)) trigrams.append(trigram);
+    }
+
+    return trigrams;
+}
+
+
+const QVector<SeriesId> *SeriesRegistry::getPostings(quint64 trigram) const
+{
+    auto it = m_trigrams.constFind(trigram);
+
+    return it == m_trigrams.constEnd() ? nullptr : &it.value();
+}
@@ -0,0 +1,113 @@
+#ifndef SERIES_REGISTRY_HPP
+#define SERIES_REGISTRY_HPP
+
+#include <QHash>
+#include <QVector>
+#include <QString>
+#include <QStringList>
+
+#include "data_source.hpp"
+
+
+//! Numeric identifier for a registered series (zero is invalid)
+typedef uint64_t SeriesId;
+
+
+/**
+ * @brief The SeriesRegistry class provides fast lookup of series across all data sources
+ *
+ * - Each registered series is assigned a stable numeric ID (IDs are never re-used)
+ * - Series can be found by "source:label" identifier with a single hash lookup
+ * - A trigram index of (lowercase) series labels supports substring and "fuzzy" search,
+ *   where the cost depends on the number of candidate series rather than the total
+ *
+ * Removed series are deleted from the trigram index lazily, and the index is rebuilt
+ * once the number of stale entries exceeds the number of live entries.
+ */
+class SeriesRegistry
+{
+public:
+    static const SeriesId INVALID_ID = 0;
+
+    //! Registration information for a single series
+    struct Entry
+    {
+        SeriesId id = INVALID_ID;
+        DataSeriesPointer series;
+        const DataSource *source = nullptr;
+
+        //! "source:label" identifier
+        QString identifier;
+
+        //! Lowercase label (used for searching)
+        QString key;
+    };
+
+    // Add a source (and all of its series) to the registry
+    void registerSource(DataSourcePointer source);
+    void unregisterSource(DataSourcePointer source);
+
+    // Add a single series, and return its ID (or the existing ID if already registered)
+    SeriesId registerSeries(const DataSource *source, DataSeriesPointer series);
+    bool unregisterSeries(const DataSeries *series);
+
+    // Update the registry after a series has been renamed
+    void updateSeries(const DataSeries *series);
+
+    void clear(void);
+
+    int getSeriesCount(void) const { return m_entries.count(); }
+
+    SeriesId getId(const DataSeries *series) const { return m_ids.value(series, INVALID_ID); }
+    DataSeriesPointer getSeries(SeriesId id) const;
+    const DataSource *getSource(SeriesId id) const;
+
+    DataSourcePointer findSource(QString label) const { return m_sources.value(label); }
+
+    DataSeriesPointer findSeries(QString source_label, QString series_label) const;
+    DataSeriesPointer findSeries(QString identifier) const;
+
+    // Find series whose labels contain all (whitespace separated) terms, ignoring case
+    QVector<SeriesId> search(QString text) const;
+
+    // Find series whose labels start with the provided text, ignoring case
+    QVector<SeriesId> searchPrefix(QString text) const;
+
+    // Find series with labels similar to the provided text (e.g. with typos), best matches first
+    QVector<SeriesId> searchSimilar(QString text, int limit = 20) const;
+
+    static QString makeIdentifier(QString source_label, QString series_label) { return source_label + ":" + series_label; }
+
+    //! Minimum proportion of matching trigrams for searchSimilar()
+    static constexpr double SIMILARITY_THRESHOLD = 0.3;
+
+protected:
+    SeriesId m_nextId = 1;
+
+    QHash<SeriesId, Entry> m_entries;
+    QHash<const DataSeries*, SeriesId> m_ids;
+    QMultiHash<QString, SeriesId> m_identifiers;
+
+    //! Registered sources, by label (the first source registered with a given label)
+    QHash<QString, DataSourcePointer> m_sources;
+    QList<DataSourcePointer> m_sourceList;
+
+    //! Trigram index (may contain stale IDs)
+    QHash<quint64, QVector<SeriesId>> m_trigrams;
+    int m_livePostings = 0;
+    int m_stalePostings = 0;
+
+    //! Sorted (key, id) pairs for prefix search, rebuilt on demand
+    mutable QVector<QPair<QString, SeriesId>> m_prefixIndex;
+    mutable bool m_prefixIndexValid = false;
+
+    void indexEntry(const Entry &entry);
+    void removeEntry(SeriesId id);
+    void rebuildTrigrams(void);
+
+    static QVector<quint64> getTrigrams(const QString &text);
+    const QVector<SeriesId> *getPostings(quint64 trigram) const;
+};
+
+
+#endif // SERIES_REGISTRY_HPP
@@ -1,63 +1,227 @@
+#include <QHeaderView>
+#include <QInputDialog>
+#include <QAction>
+#include <QKeySequence>
+
+#include <limits>
+#include <math.h>
+
 #include "datatable_widget.hpp"
 
 
 DataSeriesTableModel::DataSeriesTableModel(DataSeriesPointer series, QObject* parent) : QAbstractTableModel(parent)
 {
     this->series = series;
+
+    if (!series.isNull())
+    {
+        rows = (int) std::min<uint64_t>(series->size(), std::numeric_limits<int>::max());
+        firstTimestamp = rows > 0 ? series->getOldestTimestamp() : 0;
+
+        connect(series.data(), &DataSeries::dataUpdated, this, &DataSeriesTableModel::onSeriesDataUpdated);
+    }
 }
 
 
 int DataSeriesTableModel::rowCount(const QModelIndex &parent) const
 {
-    Q_UNUSED(parent);
+    if (parent.isValid()) return 0;
+
+    return rows;
+}
+
+
+int DataSeriesTableModel::columnCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) return 0;
+
+    return COLUMN_COUNT;
+}
+
 
-    if (series.isNull())
+/*
+ * Return the cached block containing the given row, fetching it from the series if required
+ */
+DataSeriesTableModel::Block *DataSeriesTableModel::getBlock(int row) const
+{
+    uint64_t start = ((uint64_t) row / BLOCK_SIZE) * BLOCK_SIZE;
+
+    accessCounter++;
+
+    for (auto &block : blocks)
     {
-        return 0;
+        if (block.start == start && !block.points.empty())
+        {
+            block.lastUsed = accessCounter;
+            return &block;
+        }
+    }
+
+    Block *block = nullptr;
+
+    if ((int) blocks.size() < MAX_BLOCKS)
+    {
+        blocks.emplace_back();
+        block = &blocks.back();
     }
     else
     {
-        return series->size();
+        // Replace the least recently used block
+        block = &blocks.front();
+
+        for (auto &b : blocks)
+        {
+            if (b.lastUsed < block->lastUsed) block = &b;
+        }
     }
+
+    block->start = start;
+    block->lastUsed = accessCounter;
+    block->points.resize(BLOCK_SIZE);
+    block->points.resize(series->getDataPoints(start, BLOCK_SIZE, block->points.data()));
+
+    block->text.clear();
+    block->text.resize(block->points.size() * COLUMN_COUNT);
+
+    return block->points.empty() ? nullptr : block;
 }
 
 
-int DataSeriesTableModel::columnCount(const QModelIndex &parent) const
+void DataSeriesTableModel::clearCache()
 {
-    Q_UNUSED(parent);
-
-    return 2;
+    blocks.clear();
 }
 
 
 QVariant DataSeriesTableModel::data(const QModelIndex &index, int role) const
 {
-    if (role == Qt::DisplayRole)
+    if (role != Qt::DisplayRole) return QVariant();
+
+    int row = index.row();
+    int col = index.column();
+
+    // Out of bounds
+    if (series.isNull() || row < 0 || row >= rows || col < 0 || col >= COLUMN_COUNT)
     {
-        int row = index.row();
-        int col = index.column();
+        return QVariant();
+    }
 
-        // Out of bounds
-        if (series.isNull() || row < 0 || row >= series->size())
-        {
-            return QVariant();
-        }
+    Block *block = getBlock(row);
+
+    if (!block) return QVariant();
+
+    uint64_t offset = (uint64_t) row - block->start;
+
+    if (offset >= block->points.size()) return QVariant();
+
+    QString &text = block->text[offset * COLUMN_COUNT + col];
+
+    if (text.isNull())
+    {
+        const DataPoint &point = block->points[offset];
+
+        text = formatNumber(col == COLUMN_TIMESTAMP ? point.timestamp : point.value);
+    }
+
+    return text;
+}
+
+
+QVariant DataSeriesTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole) return QVariant();
+
+    if (orientation == Qt::Vertical) return section;
+
+    switch (section)
+    {
+    case COLUMN_TIMESTAMP:
+        return tr("Timestamp");
+    case COLUMN_VALUE:
+        return tr("Value");
+    default:
+        return QVariant();
+    }
+}
+
+
+/*
+ * Integer values (e.g. sample counters, raw sensor values) are formatted without floating point conversion
+ */
+QString DataSeriesTableModel::formatNumber(double value)
+{
+    if (std::isfinite(value) && value == floor(value) && fabs(value) < 1e15)
+    {
+        return QString::number((qlonglong) value);
+    }
+
+    return QString::number(value, 'g', 12);
+}
+
+
+double DataSeriesTableModel::getTimestamp(int row) const
+{
+    if (series.isNull() || row < 0 || row >= rows) return 0;
+
+    Block *block = getBlock(row);
+
+    if (!block || (uint64_t) row - block->start >= block->points.size()) return 0;
 
-        DataPoint point = series->getDataPoint(row);
+    return block->points[row - block->start].timestamp;
+}
+
+
+int DataSeriesTableModel::getRowForTimestamp(double t) const
+{
+    if (series.isNull() || rows == 0) return -1;
+
+    int row = (int) std::min<uint64_t>(series->getIndexForTimestamp(t, DataSeries::SEARCH_RIGHT_TO_LEFT), rows);
+
+    // Select the closer of the samples either side of the timestamp
+    if (row >= rows || (row > 0 && fabs(t - getTimestamp(row - 1)) <= fabs(getTimestamp(row) - t)))
+    {
+        row--;
+    }
 
-        switch (col)
+    return row;
+}
+
+
+/*
+ * Called when data are added to (or removed from) the series
+ */
+void DataSeriesTableModel::onSeriesDataUpdated()
+{
+    int count = (int) std::min<uint64_t>(series->size(), std::numeric_limits<int>::max());
+
+    double first = count > 0 ? series->getOldestTimestamp() : 0;
+
+    // Samples have been appended
+    if (count > rows && rows > 0 && first == firstTimestamp)
+    {
+        // Discard the (partial) block at the end of the previous data
+        uint64_t start = ((uint64_t) (rows - 1) / BLOCK_SIZE) * BLOCK_SIZE;
+
+        for (auto it = blocks.begin(); it != blocks.end(); ++it)
         {
-        case 0:
-            return point.timestamp;
-        case 1:
-            return point.value;
-        default:
-            return "Invalid index: " + QString::number(col);
+            if (it->start == start)
+            {
+                blocks.erase(it);
+                break;
+            }
         }
+
+        beginInsertRows(QModelIndex(), rows, count - 1);
+        rows = count;
+        endInsertRows();
     }
-    else
+    else if (count != rows || first != firstTimestamp)
     {
-        return QVariant();
+        beginResetModel();
+        clearCache();
+        rows = count;
+        firstTimestamp = first;
+        endResetModel();
     }
 }
 
@@ -66,13 +230,28 @@ DataSeriesTableView::DataSeriesTableView(DataSeriesPointer series, QWidget *pare
     QTableView(parent),
     model(series)
 {
-    model.setHeaderData(0, Qt::Vertical, tr("Timestamp"));
-    model.setHeaderData(1, Qt::Horizontal, tr("Value"));
-
     setModel(&model);
 
     setAlternatingRowColors(true);
 
+    setSelectionMode(QAbstractItemView::SingleSelection);
+    setSelectionBehavior(QAbstractItemView::SelectRows);
+
+    // Uniform, fixed row heights - the headers do not need to measure each row
+    verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    verticalHeader()->setDefaultSectionSize(fontMetrics().height() + 4);
+    verticalHeader()->setMinimumWidth(fontMetrics().horizontalAdvance(QString::number(model.rowCount())) + 12);
+
+    horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+
+    connect(selectionModel(), &QItemSelectionModel::currentRowChanged, this, &DataSeriesTableView::onCurrentRowChanged);
+
+    QAction *jumpAction = new QAction(tr("Go to Timestamp"), this);
+    jumpAction->setShortcut(QKeySequence(Qt::CTRL | Qt::Key_G));
+    addAction(jumpAction);
+
+    connect(jumpAction, &QAction::triggered, this, &DataSeriesTableView::jumpToTimestamp);
+
     if (!series.isNull())
     {
         QString title = series->getLabel();
@@ -85,3 +264,59 @@ DataSeriesTableView::DataSeriesTableView(DataSeriesPointer series, QWidget *pare
 DataSeriesTableView::~DataSeriesTableView()
 {
 }
+
+
+void DataSeriesTableView::selectRow(int row)
+{
+    if (row < 0) return;
+
+    QModelIndex index = model.index(row, DataSeriesTableModel::COLUMN_TIMESTAMP);
+
+    setCurrentIndex(index);
+    scrollTo(index, QAbstractItemView::EnsureVisible);
+}
+
+
+void DataSeriesTableView::setCursorTimestamp(double t)
+{
+    syncingCursor = true;
+
+    selectRow(model.getRowForTimestamp(t));
+
+    syncingCursor = false;
+}
+
+
+void DataSeriesTableView::jumpToTimestamp()
+{
+    auto series = model.getSeries();
+
+    if (series.isNull() || model.rowCount() == 0) return;
+
+    bool ok = false;
+
+    double t = QInputDialog::getDouble(
+                this,
+                tr("Go to Timestamp"),
+                tr("Timestamp"),
+                model.getTimestamp(currentIndex().isValid() ? currentIndex().row() : 0),
+                series->getOldestTimestamp(),
+                series->getNewestTimestamp(),
+                6,
+                &ok);
+
+    if (ok)
+    {
+        selectRow(model.getRowForTimestamp(t));
+    }
+}
+
+
+void DataSeriesTableView::onCurrentRowChanged(const QModelIndex &current, const QModelIndex &previous)
+{
+    Q_UNUSED(previous);
+
+    if (syncingCursor || !current.isValid()) return;
+
+    emit timestampSelected(model.getTimestamp(current.row()));
+}
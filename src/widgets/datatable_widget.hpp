@@ -4,23 +4,87 @@
 #include <qtableview.h>
 #include <qwidget.h>
 
+#include <vector>
+
 #include "data_series.hpp"
 
 
+/**
+ * @brief The DataSeriesTableModel class displays the samples of a DataSeries in a table
+ *
+ * - Samples are fetched from the series in blocks (with a single lock per block),
+ *   and a small number of recently used blocks are cached
+ * - Cell text is formatted only when first displayed, and cached with the block
+ * - Samples appended to the series are added as new rows (without resetting the model)
+ *
+ * Display cost depends only on the number of visible rows, not the size of the series.
+ */
 class DataSeriesTableModel : public QAbstractTableModel
 {
     Q_OBJECT
 
 public:
+    enum Column
+    {
+        COLUMN_TIMESTAMP = 0,
+        COLUMN_VALUE,
+        COLUMN_COUNT,
+    };
+
     DataSeriesTableModel(DataSeriesPointer series, QObject *parent = nullptr);
 
     int rowCount(const QModelIndex &parent = QModelIndex()) const override;
     int columnCount(const QModelIndex &parent = QModelIndex()) const override;
 
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    DataSeriesPointer getSeries(void) const { return series; }
+
+    // Return the timestamp at the given row
+    double getTimestamp(int row) const;
+
+    // Return the row nearest to the given timestamp (or -1 if the series is empty)
+    int getRowForTimestamp(double t) const;
+
+    // Fast conversion of a sample to text
+    static QString formatNumber(double value);
+
+    //! Number of samples fetched per block
+    static const int BLOCK_SIZE = 1024;
+
+    //! Maximum number of cached blocks
+    static const int MAX_BLOCKS = 32;
+
+public slots:
+    void onSeriesDataUpdated(void);
 
 protected:
+    struct Block
+    {
+        uint64_t start = 0;
+        std::vector<DataPoint> points;
+
+        //! Formatted text (two strings per row), generated on demand
+        std::vector<QString> text;
+
+        //! For least-recently-used eviction
+        uint64_t lastUsed = 0;
+    };
+
     DataSeriesPointer series;
+
+    //! Number of rows currently exposed to the view
+    int rows = 0;
+
+    //! Timestamp of the first sample (to detect samples being removed)
+    double firstTimestamp = 0;
+
+    mutable std::vector<Block> blocks;
+    mutable uint64_t accessCounter = 0;
+
+    Block *getBlock(int row) const;
+    void clearCache(void);
 };
 
 
@@ -32,8 +96,27 @@ public:
     DataSeriesTableView(DataSeriesPointer series, QWidget *parent = nullptr);
     virtual ~DataSeriesTableView();
 
+public slots:
+    // Select the row nearest the given timestamp (e.g. the plot cursor), without emitting timestampSelected
+    void setCursorTimestamp(double t);
+
+    // Prompt the user for a timestamp, and select the nearest row
+    void jumpToTimestamp(void);
+
+signals:
+    // Emitted when the user selects a row
+    void timestampSelected(double t);
+
+protected slots:
+    void onCurrentRowChanged(const QModelIndex &current, const QModelIndex &previous);
+
 protected:
     DataSeriesTableModel model;
+
+    //! Set while the selection is updated from an external cursor
+    bool syncingCursor = false;
+
+    void selectRow(int row);
 };
 
 
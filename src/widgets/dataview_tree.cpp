@@ -1,25 +1,746 @@
 #include <QDataStream>
 #include <QDrag>
 #include <QMimeData>
+#include <QFont>
+
+#include <algorithm>
 #include <qmenu.h>
 #include <qaction.h>
 #include <qheaderview.h>
+#include <qmessagebox.h>
+#include <qapplication.h>
 
 #include "datatable_widget.hpp"
+#include "filter_options_dialog.hpp"
+#include "filter_pipeline.hpp"
+#include "plugin_registry.hpp"
 #include "series_editor_dialog.hpp"
 #include "dataview_tree.hpp"
 #include "data_source_manager.hpp"
 
 
-DataViewTree::DataViewTree(QWidget *parent) : QTreeWidget(parent)
+DataViewModel::DataViewModel(QObject *parent) : QAbstractItemModel(parent)
+{
+    auto *manager = DataSourceManager::getInstance();
+
+    connect(manager, &DataSourceManager::sourcesChanged, this, &DataViewModel::sync);
+
+    sync();
+}
+
+
+/*
+ * Series items store a pointer to their source node, source items store nullptr
+ */
+DataViewModel::SourceNode *DataViewModel::getNode(const QModelIndex &index) const
+{
+    if (!index.isValid()) return nullptr;
+
+    SourceNode *node = static_cast<SourceNode*>(index.internalPointer());
+
+    if (node) return node;
+
+    if (index.row() < 0 || index.row() >= (int) m_nodes.size()) return nullptr;
+
+    return m_nodes[index.row()].get();
+}
+
+
+int DataViewModel::getNodeRow(const SourceNode *node) const
+{
+    for (int row = 0; row < (int) m_nodes.size(); row++)
+    {
+        if (m_nodes[row].get() == node) return row;
+    }
+
+    return -1;
+}
+
+
+QModelIndex DataViewModel::index(int row, int column, const QModelIndex &parent) const
+{
+    if (!hasIndex(row, column, parent)) return QModelIndex();
+
+    if (!parent.isValid())
+    {
+        return createIndex(row, column, nullptr);
+    }
+
+    return createIndex(row, column, getNode(parent));
+}
+
+
+QModelIndex DataViewModel::parent(const QModelIndex &index) const
+{
+    if (!index.isValid()) return QModelIndex();
+
+    SourceNode *node = static_cast<SourceNode*>(index.internalPointer());
+
+    if (!node) return QModelIndex();
+
+    int row = getNodeRow(node);
+
+    if (row < 0) return QModelIndex();
+
+    return createIndex(row, 0, nullptr);
+}
+
+
+int DataViewModel::rowCount(const QModelIndex &parent) const
+{
+    if (!parent.isValid()) return (int) m_nodes.size();
+
+    // Series items have no children
+    if (parent.column() > 0 || parent.internalPointer()) return 0;
+
+    SourceNode *node = getNode(parent);
+
+    return node ? node->fetched : 0;
+}
+
+
+int DataViewModel::columnCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent);
+
+    return COLUMN_COUNT;
+}
+
+
+bool DataViewModel::hasChildren(const QModelIndex &parent) const
+{
+    if (!parent.isValid()) return !m_nodes.empty();
+
+    if (parent.column() > 0 || parent.internalPointer()) return false;
+
+    SourceNode *node = getNode(parent);
+
+    // Series which have not yet been fetched still count as children
+    return node && !node->series.isEmpty();
+}
+
+
+QVariant DataViewModel::data(const QModelIndex &index, int role) const
+{
+    SourceNode *node = getNode(index);
+
+    if (!node) return QVariant();
+
+    // Source item
+    if (!index.internalPointer())
+    {
+        if (index.column() != COLUMN_LABEL) return QVariant();
+
+        switch (role)
+        {
+        case Qt::DisplayRole:
+            return node->source->getLabel();
+        case Qt::FontRole:
+        {
+            QFont font;
+            font.setBold(true);
+            return font;
+        }
+        default:
+            return QVariant();
+        }
+    }
+
+    // Series item
+    if (index.row() < 0 || index.row() >= node->fetched) return QVariant();
+
+    const DataSeriesPointer &series = node->series.at(index.row());
+
+    if (index.column() == COLUMN_COLOR)
+    {
+        if (role == Qt::BackgroundRole) return series->getColor();
+
+        return QVariant();
+    }
+
+    switch (role)
+    {
+    case Qt::DisplayRole:
+        return series->getLabel();
+    case Qt::ToolTipRole:
+        return node->source->getLabel() + ":" + series->getLabel() + " (" + QString::number(series->size()) + " samples)";
+    case Qt::FontRole:
+    {
+        QFont font;
+        font.setItalic(true);
+        return font;
+    }
+    default:
+        return QVariant();
+    }
+}
+
+
+QVariant DataViewModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) return QVariant();
+
+    switch (section)
+    {
+    case COLUMN_LABEL:
+        return tr("Label");
+    default:
+        return QString();
+    }
+}
+
+
+Qt::ItemFlags DataViewModel::flags(const QModelIndex &index) const
+{
+    if (!index.isValid()) return Qt::NoItemFlags;
+
+    Qt::ItemFlags f = Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+
+    // Only series can be dragged (e.g. onto a plot)
+    if (index.internalPointer())
+    {
+        f |= Qt::ItemIsDragEnabled;
+    }
+
+    return f;
+}
+
+
+bool DataViewModel::canFetchMore(const QModelIndex &parent) const
+{
+    if (!parent.isValid() || parent.internalPointer()) return false;
+
+    SourceNode *node = getNode(parent);
+
+    return node && node->fetched < node->series.count();
+}
+
+
+void DataViewModel::fetchMore(const QModelIndex &parent)
+{
+    if (!canFetchMore(parent)) return;
+
+    SourceNode *node = getNode(parent);
+
+    int count = qMin(FETCH_BATCH, node->series.count() - node->fetched);
+
+    beginInsertRows(parent, node->fetched, node->fetched + count - 1);
+    node->fetched += count;
+    endInsertRows();
+}
+
+
+void DataViewModel::fetchAll(int row)
+{
+    if (row < 0 || row >= (int) m_nodes.size()) return;
+
+    SourceNode *node = m_nodes[row].get();
+
+    if (node->fetched >= node->series.count()) return;
+
+    beginInsertRows(index(row, 0), node->fetched, node->series.count() - 1);
+    node->fetched = node->series.count();
+    endInsertRows();
+}
+
+
+DataSourcePointer DataViewModel::getSource(const QModelIndex &index) const
+{
+    SourceNode *node = getNode(index);
+
+    return node ? node->source : DataSourcePointer();
+}
+
+
+DataSeriesPointer DataViewModel::getSeries(const QModelIndex &index) const
+{
+    if (!index.isValid() || !index.internalPointer()) return DataSeriesPointer();
+
+    SourceNode *node = getNode(index);
+
+    if (index.row() < 0 || index.row() >= node->fetched) return DataSeriesPointer();
+
+    return node->series.at(index.row());
+}
+
+
+/**
+ * @brief DataViewModel::sync - Update the tree to match the available data sources
+ *
+ * Only added and removed rows are signalled to the view, so this is cheap to call
+ * for every change (e.g. while data are being imported).
+ */
+void DataViewModel::sync()
+{
+    auto *manager = DataSourceManager::getInstance();
+
+    QVector<DataSourcePointer> sources;
+
+    for (int ii = 0; ii < manager->getSourceCount(); ii++)
+    {
+        auto source = manager->getSourceByIndex(ii);
+
+        if (!source.isNull()) sources.append(source);
+    }
+
+    bool changed = false;
+
+    // Remove any sources which are no longer available
+    for (int row = (int) m_nodes.size() - 1; row >= 0; row--)
+    {
+        if (!sources.contains(m_nodes[row]->source))
+        {
+            beginRemoveRows(QModelIndex(), row, row);
+            m_nodes.erase(m_nodes.begin() + row);
+            endRemoveRows();
+
+            changed = true;
+        }
+    }
+
+    // Add new sources (series are populated on demand)
+    for (auto source : sources)
+    {
+        bool found = false;
+
+        for (const auto &node : m_nodes)
+        {
+            if (node->source == source)
+            {
+                found = true;
+                break;
+            }
+        }
+
+        if (found) continue;
+
+        std::unique_ptr<SourceNode> node(new SourceNode());
+
+        node->source = source;
+
+        for (auto series : source->getSeries())
+        {
+            if (series.isNull()) continue;
+
+            node->series.append(series);
+            node->keys.append(getLabelKey(series.data()));
+        }
+
+        int row = (int) m_nodes.size();
+
+        beginInsertRows(QModelIndex(), row, row);
+        m_nodes.push_back(std::move(node));
+        endInsertRows();
+
+        changed = true;
+    }
+
+    for (int row = 0; row < (int) m_nodes.size(); row++)
+    {
+        changed |= syncSeries(row);
+    }
+
+    if (changed)
+    {
+        rebuildLabelIndex();
+    }
+
+    // Display properties (e.g. color) may have changed
+    emitSeriesChanged();
+}
+
+
+/*
+ * Apply any added or removed series for the source at the given row.
+ * Series are ordered by label, so the two lists can be merged in a single pass.
+ */
+bool DataViewModel::syncSeries(int row)
+{
+    SourceNode *node = m_nodes[row].get();
+
+    QVector<DataSeriesPointer> items;
+
+    for (auto series : node->source->getSeries())
+    {
+        if (!series.isNull()) items.append(series);
+    }
+
+    if (items == node->series) return false;
+
+    QSet<const DataSeries*> incoming;
+    QSet<const DataSeries*> existing;
+
+    for (const auto &series : items) incoming.insert(series.data());
+    for (const auto &series : node->series) existing.insert(series.data());
+
+    QModelIndex parent = index(row, 0);
+
+    int ii = 0;
+    int jj = 0;
+
+    while (ii < node->series.count() || jj < items.count())
+    {
+        if (ii < node->series.count() && jj < items.count() && node->series.at(ii) == items.at(jj))
+        {
+            ii++;
+            jj++;
+        }
+        else if (ii < node->series.count() && !incoming.contains(node->series.at(ii).data()))
+        {
+            removeSeriesRow(node, parent, ii);
+        }
+        else if (jj < items.count() && !existing.contains(items.at(jj).data()))
+        {
+            insertSeriesRow(node, parent, ii, items.at(jj));
+            ii++;
+            jj++;
+        }
+        else
+        {
+            // Series have been re-ordered (e.g. renamed) - reload the source
+            if (node->fetched > 0)
+            {
+                beginRemoveRows(parent, 0, node->fetched - 1);
+                node->fetched = 0;
+                endRemoveRows();
+            }
+
+            node->series = items;
+            node->keys.clear();
+
+            for (const auto &series : items) node->keys.append(getLabelKey(series.data()));
+
+            break;
+        }
+    }
+
+    return true;
+}
+
+
+void DataViewModel::insertSeriesRow(SourceNode *node, const QModelIndex &parent, int row, DataSeriesPointer series)
+{
+    // New series are displayed immediately if the source has been fully populated
+    bool visible = row < node->fetched || node->fetched == node->series.count();
+
+    if (visible) beginInsertRows(parent, row, row);
+
+    node->series.insert(row, series);
+    node->keys.insert(row, getLabelKey(series.data()));
+
+    if (visible)
+    {
+        node->fetched++;
+        endInsertRows();
+    }
+}
+
+
+void DataViewModel::removeSeriesRow(SourceNode *node, const QModelIndex &parent, int row)
+{
+    bool visible = row < node->fetched;
+
+    if (visible) beginRemoveRows(parent, row, row);
+
+    node->series.removeAt(row);
+    node->keys.removeAt(row);
+
+    if (visible)
+    {
+        node->fetched--;
+        endRemoveRows();
+    }
+}
+
+
+void DataViewModel::refreshSeries()
+{
+    for (auto &node : m_nodes)
+    {
+        for (int ii = 0; ii < node->series.count(); ii++)
+        {
+            node->keys[ii] = getLabelKey(node->series.at(ii).data());
+        }
+    }
+
+    rebuildLabelIndex();
+    emitSeriesChanged();
+}
+
+
+void DataViewModel::rebuildLabelIndex()
+{
+    QVector<LabelEntry> labels;
+
+    m_labelPositions.clear();
+
+    for (const auto &node : m_nodes)
+    {
+        for (int ii = 0; ii < node->series.count(); ii++)
+        {
+            m_labelPositions.insert(node->series.at(ii).data(), labels.count());
+            labels.append({node->source.data(), node->series.at(ii).data(), node->keys.at(ii)});
+        }
+    }
+
+    m_labelIndex.swap(labels);
+
+    emit labelIndexChanged();
+}
+
+
+/*
+ * Notify the view that the populated series rows should be redrawn
+ */
+void DataViewModel::emitSeriesChanged()
+{
+    for (int row = 0; row < (int) m_nodes.size(); row++)
+    {
+        int count = m_nodes[row]->fetched;
+
+        if (count == 0) continue;
+
+        QModelIndex parent = index(row, 0);
+
+        emit dataChanged(index(0, 0, parent), index(count - 1, COLUMN_COUNT - 1, parent));
+    }
+}
+
+
+DataViewFilterModel::DataViewFilterModel(DataViewModel *model, QObject *parent) :
+    QSortFilterProxyModel(parent),
+    m_model(model)
+{
+    setSourceModel(model);
+
+    connect(model, &DataViewModel::labelIndexChanged, this, &DataViewFilterModel::onLabelIndexChanged);
+}
+
+
+int DataViewFilterModel::getMatchCount() const
+{
+    return isFiltered() ? m_matches.count() : m_model->getSeriesCount();
+}
+
+
+/*
+ * Split a filter string into individual (lowercase) terms
+ */
+QList<DataViewFilterModel::FilterTerm> DataViewFilterModel::parseFilter(QString filter)
+{
+    QList<FilterTerm> terms;
+
+    for (QString text : filter.toLower().split(" ", Qt::SkipEmptyParts))
+    {
+        FilterTerm term;
+
+        term.text = text;
+        term.wildcard = text.contains('*') || text.contains('?') || text.contains('[');
+
+        if (term.wildcard)
+        {
+            if (!text.startsWith("*")) text.prepend("*");
+            if (!text.endsWith("*")) text.append("*");
+
+            // Convert from wildcard to regular expression
+            QString re_pattern = QRegularExpression::wildcardToRegularExpression(text);
+            term.regex = QRegularExpression(re_pattern, QRegularExpression::CaseInsensitiveOption);
+        }
+
+        terms.append(term);
+    }
+
+    return terms;
+}
+
+
+/*
+ * Returns true if every label matching the new terms must also match the previous terms,
+ * i.e. each previous term is contained within one of the new (substring) terms.
+ */
+bool DataViewFilterModel::isNarrowing(const QList<FilterTerm> &previous, const QList<FilterTerm> &terms)
+{
+    if (previous.isEmpty()) return false;
+
+    for (const auto &prev : previous)
+    {
+        if (prev.wildcard) return false;
+
+        bool found = false;
+
+        for (const auto &term : terms)
+        {
+            if (!term.wildcard && term.text.contains(prev.text))
+            {
+                found = true;
+                break;
+            }
+        }
+
+        if (!found) return false;
+    }
+
+    return true;
+}
+
+
+bool DataViewFilterModel::matches(const QString &key) const
+{
+    for (const auto &term : m_terms)
+    {
+        bool match = term.wildcard ? term.regex.match(key).hasMatch() : key.contains(term.text);
+
+        if (!match) return false;
+    }
+
+    return true;
+}
+
+
+void DataViewFilterModel::setFilterString(QString filter)
+{
+    QList<FilterTerm> terms = parseFilter(filter);
+
+    m_filterString = filter;
+
+    QStringList previous;
+    QStringList next;
+
+    for (const auto &term : m_terms) previous.append(term.text);
+    for (const auto &term : terms) next.append(term.text);
+
+    if (previous == next) return;
+
+    bool incremental = isNarrowing(m_terms, terms);
+
+    m_terms = terms;
+
+    updateMatches(incremental);
+}
+
+
+void DataViewFilterModel::onLabelIndexChanged()
+{
+    updateMatches(false);
+}
+
+
+/*
+ * Recalculate the set of matching series from the label index.
+ * If incremental, only the previous matches are tested.
+ */
+void DataViewFilterModel::updateMatches(bool incremental)
+{
+    const auto &labels = m_model->getLabelIndex();
+
+    QVector<int> matched;
+
+    if (isFiltered())
+    {
+        if (incremental)
+        {
+            for (int idx : m_matchedEntries)
+            {
+                if (matches(labels.at(idx).key)) matched.append(idx);
+            }
+        }
+        else
+        {
+            QStringList substrings;
+
+            for (const auto &term : m_terms)
+            {
+                if (!term.wildcard) substrings.append(term.text);
+            }
+
+            if (substrings.isEmpty())
+            {
+                for (int idx = 0; idx < labels.count(); idx++)
+                {
+                    if (matches(labels.at(idx).key)) matched.append(idx);
+                }
+            }
+            else
+            {
+                // Use the registry to find candidates for the substring terms
+                auto *registry = DataSourceManager::getInstance()->getRegistry();
+
+                for (SeriesId id : registry->search(substrings.join(" ")))
+                {
+                    int idx = m_model->getLabelPosition(registry->getSeries(id).data());
+
+                    if (idx >= 0 && matches(labels.at(idx).key)) matched.append(idx);
+                }
+
+                std::sort(matched.begin(), matched.end());
+            }
+        }
+    }
+
+    m_matchedEntries.swap(matched);
+
+    m_matches.clear();
+    m_sourceMatches.clear();
+
+    for (int idx : m_matchedEntries)
+    {
+        const auto &entry = labels.at(idx);
+
+        m_matches.insert(entry.series);
+        m_sourceMatches[entry.source]++;
+    }
+
+    invalidateFilter();
+
+    // Matching series must be populated, otherwise they cannot be displayed
+    if (isFiltered())
+    {
+        for (int row = 0; row < m_model->rowCount(); row++)
+        {
+            auto source = m_model->getSource(m_model->index(row, 0));
+
+            if (m_sourceMatches.value(source.data(), 0) > 0)
+            {
+                m_model->fetchAll(row);
+            }
+        }
+    }
+}
+
+
+bool DataViewFilterModel::filterAcceptsRow(int row, const QModelIndex &parent) const
+{
+    if (!isFiltered()) return true;
+
+    QModelIndex index = m_model->index(row, 0, parent);
+
+    if (!parent.isValid())
+    {
+        // Sources are displayed only if they contain matching series
+        auto source = m_model->getSource(index);
+
+        return m_sourceMatches.value(source.data(), 0) > 0;
+    }
+
+    auto series = m_model->getSeries(index);
+
+    return m_matches.contains(series.data());
+}
+
+
+DataViewTree::DataViewTree(QWidget *parent) : QTreeView(parent),
+    m_filter(&m_model)
 {
     setupTree();
 
-    connect(this, &QTreeWidget::itemDoubleClicked, this, &DataViewTree::onItemDoubleClicked);
+    connect(this, &QTreeView::doubleClicked, this, &DataViewTree::onItemDoubleClicked);
 
     setContextMenuPolicy(Qt::CustomContextMenu);
 
-    connect(this, &QTreeWidget::customContextMenuRequested, this, &DataViewTree::onContextMenu);
+    connect(this, &QTreeView::customContextMenuRequested, this, &DataViewTree::onContextMenu);
+
+    // New sources are expanded as they are added
+    connect(&m_filter, &QAbstractItemModel::rowsInserted, this, &DataViewTree::onRowsInserted);
 
     setAlternatingRowColors(true);
 }
@@ -35,16 +756,7 @@ DataViewTree::~DataViewTree()
  */
 void DataViewTree::setupTree()
 {
-    clear();
-
-    QStringList labels;
-
-    setColumnCount(2);
-
-    labels.append("");
-    labels.append(tr("Label"));
-
-    setHeaderLabels(labels);
+    setModel(&m_filter);
 
     setUniformRowHeights(true);
 
@@ -55,10 +767,35 @@ void DataViewTree::setupTree()
     setSelectionMode(QAbstractItemView::SelectionMode::ExtendedSelection);
     setSelectionBehavior(QAbstractItemView::SelectionBehavior::SelectRows);
 
-    header()->setSectionResizeMode(0, QHeaderView::Fixed);
-    header()->setSectionResizeMode(1, QHeaderView::Stretch);
+    header()->setSectionResizeMode(DataViewModel::COLUMN_COLOR, QHeaderView::Fixed);
+    header()->setSectionResizeMode(DataViewModel::COLUMN_LABEL, QHeaderView::Stretch);
     header()->setStretchLastSection(true);
-    header()->resizeSection(0, 55);
+    header()->resizeSection(DataViewModel::COLUMN_COLOR, 55);
+
+    expandAll();
+}
+
+
+DataSourcePointer DataViewTree::getSource(const QModelIndex &index) const
+{
+    return m_model.getSource(m_filter.mapToSource(index));
+}
+
+
+DataSeriesPointer DataViewTree::getSeries(const QModelIndex &index) const
+{
+    return m_model.getSeries(m_filter.mapToSource(index));
+}
+
+
+void DataViewTree::onRowsInserted(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid()) return;
+
+    for (int row = first; row <= last; row++)
+    {
+        expand(m_filter.index(row, 0));
+    }
 }
 
 
@@ -78,7 +815,7 @@ void DataViewTree::editDataSeries(DataSeriesPointer series)
 
     if (result)
     {
-        refresh(filterString);
+        m_model.refreshSeries();
     }
 
     dlg->deleteLater();
@@ -86,38 +823,96 @@ void DataViewTree::editDataSeries(DataSeriesPointer series)
 }
 
 
+/*
+ * Apply a filter to each of the provided series (in parallel),
+ * and add the filtered results to the same source as the original series.
+ */
+void DataViewTree::filterDataSeries(const FilterPlugin &filter, QModelIndexList indexes)
+{
+    QScopedPointer<FilterPlugin> instance(filter.createInstance());
+
+    if (instance.isNull()) return;
+
+    if (!instance->getOptions().isEmpty())
+    {
+        FilterOptionsDialog dlg(*instance, this);
+
+        if (dlg.exec() != QDialog::Accepted) return;
+
+        if (!instance->setOptions(dlg.getOptions()))
+        {
+            QMessageBox::warning(this, filter.pluginName(), tr("Invalid filter options"));
+            return;
+        }
+    }
+
+    QList<DataSourcePointer> sources;
+    QList<DataSeriesPointer> inputs;
+
+    for (const auto &index : indexes)
+    {
+        if (!index.parent().isValid()) continue;
+
+        auto source = getSource(index);
+        auto series = getSeries(index);
+
+        if (source.isNull() || series.isNull() || inputs.contains(series)) continue;
+
+        sources.append(source);
+        inputs.append(series);
+    }
+
+    if (inputs.isEmpty()) return;
+
+    FilterPipeline pipeline;
+    pipeline.append(*instance);
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+
+    QList<DataSeriesPointer> outputs = pipeline.createSeries(inputs);
+
+    QApplication::restoreOverrideCursor();
+
+    for (int idx = 0; idx < outputs.count(); idx++)
+    {
+        auto output = outputs.at(idx);
+
+        if (output.isNull()) continue;
+
+        output->setLabel(inputs.at(idx)->getLabel() + " [" + filter.pluginName() + "]");
+
+        sources.at(idx)->addSeries(output, true);
+    }
+}
+
+
 /*
  * Callback when a right-click context menu is created for a particular item
  */
 void DataViewTree::onContextMenu(const QPoint &pos)
 {
-    QTreeWidgetItem *item = itemAt(pos);
+    QModelIndex index = indexAt(pos);
 
-    if (!item)
+    if (!index.isValid())
     {
         return;
     }
 
-    auto *parent = item->parent();
     auto *manager = DataSourceManager::getInstance();
 
-    QMenu menu(this);
+    auto source = getSource(index);
 
-    if (parent)
+    if (source.isNull())
     {
-        // Right-clicked on a "DataSeries" object
-
-        QString source_label = parent->text(1);
-        QString series_label = item->text(1);
-
-        auto source = manager->getSourceByLabel(source_label);
+        return;
+    }
 
-        if (source.isNull())
-        {
-            return;
-        }
+    QMenu menu(this);
 
-        auto series = source->getSeriesByLabel(series_label);
+    if (index.parent().isValid())
+    {
+        // Right-clicked on a "DataSeries" object
+        auto series = getSeries(index);
 
         if (series.isNull())
         {
@@ -133,6 +928,21 @@ void DataViewTree::onContextMenu(const QPoint &pos)
         // View data
         QAction *viewSeriesData = new QAction(tr("View Data"), &menu);
 
+        // Apply filter (to all selected series)
+        QMenu *filterMenu = new QMenu(tr("Apply Filter"), &menu);
+
+        QMap<QAction*, QSharedPointer<FilterPlugin>> filterActions;
+
+        for (auto filter : PluginRegistry::getInstance()->FilterPlugins())
+        {
+            QAction *filterAction = filterMenu->addAction(filter->pluginName());
+            filterAction->setToolTip(filter->pluginDescription());
+
+            filterActions[filterAction] = filter;
+        }
+
+        filterMenu->setEnabled(!filterActions.isEmpty());
+
         // Delete series
         QAction *deleteSeries = new QAction(tr("Delete Series"), &menu);
 
@@ -140,12 +950,24 @@ void DataViewTree::onContextMenu(const QPoint &pos)
         menu.addSeparator();
         menu.addAction(editSeries);
         menu.addAction(viewSeriesData);
+        menu.addMenu(filterMenu);
         menu.addSeparator();
         menu.addAction(deleteSeries);
 
         QAction *action = menu.exec(mapToGlobal(pos));
 
-        if (action == exportSeries)
+        if (filterActions.contains(action))
+        {
+            QModelIndexList indexes = selectionModel()->selectedRows();
+
+            if (!indexes.contains(index))
+            {
+                indexes = {index};
+            }
+
+            filterDataSeries(*filterActions[action], indexes);
+        }
+        else if (action == exportSeries)
         {
             QList<DataSeriesPointer> dataSeries;
             dataSeries << series;
@@ -159,6 +981,13 @@ void DataViewTree::onContextMenu(const QPoint &pos)
         else if (action == viewSeriesData)
         {
             DataSeriesTableView *table = new DataSeriesTableView(series);
+
+            table->setAttribute(Qt::WA_DeleteOnClose);
+
+            // Keep the selected row in sync with the plot cursor
+            connect(table, &DataSeriesTableView::timestampSelected, this, &DataViewTree::cursorTimestampSelected);
+            connect(this, &DataViewTree::cursorTimestampChanged, table, &DataSeriesTableView::setCursorTimestamp);
+
             table->show();
         }
         else if (action == deleteSeries)
@@ -170,29 +999,32 @@ void DataViewTree::onContextMenu(const QPoint &pos)
     else
     {
         // Right-clicked on a "DataSource" object
-        QString label = item->text(1);
 
-        auto source = manager->getSourceByLabel(label);
+        // Follow file
+        QAction *followSource = new QAction(tr("Follow File"), &menu);
 
-        if (source.isNull())
-        {
-            return;
-        }
+        followSource->setCheckable(true);
+        followSource->setChecked(manager->isFollowingSource(source));
+        followSource->setEnabled(manager->canFollowSource(source));
 
         // Delete source
         QAction *deleteSource = new QAction(tr("Delete Source"), &menu);
 
+        menu.addAction(followSource);
+        menu.addSeparator();
         menu.addAction(deleteSource);
 
         QAction *action = menu.exec(mapToGlobal(pos));
 
-        if (action == deleteSource)
+        if (action == followSource)
+        {
+            manager->followSource(source, !manager->isFollowingSource(source));
+        }
+        else if (action == deleteSource)
         {
             // Emit "removed" signal for each data series
-            for (auto label : source->getSeriesLabels())
+            for (auto series : source->getSeries())
             {
-                auto series = source->getSeriesByLabel(label);
-
                 if (series.isNull()) continue;
 
                 emit onSeriesRemoved(series);
@@ -207,26 +1039,14 @@ void DataViewTree::onContextMenu(const QPoint &pos)
 /*
  * Callback when user double-clicks on an item
  */
-void DataViewTree::onItemDoubleClicked(QTreeWidgetItem *item, int col)
+void DataViewTree::onItemDoubleClicked(const QModelIndex &index)
 {
-    Q_UNUSED(col);
-
-    if (!item) return;
-
-    auto *parent = item->parent();
-
-    auto *manager = DataSourceManager::getInstance();
+    if (!index.isValid()) return;
 
     // Double clicked on a DataSeries
-    if (parent)
+    if (index.parent().isValid())
     {
-        QString source_label = parent->text(1);
-        QString series_label = item->text(1);
-
-        auto series = manager->findSeries(source_label, series_label);
-
-        editDataSeries(series);
-
+        editDataSeries(getSeries(index));
     }
     else
     {
@@ -236,84 +1056,28 @@ void DataViewTree::onItemDoubleClicked(QTreeWidgetItem *item, int col)
 
 
 /*
- * Refresh (redraw) the tree, based on user filtering.
+ * Apply user filtering to the tree.
+ * The tree itself is updated automatically when the data sources change.
  */
 int DataViewTree::refresh(QString filters)
 {
-    setUpdatesEnabled(false);
-
-    setupTree();
-
     // Save the filter text
     filterString = filters;
 
-    auto *manager = DataSourceManager::getInstance();
+    bool filtered = m_filter.isFiltered();
 
-    int series_count = 0;
+    m_filter.setFilterString(filters);
 
-    for (int ii = 0; ii < manager->getSourceCount(); ii++)
+    // Sources which were hidden by the filter are collapsed when re-displayed
+    if (filtered || m_filter.isFiltered())
     {
-        auto source = manager->getSourceByIndex(ii);
-
-        if (source.isNull()) continue;
-
-        QStringList labels = source->getSeriesLabels(filters);
-
-        // Add a header item for this "data source"
-        QTreeWidgetItem *item = new QTreeWidgetItem();
-
-        QString uid = source->getIdentifier();
-
-        item->setText(1, source->getLabel());
-
-        // Embolden text for "source"
-        QFont font = item->font(1);
-        font.setBold(true);
-        item->setFont(1, font);
-
-        int idx = topLevelItemCount();
-
-        if (labels.isEmpty() && !filters.isEmpty())
+        for (int row = 0; row < m_filter.rowCount(); row++)
         {
-            continue;
+            expand(m_filter.index(row, 0));
         }
-
-        insertTopLevelItem(idx, item);
-
-        // Construct a flat list of childItems to add to the tree in a single operation
-        QList<QTreeWidgetItem*> childItems;
-
-        for (QString series_label : labels)
-        {
-            auto series = source->getSeriesByLabel(series_label);
-
-            if (series.isNull()) continue;
-
-            QTreeWidgetItem *child = new QTreeWidgetItem();
-
-            // Series label
-            child->setText(1, series->getLabel());
-            child->setToolTip(1, source->getLabel() + ":" + series->getLabel() + " (" + QString::number(series->size()) + " samples)");
-
-            QFont font = child->font(1);
-            font.setItalic(true);
-            child->setFont(1, font);
-
-            child->setBackground(0, series->getColor());
-
-            item->addChild(child);
-
-            series_count++;
-        }
-
-        item->addChildren(childItems);
     }
 
-    setUpdatesEnabled(true);
-
-    expandAll();
-
-    return series_count;
+    return m_filter.getMatchCount();
 }
 
 
@@ -323,23 +1087,24 @@ int DataViewTree::refresh(QString filters)
  */
 void DataViewTree::startDrag(Qt::DropActions supported_actions)
 {
-    auto items = selectedItems();
+    auto rows = selectionModel()->selectedRows();
 
     // Extract source / series information for each selected DataSeries item
     QStringList source_labels;
     QStringList series_labels;
 
-    for (auto *item : items)
+    for (const auto &index : rows)
     {
-        if (!item) continue;
+        // Prevent top-level items (data sources) from being dragged
+        if (!index.parent().isValid()) continue;
 
-        auto *parent = item->parent();
+        auto source = getSource(index);
+        auto series = getSeries(index);
 
-        // Prevent top-level items (data sources) from being dragged
-        if (!parent) continue;
+        if (source.isNull() || series.isNull()) continue;
 
-        source_labels << parent->text(1);
-        series_labels << item->text(1);
+        source_labels << source->getLabel();
+        series_labels << series->getLabel();
     }
 
     // Nothing draggable was selected (e.g. only data sources were selected)
@@ -1,11 +1,183 @@
 #ifndef DATAVIEW_TREE_HPP
 #define DATAVIEW_TREE_HPP
 
-#include <QTreeWidget>
+#include <QTreeView>
+#include <QAbstractItemModel>
+#include <QSortFilterProxyModel>
+#include <QRegularExpression>
+#include <QHash>
+#include <QSet>
 
-#include "data_series.hpp"
+#include <memory>
+#include <vector>
 
-class DataViewTree : public QTreeWidget
+#include "data_source.hpp"
+#include "plugin_filter.hpp"
+
+
+/**
+ * @brief The DataViewModel class presents the available data sources (and their series) as a two-level tree
+ *
+ * - Items are not constructed; display data are generated on demand for visible rows only
+ * - Series are populated lazily (in batches) as the view requests them (see fetchMore)
+ * - Changes to the data sources are applied incrementally, rather than rebuilding the tree
+ * - A (lowercase) label index of all series is maintained for fast filtering
+ */
+class DataViewModel : public QAbstractItemModel
+{
+    Q_OBJECT
+
+public:
+    enum Column
+    {
+        COLUMN_COLOR = 0,
+        COLUMN_LABEL,
+        COLUMN_COUNT,
+    };
+
+    //! Entry in the label index
+    struct LabelEntry
+    {
+        const DataSource *source;
+        const DataSeries *series;
+        QString key;
+    };
+
+    DataViewModel(QObject *parent = nullptr);
+
+    virtual QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const override;
+    virtual QModelIndex parent(const QModelIndex &index) const override;
+
+    virtual int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    virtual int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    virtual bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+
+    virtual QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    virtual QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    virtual Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+    virtual bool canFetchMore(const QModelIndex &parent) const override;
+    virtual void fetchMore(const QModelIndex &parent) override;
+
+    // Load all series for the source at the given row
+    void fetchAll(int row);
+
+    // Return the source (or the source of the series) at the given index
+    DataSourcePointer getSource(const QModelIndex &index) const;
+
+    // Return the series at the given index (null for source items)
+    DataSeriesPointer getSeries(const QModelIndex &index) const;
+
+    int getSeriesCount(void) const { return m_labelIndex.count(); }
+
+    const QVector<LabelEntry> &getLabelIndex(void) const { return m_labelIndex; }
+
+    // Return the position of a series in the label index (or -1)
+    int getLabelPosition(const DataSeries *series) const { return m_labelPositions.value(series, -1); }
+
+    //! Number of series populated per fetchMore() call
+    static const int FETCH_BATCH = 256;
+
+public slots:
+    // Apply any changes to the available sources and series
+    void sync(void);
+
+    // Re-read labels and display properties (e.g. after a series has been edited)
+    void refreshSeries(void);
+
+signals:
+    void labelIndexChanged(void);
+
+protected:
+    struct SourceNode
+    {
+        DataSourcePointer source;
+
+        //! All series in the source, and their (lowercase) labels
+        QVector<DataSeriesPointer> series;
+        QVector<QString> keys;
+
+        //! Number of series which have been populated
+        int fetched = 0;
+    };
+
+    std::vector<std::unique_ptr<SourceNode>> m_nodes;
+
+    QVector<LabelEntry> m_labelIndex;
+    QHash<const DataSeries*, int> m_labelPositions;
+
+    SourceNode *getNode(const QModelIndex &index) const;
+    int getNodeRow(const SourceNode *node) const;
+
+    bool syncSeries(int row);
+    void insertSeriesRow(SourceNode *node, const QModelIndex &parent, int row, DataSeriesPointer series);
+    void removeSeriesRow(SourceNode *node, const QModelIndex &parent, int row);
+
+    void rebuildLabelIndex(void);
+    void emitSeriesChanged(void);
+
+    static QString getLabelKey(const DataSeries *series) { return series->getLabel().toLower(); }
+};
+
+
+/**
+ * @brief The DataViewFilterModel class filters the DataViewModel by series label
+ *
+ * The filter string is split into (case-insensitive) terms, all of which must match.
+ * Terms may contain wildcards, otherwise a simple substring match is used.
+ *
+ * Matches are computed against the label index (not the tree), with candidates taken from
+ * the SeriesRegistry trigram index where possible. When the filter is narrowed
+ * (e.g. a character is typed) only the previous matches are re-tested.
+ */
+class DataViewFilterModel : public QSortFilterProxyModel
+{
+    Q_OBJECT
+
+public:
+    DataViewFilterModel(DataViewModel *model, QObject *parent = nullptr);
+
+    void setFilterString(QString filter);
+    QString getFilterString(void) const { return m_filterString; }
+
+    bool isFiltered(void) const { return !m_terms.isEmpty(); }
+
+    // Number of series which match the filter
+    int getMatchCount(void) const;
+
+protected slots:
+    void onLabelIndexChanged(void);
+
+protected:
+    struct FilterTerm
+    {
+        QString text;
+        bool wildcard = false;
+        QRegularExpression regex;
+    };
+
+    virtual bool filterAcceptsRow(int row, const QModelIndex &parent) const override;
+
+    static QList<FilterTerm> parseFilter(QString filter);
+    static bool isNarrowing(const QList<FilterTerm> &previous, const QList<FilterTerm> &terms);
+
+    bool matches(const QString &key) const;
+    void updateMatches(bool incremental);
+
+    DataViewModel *m_model;
+
+    QString m_filterString;
+    QList<FilterTerm> m_terms;
+
+    //! Label index entries which match the current filter
+    QVector<int> m_matchedEntries;
+
+    QSet<const DataSeries*> m_matches;
+    QHash<const DataSource*, int> m_sourceMatches;
+};
+
+
+class DataViewTree : public QTreeView
 {
     Q_OBJECT
 
@@ -16,19 +188,41 @@ public:
 public slots:
     int refresh(QString filters=QString());
 
-    void onItemDoubleClicked(QTreeWidgetItem *item, int col);
+    void onItemDoubleClicked(const QModelIndex &index);
     void onContextMenu(const QPoint &pos);
 
+    // Update the selected row of any open data tables (e.g. to follow the plot cursor)
+    void setCursorTimestamp(double t) { emit cursorTimestampChanged(t); }
+
 signals:
     void onSeriesRemoved(DataSeriesPointer series);
 
+    // Emitted when a row is selected in a data table
+    void cursorTimestampSelected(double t);
+
+    // Forwarded to open data tables
+    void cursorTimestampChanged(double t);
+
+protected slots:
+    void onRowsInserted(const QModelIndex &parent, int first, int last);
+
 protected:
     virtual void startDrag(Qt::DropActions supported_actions) override;
 
     void setupTree();
     void editDataSeries(DataSeriesPointer series);
 
+    // Apply a filter to the selected series, creating a derived series for each
+    void filterDataSeries(const FilterPlugin &filter, QModelIndexList indexes);
+
+    // Lookup functions for (filtered) view indices
+    DataSourcePointer getSource(const QModelIndex &index) const;
+    DataSeriesPointer getSeries(const QModelIndex &index) const;
+
     QString filterString;
+
+    DataViewModel m_model;
+    DataViewFilterModel m_filter;
 };
 
 
@@ -28,6 +28,8 @@ DataviewWidget::DataviewWidget(QWidget *parent) : QWidget(parent)
 
 void DataviewWidget::dropEvent(QDropEvent *event)
 {
+    QStringList filenames;
+
     for (const QUrl &url : event->mimeData()->urls())
     {
         const QString& filename = url.toLocalFile();
@@ -36,9 +38,15 @@ void DataviewWidget::dropEvent(QDropEvent *event)
 
         if (info.exists() && info.isFile())
         {
-            emit fileDropped(filename);
+            filenames.append(filename);
         }
     }
+
+    // Dropped files are imported together (concurrently)
+    if (!filenames.isEmpty())
+    {
+        emit filesDropped(filenames);
+    }
 }
 
 
@@ -23,7 +23,7 @@ public slots:
     void clearFilter(void);
 
 signals:
-    void fileDropped(QString filename);
+    void filesDropped(QStringList filenames);
 
 protected:
     Ui::dataview ui;
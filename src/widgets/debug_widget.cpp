@@ -1,15 +1,22 @@
+#include <qcolor.h>
 #include <qscrollbar.h>
 
+#include <algorithm>
+
 #include "debug_widget.hpp"
 
-#include "lumberjack_debug.hpp"
 #include "lumberjack_settings.hpp"
 
 
+const int DebugMessageModel::MAX_MESSAGES;
+
+
 DebugWidget::DebugWidget(QWidget *parent) : QWidget(parent)
 {
     ui.setupUi(this);
 
+    ui.debugList->setModel(&model);
+
     // Button callbacks
     connect(ui.clearAll, &QPushButton::released, this, &DebugWidget::clearDebugMessages);
 
@@ -49,8 +56,9 @@ void DebugWidget::debugPreferencesChanged()
     settings->saveSetting("debug", "showInfo", ui.showInfo->isChecked());
     settings->saveSetting("debug", "showDebug", ui.showDebug->isChecked());
 
-    ui.debugConsole->clear();
-    latestTimestamp = 0;
+    // Re-fetch all retained messages with the new filter
+    model.clear();
+    messageCursor = 0;
 
     updateDebugMessages();
 }
@@ -58,19 +66,68 @@ void DebugWidget::debugPreferencesChanged()
 
 void DebugWidget::updateDebugMessages()
 {
-    auto messages = getLumberjackDebugMessages(latestTimestamp);
+    auto messages = getLumberjackDebugMessages(messageCursor, getMessageMask());
+
+    if (messages.isEmpty()) return;
+
+    // Follow new messages, unless the user has scrolled up
+    QScrollBar *scroll = ui.debugList->verticalScrollBar();
+
+    bool atBottom = scroll->value() >= scroll->maximum();
 
-    for (auto &msg : messages)
+    model.appendMessages(messages);
+
+    if (atBottom)
     {
-        qint64 t = msg.timestamp;
+        ui.debugList->scrollToBottom();
+    }
+}
+
 
-        latestTimestamp = t;
+uint32_t DebugWidget::getMessageMask() const
+{
+    uint32_t mask = 0x00;
 
-        // Extract timestamp
-        QString text;
+    if (ui.showInfo->isChecked()) mask |= (1 << QtMsgType::QtInfoMsg);
+    if (ui.showDebug->isChecked()) mask |= (1 << QtMsgType::QtDebugMsg);
+    if (ui.showWarning->isChecked()) mask |= (1 << QtMsgType::QtWarningMsg);
+    if (ui.showCritical->isChecked()) mask |= (1 << QtMsgType::QtCriticalMsg);
+    if (ui.showFatal->isChecked()) mask |= (1 << QtMsgType::QtFatalMsg);
+
+    return mask;
+}
+
+
+void DebugWidget::clearDebugMessages()
+{
+    model.clear();
+    clearLumberjackDebugMessages();
+    updateDebugMessages();
+}
+
+
+int DebugMessageModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) return 0;
+
+    return (int) messages.size();
+}
+
+
+QVariant DebugMessageModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= (int) messages.size()) return QVariant();
+
+    const LumberjackDebugMessage &msg = messages[index.row()];
+
+    switch (role)
+    {
+    case Qt::DisplayRole:
+    {
+        qint64 t = msg.timestamp;
 
         // Milliseconds
-        text += "." + QString::number(t % 1000).rightJustified(3, '0');
+        QString text = "." + QString::number(t % 1000).rightJustified(3, '0');
         t /= 1000;
 
         // Seconds
@@ -84,64 +141,63 @@ void DebugWidget::updateDebugMessages()
         // Hours
         text = QString::number(t) + text;
 
-        text += " - ";
-        text += msg.message;
-        text += "<br>";
-
-        addDebugMessage(msg.messageType, text);
+        return text + " - " + msg.message;
+    }
+    case Qt::ForegroundRole:
+        switch (msg.messageType)
+        {
+        case QtMsgType::QtCriticalMsg:
+            return QColor(Qt::red);
+        case QtMsgType::QtFatalMsg:
+            return QColor(255, 165, 0);
+        case QtMsgType::QtWarningMsg:
+            return QColor(Qt::blue);
+        default:
+            return QColor(Qt::black);
+        }
+    default:
+        return QVariant();
     }
 }
 
 
-/*
- * Append a single debug message to the display
- */
-void DebugWidget::addDebugMessage(QtMsgType type, QString &msg)
+void DebugMessageModel::appendMessages(const QList<LumberjackDebugMessage> &incoming)
 {
-    QString color = "black";
+    if (incoming.isEmpty()) return;
 
-    switch (type)
+    // Remove the oldest messages, to keep the list bounded
+    int excess = (int) (messages.size() + incoming.size()) - MAX_MESSAGES;
+
+    if (excess > 0)
     {
-    case QtMsgType::QtCriticalMsg:
-        color = "red";
-        break;
-    case QtMsgType::QtFatalMsg:
-        color = "orange";
-        break;
-    case QtMsgType::QtWarningMsg:
-        color = "blue";
-        break;
-    case QtMsgType::QtInfoMsg:
-        color = "black";
-        break;
-    case QtMsgType::QtDebugMsg:
-        color = "black";
-        break;
-    default:
-        break;
+        excess = std::min(excess, (int) messages.size());
+
+        if (excess > 0)
+        {
+            beginRemoveRows(QModelIndex(), 0, excess - 1);
+            messages.erase(messages.begin(), messages.begin() + excess);
+            endRemoveRows();
+        }
     }
 
-    QString html;
-
-    html += "<font color='" + color + "'>";
-    html += msg;
-    html += "</font>";
+    // Only the newest messages are kept if more than MAX_MESSAGES arrive at once
+    int first = std::max(0, (int) incoming.size() - MAX_MESSAGES);
+    int row = (int) messages.size();
 
-    ui.debugConsole->insertHtml(html);
+    beginInsertRows(QModelIndex(), row, row + (int) incoming.size() - first - 1);
 
-    QTextCursor cursor = ui.debugConsole->textCursor();
-    cursor.movePosition(QTextCursor::End);
-
-    // Scroll to the bottom of the window
-    ui.debugConsole->verticalScrollBar()->setValue(ui.debugConsole->verticalScrollBar()->maximum());
+    for (int idx = first; idx < incoming.size(); idx++)
+    {
+        messages.push_back(incoming.at(idx));
+    }
 
-    QApplication::processEvents();
+    endInsertRows();
 }
 
 
-void DebugWidget::clearDebugMessages()
+void DebugMessageModel::clear()
 {
-    ui.debugConsole->clear();
-    clearLumberjackDebugMessages();
-    updateDebugMessages();
+    beginResetModel();
+    messages.clear();
+    endResetModel();
 }
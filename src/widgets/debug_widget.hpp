@@ -1,11 +1,43 @@
 #ifndef DEBUG_WIDGET_HPP
 #define DEBUG_WIDGET_HPP
 
+#include <QAbstractListModel>
 #include <QWidget>
 #include <qtimer.h>
 
+#include <deque>
+
+#include "lumberjack_debug.hpp"
+
 #include "ui_debug_widget.h"
 
+
+/**
+ * @brief The DebugMessageModel class provides the (bounded) list of displayed debug messages
+ *
+ * Messages are only formatted when displayed, so the view cost does not depend on the number of messages.
+ */
+class DebugMessageModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    DebugMessageModel(QObject *parent = nullptr) : QAbstractListModel(parent) {}
+
+    virtual int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    virtual QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    void appendMessages(const QList<LumberjackDebugMessage> &messages);
+    void clear(void);
+
+    //! Maximum number of messages displayed (older messages are removed)
+    static const int MAX_MESSAGES = 20000;
+
+protected:
+    std::deque<LumberjackDebugMessage> messages;
+};
+
+
 class DebugWidget : public QWidget
 {
     Q_OBJECT
@@ -22,11 +54,14 @@ public slots:
 protected:
     Ui::debugForm ui;
 
+    DebugMessageModel model;
+
     QTimer* updateTimer = nullptr;
 
-    qint64 latestTimestamp = 0;
+    //! Sequence number of the next message to fetch
+    uint64_t messageCursor = 0;
 
-    void addDebugMessage(QtMsgType type, QString &msg);
+    uint32_t getMessageMask(void) const;
 };
 
 #endif // DEBUG_WIDGET_HPP
@@ -0,0 +1,84 @@
+#include <QCheckBox>
+#include <QDialogButtonBox>
+#include <QDoubleSpinBox>
+#include <QSpinBox>
+
+#include "filter_options_dialog.hpp"
+
+
+FilterOptionsDialog::FilterOptionsDialog(const FilterPlugin &filter, QWidget *parent) :
+    QDialog(parent),
+    options(filter.getOptions())
+{
+    setWindowModality(Qt::ApplicationModal);
+    setWindowTitle(filter.pluginName());
+
+    layout = new QFormLayout(this);
+
+    for (auto it = options.constBegin(); it != options.constEnd(); ++it)
+    {
+        QWidget *editor = nullptr;
+
+        switch (it.value().userType())
+        {
+        case QMetaType::Bool:
+        {
+            QCheckBox *checkbox = new QCheckBox(this);
+            checkbox->setChecked(it.value().toBool());
+            editor = checkbox;
+            break;
+        }
+        case QMetaType::Int:
+        {
+            QSpinBox *spinbox = new QSpinBox(this);
+            spinbox->setRange(0, 1000000);
+            spinbox->setValue(it.value().toInt());
+            editor = spinbox;
+            break;
+        }
+        default:
+        {
+            QDoubleSpinBox *spinbox = new QDoubleSpinBox(this);
+            spinbox->setRange(-1e12, 1e12);
+            spinbox->setDecimals(6);
+            spinbox->setValue(it.value().toDouble());
+            editor = spinbox;
+            break;
+        }
+        }
+
+        editors[it.key()] = editor;
+        layout->addRow(it.key(), editor);
+    }
+
+    QDialogButtonBox *buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, this);
+
+    layout->addRow(buttons);
+
+    connect(buttons, &QDialogButtonBox::accepted, this, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, this, &QDialog::reject);
+}
+
+
+QVariantMap FilterOptionsDialog::getOptions() const
+{
+    QVariantMap result = options;
+
+    for (auto it = editors.constBegin(); it != editors.constEnd(); ++it)
+    {
+        if (auto *checkbox = qobject_cast<QCheckBox*>(it.value()))
+        {
+            result[it.key()] = checkbox->isChecked();
+        }
+        else if (auto *spinbox = qobject_cast<QSpinBox*>(it.value()))
+        {
+            result[it.key()] = spinbox->value();
+        }
+        else if (auto *spinbox = qobject_cast<QDoubleSpinBox*>(it.value()))
+        {
+            result[it.key()] = spinbox->value();
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,33 @@
+#ifndef FILTER_OPTIONS_DIALOG_HPP
+#define FILTER_OPTIONS_DIALOG_HPP
+
+#include <QDialog>
+#include <QFormLayout>
+#include <QMap>
+
+#include "plugin_filter.hpp"
+
+
+/**
+ * @brief The FilterOptionsDialog class allows the user to edit the options of a FilterPlugin
+ *
+ * An editor widget is generated for each option, based on the type of the option value.
+ */
+class FilterOptionsDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    FilterOptionsDialog(const FilterPlugin &filter, QWidget *parent = nullptr);
+
+    QVariantMap getOptions(void) const;
+
+protected:
+    QVariantMap options;
+
+    QFormLayout *layout = nullptr;
+
+    QMap<QString, QWidget*> editors;
+};
+
+#endif // FILTER_OPTIONS_DIALOG_HPP
@@ -109,15 +109,12 @@ void VariableRow::populateSeriesComboBox()
             continue;
         }
 
-        QStringList seriesLabels = source->getSeriesLabels();
-
         // Add each series from this source
-        for (const QString& seriesLabel : seriesLabels)
+        for (const DataSeriesPointer& series : source->getSeries())
         {
-            DataSeriesPointer series = source->getSeriesByLabel(seriesLabel);
             if (series && series->hasData())  // Only non-empty series
             {
-                QString displayText = source->getLabel() + " - " + seriesLabel;
+                QString displayText = source->getLabel() + " - " + series->getLabel();
                 comboSeries->addItem(displayText);
                 seriesMap[itemIndex] = series;  // Store pointer for retrieval
                 itemIndex++;
@@ -225,19 +222,11 @@ void MathTraceDialog::setEditMode(MathDataSeriesPointer series)
         row->setVariableName(varName);
 
         // Find the source for this series
-        DataSourceManager* manager = DataSourceManager::getInstance();
-        for (int i = 0; i < manager->getSourceCount(); ++i)
+        SeriesRegistry* registry = DataSourceManager::getInstance()->getRegistry();
+        const DataSource* source = registry->getSource(registry->getId(inputSeries.data()));
+        if (source)
         {
-            DataSourcePointer source = manager->getSourceByIndex(i);
-            if (source)
-            {
-                DataSeriesPointer foundSeries = source->getSeriesByLabel(inputSeries->getLabel());
-                if (foundSeries == inputSeries)
-                {
-                    row->setSelectedSeries(source->getLabel(), inputSeries->getLabel());
-                    break;
-                }
-            }
+            row->setSelectedSeries(source->getLabel(), inputSeries->getLabel());
         }
 
         connect(row, &VariableRow::deleteRequested, this, &MathTraceDialog::onDeleteVariable);
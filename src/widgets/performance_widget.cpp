@@ -0,0 +1,220 @@
+#include <QFileDialog>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QSplitter>
+#include <QVBoxLayout>
+
+#include "performance_widget.hpp"
+
+#include "data_source_manager.hpp"
+#include "performance_monitor.hpp"
+
+
+const int PerformanceWidget::UPDATE_INTERVAL;
+
+
+PerformanceWidget::PerformanceWidget(QWidget *parent) : QWidget(parent)
+{
+    QVBoxLayout *layout = new QVBoxLayout(this);
+
+    QHBoxLayout *controls = new QHBoxLayout();
+
+    enableCheck = new QCheckBox(tr("Enabled"), this);
+    enableCheck->setChecked(PerformanceMonitor::isEnabled());
+    connect(enableCheck, &QCheckBox::toggled, this, &PerformanceWidget::setMonitorEnabled);
+
+    droppedLabel = new QLabel(this);
+
+    QPushButton *resetButton = new QPushButton(tr("Reset"), this);
+    connect(resetButton, &QPushButton::released, this, &PerformanceWidget::reset);
+
+    QPushButton *exportButton = new QPushButton(tr("Export Trace..."), this);
+    connect(exportButton, &QPushButton::released, this, &PerformanceWidget::exportTrace);
+
+    controls->addWidget(enableCheck);
+    controls->addWidget(droppedLabel);
+    controls->addStretch();
+    controls->addWidget(resetButton);
+    controls->addWidget(exportButton);
+
+    statsTree = new QTreeWidget(this);
+    statsTree->setHeaderLabels(QStringList() << tr("Name") << tr("Detail") << tr("Count") << tr("Last") << tr("Mean") << tr("Min") << tr("Max"));
+    statsTree->setSortingEnabled(true);
+    statsTree->sortByColumn(0, Qt::AscendingOrder);
+
+    memoryTree = new QTreeWidget(this);
+    memoryTree->setHeaderLabels(QStringList() << tr("Series") << tr("Samples") << tr("Memory (MB)"));
+    memoryTree->setSortingEnabled(true);
+    memoryTree->sortByColumn(0, Qt::AscendingOrder);
+
+    QSplitter *splitter = new QSplitter(Qt::Vertical, this);
+
+    splitter->addWidget(statsTree);
+    splitter->addWidget(memoryTree);
+    splitter->setStretchFactor(0, 3);
+    splitter->setStretchFactor(1, 1);
+
+    layout->addLayout(controls);
+    layout->addWidget(splitter);
+
+    // Events are collected even while the widget is hidden, so that the thread buffers do not overflow
+    updateTimer.setInterval(UPDATE_INTERVAL);
+    connect(&updateTimer, &QTimer::timeout, this, &PerformanceWidget::refresh);
+    updateTimer.start();
+}
+
+
+void PerformanceWidget::refresh()
+{
+    PerformanceMonitor::getInstance()->collect();
+
+    if (!isVisible()) return;
+
+    updateStatistics();
+    updateMemory();
+}
+
+
+void PerformanceWidget::reset()
+{
+    PerformanceMonitor::getInstance()->reset();
+
+    statsTree->clear();
+    categoryItems.clear();
+    statItems.clear();
+
+    refresh();
+}
+
+
+void PerformanceWidget::exportTrace()
+{
+    QString filename = QFileDialog::getSaveFileName(
+                this,
+                tr("Export Trace"),
+                "lumberjack_trace.json",
+                tr("Trace files (*.json)"));
+
+    if (filename.isEmpty()) return;
+
+    auto *monitor = PerformanceMonitor::getInstance();
+
+    monitor->collect();
+
+    QStringList errors;
+
+    if (!monitor->exportTrace(filename, errors))
+    {
+        QMessageBox::warning(this, tr("Export Failed"), errors.join("\n"));
+    }
+}
+
+
+void PerformanceWidget::setMonitorEnabled(bool enabled)
+{
+    PerformanceMonitor::setEnabled(enabled);
+}
+
+
+/*
+ * Update the timing and counter statistics.
+ * Existing items are updated in place, so that selection and expansion are retained.
+ */
+void PerformanceWidget::updateStatistics()
+{
+    auto *monitor = PerformanceMonitor::getInstance();
+
+    statsTree->setSortingEnabled(false);
+
+    for (const auto &stat : monitor->getStatistics())
+    {
+        QString category = stat.name.section('/', 0, 0);
+        QString key = stat.name + '\n' + stat.detail;
+
+        QTreeWidgetItem *parent = categoryItems.value(category, nullptr);
+
+        if (!parent)
+        {
+            parent = new QTreeWidgetItem(statsTree, QStringList() << category);
+            parent->setExpanded(true);
+
+            categoryItems[category] = parent;
+        }
+
+        QTreeWidgetItem *item = statItems.value(key, nullptr);
+
+        if (!item)
+        {
+            item = new QTreeWidgetItem(parent);
+
+            item->setText(0, stat.name.section('/', 1));
+            item->setText(1, stat.detail);
+
+            for (int col = 2; col <= 6; col++)
+            {
+                item->setTextAlignment(col, Qt::AlignRight | Qt::AlignVCenter);
+            }
+
+            statItems[key] = item;
+        }
+
+        // Spans are displayed in ms
+        QString suffix = stat.type == PerformanceEvent::SPAN ? " ms" : QString();
+
+        item->setText(2, QString::number(stat.count));
+        item->setText(3, QString::number(stat.last, 'f', 3) + suffix);
+        item->setText(4, QString::number(stat.getMean(), 'f', 3) + suffix);
+        item->setText(5, QString::number(stat.minimum, 'f', 3) + suffix);
+        item->setText(6, QString::number(stat.maximum, 'f', 3) + suffix);
+    }
+
+    statsTree->setSortingEnabled(true);
+
+    uint64_t dropped = monitor->getDroppedCount();
+
+    droppedLabel->setText(dropped > 0 ? tr("%1 events dropped").arg(dropped) : QString());
+}
+
+
+void PerformanceWidget::updateMemory()
+{
+    auto *manager = DataSourceManager::getInstance();
+
+    memoryTree->setSortingEnabled(false);
+    memoryTree->clear();
+
+    for (int idx = 0; idx < manager->getSourceCount(); idx++)
+    {
+        auto source = manager->getSourceByIndex(idx);
+
+        if (source.isNull()) continue;
+
+        QTreeWidgetItem *sourceItem = new QTreeWidgetItem(memoryTree, QStringList() << source->getLabel());
+
+        uint64_t samples = 0;
+        uint64_t bytes = 0;
+
+        for (auto series : source->getSeries())
+        {
+            uint64_t n = series->size();
+            uint64_t b = series->getMemoryUsage();
+
+            QTreeWidgetItem *item = new QTreeWidgetItem(sourceItem);
+
+            item->setText(0, series->getLabel());
+            item->setText(1, QString::number(n));
+            item->setText(2, QString::number(b / (1024.0 * 1024.0), 'f', 2));
+
+            samples += n;
+            bytes += b;
+        }
+
+        sourceItem->setText(1, QString::number(samples));
+        sourceItem->setText(2, QString::number(bytes / (1024.0 * 1024.0), 'f', 2));
+        sourceItem->setExpanded(true);
+    }
+
+    memoryTree->setSortingEnabled(true);
+}
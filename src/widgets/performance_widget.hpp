@@ -0,0 +1,56 @@
+#ifndef PERFORMANCE_WIDGET_HPP
+#define PERFORMANCE_WIDGET_HPP
+
+#include <QCheckBox>
+#include <QHash>
+#include <QLabel>
+#include <QTimer>
+#include <QTreeWidget>
+#include <QWidget>
+
+
+/**
+ * @brief The PerformanceWidget class displays the statistics collected by the PerformanceMonitor
+ *
+ * - Timings and counters, grouped by category
+ * - Memory used by each series
+ *
+ * The widget also drives collection of events from the monitor,
+ * so it should exist (but need not be visible) for the lifetime of the application.
+ */
+class PerformanceWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    PerformanceWidget(QWidget *parent = nullptr);
+
+    //! Interval for collecting events from the monitor (ms)
+    static const int UPDATE_INTERVAL = 500;
+
+public slots:
+    void refresh(void);
+    void reset(void);
+    void exportTrace(void);
+
+protected slots:
+    void setMonitorEnabled(bool enabled);
+
+protected:
+    void updateStatistics(void);
+    void updateMemory(void);
+
+    QTreeWidget *statsTree = nullptr;
+    QTreeWidget *memoryTree = nullptr;
+
+    QCheckBox *enableCheck = nullptr;
+    QLabel *droppedLabel = nullptr;
+
+    //! Items in the statistics tree, by category and key
+    QHash<QString, QTreeWidgetItem*> categoryItems;
+    QHash<QString, QTreeWidgetItem*> statItems;
+
+    QTimer updateTimer;
+};
+
+#endif // PERFORMANCE_WIDGET_HPP
@@ -1,6 +1,5 @@
-#include <qelapsedtimer.h>
-
 #include "plot_sampler.hpp"
+#include "performance_monitor.hpp"
 
 
 
@@ -10,6 +9,20 @@ PlotCurveUpdater::PlotCurveUpdater(DataSeries &data_series) : QObject(), series(
 }
 
 
+/*
+ * Discard the cached sampling arguments,
+ * so that the curve is resampled even if the view has not changed
+ */
+void PlotCurveUpdater::invalidate()
+{
+    QMutexLocker lock(&mutex);
+
+    t_min_latest = -1;
+    t_max_latest = -1;
+    n_pixels_latest = 0;
+}
+
+
 /**
  * Re-sample the data for the provided data series, between the specified timestamps
  *
@@ -34,9 +47,8 @@ void PlotCurveUpdater::updateCurveSamples(double t_min, double t_max, unsigned i
     t_max_latest = t_max;
     n_pixels_latest = n_pixels;
 
-    // Profiling timer
-    QElapsedTimer elapsed;
-    elapsed.restart();
+    // Resample latency is recorded for each curve
+    PerformanceScope scope("Plot/Resample", series.getLabel());
 
     // Initialize empty arrays
     QVector<double> t_data;
@@ -52,6 +64,9 @@ void PlotCurveUpdater::updateCurveSamples(double t_min, double t_max, unsigned i
 
     const size_t N = series.size();
 
+    // Samples are read in chunks, rather than locking the series for each sample
+    DataSeriesReader reader(series);
+
     // Ensure that the timestamp values are ordered correctly
     if (t_min > t_max)
     {
@@ -87,14 +102,14 @@ void PlotCurveUpdater::updateCurveSamples(double t_min, double t_max, unsigned i
 
         if (sample_left)
         {
-            point = series.getDataPoint(idx_min - 1);
+            point = reader.at(idx_min - 1);
             t_data.push_back(point.timestamp);
             y_data.push_back(point.value);
         }
 
         for (auto idx = idx_min; (idx <= idx_max) && (idx < N); idx++)
         {
-            point = series.getDataPoint(idx);
+            point = reader.at(idx);
 
             t_data.push_back(point.timestamp);
             y_data.push_back(point.value);
@@ -102,7 +117,7 @@ void PlotCurveUpdater::updateCurveSamples(double t_min, double t_max, unsigned i
 
         if (sample_right)
         {
-            point = series.getDataPoint(idx_max + 1);
+            point = reader.at(idx_max + 1);
             t_data.push_back(point.timestamp);
             y_data.push_back(point.value);
         }
@@ -120,7 +135,7 @@ void PlotCurveUpdater::updateCurveSamples(double t_min, double t_max, unsigned i
 
     if (sample_left)
     {
-        point = series.getDataPoint(idx_min - 1);
+        point = reader.at(idx_min - 1);
         t_data.push_back(point.timestamp);
         y_data.push_back(point.value);
     }
@@ -128,13 +143,13 @@ void PlotCurveUpdater::updateCurveSamples(double t_min, double t_max, unsigned i
     // Time delta per pixel
     double dt = (t_max - t_min) / n_pixels;
 
-    double t = series.getTimestamp(idx_min);
+    double t = reader.getTimestamp(idx_min);
 
     // Pre-calculate the time of the "next" pixel
     double t_next = t + dt;
 
     // Construct pointers to raw samples to be added
-    DataPoint pt_first = series.getDataPoint(idx_min);
+    DataPoint pt_first = reader.at(idx_min);
     DataPoint pt_min = pt_first;
     DataPoint pt_max = pt_first;
     DataPoint pt_last = pt_first;
@@ -149,9 +164,41 @@ void PlotCurveUpdater::updateCurveSamples(double t_min, double t_max, unsigned i
     bool min_value_found = false;
     bool max_value_found = false;
 
+    // Block summaries (if available) allow entire blocks of samples to be skipped
+    bool use_summary = series.hasSummaryBlocks();
+    DataSummaryBlock block;
+
+    // Index of the first sample in the current pixel
+    uint64_t pixel_start_idx = idx_min;
+
     for (uint64_t idx = idx_min; idx <= idx_max; idx++)
     {
-        auto point = series.getDataPoint(idx);
+        // If an entire block falls within the current pixel, merge the block summary
+        if (use_summary &&
+            series.getSummaryBlock(idx, block) &&
+            block.first_index >= pixel_start_idx &&
+            block.first_index <= idx &&
+            block.last_index < idx_max &&
+            block.last.timestamp < t_next)
+        {
+            pt_counter += block.last_index - idx + 1;
+
+            if (block.min.value < pt_min.value)
+            {
+                pt_min = block.min;
+            }
+            if (block.max.value > pt_max.value)
+            {
+                pt_max = block.max;
+            }
+
+            pt_last = block.last;
+
+            idx = block.last_index;
+            continue;
+        }
+
+        auto point = reader.at(idx);
 
         if ((idx < idx_max) && (point.timestamp < t_next))
         {
@@ -262,13 +309,15 @@ void PlotCurveUpdater::updateCurveSamples(double t_min, double t_max, unsigned i
 
             // Reset point counter
             pt_counter = 1;
+
+            pixel_start_idx = idx;
         }
     }
 
     // If there is a point "off screen" to the right, add it
     if (sample_right)
     {
-        point = series.getDataPoint(idx_max + 1);
+        point = reader.at(idx_max + 1);
         t_data.push_back(point.timestamp);
         y_data.push_back(point.value);
     }
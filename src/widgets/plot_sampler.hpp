@@ -20,6 +20,9 @@ public:
 public slots:
     virtual void updateCurveSamples(double t_min, double t_max, unsigned int n_pixels);
 
+    // Force the next call to updateCurveSamples() to resample (e.g. when new data arrive)
+    void invalidate(void);
+
 signals:
     // Sampled data is returned
     void sampleComplete(const QVector<double>&, const QVector<double>&);
@@ -12,6 +12,7 @@ PluginsDialog::PluginsDialog(QWidget *parent) : QDialog(parent)
     ui.plugin_select->addItem(tr("Data Import"));
     ui.plugin_select->addItem(tr("Data Export"));
     ui.plugin_select->addItem(tr("Data Filter"));
+    ui.plugin_select->addItem(tr("Data Stream"));
 
     connect(ui.plugin_select, &QComboBox::currentIndexChanged, this, &PluginsDialog::selectPluginType);
     connect(ui.closeButton, &QPushButton::released, this, &PluginsDialog::close);
@@ -74,24 +75,30 @@ void PluginsDialog::selectPluginType(int idx)
 
     switch (idx)
     {
-    case 1:  // Importer plugins
+    case 0:  // Importer plugins
         for (auto plugin : registry->ImportPlugins())
         {
             plugins.append(plugin);
         }
         break;
-    case 2:  // Exporter plugins
+    case 1:  // Exporter plugins
         for (auto plugin : registry->ExportPlugins())
         {
             plugins.append(plugin);
         }
         break;
-    case 3: // Filter plugins
+    case 2: // Filter plugins
         for (auto plugin : registry->FilterPlugins())
         {
             plugins.append(plugin);
         }
         break;
+    case 3: // Stream plugins
+        for (auto plugin : registry->StreamPlugins())
+        {
+            plugins.append(plugin);
+        }
+        break;
     default:
         break;
     }
@@ -3,6 +3,7 @@
 #include <qwt_symbol.h>
 
 #include "series_editor_dialog.hpp"
+#include "data_source_manager.hpp"
 
 
 SeriesEditorDialog::SeriesEditorDialog(DataSeriesPointer s, QWidget *parent) : QDialog(parent), series(s)
@@ -130,6 +131,8 @@ void SeriesEditorDialog::save()
     if (ui.label_text->text().isEmpty()) return;
 
     series->setLabel(ui.label_text->text());
+
+    DataSourceManager::getInstance()->getRegistry()->updateSeries(series.data());
     series->setUnits(ui.units_text->text());
 
     series->setScaler(ui.scaling->value(), false);
@@ -1,11 +1,17 @@
 #include <qpainter.h>
 #include <qrect.h>
 
+#include <vector>
+#include <limits>
+#include <cmath>
+#include <algorithm>
+
 #include <qwt_abstract_scale_draw.h>
 #include <qwt_scale_widget.h>
 #include <qwt_scale_map.h>
 
 #include "timeline_widget.hpp"
+#include "data_source_manager.hpp"
 
 
 RangeMarker::RangeMarker()
@@ -42,6 +48,181 @@ void RangeMarker::draw(QPainter *painter,
 }
 
 
+TimelineThumbnail::TimelineThumbnail()
+{
+    setZ(-1);
+}
+
+
+void TimelineThumbnail::setImage(const QImage &image, const QwtInterval &interval)
+{
+    this->image = image;
+    this->interval = interval;
+}
+
+
+void TimelineThumbnail::draw(QPainter *painter,
+                             const QwtScaleMap &xMap,
+                             const QwtScaleMap &yMap,
+                             const QRectF &canvasRect) const
+{
+    Q_UNUSED(yMap);
+
+    if (image.isNull() || !interval.isValid()) return;
+
+    double x1 = xMap.transform(interval.minValue());
+    double x2 = xMap.transform(interval.maxValue());
+
+    QRectF target(x1, canvasRect.top(), x2 - x1, canvasRect.height());
+
+    painter->drawImage(target, image);
+}
+
+
+/**
+ * @brief TimelineThumbnailWorker::render - Render a thumbnail of the provided series
+ * @param series - Series to include in the thumbnail
+ * @param t_min - Start of the thumbnail interval
+ * @param t_max - End of the thumbnail interval
+ * @param request - Request number (used to abandon out-of-date renders)
+ */
+void TimelineThumbnailWorker::render(QList<TimelineThumbnailSeries> series, double t_min, double t_max, int request)
+{
+    QImage image = renderImage(series, t_min, t_max, request);
+
+    // Always emitted, so that the requester can release the series
+    emit thumbnailReady(image, t_min, t_max, request);
+}
+
+
+QImage TimelineThumbnailWorker::renderImage(const QList<TimelineThumbnailSeries> &series, double t_min, double t_max, int request) const
+{
+    if (isCancelled(request) || t_max <= t_min) return QImage();
+
+    const int W = THUMBNAIL_WIDTH;
+    const int H = THUMBNAIL_HEIGHT;
+
+    const double scale = (double) W / (t_max - t_min);
+
+    auto getBin = [&](double t) { return qBound(0, (int) ((t - t_min) * scale), W - 1); };
+
+    std::vector<double> density(W, 0);
+
+    QImage image(W, H, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+
+    QPainter painter(&image);
+
+    std::vector<double> binMin(W);
+    std::vector<double> binMax(W);
+
+    int envelopes = 0;
+
+    for (const auto &item : series)
+    {
+        const DataSeries *s = item.series;
+
+        if (!s || s->size() == 0) continue;
+
+        if (isCancelled(request)) return QImage();
+
+        std::fill(binMin.begin(), binMin.end(), std::numeric_limits<double>::quiet_NaN());
+        std::fill(binMax.begin(), binMax.end(), std::numeric_limits<double>::quiet_NaN());
+
+        double v_min = std::numeric_limits<double>::max();
+        double v_max = std::numeric_limits<double>::lowest();
+
+        auto accumulate = [&](int bin, double lo, double hi, uint64_t count)
+        {
+            density[bin] += count;
+
+            if (std::isnan(binMin[bin]) || lo < binMin[bin]) binMin[bin] = lo;
+            if (std::isnan(binMax[bin]) || hi > binMax[bin]) binMax[bin] = hi;
+
+            v_min = qMin(v_min, lo);
+            v_max = qMax(v_max, hi);
+        };
+
+        uint64_t idx = s->getIndexForTimestamp(t_min, DataSeries::SEARCH_RIGHT_TO_LEFT);
+        uint64_t end = std::min<uint64_t>(s->getIndexForTimestamp(t_max), s->size());
+
+        DataSummaryBlock block;
+
+        if (s->hasSummaryBlocks())
+        {
+            // Each block is accumulated into the bin at its midpoint
+            while (idx < end && s->getSummaryBlock(idx, block))
+            {
+                double t = (block.first.timestamp + block.last.timestamp) / 2;
+
+                accumulate(getBin(t), block.min.value, block.max.value, block.last_index - block.first_index + 1);
+
+                idx = block.last_index + 1;
+
+                if ((idx % (DataSeriesReader::DEFAULT_CHUNK_SIZE * 16)) == 0 && isCancelled(request)) return QImage();
+            }
+        }
+
+        DataSeriesReader reader(*s);
+
+        for (; idx < end; idx++)
+        {
+            const DataPoint &point = reader.at(idx);
+
+            accumulate(getBin(point.timestamp), point.value, point.value, 1);
+
+            if ((idx % (DataSeriesReader::DEFAULT_CHUNK_SIZE * 16)) == 0 && isCancelled(request)) return QImage();
+        }
+
+        if (envelopes >= MAX_ENVELOPES || v_max < v_min) continue;
+
+        envelopes++;
+
+        // Draw the envelope, normalized to the range of the series
+        double range = v_max > v_min ? v_max - v_min : 1;
+
+        QColor color = item.color;
+        color.setAlpha(160);
+
+        painter.setPen(QPen(color, 1));
+
+        for (int x = 0; x < W; x++)
+        {
+            if (std::isnan(binMin[x])) continue;
+
+            int y1 = H - 1 - (int) ((binMin[x] - v_min) / range * (H - 1));
+            int y2 = H - 1 - (int) ((binMax[x] - v_min) / range * (H - 1));
+
+            painter.drawLine(x, y1, x, y2);
+        }
+    }
+
+    // Shade the background according to (log-scaled) data density
+    double maxDensity = *std::max_element(density.begin(), density.end());
+
+    if (maxDensity > 0)
+    {
+        painter.setCompositionMode(QPainter::CompositionMode_DestinationOver);
+
+        for (int x = 0; x < W; x++)
+        {
+            if (density[x] <= 0) continue;
+
+            int alpha = 20 + (int) (80 * std::log1p(density[x]) / std::log1p(maxDensity));
+
+            painter.setPen(QPen(QColor(70, 110, 160, alpha), 1));
+            painter.drawLine(x, 0, x, H - 1);
+        }
+    }
+
+    painter.end();
+
+    if (isCancelled(request)) return QImage();
+
+    return image;
+}
+
+
 TimelineZoomer::TimelineZoomer(QWidget *parent) : QwtPlotZoomer(parent, true)
 {
     setMaxStackDepth(-1);
@@ -82,6 +263,9 @@ TimelineWidget::TimelineWidget(QWidget *parent) : QwtPlot(parent)
     axisScaleDraw(QwtPlot::xBottom)->enableComponent(QwtAbstractScaleDraw::Labels, false);
     axisScaleDraw(QwtPlot::xBottom)->enableComponent(QwtAbstractScaleDraw::Ticks, false);
 
+    // Initialize data thumbnail (drawn behind the range marker)
+    thumbnail.attach(this);
+
     // Initialize range marker rectangle
     rangeMarker.attach(this);
     rangeMarker.setInterval(QwtInterval(0, 1));
@@ -91,12 +275,97 @@ TimelineWidget::TimelineWidget(QWidget *parent) : QwtPlot(parent)
 
     connect(zoomer, &QwtPlotZoomer::zoomed, this, &TimelineWidget::onZoomed);
 
+    // Thumbnails are rendered in a background thread
+    worker = new TimelineThumbnailWorker();
+    worker->moveToThread(&workerThread);
+
+    connect(this, &TimelineWidget::renderRequested, worker, &TimelineThumbnailWorker::render);
+    connect(worker, &TimelineThumbnailWorker::thumbnailReady, this, &TimelineWidget::onThumbnailReady);
+
+    workerThread.start(QThread::LowPriority);
+
+    // Changes are grouped together, so the thumbnail is not re-rendered for every update
+    thumbnailTimer.setSingleShot(true);
+    thumbnailTimer.setInterval(THUMBNAIL_DELAY);
+
+    connect(&thumbnailTimer, &QTimer::timeout, this, &TimelineWidget::renderThumbnail);
+
+    connect(DataSourceManager::getInstance(), &DataSourceManager::sourcesChanged, this, &TimelineWidget::invalidateThumbnail);
 }
 
 
 TimelineWidget::~TimelineWidget()
 {
     zoomer->deleteLater();
+
+    // Abandon any running render, and wait for the thread to complete
+    worker->setLatestRequest(-1);
+
+    workerThread.quit();
+    workerThread.wait();
+
+    delete worker;
+}
+
+
+void TimelineWidget::invalidateThumbnail()
+{
+    thumbnailTimer.start();
+}
+
+
+/*
+ * Request a new thumbnail of all loaded series, over the current time limits
+ */
+void TimelineWidget::renderThumbnail()
+{
+    if (!timeLimits.isValid() || timeLimits.width() <= 0) return;
+
+    QList<DataSeriesPointer> series;
+
+    auto *manager = DataSourceManager::getInstance();
+
+    for (int ii = 0; ii < manager->getSourceCount(); ii++)
+    {
+        auto source = manager->getSourceByIndex(ii);
+
+        if (!source.isNull()) series.append(source->getSeries());
+    }
+
+    // The worker only reads the samples; colors are captured here
+    QList<TimelineThumbnailSeries> items;
+
+    for (auto s : series)
+    {
+        if (s.isNull()) continue;
+
+        TimelineThumbnailSeries item;
+
+        item.series = s.data();
+        item.color = s->getColor();
+
+        items.append(item);
+    }
+
+    renderRequest++;
+    worker->setLatestRequest(renderRequest);
+
+    renderSeries.insert(renderRequest, series);
+
+    emit renderRequested(items, timeLimits.minValue(), timeLimits.maxValue(), renderRequest);
+}
+
+
+void TimelineWidget::onThumbnailReady(QImage image, double t_min, double t_max, int request)
+{
+    // The worker has finished with the series for this request
+    renderSeries.remove(request);
+
+    if (request != renderRequest || image.isNull()) return;
+
+    thumbnail.setImage(image, QwtInterval(t_min, t_max));
+
+    replot();
 }
 
 
@@ -114,6 +383,12 @@ void TimelineWidget::updateTimeLimits(const QwtInterval &limits)
 {
     setAxisScale(QwtPlot::xBottom, limits.minValue(), limits.maxValue());
 
+    if (limits.minValue() != timeLimits.minValue() || limits.maxValue() != timeLimits.maxValue())
+    {
+        timeLimits = limits;
+        invalidateThumbnail();
+    }
+
     replot();
 }
 
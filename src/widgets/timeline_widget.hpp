@@ -1,11 +1,20 @@
 #ifndef TIMELINE_WIDGET_HPP
 #define TIMELINE_WIDGET_HPP
 
+#include <QHash>
+#include <QImage>
+#include <QThread>
+#include <QTimer>
+
+#include <atomic>
+
 #include <qwt_plot_item.h>
 #include <qwt_plot.h>
 #include <qwt_interval.h>
 #include <qwt_plot_zoomer.h>
 
+#include "data_series.hpp"
+
 
 /**
  * @brief The RangeMarker class is a custom QwtPlotItem to draw a rectangular section on the curve.
@@ -31,6 +40,86 @@ protected:
 
 
 
+/**
+ * @brief The TimelineThumbnail class draws a (cached) overview image of the loaded data
+ *
+ * The image covers a fixed time interval, and is simply scaled onto the canvas,
+ * so the timeline can be redrawn (e.g. when the view is panned) without reading any samples.
+ */
+class TimelineThumbnail : public QwtPlotItem
+{
+public:
+    TimelineThumbnail();
+
+    void setImage(const QImage &image, const QwtInterval &interval);
+
+    virtual void draw(QPainter *painter,
+                      const QwtScaleMap &xMap,
+                      const QwtScaleMap &yMap,
+                      const QRectF &canvasRect) const override;
+
+protected:
+    QImage image;
+    QwtInterval interval;
+};
+
+
+/**
+ * @brief The TimelineThumbnailSeries struct describes a single series to be rendered in the thumbnail
+ *
+ * The series is referenced (but not owned) by the worker,
+ * and the color is captured in the GUI thread when the render is requested.
+ */
+struct TimelineThumbnailSeries
+{
+    const DataSeries *series = nullptr;
+    QColor color;
+};
+
+
+/**
+ * @brief The TimelineThumbnailWorker class renders the timeline thumbnail in a background thread
+ *
+ * A single pass is made through each series, accumulating (per time bin):
+ * - The number of samples (data density), shaded as the background
+ * - The min / max envelope of each series (normalized to the range of that series)
+ *
+ * Series which provide summary blocks are processed per block, rather than per sample.
+ *
+ * The requesting thread must keep the series alive until thumbnailReady() is emitted for the request
+ * (it is emitted for every request, with a null image if the render was abandoned).
+ */
+class TimelineThumbnailWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Any render for an earlier request is abandoned (called from the GUI thread)
+    void setLatestRequest(int request) { latestRequest = request; }
+
+    //! Resolution of the thumbnail image
+    static const int THUMBNAIL_WIDTH = 2048;
+    static const int THUMBNAIL_HEIGHT = 64;
+
+    //! Maximum number of series envelopes drawn in the thumbnail
+    static const int MAX_ENVELOPES = 16;
+
+public slots:
+    void render(QList<TimelineThumbnailSeries> series, double t_min, double t_max, int request);
+
+signals:
+    void thumbnailReady(QImage image, double t_min, double t_max, int request);
+
+protected:
+    // Render the thumbnail image (returns a null image if the request is abandoned)
+    QImage renderImage(const QList<TimelineThumbnailSeries> &series, double t_min, double t_max, int request) const;
+
+    std::atomic<int> latestRequest {0};
+
+    bool isCancelled(int request) const { return request != latestRequest; }
+};
+
+
 /**
  * @brief The TimelineZoomer class is a custom implementation of QwtPlotZoomer
  *
@@ -56,19 +145,46 @@ public:
     TimelineWidget(QWidget *parent = nullptr);
     virtual ~TimelineWidget();
 
+    //! Delay before the thumbnail is re-rendered after a change (ms)
+    static const int THUMBNAIL_DELAY = 500;
+
 public slots:
     void updateTimeLimits(const QwtInterval &limits);
     void updateViewLimits(const QwtInterval &limits);
 
     void onZoomed(const QRectF &zoomRect);
 
+    // Schedule a re-render of the thumbnail (e.g. when data are loaded)
+    void invalidateThumbnail(void);
+
 signals:
     void timeUpdated(const QwtInterval &interval);
 
+    void renderRequested(QList<TimelineThumbnailSeries> series, double t_min, double t_max, int request);
+
+protected slots:
+    void renderThumbnail(void);
+    void onThumbnailReady(QImage image, double t_min, double t_max, int request);
+
 protected:
     RangeMarker rangeMarker;
+    TimelineThumbnail thumbnail;
 
     TimelineZoomer *zoomer = nullptr;
+
+    QwtInterval timeLimits;
+
+    TimelineThumbnailWorker *worker = nullptr;
+    QThread workerThread;
+
+    QTimer thumbnailTimer;
+
+    //! Most recent render request
+    int renderRequest = 0;
+
+    //! Series referenced by each outstanding render request
+    //! (held here so that a series is never released in the worker thread)
+    QHash<int, QList<DataSeriesPointer>> renderSeries;
 };
 
 #endif // TIMELINE_WIDGET_HPP
@@ -1,7 +1,18 @@
 #include <qtest.h>
 
 #include "test_series.hpp"
+#include "test_series_concurrency.hpp"
+#include "test_ring_series.hpp"
+#include "test_paged_series.hpp"
+#include "test_compressed_series.hpp"
 #include "test_source.hpp"
+#include "test_registry.hpp"
+#include "test_filter.hpp"
+#include "test_synthetic.hpp"
+#include "test_performance.hpp"
+#include "test_import_diagnostics.hpp"
+#include "test_data_batch.hpp"
+#include "test_debug.hpp"
 #include "test_curve.hpp"
 
 int main(int argc, char *argv[])
@@ -13,11 +24,66 @@ int main(int argc, char *argv[])
     DataSeriesTests test_series;
     result += QTest::qExec(&test_series, argc, argv);
 
+    qDebug() << "Running concurrency tests for DataSeries class";
+
+    DataSeriesConcurrencyTests test_series_concurrency;
+    result += QTest::qExec(&test_series_concurrency, argc, argv);
+
+    qDebug() << "Running unit tests for RingBufferDataSeries class";
+
+    RingBufferDataSeriesTests test_ring_series;
+    result += QTest::qExec(&test_ring_series, argc, argv);
+
+    qDebug() << "Running unit tests for PagedDataSeries class";
+
+    PagedDataSeriesTests test_paged_series;
+    result += QTest::qExec(&test_paged_series, argc, argv);
+
+    qDebug() << "Running unit tests for CompressedDataSeries class";
+
+    CompressedDataSeriesTests test_compressed_series;
+    result += QTest::qExec(&test_compressed_series, argc, argv);
+
     qDebug() << "Running unit tests for DataSource class";
 
     DataSourceTests test_source;
     result += QTest::qExec(&test_source, argc, argv);
 
+    qDebug() << "Running unit tests for SeriesRegistry class";
+
+    SeriesRegistryTests test_registry;
+    result += QTest::qExec(&test_registry, argc, argv);
+
+    qDebug() << "Running unit tests for FilterPipeline class";
+
+    FilterPipelineTests test_filter;
+    result += QTest::qExec(&test_filter, argc, argv);
+
+    qDebug() << "Running unit tests for synthetic data generator";
+
+    SyntheticDataTests test_synthetic;
+    result += QTest::qExec(&test_synthetic, argc, argv);
+
+    qDebug() << "Running unit tests for PerformanceMonitor class";
+
+    PerformanceMonitorTests test_performance;
+    result += QTest::qExec(&test_performance, argc, argv);
+
+    qDebug() << "Running unit tests for ImportDiagnostics class";
+
+    ImportDiagnosticsTests test_import_diagnostics;
+    result += QTest::qExec(&test_import_diagnostics, argc, argv);
+
+    qDebug() << "Running unit tests for DataBatch class";
+
+    DataBatchTests test_data_batch;
+    result += QTest::qExec(&test_data_batch, argc, argv);
+
+    qDebug() << "Running unit tests for debug message buffer";
+
+    DebugMessageTests test_debug;
+    result += QTest::qExec(&test_debug, argc, argv);
+
     qDebug() << "Running unit tests for PlotCurve class";
 
     PlotCurveTests test_curve;
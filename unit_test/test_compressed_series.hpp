@@ -0,0 +1,155 @@
+#ifndef TEST_COMPRESSED_SERIES_H
+#define TEST_COMPRESSED_SERIES_H
+
+#include <qobject.h>
+#include <qtest.h>
+
+#include <random>
+
+#include "compressed_data_series.hpp"
+
+class CompressedDataSeriesTests : public QObject
+{
+    Q_OBJECT
+
+public:
+    CompressedDataSeriesTests() : series("compressed series") {}
+
+    // Multiple full blocks, and a partial tail block
+    const uint64_t N = CompressedDataSeries::BLOCK_SAMPLES * 20 + 77;
+
+    // Uniform 10ms timestamps, with slowly varying (quantized) values
+    double timestamp(uint64_t idx) const { return 1e12 + idx * 10.0; }
+    double value(uint64_t idx) const { return ((idx / 100) % 50) * 0.25; }
+
+private slots:
+
+    void init(void)
+    {
+        series.clearData();
+
+        std::vector<DataPoint> points;
+
+        for (uint64_t idx = 0; idx < N; idx++)
+        {
+            points.push_back(DataPoint(timestamp(idx), value(idx)));
+        }
+
+        series.appendData(points);
+    }
+
+    void testStorage(void)
+    {
+        QCOMPARE(series.size(), N);
+        QCOMPARE(series.getBlockCount(), 20);
+
+        // Typical data should compress well
+        QVERIFY(series.getStorageBytes() * 3 < N * sizeof(DataPoint));
+    }
+
+    void testDataAccess(void)
+    {
+        for (uint64_t idx = 0; idx < N; idx += 37)
+        {
+            QCOMPARE(series.getTimestamp(idx), timestamp(idx));
+            QCOMPARE(series.getValue(idx), value(idx));
+        }
+
+        auto data = series.getData();
+
+        QCOMPARE(data.size(), N);
+        QCOMPARE(data.back().timestamp, timestamp(N - 1));
+    }
+
+    // Encoding must be exact for arbitrary timestamps and values
+    void testLossless(void)
+    {
+        CompressedDataSeries random("random");
+
+        std::mt19937_64 generator(1234);
+        std::normal_distribution<double> distribution;
+
+        std::vector<DataPoint> points;
+
+        double t = -5000;
+
+        for (int idx = 0; idx < 10000; idx++)
+        {
+            t += std::abs(distribution(generator));
+            points.push_back(DataPoint(t, distribution(generator) * 1e3));
+        }
+
+        random.appendData(points);
+
+        auto data = random.getData();
+
+        QCOMPARE(data.size(), points.size());
+
+        for (size_t idx = 0; idx < points.size(); idx++)
+        {
+            QCOMPARE(data[idx].timestamp, points[idx].timestamp);
+            QCOMPARE(data[idx].value, points[idx].value);
+        }
+    }
+
+    void testIndexSearch(void)
+    {
+        QCOMPARE(series.getIndexForTimestamp(0), 0);
+        QCOMPARE(series.getIndexForTimestamp(timestamp(N + 10)), N);
+
+        for (uint64_t idx = 1000; idx < N; idx += 1234)
+        {
+            QCOMPARE(series.getIndexForTimestamp(timestamp(idx) + 0.5), idx + 1);
+            QCOMPARE(series.getIndexForTimestamp(timestamp(idx), DataSeries::SEARCH_RIGHT_TO_LEFT), idx);
+        }
+    }
+
+    void testSummary(void)
+    {
+        DataSummaryBlock block;
+
+        QVERIFY(series.getSummaryBlock(CompressedDataSeries::BLOCK_SAMPLES + 5, block));
+        QCOMPARE(block.first_index, CompressedDataSeries::BLOCK_SAMPLES);
+        QCOMPARE(block.last_index, 2 * CompressedDataSeries::BLOCK_SAMPLES - 1);
+
+        // No summary for the tail block
+        QVERIFY(!series.getSummaryBlock(N - 1, block));
+
+        QCOMPARE(series.getMaximumValue(), 12.25);
+    }
+
+    // Out-of-order samples are merged into the compressed blocks
+    void testOutOfOrder(void)
+    {
+        series.addData(timestamp(5) + 1, 123);
+
+        QCOMPARE(series.size(), N + 1);
+        QCOMPARE(series.getValue(6), 123);
+        QCOMPARE(series.getTimestamp(7), timestamp(6));
+        QCOMPARE(series.getNewestTimestamp(), timestamp(N - 1));
+    }
+
+    void testClip(void)
+    {
+        double t_min = timestamp(3000);
+        double t_max = timestamp(9000);
+
+        series.clipTimeRange(t_min, t_max);
+
+        QCOMPARE(series.size(), 6001);
+        QCOMPARE(series.getOldestTimestamp(), t_min);
+        QCOMPARE(series.getNewestTimestamp(), t_max);
+
+        // Blocks before the clipped region are released
+        QVERIFY(series.getBlockCount() < 9);
+
+        series.addData(t_max + 10, 1);
+        QCOMPARE(series.getNewestTimestamp(), t_max + 10);
+    }
+
+protected:
+
+    CompressedDataSeries series;
+};
+
+#endif // TEST_COMPRESSED_SERIES_H
@@ -0,0 +1,141 @@
+#ifndef TEST_DATA_BATCH_HPP
+#define TEST_DATA_BATCH_HPP
+
+#include <math.h>
+
+#include <qobject.h>
+#include <qtest.h>
+
+#include "data_batch.hpp"
+#include "float32_data_series.hpp"
+#include "plugin_importer.hpp"
+
+
+/*
+ * Minimal importer which exposes the columnar batch interface
+ */
+class BatchTestImporter : public ImportPlugin
+{
+public:
+    BatchTestImporter()
+    {
+        // Float32 columns are stored in Float32 series
+        setSeriesFactory([](QString label, DataSeries::ValuePrecision precision) {
+            if (precision == DataSeries::PRECISION_FLOAT)
+            {
+                return DataSeriesPointer(new Float32DataSeries(label));
+            }
+
+            return DataSeriesPointer(new DataSeries(label));
+        });
+    }
+
+    virtual QString pluginName(void) const override { return "Batch Test"; }
+    virtual QString pluginDescription(void) const override { return QString(); }
+    virtual QString pluginVersion(void) const override { return "0.0.0"; }
+
+    virtual QStringList supportedFileTypes(void) const override { return QStringList(); }
+    virtual bool importData(QStringList &errors) override { Q_UNUSED(errors); return false; }
+    virtual void cancelImport(void) override {}
+    virtual uint8_t getImportProgress(void) const override { return 0; }
+    virtual QList<DataSeriesPointer> getDataSeries(void) const override { return getBatchSeries(); }
+
+    using ImportPlugin::m_batch;
+    using ImportPlugin::ingestBatch;
+    using ImportPlugin::resetBatch;
+};
+
+
+class DataBatchTests : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testSchema(void)
+    {
+        DataBatch batch;
+
+        QCOMPARE(batch.addColumn("speed", "m/s"), 0);
+        QCOMPARE(batch.addColumn("temp", "C", DataBatchColumn::DTYPE_FLOAT32), 1);
+
+        QCOMPARE(batch.getColumnCount(), 2);
+        QCOMPARE(batch.getColumn(0).label, QString("speed"));
+        QCOMPARE(batch.getColumn(1).units, QString("C"));
+
+        QCOMPARE(batch.getColumn(0).getPrecision(), DataSeries::PRECISION_DOUBLE);
+        QCOMPARE(batch.getColumn(1).getPrecision(), DataSeries::PRECISION_FLOAT);
+
+        // Mismatched column count
+        QVERIFY(!batch.addChunk({1, 2, 3}, {{1, 2, 3}}));
+
+        // Mismatched column length
+        QVERIFY(!batch.addChunk({1, 2, 3}, {{1, 2, 3}, {1, 2}}));
+
+        QCOMPARE(batch.getPendingSamples(), 0);
+
+        QVERIFY(batch.addChunk({1, 2, 3}, {{1, 2, 3}, {4, 5, 6}}));
+
+        QCOMPARE(batch.getPendingSamples(), 3);
+
+        batch.clear();
+
+        QCOMPARE(batch.getColumnCount(), 0);
+        QCOMPARE(batch.getPendingSamples(), 0);
+    }
+
+    void testIngest(void)
+    {
+        BatchTestImporter importer;
+
+        importer.m_batch.addColumn("speed", "m/s");
+        importer.m_batch.addColumn("temp", "C", DataBatchColumn::DTYPE_FLOAT32);
+
+        // NaN values indicate that a column has no sample at that timestamp
+        QVERIFY(importer.m_batch.addChunk({0, 1, 2, 3}, {{0, 10, NAN, 30}, {NAN, 1.5, 2.5, 3.5}}));
+        QVERIFY(importer.m_batch.addChunk({4, 5}, {{40, 50}, {4.5, NAN}}));
+
+        // Chunk which does not match the schema is rejected
+        QVERIFY(!importer.m_batch.addChunk({6, 7}, {{60, 70}}));
+
+        QCOMPARE(importer.m_batch.getPendingSamples(), 6);
+
+        importer.ingestBatch();
+
+        // Pending chunks are released once ingested
+        QCOMPARE(importer.m_batch.getPendingSamples(), 0);
+        QVERIFY(importer.m_batch.takeChunks().empty());
+
+        auto series = importer.getDataSeries();
+
+        QCOMPARE(series.count(), 2);
+
+        QCOMPARE(series[0]->getLabel(), QString("speed"));
+        QCOMPARE(series[0]->getUnits(), QString("m/s"));
+        QVERIFY(qobject_cast<Float32DataSeries*>(series[0].data()) == nullptr);
+        QVERIFY(qobject_cast<Float32DataSeries*>(series[1].data()) != nullptr);
+
+        QCOMPARE(series[0]->size(), 5);
+        QCOMPARE(series[0]->getTimestamp(2), 3);
+        QCOMPARE(series[0]->getValue(4), 50);
+
+        QCOMPARE(series[1]->size(), 4);
+        QCOMPARE(series[1]->getTimestamp(0), 1);
+        QCOMPARE(series[1]->getValue(3), 4.5);
+
+        // Subsequent chunks are appended to the same series
+        QVERIFY(importer.m_batch.addChunk({6}, {{60}, {6.5}}));
+
+        importer.ingestBatch();
+
+        QCOMPARE(importer.getDataSeries().count(), 2);
+        QCOMPARE(series[0]->size(), 6);
+        QCOMPARE(series[1]->getNewestValue(), 6.5);
+
+        importer.resetBatch();
+
+        QCOMPARE(importer.getDataSeries().count(), 0);
+        QCOMPARE(importer.m_batch.getColumnCount(), 0);
+    }
+};
+
+#endif // TEST_DATA_BATCH_HPP
@@ -0,0 +1,200 @@
+#ifndef TEST_DEBUG_HPP
+#define TEST_DEBUG_HPP
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <qobject.h>
+#include <qtest.h>
+
+#include "lumberjack_debug.hpp"
+
+
+/*
+ * Tests for the debug message ring.
+ *
+ * Messages are passed directly to the handler, so that the QTest message handler is not replaced.
+ */
+class DebugMessageTests : public QObject
+{
+    Q_OBJECT
+
+private:
+    static void log(QtMsgType type, const QString &message)
+    {
+        lumberjackDebugHandler(type, QMessageLogContext(), message);
+    }
+
+    // Message text for the given producer and index, padded so that a torn copy can be detected
+    static QString producerMessage(int producer, int index)
+    {
+        return QString("%1:%2:").arg(producer).arg(index) + QString(200, QChar('a' + producer));
+    }
+
+private slots:
+    void init(void)
+    {
+        clearLumberjackDebugMessages();
+    }
+
+    // Each call returns only the messages logged since the previous call
+    void testCursor(void)
+    {
+        uint64_t cursor = 0;
+
+        log(QtDebugMsg, "one");
+        log(QtWarningMsg, "two");
+        log(QtDebugMsg, "three");
+
+        auto messages = getLumberjackDebugMessages(cursor);
+
+        QCOMPARE(messages.count(), 3);
+        QCOMPARE(messages.at(0).message, QString("one"));
+        QCOMPARE(messages.at(1).messageType, QtWarningMsg);
+        QCOMPARE(messages.at(2).sequence, messages.at(0).sequence + 2);
+
+        QVERIFY(getLumberjackDebugMessages(cursor).isEmpty());
+
+        log(QtWarningMsg, "four");
+        log(QtDebugMsg, "five");
+
+        // Filter by message type
+        messages = getLumberjackDebugMessages(cursor, 1 << QtWarningMsg);
+
+        QCOMPARE(messages.count(), 1);
+        QCOMPARE(messages.at(0).message, QString("four"));
+
+        // The cursor advances past filtered messages
+        QVERIFY(getLumberjackDebugMessages(cursor).isEmpty());
+    }
+
+    void testClear(void)
+    {
+        uint64_t cursor = 0;
+
+        log(QtDebugMsg, "before");
+
+        clearLumberjackDebugMessages();
+
+        QVERIFY(getLumberjackDebugMessages(cursor).isEmpty());
+
+        log(QtDebugMsg, "after");
+
+        auto messages = getLumberjackDebugMessages(cursor);
+
+        QCOMPARE(messages.count(), 1);
+        QCOMPARE(messages.at(0).message, QString("after"));
+    }
+
+    // The oldest messages are overwritten, and long messages are truncated
+    void testWraparound(void)
+    {
+        uint64_t cursor = 0;
+
+        const int N = LUMBERJACK_DEBUG_CAPACITY + 100;
+
+        for (int ii = 0; ii < N; ii++)
+        {
+            log(QtDebugMsg, QString("msg %1").arg(ii));
+        }
+
+        auto messages = getLumberjackDebugMessages(cursor);
+
+        QCOMPARE(messages.count(), (int) LUMBERJACK_DEBUG_CAPACITY);
+        QCOMPARE(messages.first().message, QString("msg 100"));
+        QCOMPARE(messages.last().message, QString("msg %1").arg(N - 1));
+
+        for (int ii = 1; ii < messages.count(); ii++)
+        {
+            QCOMPARE(messages.at(ii).sequence, messages.at(ii - 1).sequence + 1);
+        }
+
+        // Multi-byte characters are not split when truncated
+        log(QtDebugMsg, QString(LUMBERJACK_DEBUG_MESSAGE_LENGTH, QChar(0x00E9)));
+
+        messages = getLumberjackDebugMessages(cursor);
+
+        QCOMPARE(messages.count(), 1);
+        QCOMPARE(messages.at(0).message, QString(LUMBERJACK_DEBUG_MESSAGE_LENGTH / 2, QChar(0x00E9)));
+    }
+
+    // Messages are logged from several threads while being read
+    void testConcurrentProducers(void)
+    {
+        const int PRODUCERS = 4;
+        const int COUNT = 2000;
+
+        std::atomic<bool> done {false};
+        std::atomic<int> errors {0};
+        std::atomic<int> received {0};
+
+        std::thread reader([&]() {
+            uint64_t cursor = 0;
+            uint64_t sequence = 0;
+
+            std::vector<int> last(PRODUCERS, -1);
+
+            while (true)
+            {
+                bool finished = done.load();
+
+                for (const auto &msg : getLumberjackDebugMessages(cursor))
+                {
+                    QStringList parts = msg.message.split(":");
+
+                    int producer = parts.value(0).toInt();
+                    int index = parts.value(1).toInt();
+
+                    bool valid = parts.count() == 3 && producer >= 0 && producer < PRODUCERS &&
+                                 msg.message == producerMessage(producer, index);
+
+                    // Messages from each producer are in order (some may have been overwritten)
+                    if (!valid || index <= last[producer] || msg.sequence < sequence)
+                    {
+                        errors++;
+                        continue;
+                    }
+
+                    last[producer] = index;
+                    sequence = msg.sequence;
+
+                    received++;
+                }
+
+                if (finished) break;
+            }
+        });
+
+        std::vector<std::thread> producers;
+
+        for (int p = 0; p < PRODUCERS; p++)
+        {
+            producers.push_back(std::thread([p]() {
+                for (int ii = 0; ii < COUNT; ii++)
+                {
+                    log(QtDebugMsg, producerMessage(p, ii));
+                }
+            }));
+        }
+
+        for (auto &producer : producers)
+        {
+            producer.join();
+        }
+
+        done = true;
+
+        reader.join();
+
+        QCOMPARE(errors.load(), 0);
+        QVERIFY(received.load() > 0);
+
+        // All of the retained messages are available once the producers have finished
+        uint64_t cursor = 0;
+
+        QCOMPARE(getLumberjackDebugMessages(cursor).count(), (int) LUMBERJACK_DEBUG_CAPACITY);
+    }
+};
+
+#endif // TEST_DEBUG_HPP
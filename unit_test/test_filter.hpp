@@ -0,0 +1,226 @@
+#ifndef TEST_FILTER_HPP
+#define TEST_FILTER_HPP
+
+#include <qobject.h>
+#include <qtest.h>
+
+#include <math.h>
+
+#include "filter_pipeline.hpp"
+#include "filtered_data_series.hpp"
+#include "offset_filter/offset_filter.hpp"
+#include "scaler_filter/scaler_filter.hpp"
+#include "signal_filters/butterworth_filter.hpp"
+#include "signal_filters/decimate_filter.hpp"
+#include "signal_filters/fir_filter.hpp"
+#include "signal_filters/median_filter.hpp"
+
+
+class FilterPipelineTests : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testKernels(void)
+    {
+        double timestamps[] = {1, 2, 3, 4};
+        double values[] = {10, 20, 30, 40};
+
+        FilterPipeline pipeline;
+
+        pipeline.append(ScalerFilter(2));
+        pipeline.append(OffsetFilter(-5));
+
+        QVERIFY(pipeline.isStateless());
+        QVERIFY(pipeline.isParallelSafe());
+
+        QCOMPARE(pipeline.process(timestamps, values, 4), (size_t) 4);
+
+        QCOMPARE(values[0], 15.0);
+        QCOMPARE(values[3], 75.0);
+        QCOMPARE(timestamps[3], 4.0);
+
+        // Copies of the pipeline are independent
+        FilterPipeline copy(pipeline);
+
+        QCOMPARE(copy.count(), 2);
+        QVERIFY(copy.getFilters().at(0) != pipeline.getFilters().at(0));
+    }
+
+    void testLazySeries(void)
+    {
+        DataSeriesPointer source(new DataSeries("Source"));
+
+        for (int ii = 0; ii < 1000; ii++)
+        {
+            source->addData(ii, ii, false);
+        }
+
+        FilterPipeline pipeline;
+        pipeline.append(OffsetFilter(100));
+
+        DataSeriesPointer lazy = pipeline.createSeries(source);
+        DataSeriesPointer materialized = pipeline.createSeries(source, true);
+
+        QVERIFY(qobject_cast<FilteredDataSeries*>(lazy.data()));
+        QVERIFY(!qobject_cast<FilteredDataSeries*>(materialized.data()));
+
+        QCOMPARE(lazy->size(), (size_t) 1000);
+        QCOMPARE(materialized->size(), (size_t) 1000);
+
+        QCOMPARE(lazy->getValue(500), 600.0);
+        QCOMPARE(materialized->getValue(500), 600.0);
+        QCOMPARE(lazy->getIndexForTimestamp(500.5), (uint64_t) 501);
+
+        // Changes to the source are visible through the lazy series
+        source->addData(1000, 1000);
+
+        QCOMPARE(lazy->size(), (size_t) 1001);
+        QCOMPARE(lazy->getNewestValue(), 1100.0);
+    }
+
+    void testParallelApply(void)
+    {
+        DataSeries source;
+
+        const int N = FilterPipeline::MIN_SAMPLES_PER_THREAD * 4;
+
+        for (int ii = 0; ii < N; ii++)
+        {
+            source.addData(ii, ii % 100, false);
+        }
+
+        FilterPipeline pipeline;
+        pipeline.append(ScalerFilter(0.5));
+
+        DataSeries serial;
+        DataSeries parallel;
+
+        pipeline.apply(source, serial, 1);
+        pipeline.apply(source, parallel, 4);
+
+        QCOMPARE(serial.size(), (size_t) N);
+        QCOMPARE(parallel.size(), (size_t) N);
+
+        for (int ii = 0; ii < N; ii += 997)
+        {
+            QCOMPARE(parallel.getTimestamp(ii), serial.getTimestamp(ii));
+            QCOMPARE(parallel.getValue(ii), (ii % 100) * 0.5);
+        }
+    }
+
+    void testSignalFilters(void)
+    {
+        // 1kHz samples: 5Hz signal with 200Hz interference
+        DataSeriesPointer source(new DataSeries("Vibration"));
+
+        const int N = 10000;
+
+        for (int ii = 0; ii < N; ii++)
+        {
+            double t = ii / 1000.0;
+
+            source->addData(ii, sin(2 * M_PI * 5 * t) + 0.5 * sin(2 * M_PI * 200 * t), false);
+        }
+
+        auto residual = [&](DataSeriesPointer filtered, double delay)
+        {
+            // Maximum deviation from the 5Hz signal (after the initial transient)
+            double error = 0;
+
+            for (uint64_t ii = N / 2; ii < filtered->size(); ii++)
+            {
+                double t = (filtered->getTimestamp(ii) - delay) / 1000.0;
+                error = qMax(error, fabs(filtered->getValue(ii) - sin(2 * M_PI * 5 * t)));
+            }
+
+            return error;
+        };
+
+        auto amplitude = [&](DataSeriesPointer filtered)
+        {
+            // IIR filters delay the signal, so only the amplitude is compared
+            double peak = 0;
+
+            for (uint64_t ii = filtered->size() / 2; ii < filtered->size(); ii++)
+            {
+                peak = qMax(peak, fabs(filtered->getValue(ii)));
+            }
+
+            return peak;
+        };
+
+        ButterworthFilter butterworth;
+        QVERIFY(butterworth.setOptions({{"cutoff", 20.0}, {"order", 4}}));
+        QVERIFY(!butterworth.setOptions({{"cutoff", 600.0}, {"sampleRate", 1000.0}}));
+
+        FilterPipeline lowpass;
+        lowpass.append(butterworth);
+
+        QVERIFY(!lowpass.isStateless());
+
+        DataSeriesPointer filtered = lowpass.createSeries(source);
+
+        QCOMPARE(filtered->size(), (size_t) N);
+        QVERIFY(amplitude(source) > 1.4);
+        QVERIFY(qAbs(amplitude(filtered) - 1) < 0.05);
+
+        FIRFilter fir;
+        QVERIFY(fir.setOptions({{"taps", 101}, {"cutoff", 20.0}}));
+
+        FilterPipeline firpass;
+        firpass.append(fir);
+
+        // Linear phase filter delays the signal by (taps - 1) / 2 samples
+        QVERIFY(residual(firpass.createSeries(source), 50) < 0.1);
+
+        // Median filter removes an isolated spike
+        DataSeriesPointer spiky(new DataSeries("Spiky"));
+
+        for (int ii = 0; ii < 100; ii++)
+        {
+            spiky->addData(ii, ii == 50 ? 1000 : 1, false);
+        }
+
+        FilterPipeline median;
+        median.append(MedianFilter(5));
+
+        QCOMPARE(median.createSeries(spiky)->getMaximumValue(), 1.0);
+
+        // Non-finite samples are passed through, and are not added to the window
+        double medianTimestamps[] = {0, 1, 2, 3, 4, 5, 6};
+        double medianValues[] = {1, NAN, 3, INFINITY, 2, 5, NAN};
+
+        FilterPipeline windowed;
+        windowed.append(MedianFilter(3));
+
+        QCOMPARE(windowed.process(medianTimestamps, medianValues, 7), (size_t) 7);
+
+        QCOMPARE(medianValues[0], 1.0);
+        QVERIFY(qIsNaN(medianValues[1]));
+        QCOMPARE(medianValues[2], 2.0);
+        QVERIFY(qIsInf(medianValues[3]));
+        QCOMPARE(medianValues[4], 2.0);
+        QCOMPARE(medianValues[5], 3.0);
+        QVERIFY(qIsNaN(medianValues[6]));
+
+        // Decimation retains every Nth sample
+        FilterPipeline decimate;
+        decimate.append(DecimateFilter(10));
+
+        DataSeriesPointer decimated = decimate.createSeries(source);
+
+        QCOMPARE(decimated->size(), (size_t) N / 10);
+        QCOMPARE(decimated->getTimestamp(1), 10.0);
+        QVERIFY(qAbs(amplitude(decimated) - 1) < 0.05);
+
+        // Multiple channels are filtered independently
+        QList<DataSeriesPointer> outputs = lowpass.createSeries({source, spiky, source});
+
+        QCOMPARE(outputs.count(), 3);
+        QCOMPARE(outputs.at(1)->size(), (size_t) 100);
+        QCOMPARE(outputs.at(0)->getValue(N - 1), outputs.at(2)->getValue(N - 1));
+    }
+};
+
+#endif // TEST_FILTER_HPP
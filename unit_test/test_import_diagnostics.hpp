@@ -0,0 +1,82 @@
+#ifndef TEST_IMPORT_DIAGNOSTICS_HPP
+#define TEST_IMPORT_DIAGNOSTICS_HPP
+
+#include <qobject.h>
+#include <qtest.h>
+
+#include "import_diagnostics.hpp"
+
+
+class ImportDiagnosticsTests : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testCounts(void)
+    {
+        ImportDiagnostics diagnostics;
+
+        QVERIFY(diagnostics.isEmpty());
+
+        for (int line = 10; line < 1010; line++)
+        {
+            diagnostics.add("Invalid timestamp", 0, line);
+
+            if (line % 10 == 0)
+            {
+                diagnostics.add("Bad value", 2, line);
+            }
+        }
+
+        diagnostics.add("Bad value", 3, 2000);
+        diagnostics.add("Truncated file");
+
+        QCOMPARE(diagnostics.getCount(), (uint64_t) 1102);
+        QCOMPARE(diagnostics.getCount("Invalid timestamp"), (uint64_t) 1000);
+        QCOMPARE(diagnostics.getCount("Bad value"), (uint64_t) 101);
+
+        // One entry per category and column
+        QCOMPARE(diagnostics.getIssues().size(), (size_t) 4);
+
+        const auto &first = diagnostics.getIssues().at(0);
+
+        QCOMPARE(first.count, (uint64_t) 1000);
+        QCOMPARE(first.lines.size(), (size_t) ImportDiagnostics::MAX_EXAMPLE_LINES);
+        QCOMPARE(first.lines.front(), (int64_t) 10);
+
+        diagnostics.clear();
+
+        QVERIFY(diagnostics.isEmpty());
+        QVERIFY(diagnostics.getIssues().empty());
+    }
+
+    void testSummary(void)
+    {
+        ImportDiagnostics diagnostics;
+
+        QStringList errors;
+
+        diagnostics.report(errors);
+        QVERIFY(errors.isEmpty());
+
+        diagnostics.add("Invalid timestamp", 0, 17);
+        diagnostics.add("Invalid timestamp", 0, 18);
+        diagnostics.add("Missing column", 5, 3);
+
+        diagnostics.report(errors, QStringList() << "time" << "value");
+
+        QCOMPARE(errors.count(), 2);
+        QCOMPARE(errors.at(0), QString("Invalid timestamp: 2 occurrences (column 'time'), e.g. lines 17, 18"));
+        QCOMPARE(errors.at(1), QString("Missing column: 1 occurrence (column 5), line 3"));
+
+        // The number of reported issues is limited
+        for (int col = 0; col < 100; col++)
+        {
+            diagnostics.add("Bad value", col);
+        }
+
+        QCOMPARE(diagnostics.getSummary().count(), ImportDiagnostics::MAX_REPORTED_ISSUES + 1);
+    }
+};
+
+#endif // TEST_IMPORT_DIAGNOSTICS_HPP
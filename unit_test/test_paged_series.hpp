@@ -0,0 +1,229 @@
+#ifndef TEST_PAGED_SERIES_H
+#define TEST_PAGED_SERIES_H
+
+#include <qobject.h>
+#include <qtest.h>
+
+#include "paged_data_series.hpp"
+
+class PagedDataSeriesTests : public QObject
+{
+    Q_OBJECT
+
+public:
+    PagedDataSeriesTests() : series("paged series") {}
+
+    // Three full pages, and a partial tail page
+    const uint64_t N = PagedDataSeries::PAGE_SAMPLES * 3 + 1000;
+
+private slots:
+
+    void initTestCase(void)
+    {
+        PageStore::setResidentPageLimit(2);
+    }
+
+    void cleanupTestCase(void)
+    {
+        PageStore::setResidentPageLimit(PageStore::DEFAULT_RESIDENT_PAGES);
+    }
+
+    void init(void)
+    {
+        series.clearData();
+
+        std::vector<DataPoint> points;
+
+        for (uint64_t idx = 0; idx < N; idx++)
+        {
+            points.push_back(DataPoint(idx, idx % 1000));
+        }
+
+        series.appendData(points);
+    }
+
+    void testStorage(void)
+    {
+        QVERIFY(series.isDiskBacked());
+
+        QCOMPARE(series.size(), N);
+        QCOMPARE(series.getPageCount(), 3);
+
+        QCOMPARE(series.getOldestTimestamp(), 0);
+        QCOMPARE(series.getNewestTimestamp(), N - 1);
+    }
+
+    // Random access across pages, with a limited number of resident pages
+    void testDataAccess(void)
+    {
+        for (uint64_t idx = 0; idx < N; idx += 997)
+        {
+            QCOMPARE(series.getTimestamp(idx), idx);
+            QCOMPARE(series.getValue(idx), idx % 1000);
+
+            QVERIFY(PageStore::getInstance()->getResidentPageCount() <= 2);
+        }
+
+        auto data = series.getData();
+
+        QCOMPARE(data.size(), N);
+        QCOMPARE(data.back().timestamp, N - 1);
+    }
+
+    void testIndexSearch(void)
+    {
+        QCOMPARE(series.getIndexForTimestamp(-1), 0);
+        QCOMPARE(series.getIndexForTimestamp(N + 10), N);
+
+        for (uint64_t idx = 1000; idx < N; idx += 12345)
+        {
+            QCOMPARE(series.getIndexForTimestamp(idx + 0.5), idx + 1);
+            QCOMPARE(series.getIndexForTimestamp(idx, DataSeries::SEARCH_RIGHT_TO_LEFT), idx);
+        }
+    }
+
+    void testSummary(void)
+    {
+        DataSummaryBlock block;
+
+        QVERIFY(series.getSummaryBlock(PagedDataSeries::PAGE_SAMPLES + 5, block));
+        QCOMPARE(block.first_index, PagedDataSeries::PAGE_SAMPLES);
+        QCOMPARE(block.last_index, 2 * PagedDataSeries::PAGE_SAMPLES - 1);
+        QCOMPARE(block.min.value, 0);
+        QCOMPARE(block.max.value, 999);
+
+        // No summary for the tail page
+        QVERIFY(!series.getSummaryBlock(N - 1, block));
+
+        QCOMPARE(series.getMinimumValue(), 0);
+        QCOMPARE(series.getMaximumValue(), 999);
+    }
+
+    // Out-of-order samples are merged into the sealed pages
+    void testOutOfOrder(void)
+    {
+        series.addData(10.5, 5);
+        series.addData(N - 10.5, 5);
+
+        QCOMPARE(series.getOutOfOrderCount(), 2);
+
+        QCOMPARE(series.size(), N + 2);
+        QCOMPARE(series.getPageCount(), 3);
+
+        QCOMPARE(series.getTimestamp(11), 10.5);
+        QCOMPARE(series.getTimestamp(12), 11);
+        QCOMPARE(series.getTimestamp(N - 9), N - 10.5);
+        QCOMPARE(series.getNewestTimestamp(), N - 1);
+
+        // Page summaries are updated
+        DataSummaryBlock block;
+
+        QVERIFY(series.getSummaryBlock(PagedDataSeries::PAGE_SAMPLES, block));
+        QCOMPARE(block.first.timestamp, PagedDataSeries::PAGE_SAMPLES - 1);
+    }
+
+    // Jittered data (imported in chunks) are all retained, in order
+    void testJitteredImport(void)
+    {
+        series.clearData();
+
+        std::vector<DataPoint> points;
+
+        for (uint64_t idx = 0; idx < N; idx++)
+        {
+            // Every seventh sample arrives up to two pages late
+            double t = (idx % 7 == 3) ? idx - (idx * 7919) % (2 * PagedDataSeries::PAGE_SAMPLES) : idx;
+
+            points.push_back(DataPoint(t, idx));
+        }
+
+        const uint64_t CHUNK = 10000;
+
+        for (uint64_t idx = 0; idx < N; idx += CHUNK)
+        {
+            std::vector<DataPoint> chunk(points.begin() + idx, points.begin() + std::min(idx + CHUNK, N));
+
+            series.appendData(chunk, false);
+        }
+
+        QVERIFY(series.getOutOfOrderCount() > 0);
+
+        auto data = series.getData();
+
+        QCOMPARE(data.size(), N);
+
+        std::stable_sort(points.begin(), points.end(), [](const DataPoint &a, const DataPoint &b) {
+            return a.timestamp < b.timestamp;
+        });
+
+        for (uint64_t idx = 0; idx < N; idx++)
+        {
+            QCOMPARE(data[idx].timestamp, points[idx].timestamp);
+            QCOMPARE(data[idx].value, points[idx].value);
+        }
+
+        QCOMPARE(series.getPageCount(), 3);
+    }
+
+    // Pages of all series are written to the same store, and released slots are reused
+    void testSharedStore(void)
+    {
+        auto store = PageStore::getInstance();
+
+        QCOMPARE(store->getPageCount(), 3);
+
+        PagedDataSeries other("other series");
+
+        std::vector<DataPoint> points;
+
+        for (uint64_t idx = 0; idx < PagedDataSeries::PAGE_SAMPLES * 2; idx++)
+        {
+            points.push_back(DataPoint(idx, -1.0 * idx));
+        }
+
+        other.appendData(points);
+
+        QCOMPARE(other.getPageCount(), 2);
+        QCOMPARE(store->getPageCount(), 5);
+
+        // Pages are read back from the correct slots
+        QCOMPARE(series.getValue(PagedDataSeries::PAGE_SAMPLES + 7), (PagedDataSeries::PAGE_SAMPLES + 7) % 1000);
+        QCOMPARE(other.getValue(PagedDataSeries::PAGE_SAMPLES + 7), -1.0 * (PagedDataSeries::PAGE_SAMPLES + 7));
+
+        QVERIFY(store->getResidentPageCount() <= 2);
+
+        other.clearData();
+
+        QCOMPARE(store->getPageCount(), 3);
+
+        // Slots are reused
+        other.appendData(points);
+
+        QCOMPARE(store->getPageCount(), 5);
+        QCOMPARE(other.getValue(5), -5);
+        QCOMPARE(series.getValue(5), 5);
+    }
+
+    void testClip(void)
+    {
+        double t_min = PagedDataSeries::PAGE_SAMPLES + 100;
+        double t_max = 2 * PagedDataSeries::PAGE_SAMPLES + 100;
+
+        series.clipTimeRange(t_min, t_max);
+
+        QCOMPARE(series.size(), PagedDataSeries::PAGE_SAMPLES + 1);
+        QCOMPARE(series.getOldestTimestamp(), t_min);
+        QCOMPARE(series.getNewestTimestamp(), t_max);
+        QCOMPARE(series.getPageCount(), 2);
+
+        // New data are appended after the clipped region
+        series.addData(t_max + 1, 1);
+        QCOMPARE(series.getNewestTimestamp(), t_max + 1);
+    }
+
+protected:
+
+    PagedDataSeries series;
+};
+
+#endif // TEST_PAGED_SERIES_H
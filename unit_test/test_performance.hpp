@@ -0,0 +1,156 @@
+#ifndef TEST_PERFORMANCE_HPP
+#define TEST_PERFORMANCE_HPP
+
+#include <qobject.h>
+#include <qtest.h>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+#include <thread>
+#include <vector>
+
+#include "performance_monitor.hpp"
+
+
+class PerformanceMonitorTests : public QObject
+{
+    Q_OBJECT
+
+protected:
+    static PerformanceStatistic findStatistic(QString name, QString detail = QString())
+    {
+        for (const auto &stat : PerformanceMonitor::getInstance()->getStatistics())
+        {
+            if (stat.name == name && stat.detail == detail) return stat;
+        }
+
+        return PerformanceStatistic();
+    }
+
+private slots:
+    void testScope(void)
+    {
+        auto *monitor = PerformanceMonitor::getInstance();
+
+        monitor->reset();
+
+        for (int ii = 0; ii < 10; ii++)
+        {
+            PerformanceScope scope("Test/Scope", "detail");
+        }
+
+        monitor->recordCounter("Test/Counter", QString(), 5);
+        monitor->recordCounter("Test/Counter", QString(), 15);
+
+        monitor->collect();
+
+        auto scope = findStatistic("Test/Scope", "detail");
+
+        QCOMPARE(scope.count, (uint64_t) 10);
+        QVERIFY(scope.minimum >= 0);
+        QVERIFY(scope.maximum >= scope.minimum);
+
+        auto counter = findStatistic("Test/Counter");
+
+        QCOMPARE(counter.type, PerformanceEvent::COUNTER);
+        QCOMPARE(counter.count, (uint64_t) 2);
+        QCOMPARE(counter.getMean(), 10.0);
+        QCOMPARE(counter.last, 15.0);
+
+        // Nothing is recorded while disabled
+        PerformanceMonitor::setEnabled(false);
+
+        {
+            PerformanceScope disabled("Test/Scope", "detail");
+        }
+
+        PerformanceMonitor::setEnabled(true);
+
+        monitor->collect();
+
+        QCOMPARE(findStatistic("Test/Scope", "detail").count, (uint64_t) 10);
+    }
+
+    void testThreads(void)
+    {
+        auto *monitor = PerformanceMonitor::getInstance();
+
+        monitor->reset();
+
+        const int THREADS = 4;
+        const int EVENTS = 1000;
+
+        // Threads record concurrently (each into its own buffer)
+        std::vector<std::thread> threads;
+
+        for (int t = 0; t < THREADS; t++)
+        {
+            threads.emplace_back([=]()
+            {
+                for (int ii = 0; ii < EVENTS; ii++)
+                {
+                    PerformanceScope scope("Test/Thread");
+                }
+            });
+        }
+
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+
+        monitor->collect();
+
+        QCOMPARE(findStatistic("Test/Thread").count, (uint64_t) (THREADS * EVENTS));
+    }
+
+    void testExportTrace(void)
+    {
+        auto *monitor = PerformanceMonitor::getInstance();
+
+        monitor->reset();
+
+        {
+            PerformanceScope scope("Test/Export", "span");
+        }
+
+        monitor->recordCounter("Test/Export", "counter", 42);
+        monitor->collect();
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+
+        QString filename = dir.filePath("trace.json");
+        QStringList errors;
+
+        QVERIFY(monitor->exportTrace(filename, errors));
+
+        QFile file(filename);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+
+        QJsonParseError error;
+        QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+
+        QCOMPARE(error.error, QJsonParseError::NoError);
+
+        QJsonArray events = doc.object()["traceEvents"].toArray();
+
+        QCOMPARE(events.count(), 2);
+
+        QJsonObject span = events.at(0).toObject();
+
+        QCOMPARE(span["ph"].toString(), QString("X"));
+        QCOMPARE(span["cat"].toString(), QString("Test"));
+        QCOMPARE(span["args"].toObject()["detail"].toString(), QString("span"));
+
+        QJsonObject counter = events.at(1).toObject();
+
+        QCOMPARE(counter["ph"].toString(), QString("C"));
+        QCOMPARE(counter["args"].toObject()["value"].toDouble(), 42.0);
+    }
+};
+
+#endif // TEST_PERFORMANCE_HPP
@@ -0,0 +1,119 @@
+#ifndef TEST_REGISTRY_HPP
+#define TEST_REGISTRY_HPP
+
+#include <qobject.h>
+#include <qtest.h>
+
+#include "data_source.hpp"
+#include "series_registry.hpp"
+
+
+class SeriesRegistryTests : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testLookup(void)
+    {
+        SeriesRegistry registry;
+
+        DataSourcePointer source(new DataSource("test", "Flight Log"));
+
+        source->addSeries(new DataSeries("Altitude"));
+        source->addSeries(new DataSeries("Airspeed"));
+
+        registry.registerSource(source);
+
+        QCOMPARE(registry.getSeriesCount(), 2);
+
+        QVERIFY(registry.findSource("Flight Log") == source);
+        QVERIFY(registry.findSource("Other").isNull());
+
+        DataSeriesPointer altitude = registry.findSeries("Flight Log", "Altitude");
+
+        QVERIFY(!altitude.isNull());
+        QVERIFY(altitude == source->getSeriesByLabel("Altitude"));
+        QVERIFY(registry.findSeries("Flight Log:Airspeed") == source->getSeriesByLabel("Airspeed"));
+        QVERIFY(registry.findSeries("Flight Log", "Heading").isNull());
+
+        // IDs are stable, and are not re-used
+        SeriesId id = registry.getId(altitude.data());
+
+        QVERIFY(id != SeriesRegistry::INVALID_ID);
+        QVERIFY(registry.getSeries(id) == altitude);
+        QVERIFY(registry.getSource(id) == source.data());
+
+        QVERIFY(registry.unregisterSeries(altitude.data()));
+        QVERIFY(registry.getSeries(id).isNull());
+        QVERIFY(registry.findSeries("Flight Log", "Altitude").isNull());
+
+        QVERIFY(registry.registerSeries(source.data(), altitude) > id);
+
+        // Renamed series are found by their new label
+        altitude->setLabel("Height");
+        registry.updateSeries(altitude.data());
+
+        QVERIFY(registry.findSeries("Flight Log", "Altitude").isNull());
+        QVERIFY(registry.findSeries("Flight Log", "Height") == altitude);
+        QCOMPARE(registry.search("height").count(), 1);
+        QCOMPARE(registry.search("altitude").count(), 0);
+
+        registry.unregisterSource(source);
+
+        QCOMPARE(registry.getSeriesCount(), 0);
+        QVERIFY(registry.findSource("Flight Log").isNull());
+    }
+
+    void testSearch(void)
+    {
+        SeriesRegistry registry;
+
+        DataSourcePointer source(new DataSource("test", "Log"));
+
+        const int N = 5000;
+
+        for (int ii = 0; ii < N; ii++)
+        {
+            source->addSeries(new DataSeries(QString("GPS_%1.Lat").arg(ii)));
+            source->addSeries(new DataSeries(QString("IMU_%1.AccX").arg(ii)));
+        }
+
+        registry.registerSource(source);
+
+        QCOMPARE(registry.getSeriesCount(), 2 * N);
+
+        // Substring search (case insensitive, all terms must match)
+        QCOMPARE(registry.search("accx").count(), N);
+        QCOMPARE(registry.search("IMU_123").count(), 11);
+        QCOMPARE(registry.search("imu_123 accx").count(), 11);
+        QCOMPARE(registry.search("imu lat").count(), 0);
+        QCOMPARE(registry.search("zzz").count(), 0);
+
+        // Short terms are not indexed, but must still be found
+        QCOMPARE(registry.search("x").count(), N);
+
+        // Prefix search
+        QCOMPARE(registry.searchPrefix("gps_4999").count(), 1);
+        QCOMPARE(registry.searchPrefix("gps_499").count(), 11);
+        QCOMPARE(registry.searchPrefix("lat").count(), 0);
+
+        // Similar labels (e.g. with a typo)
+        auto similar = registry.searchSimilar("imu_1234.acx", 5);
+
+        QVERIFY(similar.count() > 0);
+        QCOMPARE(registry.getSeries(similar.first())->getLabel(), QString("IMU_1234.AccX"));
+
+        // Removed series are no longer found
+        for (int ii = 0; ii < N; ii++)
+        {
+            registry.unregisterSeries(source->getSeriesByLabel(QString("IMU_%1.AccX").arg(ii)).data());
+        }
+
+        QCOMPARE(registry.getSeriesCount(), N);
+        QCOMPARE(registry.search("accx").count(), 0);
+        QCOMPARE(registry.search("lat").count(), N);
+    }
+};
+
+
+#endif // TEST_REGISTRY_HPP
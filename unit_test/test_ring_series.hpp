@@ -0,0 +1,170 @@
+#ifndef TEST_RING_SERIES_H
+#define TEST_RING_SERIES_H
+
+#include <math.h>
+
+#include <qobject.h>
+#include <qtest.h>
+
+#include "ring_buffer_data_series.hpp"
+
+class RingBufferDataSeriesTests : public QObject
+{
+    Q_OBJECT
+
+public:
+    RingBufferDataSeriesTests() : series("ring series", 100) {}
+
+private slots:
+
+    void init(void)
+    {
+        series.clearData();
+
+        for (int idx = 0; idx < 50; idx++)
+        {
+            series.addData(idx, idx * 2);
+        }
+    }
+
+    // Tests for size and capacity
+    void testSize(void)
+    {
+        QCOMPARE(series.getCapacity(), 100);
+        QCOMPARE(series.size(), 50);
+
+        series.clearData();
+        QCOMPARE(series.size(), 0);
+    }
+
+    // Once the buffer is full, the oldest samples are evicted
+    void testEviction(void)
+    {
+        uint64_t evicted = series.getEvictedCount();
+
+        for (int idx = 50; idx < 250; idx++)
+        {
+            series.addData(idx, idx * 2);
+        }
+
+        QCOMPARE(series.size(), 100);
+        QCOMPARE(series.getEvictedCount(), evicted + 150);
+
+        QCOMPARE(series.getOldestTimestamp(), 150);
+        QCOMPARE(series.getNewestTimestamp(), 249);
+
+        // Data are returned in time order
+        for (size_t idx = 0; idx < series.size(); idx++)
+        {
+            QCOMPARE(series.getTimestamp(idx), 150 + idx);
+            QCOMPARE(series.getValue(idx), (150 + idx) * 2);
+        }
+
+        auto data = series.getData();
+
+        QCOMPARE(data.size(), 100);
+        QCOMPARE(data.front().timestamp, 150);
+        QCOMPARE(data.back().timestamp, 249);
+
+        QVERIFY_EXCEPTION_THROWN(series.getValue(100), std::out_of_range);
+    }
+
+    // Out-of-order samples are discarded
+    void testOutOfOrder(void)
+    {
+        uint64_t discarded = series.getDiscardedCount();
+
+        series.addData(10, 1000);
+        series.addData(25.5, 1000);
+
+        QCOMPARE(series.size(), 50);
+        QCOMPARE(series.getDiscardedCount(), discarded + 2);
+
+        // Samples with a duplicate timestamp are accepted
+        series.addData(49, 1000);
+        QCOMPARE(series.size(), 51);
+    }
+
+    // Binary search must account for the buffer wrapping around
+    void testIndexSearch(void)
+    {
+        for (int idx = 50; idx < 130; idx++)
+        {
+            series.addData(idx, idx);
+        }
+
+        // Buffer now contains timestamps [30, 129]
+        QCOMPARE(series.getIndexForTimestamp(0), 0);
+        QCOMPARE(series.getIndexForTimestamp(1000), 100);
+
+        QCOMPARE(series.getIndexForTimestamp(75.5), 46);
+        QCOMPARE(series.getIndexForTimestamp(75, DataSeries::SEARCH_RIGHT_TO_LEFT), 45);
+        QCOMPARE(series.getIndexForTimestamp(75, DataSeries::SEARCH_LEFT_TO_RIGHT), 46);
+    }
+
+    // Clipping discards samples at either end of the buffer
+    void testClip(void)
+    {
+        series.clipTimeRange(10, 39.5);
+
+        QCOMPARE(series.size(), 30);
+        QCOMPARE(series.getOldestTimestamp(), 10);
+        QCOMPARE(series.getNewestTimestamp(), 39);
+    }
+
+    // Deferred updates are delivered by flushUpdate()
+    void testDeferredUpdate(void)
+    {
+        update_count = 0;
+
+        connect(&series, SIGNAL(dataUpdated()), this, SLOT(onDataUpdated()));
+
+        for (int idx = 50; idx < 60; idx++)
+        {
+            series.addData(idx, idx, false);
+        }
+
+        QCOMPARE(update_count, 0);
+        QVERIFY(series.hasPendingUpdate());
+
+        QVERIFY(series.flushUpdate());
+        QCOMPARE(update_count, 1);
+
+        // Nothing pending, so no signal emitted
+        QVERIFY(!series.flushUpdate());
+        QCOMPARE(update_count, 1);
+
+        disconnect(&series, SIGNAL(dataUpdated()), this, SLOT(onDataUpdated()));
+    }
+
+    // A block of samples is appended under a single lock, with the same rules as addData()
+    void testAppendColumns(void)
+    {
+        size_t n = series.size();
+        uint64_t discarded = series.getDiscardedCount();
+
+        std::vector<double> timestamps = {60, 61, 55, 62, 63};
+        std::vector<double> values = {1, 2, 3, NAN, 5};
+
+        series.appendColumns(timestamps.data(), values.data(), timestamps.size(), false);
+
+        QCOMPARE(series.size(), n + 3);
+        QCOMPARE(series.getDiscardedCount(), discarded + 1);
+        QCOMPARE(series.getNewestTimestamp(), 63);
+        QVERIFY(series.hasPendingUpdate());
+    }
+
+public slots:
+    void onDataUpdated()
+    {
+        update_count++;
+    }
+
+protected:
+
+    int update_count = 0;
+
+    RingBufferDataSeries series;
+};
+
+#endif // TEST_RING_SERIES_H
@@ -2,11 +2,46 @@
 #define TEST_SERIES_H
 
 #include <stdlib.h>
+#include <math.h>
 
 #include <qobject.h>
 #include <qtest.h>
 
 #include "data_series.hpp"
+#include "compressed_data_series.hpp"
+#include "float32_data_series.hpp"
+#include "paged_data_series.hpp"
+#include "ring_buffer_data_series.hpp"
+
+
+/*
+ * Exposes the unchecked (raw) sample accessor of a storage mode,
+ * which is reached without an index check if the series is modified after the caller checked size()
+ */
+template <typename Series>
+class RawAccessSeries : public Series
+{
+public:
+    RawAccessSeries(QString label) : Series(label) {}
+
+    using Series::getRawDataPoint;
+};
+
+
+template <typename Series>
+static void checkRawAccess(RawAccessSeries<Series> &series)
+{
+    QVERIFY_EXCEPTION_THROWN(series.getRawDataPoint(0), std::out_of_range);
+
+    for (int ii = 0; ii < 10; ii++)
+    {
+        series.addData(DataPoint(ii, ii), false);
+    }
+
+    QCOMPARE(series.getRawDataPoint(9).value, 9);
+    QVERIFY_EXCEPTION_THROWN(series.getRawDataPoint(10), std::out_of_range);
+}
+
 
 class DataSeriesTests : public QObject
 {
@@ -59,6 +94,22 @@ private slots:
         QVERIFY_EXCEPTION_THROWN(series.getValue(1000), std::out_of_range);
     }
 
+    // Out-of-range raw accesses throw (rather than returning another sample) in every storage mode
+    void testRawAccessRange(void)
+    {
+        RawAccessSeries<DataSeries> memory("memory");
+        RawAccessSeries<Float32DataSeries> floats("floats");
+        RawAccessSeries<RingBufferDataSeries> ring("ring");
+        RawAccessSeries<CompressedDataSeries> compressed("compressed");
+        RawAccessSeries<PagedDataSeries> paged("paged");
+
+        checkRawAccess(memory);
+        checkRawAccess(floats);
+        checkRawAccess(ring);
+        checkRawAccess(compressed);
+        checkRawAccess(paged);
+    }
+
     // Test for data update signals
     void testDataSignals(void)
     {
@@ -273,6 +324,303 @@ private slots:
         }
     }
 
+    // Test bulk insertion of samples
+    void testAppendData(void)
+    {
+        update_count = 0;
+
+        connect(&series, SIGNAL(dataUpdated()), this, SLOT(onDataUpdated()), Qt::UniqueConnection);
+
+        std::vector<DataPoint> points;
+
+        for (int ii = 100; ii < 200; ii++)
+        {
+            points.push_back(DataPoint(ii, ii));
+        }
+
+        // Out-of-order and invalid samples
+        points.push_back(DataPoint(50.5, 1));
+        points.push_back(DataPoint(150.5, NAN));
+
+        series.appendData(points, false);
+
+        QCOMPARE(series.size(), 201);
+        QCOMPARE(series.getNewestTimestamp(), 199);
+        QVERIFY(isInOrder());
+
+        // A single (deferred) update signal
+        QCOMPARE(update_count, 0);
+        QVERIFY(series.flushUpdate());
+        QCOMPARE(update_count, 1);
+
+        disconnect(&series, SIGNAL(dataUpdated()), this, SLOT(onDataUpdated()));
+    }
+
+    // Test bulk (scaled) data access
+    void testBulkAccess(void)
+    {
+        std::vector<DataPoint> points(150);
+
+        series.setScaler(2, false);
+        series.setOffset(1, false);
+
+        // Only the available samples are copied
+        QCOMPARE(series.getDataPoints(50, points.size(), points.data()), 50);
+        QCOMPARE(series.getDataPoints(100, points.size(), points.data()), 0);
+
+        DataSeriesReader reader(series, 16);
+
+        for (uint64_t idx = 0; idx < series.size(); idx++)
+        {
+            QCOMPARE(reader.getTimestamp(idx), series.getTimestamp(idx));
+            QCOMPARE(reader.getValue(idx), series.getValue(idx));
+        }
+
+        QCOMPARE(points[10].value, series.getValue(60));
+
+        series.setScaler(1, false);
+        series.setOffset(0, false);
+    }
+
+    // Test single-precision value storage
+    void testFloatPrecision(void)
+    {
+        Float32DataSeries floats("float series");
+
+        QCOMPARE(floats.getValuePrecision(), DataSeries::PRECISION_FLOAT);
+
+        std::vector<DataPoint> points;
+
+        for (int ii = 0; ii < 100; ii++)
+        {
+            points.push_back(DataPoint(ii, ii * 0.1));
+        }
+
+        floats.appendData(points);
+        floats.addData(DataPoint(50.5, 1));
+
+        QCOMPARE(floats.getOutOfOrderCount(), 1);
+
+        QCOMPARE(floats.size(), 101);
+        QCOMPARE(floats.getValue(51), 1);
+        QCOMPARE(floats.getValue(10), (double) 1.0f);
+        QCOMPARE(floats.getValue(19), (double) (float) (19 * 0.1));
+        QVERIFY(floats.getValue(19) != 19 * 0.1);
+
+        QCOMPARE(floats.getIndexForTimestamp(50.5, DataSeries::SEARCH_RIGHT_TO_LEFT), 51);
+
+        // Out-of-order samples are merged (in a single pass) when the series is next read
+        points.clear();
+
+        for (int ii = 100; ii < 200; ii++)
+        {
+            points.push_back(DataPoint(ii % 10 == 0 ? ii - 75 : ii, 2));
+        }
+
+        floats.appendData(points);
+
+        QCOMPARE(floats.getOutOfOrderCount(), 11);
+        QCOMPARE(floats.size(), 201);
+
+        for (uint64_t ii = 1; ii < floats.size(); ii++)
+        {
+            QVERIFY(floats.getTimestamp(ii) >= floats.getTimestamp(ii - 1));
+        }
+
+        // Existing samples precede late samples with the same timestamp
+        uint64_t idx = floats.getIndexForTimestamp(25, DataSeries::SEARCH_RIGHT_TO_LEFT);
+
+        QCOMPARE(floats.getValue(idx), (double) 2.5f);
+        QCOMPARE(floats.getValue(idx + 1), 2);
+
+        floats.clipTimeRange(10, 20);
+        QCOMPARE(floats.size(), 11);
+        QCOMPARE(floats.getOldestTimestamp(), 10);
+        QCOMPARE(floats.getNewestTimestamp(), 20);
+
+        floats.clearData();
+        QCOMPARE(floats.getOutOfOrderCount(), 0);
+
+        // Values are stored in a single precision column, in the same block layout as DataSeries
+        const uint64_t N = Float32Storage::BLOCK_SIZE * 2 + 100;
+
+        for (uint64_t ii = 0; ii < N; ii++)
+        {
+            floats.addData(DataPoint(ii, ii), false);
+        }
+
+        QCOMPARE(floats.size(), N);
+        QCOMPARE(floats.getValue(Float32Storage::BLOCK_SIZE), Float32Storage::BLOCK_SIZE);
+        QVERIFY(floats.getMemoryUsage() < (N + Float32Storage::BLOCK_SIZE) * (sizeof(double) + sizeof(float)));
+    }
+
+    void testAppendColumns(void)
+    {
+        const uint64_t N = 1000;
+
+        std::vector<double> timestamps(N);
+        std::vector<double> values(N);
+
+        for (uint64_t ii = 0; ii < N; ii++)
+        {
+            timestamps[ii] = ii;
+            values[ii] = ii * 2;
+        }
+
+        // Missing samples are ignored
+        values[10] = NAN;
+
+        DataSeries doubles("doubles");
+        Float32DataSeries floats("floats");
+
+        for (DataSeries *s : {(DataSeries*) &doubles, (DataSeries*) &floats})
+        {
+            s->appendColumns(timestamps.data(), values.data(), N);
+
+            QCOMPARE(s->size(), N - 1);
+            QCOMPARE(s->getTimestamp(10), 11);
+            QCOMPARE(s->getValue(999 - 1), 1998);
+
+            // Out-of-order data are inserted in the correct position
+            double t = 4.5;
+            double v = -1;
+
+            s->appendColumns(&t, &v, 1);
+
+            QCOMPARE(s->size(), N);
+            QCOMPARE(s->getTimestamp(5), 4.5);
+            QCOMPARE(s->getValue(5), -1);
+        }
+    }
+
+    // Test access and searching across storage block boundaries
+    void testStorageBlocks(void)
+    {
+        const uint64_t N = DataStorage::BLOCK_SIZE * 3 + 100;
+
+        DataSeries blocks("blocks");
+
+        // Each timestamp appears twice, so equal timestamps span the block boundaries
+        for (uint64_t ii = 0; ii < N; ii++)
+        {
+            blocks.addData(DataPoint(ii / 2, ii), false);
+        }
+
+        QCOMPARE(blocks.size(), N);
+
+        // Memory is allocated in blocks, rather than doubling
+        QVERIFY(blocks.getMemoryUsage() < (N + DataStorage::BLOCK_SIZE) * sizeof(DataPoint));
+
+        const uint64_t boundary = DataStorage::BLOCK_SIZE * 2;
+
+        QCOMPARE(blocks.getValue(boundary - 1), boundary - 1);
+        QCOMPARE(blocks.getValue(boundary), boundary);
+
+        double t = boundary / 2;
+
+        QCOMPARE(blocks.getIndexForTimestamp(t, DataSeries::SEARCH_RIGHT_TO_LEFT), boundary);
+        QCOMPARE(blocks.getIndexForTimestamp(t, DataSeries::SEARCH_LEFT_TO_RIGHT), boundary + 2);
+        QCOMPARE(blocks.getIndexForTimestamp(t - 0.5, DataSeries::SEARCH_RIGHT_TO_LEFT), boundary);
+
+        // Bulk access across a boundary
+        std::vector<DataPoint> points(100);
+
+        QCOMPARE(blocks.getDataPoints(boundary - 50, points.size(), points.data()), 100);
+
+        for (uint64_t ii = 0; ii < points.size(); ii++)
+        {
+            QCOMPARE(points[ii].value, boundary - 50 + ii);
+        }
+
+        // Out-of-order samples are merged into the correct block
+        blocks.addData(DataPoint(10.5, -1), false);
+        blocks.addData(DataPoint(t, -2), false);
+
+        QCOMPARE(blocks.size(), N + 2);
+        QCOMPARE(blocks.getValue(22), -1);
+        QCOMPARE(blocks.getValue(boundary + 3), -2);
+        QCOMPARE(blocks.getValue(boundary + 4), boundary + 2);
+    }
+
+    // Out-of-order samples are buffered, and merged when the series is sealed
+    void testOutOfOrderIngestion(void)
+    {
+        // Samples span several compressed blocks, and several pages
+        const int N = 200000;
+
+        QList<DataSeriesPointer> modes = {
+            DataSeriesPointer(new DataSeries("jitter")),
+            DataSeriesPointer(new Float32DataSeries("jitter (float)")),
+            DataSeriesPointer(new CompressedDataSeries("jitter (compressed)")),
+            DataSeriesPointer(new PagedDataSeries("jitter (paged)")),
+        };
+
+        std::vector<DataPoint> points;
+
+        // Every twentieth sample arrives 30ms late
+        for (int ii = 0; ii < N; ii++)
+        {
+            int t = (ii % 20 == 19) ? ii - 30 : ii;
+
+            points.push_back(DataPoint(t, t));
+        }
+
+        for (auto jitter : modes)
+        {
+            jitter->appendData(points, false);
+
+            QCOMPARE(jitter->getOutOfOrderCount(), N / 20);
+            QCOMPARE(jitter->getMaximumLateness(), 29);
+
+            jitter->seal();
+
+            QCOMPARE(jitter->size(), N);
+            QCOMPARE(jitter->getTimestamp(0), -11);
+            QCOMPARE(jitter->getNewestTimestamp(), N - 2);
+
+            // Buffered samples are merged when the series is read
+            jitter->addData(DataPoint(5000.5, -1), false);
+            jitter->addData(DataPoint(5000.5, -2), false);
+
+            uint64_t idx = jitter->getIndexForTimestamp(5000.5, DataSeries::SEARCH_RIGHT_TO_LEFT);
+
+            QCOMPARE(jitter->getTimestamp(idx), 5000.5);
+            QCOMPARE(jitter->getValue(idx), -1);
+            QCOMPARE(jitter->getValue(idx + 1), -2);
+
+            QCOMPARE(jitter->size(), N + 2);
+            QCOMPARE(jitter->getOutOfOrderCount(), N / 20 + 2);
+
+            auto data = jitter->getData();
+
+            for (uint64_t ii = 1; ii < data.size(); ii++)
+            {
+                QVERIFY(data[ii].timestamp >= data[ii - 1].timestamp);
+            }
+
+            // Truncating (within a block or page) retains the disorder statistics
+            const uint64_t keep = N / 2 + 17;
+
+            jitter->addData(DataPoint(100.5, -3), false);
+            jitter->truncateData(keep, false);
+
+            QCOMPARE(jitter->size(), keep);
+            QCOMPARE(jitter->getValue(jitter->getIndexForTimestamp(100.5, DataSeries::SEARCH_RIGHT_TO_LEFT)), -3);
+            QCOMPARE(jitter->getNewestTimestamp(), data[keep - 2].timestamp);
+            QCOMPARE(jitter->getOutOfOrderCount(), N / 20 + 3);
+
+            jitter->addData(DataPoint(N, N), false);
+
+            QCOMPARE(jitter->size(), keep + 1);
+            QCOMPARE(jitter->getNewestValue(), N);
+
+            jitter->clearData(false);
+
+            QCOMPARE(jitter->getOutOfOrderCount(), 0);
+            QCOMPARE(jitter->getMaximumLateness(), 0);
+        }
+    }
+
 public slots:
     void onDataUpdated()
     {
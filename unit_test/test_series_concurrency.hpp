@@ -0,0 +1,181 @@
+#ifndef TEST_SERIES_CONCURRENCY_H
+#define TEST_SERIES_CONCURRENCY_H
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <qobject.h>
+#include <qtest.h>
+
+#include "data_series.hpp"
+
+
+/*
+ * Samples are read from other threads while the series is modified.
+ *
+ * Every sample has value == 2 * timestamp, so readers can check that they never see
+ * a partially written (or released) sample, and that the data are always sorted.
+ *
+ * These tests are intended to be run with ThreadSanitizer (qmake CONFIG+=tsan)
+ */
+class DataSeriesConcurrencyTests : public QObject
+{
+    Q_OBJECT
+
+private:
+    static const int READER_COUNT = 3;
+
+    // Read from the series until done is set, returning the number of inconsistencies found
+    static uint64_t readSeries(const DataSeries &series, const std::atomic<bool> &done)
+    {
+        uint64_t errors = 0;
+
+        std::vector<DataPoint> points(0x400);
+
+        while (!done.load())
+        {
+            uint64_t n = series.size();
+
+            if (n == 0) continue;
+
+            try
+            {
+                DataPoint newest = series.getNewestDataPoint();
+
+                if (newest.value != 2 * newest.timestamp) errors++;
+            }
+            catch (const std::out_of_range &)
+            {
+                // The series was cleared
+            }
+
+            uint64_t idx = series.getIndexForTimestamp(n / 2, DataSeries::SEARCH_RIGHT_TO_LEFT);
+
+            uint64_t count = series.getDataPoints(idx, points.size(), points.data());
+
+            for (uint64_t ii = 0; ii < count; ii++)
+            {
+                if (points[ii].value != 2 * points[ii].timestamp) errors++;
+
+                if (ii > 0 && points[ii].timestamp < points[ii - 1].timestamp) errors++;
+            }
+
+            series.getMemoryUsage();
+        }
+
+        return errors;
+    }
+
+    // Run the writer function, while reading from the series in other threads
+    template <typename Writer>
+    static uint64_t runConcurrent(DataSeries &series, Writer writer)
+    {
+        std::atomic<bool> done {false};
+        std::atomic<uint64_t> errors {0};
+
+        std::vector<std::thread> readers;
+
+        for (int ii = 0; ii < READER_COUNT; ii++)
+        {
+            readers.push_back(std::thread([&]() {
+                errors += readSeries(series, done);
+            }));
+        }
+
+        writer();
+
+        done = true;
+
+        for (auto &reader : readers)
+        {
+            reader.join();
+        }
+
+        return errors.load();
+    }
+
+private slots:
+
+    // Samples are appended (with buffer growth) while being read
+    void testConcurrentAppend(void)
+    {
+        DataSeries series("append");
+
+        const int N = 200000;
+
+        uint64_t errors = runConcurrent(series, [&]() {
+            std::vector<DataPoint> chunk;
+
+            for (int ii = 0; ii < N; ii++)
+            {
+                if (ii % 2)
+                {
+                    series.addData(DataPoint(ii, 2 * ii), false);
+                }
+                else
+                {
+                    chunk.push_back(DataPoint(ii, 2 * ii));
+                }
+
+                if (chunk.size() >= 100)
+                {
+                    series.appendData(chunk, false);
+                    chunk.clear();
+                }
+            }
+
+            series.appendData(chunk, false);
+        });
+
+        QCOMPARE(errors, 0);
+        QCOMPARE(series.size(), N);
+
+        for (int ii = 0; ii < N; ii += 997)
+        {
+            QCOMPARE(series.getTimestamp(ii), ii);
+        }
+    }
+
+    // The data are replaced (out-of-order merge, clipping and clearing) while being read
+    void testConcurrentReplace(void)
+    {
+        DataSeries series("replace");
+
+        uint64_t errors = runConcurrent(series, [&]() {
+            for (int pass = 0; pass < 20; pass++)
+            {
+                std::vector<DataPoint> points;
+
+                for (int ii = 0; ii < 5000; ii++)
+                {
+                    // Every tenth sample is out of order
+                    int t = (ii % 10 == 9) ? ii - 50 : ii;
+
+                    points.push_back(DataPoint(t, 2 * t));
+                }
+
+                series.appendData(points, false);
+
+                series.addData(DataPoint(10, 20), false);
+
+                series.clipTimeRange(100, 4000, false);
+
+                if (pass % 5 == 0)
+                {
+                    series.clearData(false);
+                }
+            }
+        });
+
+        QCOMPARE(errors, 0);
+
+        DataSeries::SearchDirection direction = DataSeries::SEARCH_LEFT_TO_RIGHT;
+
+        QCOMPARE(series.getIndexForTimestamp(0, direction), 0);
+        QCOMPARE(series.getOldestTimestamp(), 100);
+        QCOMPARE(series.getNewestTimestamp(), 4000);
+    }
+};
+
+#endif // TEST_SERIES_CONCURRENCY_H
@@ -0,0 +1,142 @@
+#ifndef TEST_SYNTHETIC_HPP
+#define TEST_SYNTHETIC_HPP
+
+#include <qobject.h>
+#include <qtest.h>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <math.h>
+#include <vector>
+
+#include "synthetic_importer/synthetic_data_generator.hpp"
+
+
+class SyntheticDataTests : public QObject
+{
+    Q_OBJECT
+
+protected:
+    static void generate(const SyntheticDataOptions &options, int series, std::vector<double> &timestamps, std::vector<double> &values)
+    {
+        SyntheticSeriesGenerator generator(options, 0, series);
+
+        timestamps.resize(options.samplesPerSeries);
+        values.resize(options.samplesPerSeries);
+
+        size_t n = 0;
+
+        // Generate in uneven chunks, which must not affect the output
+        while (generator.getRemaining() > 0)
+        {
+            n += generator.next(timestamps.data() + n, values.data() + n, 777);
+        }
+
+        QCOMPARE(n, (size_t) options.samplesPerSeries);
+    }
+
+private slots:
+    void testDeterministic(void)
+    {
+        SyntheticDataOptions options;
+
+        options.seed = 1234;
+        options.samplesPerSeries = 10000;
+        options.jitter = 0.2;
+        options.gapProbability = 0.001;
+        options.nanFraction = 0.01;
+        options.outOfOrderFraction = 0.01;
+
+        std::vector<double> t1, v1, t2, v2;
+
+        generate(options, 3, t1, v1);
+        generate(options, 3, t2, v2);
+
+        for (size_t ii = 0; ii < t1.size(); ii++)
+        {
+            QCOMPARE(t1[ii], t2[ii]);
+            QVERIFY(v1[ii] == v2[ii] || (isnan(v1[ii]) && isnan(v2[ii])));
+        }
+
+        // A different seed produces different data
+        options.seed = 4321;
+
+        generate(options, 3, t2, v2);
+
+        QVERIFY(v1[100] != v2[100]);
+    }
+
+    void testDisorder(void)
+    {
+        SyntheticDataOptions options;
+
+        options.samplesPerSeries = 100000;
+        options.nanFraction = 0.05;
+        options.outOfOrderFraction = 0.02;
+
+        std::vector<double> timestamps, values;
+
+        generate(options, 0, timestamps, values);
+
+        int nan = 0;
+        int disordered = 0;
+
+        for (size_t ii = 0; ii < timestamps.size(); ii++)
+        {
+            if (isnan(values[ii])) nan++;
+            if (ii > 0 && timestamps[ii] < timestamps[ii - 1]) disordered++;
+        }
+
+        QVERIFY(nan > 4000 && nan < 6000);
+        QVERIFY(disordered > 1000 && disordered < 3000);
+    }
+
+    void testSharedTimebase(void)
+    {
+        SyntheticDataOptions options;
+
+        options.samplesPerSeries = 5000;
+        options.jitter = 0.5;
+        options.rateSpread = 0.5;
+        options.gapProbability = 0.01;
+        options.sharedTimebase = true;
+
+        std::vector<double> t1, v1, t2, v2;
+
+        generate(options, 0, t1, v1);
+        generate(options, 1, t2, v2);
+
+        QVERIFY(t1 == t2);
+    }
+
+    void testWriteCSV(void)
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+
+        SyntheticDataOptions options;
+
+        options.seriesPerSource = 3;
+        options.samplesPerSeries = 1000;
+
+        QString filename = dir.filePath("synthetic.csv");
+        QStringList errors;
+
+        SyntheticDataGenerator generator(options);
+
+        QVERIFY(generator.writeCSV(filename, 0, errors));
+        QVERIFY(errors.isEmpty());
+
+        QFile file(filename);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+
+        QList<QByteArray> lines = file.readAll().split('\n');
+
+        // Header, one line per sample, and a trailing newline
+        QCOMPARE(lines.count(), 1002);
+        QCOMPARE(lines.first(), QByteArray("timestamp,Sine 1,Square 2,Sawtooth 3"));
+        QCOMPARE(lines.at(1).split(',').count(), 4);
+    }
+};
+
+#endif // TEST_SYNTHETIC_HPP
@@ -29,22 +29,86 @@ CONFIG (debug, debug|release) {
 
 INCLUDEPATH += ../qwt/src
 
-INCLUDEPATH += ../src
+INCLUDEPATH += ../src \
+    ../src/plugins \
+    ../plugins
 
 SOURCES += \
+    ../src/compressed_data_series.cpp \
     ../src/data_series.cpp \
+    ../src/data_storage.cpp \
     ../src/data_source.cpp \
+    ../src/filter_pipeline.cpp \
+    ../src/filtered_data_series.cpp \
+    ../src/float32_data_series.cpp \
+    ../src/lumberjack_debug.cpp \
+    ../src/page_store.cpp \
+    ../src/paged_data_series.cpp \
+    ../src/performance_monitor.cpp \
     ../src/plot_curve.cpp \
+    ../src/ring_buffer_data_series.cpp \
+    ../src/series_registry.cpp \
+    ../src/plugins/plugin_importer.cpp \
+    ../plugins/offset_filter/offset_filter.cpp \
+    ../plugins/scaler_filter/scaler_filter.cpp \
+    ../plugins/signal_filters/biquad_cascade.cpp \
+    ../plugins/signal_filters/butterworth_filter.cpp \
+    ../plugins/signal_filters/decimate_filter.cpp \
+    ../plugins/signal_filters/fir_filter.cpp \
+    ../plugins/signal_filters/median_filter.cpp \
+    ../plugins/synthetic_importer/synthetic_data_generator.cpp \
     main.cpp \
 
 HEADERS += \
+    ../src/compressed_data_series.hpp \
+    ../src/data_batch.hpp \
+    ../src/data_point.hpp \
     ../src/data_series.hpp \
+    ../src/data_storage.hpp \
     ../src/data_source.hpp \
+    ../src/filter_pipeline.hpp \
+    ../src/filtered_data_series.hpp \
+    ../src/float32_data_series.hpp \
+    ../src/import_diagnostics.hpp \
+    ../src/lumberjack_debug.hpp \
     ../src/lumberjack_version.hpp \
+    ../src/page_store.hpp \
+    ../src/paged_data_series.hpp \
+    ../src/performance_monitor.hpp \
     ../src/plot_curve.hpp \
+    ../src/ring_buffer_data_series.hpp \
+    ../src/series_registry.hpp \
+    ../src/plugins/plugin_base.hpp \
+    ../src/plugins/plugin_filter.hpp \
+    ../src/plugins/plugin_importer.hpp \
+    ../plugins/offset_filter/offset_filter.hpp \
+    ../plugins/scaler_filter/scaler_filter.hpp \
+    ../plugins/signal_filters/biquad_cascade.hpp \
+    ../plugins/signal_filters/butterworth_filter.hpp \
+    ../plugins/signal_filters/decimate_filter.hpp \
+    ../plugins/signal_filters/fir_filter.hpp \
+    ../plugins/signal_filters/median_filter.hpp \
+    ../plugins/synthetic_importer/synthetic_data_generator.hpp \
+    test_compressed_series.hpp \
     test_curve.hpp \
+    test_data_batch.hpp \
+    test_debug.hpp \
+    test_filter.hpp \
+    test_import_diagnostics.hpp \
+    test_paged_series.hpp \
+    test_performance.hpp \
+    test_registry.hpp \
+    test_ring_series.hpp \
     test_series.hpp \
-    test_source.hpp
+    test_series_concurrency.hpp \
+    test_source.hpp \
+    test_synthetic.hpp
+
+# ThreadSanitizer build (qmake CONFIG+=tsan), for the concurrency tests
+tsan {
+    QMAKE_CXXFLAGS += -fsanitize=thread -g
+    QMAKE_LFLAGS += -fsanitize=thread
+}
 
 # Generate coverage data
 QMAKE_CXXFLAGS += --coverage